@@ -0,0 +1,456 @@
+// Copyright (c) 2026 Kirill Gavrilov
+
+#include "OcctAssemblyTree.h"
+
+#include <AIS_ListOfInteractive.hxx>
+#include <TCollection_HAsciiString.hxx>
+
+#include <algorithm>
+#include <cstring>
+
+#ifdef HAVE_DATAEXCHANGE
+  #include <TDataStd_Name.hxx>
+  #include <TDF_LabelSequence.hxx>
+  #include <TDF_Tool.hxx>
+  #include <XCAFDoc_DocumentTool.hxx>
+  #include <XCAFDoc_ShapeTool.hxx>
+  #include <XCAFPrs_DocumentExplorer.hxx>
+#endif
+
+// ================================================================
+// Function : SetObjectId
+// ================================================================
+void OcctAssemblyTree::SetObjectId(const Handle(AIS_InteractiveObject)& theObj,
+                                   const TCollection_AsciiString& theId)
+{
+  theObj->SetOwner(new TCollection_HAsciiString(theId));
+}
+
+// ================================================================
+// Function : ObjectId
+// ================================================================
+TCollection_AsciiString OcctAssemblyTree::ObjectId(const Handle(AIS_InteractiveObject)& theObj)
+{
+  Handle(TCollection_HAsciiString) anId = Handle(TCollection_HAsciiString)::DownCast(theObj->GetOwner());
+  return !anId.IsNull() ? anId->String() : TCollection_AsciiString();
+}
+
+// ================================================================
+// Function : IsSubPath
+// ================================================================
+bool OcctAssemblyTree::IsSubPath(const TCollection_AsciiString& theId,
+                                 const TCollection_AsciiString& theParentId)
+{
+  // path components are terminated by '.', so that plain prefix comparison doesn't match sibling entries
+  return !theParentId.IsEmpty()
+       && theId.Length() >= theParentId.Length()
+       && std::strncmp(theId.ToCString(), theParentId.ToCString(), theParentId.Length()) == 0;
+}
+
+// ================================================================
+// Function : Clear
+// ================================================================
+void OcctAssemblyTree::Clear()
+{
+  myNodes.clear();
+  myRoots.clear();
+  myNodeIds.Clear();
+  myObjects.clear();
+  ++myVisRevision;
+}
+
+// ================================================================
+// Function : Init
+// ================================================================
+void OcctAssemblyTree::Init(const Handle(TDocStd_Document)& theDoc)
+{
+  Clear();
+#ifdef HAVE_DATAEXCHANGE
+  if (theDoc.IsNull())
+    return;
+
+  TDF_LabelSequence aLabels;
+  XCAFDoc_DocumentTool::ShapeTool(theDoc->Main())->GetFreeShapes(aLabels);
+  for (TDF_LabelSequence::Iterator aLabIter(aLabels); aLabIter.More(); aLabIter.Next())
+  {
+    const int aRoot = addNode(aLabIter.Value(), -1);
+    myNodes[aRoot].Index = (int )myRoots.size();
+    myRoots.push_back(aRoot);
+  }
+#else
+  (void )theDoc;
+#endif
+}
+
+// ================================================================
+// Function : addNode
+// ================================================================
+int OcctAssemblyTree::addNode(const TDF_Label& theLabel,
+                              int theParent)
+{
+  Node aNode;
+  aNode.Label = theLabel;
+  aNode.RefLabel = theLabel;
+  aNode.Parent = theParent;
+  if (theParent != -1)
+  {
+    aNode.Depth = myNodes[theParent].Depth + 1;
+    aNode.IsHidden = myNodes[theParent].IsHidden;
+  }
+#ifdef HAVE_DATAEXCHANGE
+  XCAFDoc_ShapeTool::GetReferredShape(theLabel, aNode.RefLabel);
+  aNode.Id = XCAFPrs_DocumentExplorer::DefineChildId(theLabel, theParent != -1 ? myNodes[theParent].Id : TCollection_AsciiString());
+  aNode.IsAssembly = XCAFDoc_ShapeTool::IsAssembly(aNode.RefLabel);
+
+  // instance name, or name of referred product
+  Handle(TDataStd_Name) aName;
+  if (theLabel.FindAttribute(TDataStd_Name::GetID(), aName)
+   || aNode.RefLabel.FindAttribute(TDataStd_Name::GetID(), aName))
+  {
+    aNode.Name = TCollection_AsciiString(aName->Get());
+  }
+  if (aNode.Name.IsEmpty())
+    TDF_Tool::Entry(theLabel, aNode.Name);
+#endif
+
+  myNodes.push_back(aNode);
+  myNodeIds.Bind(aNode.Id, (int )myNodes.size() - 1);
+  return (int )myNodes.size() - 1;
+}
+
+// ================================================================
+// Function : Children
+// ================================================================
+const std::vector<int>& OcctAssemblyTree::Children(int theNode)
+{
+  if (myNodes[theNode].IsExpanded)
+    return myNodes[theNode].Children;
+
+  myNodes[theNode].IsExpanded = true;
+#ifdef HAVE_DATAEXCHANGE
+  if (myNodes[theNode].IsAssembly)
+  {
+    TDF_LabelSequence aComps;
+    XCAFDoc_ShapeTool::GetComponents(myNodes[theNode].RefLabel, aComps, false);
+    std::vector<int> aChildren;
+    aChildren.reserve(aComps.Length());
+    for (TDF_LabelSequence::Iterator aCompIter(aComps); aCompIter.More(); aCompIter.Next())
+    {
+      // addNode() may reallocate nodes, so that children are assigned afterwards
+      const int aChild = addNode(aCompIter.Value(), theNode);
+      myNodes[aChild].Index = (int )aChildren.size();
+      aChildren.push_back(aChild);
+    }
+    myNodes[theNode].Children.swap(aChildren);
+  }
+#endif
+  return myNodes[theNode].Children;
+}
+
+// ================================================================
+// Function : FindNode
+// ================================================================
+int OcctAssemblyTree::FindNode(const TCollection_AsciiString& theId)
+{
+  // descend from the deepest created node, creating children of assemblies along the path
+  int aNode = findCreatedNode(theId);
+  while (aNode != -1
+      && myNodes[aNode].Id.Length() != theId.Length())
+  {
+    Children(aNode);
+    int aNextLen = myNodes[aNode].Id.Length() + 1;
+    while (aNextLen < theId.Length()
+        && theId.Value(aNextLen) != '.')
+    {
+      ++aNextLen;
+    }
+    const int* aChild = myNodeIds.Seek(theId.SubString(1, aNextLen));
+    aNode = aChild != NULL ? *aChild : -1;
+  }
+  return aNode;
+}
+
+// ================================================================
+// Function : findCreatedNode
+// ================================================================
+int OcctAssemblyTree::findCreatedNode(const TCollection_AsciiString& theId) const
+{
+  // path components are terminated by '.', so that ancestors are looked up by prefixes ending with '.'
+  for (int aLen = theId.Length(); aLen > 0; --aLen)
+  {
+    if (theId.Value(aLen) != '.')
+      continue;
+
+    if (const int* aNode = myNodeIds.Seek(theId.SubString(1, aLen)))
+      return *aNode;
+  }
+  return -1;
+}
+
+// ================================================================
+// Function : IsHidden
+// ================================================================
+bool OcctAssemblyTree::IsHidden(const TCollection_AsciiString& theId) const
+{
+  // not created nodes inherit hidden state of their nearest created ancestor
+  const int aNode = findCreatedNode(theId);
+  return aNode != -1 && myNodes[aNode].IsHidden;
+}
+
+// ================================================================
+// Function : BindObjects
+// ================================================================
+void OcctAssemblyTree::BindObjects(const Handle(AIS_InteractiveContext)& theCtx)
+{
+  myObjects.clear();
+  AIS_ListOfInteractive anObjects;
+  theCtx->ObjectsInside(anObjects);
+  for (AIS_ListOfInteractive::Iterator anObjIter(anObjects); anObjIter.More(); anObjIter.Next())
+  {
+    AddObject(anObjIter.Value());
+  }
+}
+
+// ================================================================
+// Function : AddObject
+// ================================================================
+void OcctAssemblyTree::AddObject(const Handle(AIS_InteractiveObject)& theObj)
+{
+  const TCollection_AsciiString anId = ObjectId(theObj);
+  if (anId.IsEmpty())
+    return;
+
+  std::vector<Handle(AIS_InteractiveObject)>& anObjects = myObjects[anId.ToCString()];
+  if (std::find(anObjects.begin(), anObjects.end(), theObj) == anObjects.end())
+    anObjects.push_back(theObj);
+}
+
+// ================================================================
+// Function : RemoveObject
+// ================================================================
+void OcctAssemblyTree::RemoveObject(const Handle(AIS_InteractiveObject)& theObj)
+{
+  const TCollection_AsciiString anId = ObjectId(theObj);
+  std::map<std::string, std::vector<Handle(AIS_InteractiveObject)>>::iterator aFound = myObjects.find(anId.ToCString());
+  if (aFound == myObjects.end())
+    return;
+
+  std::vector<Handle(AIS_InteractiveObject)>& anObjects = aFound->second;
+  anObjects.erase(std::remove(anObjects.begin(), anObjects.end(), theObj), anObjects.end());
+  if (anObjects.empty())
+    myObjects.erase(aFound);
+}
+
+// ================================================================
+// Function : NodePath
+// ================================================================
+std::vector<int> OcctAssemblyTree::NodePath(int theNode) const
+{
+  std::vector<int> aPath;
+  for (int aNode = theNode; aNode != -1; aNode = myNodes[aNode].Parent)
+  {
+    aPath.push_back(aNode);
+  }
+  std::reverse(aPath.begin(), aPath.end());
+  return aPath;
+}
+
+// ================================================================
+// Function : nodeObjects
+// ================================================================
+void OcctAssemblyTree::nodeObjects(const TCollection_AsciiString& theId,
+                                   bool theToUseAncestor,
+                                   NCollection_Sequence<Handle(AIS_InteractiveObject)>& theNodeObjects) const
+{
+  // objects of the node and its descendants form a range of paths starting with node path
+  const std::string aPrefix(theId.ToCString());
+  const int aNbBefore = theNodeObjects.Length();
+  for (std::map<std::string, std::vector<Handle(AIS_InteractiveObject)>>::const_iterator anObjIter = myObjects.lower_bound(aPrefix);
+       anObjIter != myObjects.end() && anObjIter->first.compare(0, aPrefix.size(), aPrefix) == 0; ++anObjIter)
+  {
+    for (const Handle(AIS_InteractiveObject)& anObj : anObjIter->second)
+      theNodeObjects.Append(anObj);
+  }
+  if (!theToUseAncestor
+   || theNodeObjects.Length() != aNbBefore)
+  {
+    return;
+  }
+
+  // object of the nearest ancestor
+  for (size_t aLen = aPrefix.size() > 0 ? aPrefix.size() - 1 : 0; aLen > 0; --aLen)
+  {
+    if (aPrefix[aLen - 1] != '.')
+      continue;
+
+    std::map<std::string, std::vector<Handle(AIS_InteractiveObject)>>::const_iterator aFound = myObjects.find(aPrefix.substr(0, aLen));
+    if (aFound != myObjects.end())
+    {
+      theNodeObjects.Append(aFound->second.front());
+      return;
+    }
+  }
+}
+
+// ================================================================
+// Function : SelectNodes
+// ================================================================
+int OcctAssemblyTree::SelectNodes(const Handle(AIS_InteractiveContext)& theCtx,
+                                  const std::vector<int>& theNodes)
+{
+  NCollection_Sequence<Handle(AIS_InteractiveObject)> aSelObjects;
+  for (int aNode : theNodes)
+  {
+    nodeObjects(myNodes[aNode].Id, true, aSelObjects);
+  }
+
+  theCtx->ClearSelected(false);
+  int aNbSelected = 0;
+  for (NCollection_Sequence<Handle(AIS_InteractiveObject)>::Iterator anObjIter(aSelObjects); anObjIter.More(); anObjIter.Next())
+  {
+    const Handle(AIS_InteractiveObject)& anObj = anObjIter.Value();
+    if (theCtx->IsDisplayed(anObj)
+    && !theCtx->IsSelected(anObj))
+    {
+      theCtx->AddOrRemoveSelected(anObj, false);
+      ++aNbSelected;
+    }
+  }
+  return aNbSelected;
+}
+
+// ================================================================
+// Function : SelectedNodes
+// ================================================================
+std::vector<int> OcctAssemblyTree::SelectedNodes(const Handle(AIS_InteractiveContext)& theCtx)
+{
+  std::vector<int> aNodes;
+  for (theCtx->InitSelected(); theCtx->MoreSelected(); theCtx->NextSelected())
+  {
+    const TCollection_AsciiString anId = ObjectId(theCtx->SelectedInteractive());
+    if (anId.IsEmpty())
+      continue;
+
+    const int aNode = FindNode(anId);
+    if (aNode != -1
+     && std::find(aNodes.begin(), aNodes.end(), aNode) == aNodes.end())
+    {
+      aNodes.push_back(aNode);
+    }
+  }
+  return aNodes;
+}
+
+// ================================================================
+// Function : setHidden
+// ================================================================
+void OcctAssemblyTree::setHidden(int theNode, bool theIsHidden)
+{
+  myNodes[theNode].IsHidden = theIsHidden;
+  for (int aChild : myNodes[theNode].Children)
+  {
+    setHidden(aChild, theIsHidden);
+  }
+}
+
+// ================================================================
+// Function : updateParentsHidden
+// ================================================================
+void OcctAssemblyTree::updateParentsHidden(int theNode)
+{
+  // parent is hidden only when all its children are hidden
+  for (int aParent = myNodes[theNode].Parent; aParent != -1; aParent = myNodes[aParent].Parent)
+  {
+    bool isHidden = true;
+    for (int aChild : myNodes[aParent].Children)
+    {
+      if (!myNodes[aChild].IsHidden)
+      {
+        isHidden = false;
+        break;
+      }
+    }
+    if (myNodes[aParent].IsHidden == isHidden)
+      break;
+
+    myNodes[aParent].IsHidden = isHidden;
+  }
+}
+
+// ================================================================
+// Function : SetNodeVisible
+// ================================================================
+int OcctAssemblyTree::SetNodeVisible(const Handle(AIS_InteractiveContext)& theCtx,
+                                     int theNode,
+                                     bool theToShow)
+{
+  setHidden(theNode, !theToShow);
+  updateParentsHidden(theNode);
+  ++myVisRevision;
+
+  NCollection_Sequence<Handle(AIS_InteractiveObject)> aNodeObjects;
+  nodeObjects(myNodes[theNode].Id, false, aNodeObjects);
+
+  int aNbChanged = 0;
+  for (NCollection_Sequence<Handle(AIS_InteractiveObject)>::Iterator anObjIter(aNodeObjects); anObjIter.More(); anObjIter.Next())
+  {
+    const Handle(AIS_InteractiveObject)& anObj = anObjIter.Value();
+    if (theCtx->IsDisplayed(anObj) == theToShow
+     || theCtx->DisplayStatus(anObj) == PrsMgr_DisplayStatus_None)
+    {
+      continue;
+    }
+
+    if (theToShow)
+      theCtx->Display(anObj, false);
+    else
+      theCtx->Erase(anObj, false);
+    ++aNbChanged;
+  }
+  return aNbChanged;
+}
+
+// ================================================================
+// Function : SyncVisibility
+// ================================================================
+void OcctAssemblyTree::SyncVisibility(const Handle(AIS_InteractiveContext)& theCtx)
+{
+  ++myVisRevision;
+
+  // children are always created after their parent, so that reverse order visits children first
+  for (int aNodeIter = (int )myNodes.size() - 1; aNodeIter >= 0; --aNodeIter)
+  {
+    Node& aNode = myNodes[aNodeIter];
+    NCollection_Sequence<Handle(AIS_InteractiveObject)> aNodeObjects;
+    nodeObjects(aNode.Id, false, aNodeObjects);
+    if (aNodeObjects.IsEmpty())
+    {
+      // node without objects (e.g. parts not yet loaded) derives its state from created children
+      if (aNode.Children.empty())
+        continue;
+
+      bool isHidden = true;
+      for (int aChild : aNode.Children)
+      {
+        if (!myNodes[aChild].IsHidden)
+        {
+          isHidden = false;
+          break;
+        }
+      }
+      aNode.IsHidden = isHidden;
+      continue;
+    }
+
+    bool isHidden = true;
+    for (NCollection_Sequence<Handle(AIS_InteractiveObject)>::Iterator anObjIter(aNodeObjects); anObjIter.More(); anObjIter.Next())
+    {
+      if (theCtx->IsDisplayed(anObjIter.Value()))
+      {
+        isHidden = false;
+        break;
+      }
+    }
+    aNode.IsHidden = isHidden;
+  }
+}
@@ -0,0 +1,161 @@
+// Copyright (c) 2026 Kirill Gavrilov
+
+#ifndef _OcctAssemblyTree_HeaderFile
+#define _OcctAssemblyTree_HeaderFile
+
+#include <AIS_InteractiveContext.hxx>
+#include <NCollection_DataMap.hxx>
+#include <NCollection_Sequence.hxx>
+#include <TCollection_AsciiString.hxx>
+#include <TDF_Label.hxx>
+#include <TDocStd_Document.hxx>
+
+#include <map>
+#include <string>
+#include <vector>
+
+//! Lazily expanded tree of XCAF product structure, synchronized with displayed objects.
+//!
+//! Nodes are created only for free shapes and for components of expanded assemblies,
+//! so that memory and time depend on the part of the tree explored by the user, not on assembly size.
+//! Every node is identified by occurrence path defined by XCAFPrs_DocumentExplorer::DefineChildId(),
+//! and displayed objects are bound to nodes by SetObjectId() storing the path as object owner.
+//! Objects bound to a node or to any of its descendants belong to the node;
+//! a node without own objects (a part of object displaying the whole free shape) refers to the object of its nearest ancestor.
+//! Objects are kept in a map ordered by occurrence path, filled by BindObjects() from the context
+//! and updated by AddObject() and RemoveObject() for objects displayed or removed later (e.g. by OcctOnDemandAssembly),
+//! so that selection and visibility changes don't walk all objects of the context.
+//!
+//! The tree is independent from GUI toolkit; widgets keep node indices within their rows.
+//! Available only when samples are built with HAVE_DATAEXCHANGE (USE_DATAEXCHANGE CMake option).
+class OcctAssemblyTree
+{
+public:
+
+  //! Bind object to occurrence path.
+  static void SetObjectId(const Handle(AIS_InteractiveObject)& theObj,
+                          const TCollection_AsciiString& theId);
+
+  //! Return occurrence path bound to object or empty string.
+  static TCollection_AsciiString ObjectId(const Handle(AIS_InteractiveObject)& theObj);
+
+  //! Return TRUE if occurrence path is equal to theParentId or lies within it.
+  static bool IsSubPath(const TCollection_AsciiString& theId,
+                        const TCollection_AsciiString& theParentId);
+
+public:
+
+  //! Tree node.
+  struct Node
+  {
+    TDF_Label               Label;        //!< occurrence label (component or free shape)
+    TDF_Label               RefLabel;     //!< referred shape label
+    TCollection_AsciiString Id;           //!< occurrence path
+    TCollection_AsciiString Name;
+    int                     Parent = -1;
+    int                     Index  = 0;   //!< index within children of the parent (or within roots)
+    int                     Depth  = 0;
+    bool                    IsAssembly = false;
+    bool                    IsExpanded = false; //!< children have been collected
+    bool                    IsHidden   = false;
+    std::vector<int>        Children;
+  };
+
+public:
+
+  //! Empty constructor.
+  OcctAssemblyTree() {}
+
+  //! Initialize tree with free shapes of the document.
+  void Init(const Handle(TDocStd_Document)& theDoc);
+
+  //! Clear the tree and bound objects.
+  void Clear();
+
+  //! Return root nodes.
+  const std::vector<int>& Roots() const { return myRoots; }
+
+  //! Return node.
+  const Node& GetNode(int theNode) const { return myNodes[theNode]; }
+
+  //! Return number of created nodes.
+  int NbNodes() const { return (int )myNodes.size(); }
+
+  //! Return children of the node, collecting them on first request.
+  const std::vector<int>& Children(int theNode);
+
+  //! Find node by occurrence path, expanding its ancestors.
+  //! @return node index or -1 if not found
+  int FindNode(const TCollection_AsciiString& theId);
+
+  //! Return hidden state of the node of occurrence path (or of its nearest created ancestor) without expanding the tree.
+  bool IsHidden(const TCollection_AsciiString& theId) const;
+
+  //! Return revision number incremented on every change of hidden state of nodes.
+  int VisibilityRevision() const { return myVisRevision; }
+
+  //! Bind objects of the context (displayed and erased) to nodes by their occurrence paths, replacing bound objects.
+  //! This walks all objects of the context, so that it is intended to be called after loading the document.
+  void BindObjects(const Handle(AIS_InteractiveContext)& theCtx);
+
+  //! Bind object displayed after BindObjects(); objects without occurrence path are ignored.
+  void AddObject(const Handle(AIS_InteractiveObject)& theObj);
+
+  //! Unbind object removed from context.
+  void RemoveObject(const Handle(AIS_InteractiveObject)& theObj);
+
+  //! Return path of nodes from the root to the node inclusive.
+  std::vector<int> NodePath(int theNode) const;
+
+  //! Select objects of specified nodes within context (replacing current selection) without redrawing the viewer.
+  //! @return number of selected objects
+  int SelectNodes(const Handle(AIS_InteractiveContext)& theCtx,
+                  const std::vector<int>& theNodes);
+
+  //! Find nodes of objects selected within context, expanding their ancestors.
+  std::vector<int> SelectedNodes(const Handle(AIS_InteractiveContext)& theCtx);
+
+  //! Show or hide objects of the node without redrawing the viewer.
+  //! Hidden state is propagated to created descendants, while ancestors become hidden only when all their children are hidden.
+  //! @return number of displayed or erased objects
+  int SetNodeVisible(const Handle(AIS_InteractiveContext)& theCtx,
+                     int theNode,
+                     bool theToShow);
+
+  //! Update hidden state of created nodes from display status of their objects,
+  //! e.g. after objects have been displayed or erased not through the tree;
+  //! nodes without objects derive their state from created children.
+  void SyncVisibility(const Handle(AIS_InteractiveContext)& theCtx);
+
+protected:
+
+  //! Create node.
+  int addNode(const TDF_Label& theLabel,
+              int theParent);
+
+  //! Return the deepest created node which path is equal to theId or lies within it, or -1.
+  int findCreatedNode(const TCollection_AsciiString& theId) const;
+
+  //! Collect bound objects belonging to the node.
+  //! @param[in] theToUseAncestor  return object of the nearest ancestor if node has no own objects
+  void nodeObjects(const TCollection_AsciiString& theId,
+                   bool theToUseAncestor,
+                   NCollection_Sequence<Handle(AIS_InteractiveObject)>& theNodeObjects) const;
+
+  //! Set hidden state of node and its created descendants.
+  void setHidden(int theNode, bool theIsHidden);
+
+  //! Update hidden state of ancestors from their children.
+  void updateParentsHidden(int theNode);
+
+protected:
+
+  std::vector<Node> myNodes;
+  std::vector<int>  myRoots;
+  NCollection_DataMap<TCollection_AsciiString, int> myNodeIds; //!< created nodes by occurrence path
+  std::map<std::string, std::vector<Handle(AIS_InteractiveObject)>> myObjects; //!< bound objects ordered by occurrence path
+  int               myVisRevision = 0;
+
+};
+
+#endif // _OcctAssemblyTree_HeaderFile
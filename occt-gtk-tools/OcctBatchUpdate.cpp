@@ -0,0 +1,341 @@
+// Copyright (c) 2026 Kirill Gavrilov
+
+#include "OcctBatchUpdate.h"
+
+#include "OcctSceneBoundsIndex.h"
+
+#include <AIS_Shape.hxx>
+#include <BRepPrimAPI_MakeBox.hxx>
+#include <Message.hxx>
+#include <OSD_Timer.hxx>
+
+#include <algorithm>
+#include <cmath>
+
+// ================================================================
+// Function : changeOf
+// ================================================================
+OcctBatchUpdate::Change& OcctBatchUpdate::changeOf(const Handle(AIS_InteractiveObject)& theObj)
+{
+  if (Change* aChange = myChanges.ChangeSeek(theObj))
+    return *aChange;
+
+  const int anIndex = myChanges.Add(theObj, Change());
+  return myChanges.ChangeFromIndex(anIndex);
+}
+
+// ================================================================
+// Function : Display
+// ================================================================
+void OcctBatchUpdate::Display(const Handle(AIS_InteractiveObject)& theObj,
+                              int theDispMode,
+                              int theSelMode)
+{
+  Change& aChange = changeOf(theObj);
+  aChange.Flags = (aChange.Flags & ~Change_Erase) | Change_Display;
+  aChange.DispMode = theDispMode;
+  aChange.SelMode  = theSelMode;
+}
+
+// ================================================================
+// Function : Erase
+// ================================================================
+void OcctBatchUpdate::Erase(const Handle(AIS_InteractiveObject)& theObj)
+{
+  Change& aChange = changeOf(theObj);
+  aChange.Flags = (aChange.Flags & ~Change_Display) | Change_Erase;
+}
+
+// ================================================================
+// Function : SetColor
+// ================================================================
+void OcctBatchUpdate::SetColor(const Handle(AIS_InteractiveObject)& theObj,
+                               const Quantity_Color& theColor)
+{
+  Change& aChange = changeOf(theObj);
+  aChange.Flags |= Change_Color;
+  aChange.Color = theColor;
+}
+
+// ================================================================
+// Function : SetTransparency
+// ================================================================
+void OcctBatchUpdate::SetTransparency(const Handle(AIS_InteractiveObject)& theObj,
+                                      double theTransparency)
+{
+  Change& aChange = changeOf(theObj);
+  aChange.Flags |= Change_Transparency;
+  aChange.Transparency = theTransparency;
+}
+
+// ================================================================
+// Function : SetLocation
+// ================================================================
+void OcctBatchUpdate::SetLocation(const Handle(AIS_InteractiveObject)& theObj,
+                                  const gp_Trsf& theTrsf)
+{
+  Change& aChange = changeOf(theObj);
+  aChange.Flags |= Change_Location;
+  aChange.Location = theTrsf;
+}
+
+// ================================================================
+// Function : Apply
+// ================================================================
+int OcctBatchUpdate::Apply(const Handle(AIS_InteractiveContext)& theCtx)
+{
+  const int aNbObjects = myChanges.Extent();
+
+  // erase first - erased objects don't need their presentations to be updated
+  for (NCollection_IndexedDataMap<Handle(AIS_InteractiveObject), Change>::Iterator aChangeIter(myChanges); aChangeIter.More(); aChangeIter.Next())
+  {
+    const Handle(AIS_InteractiveObject)& anObj = aChangeIter.Key();
+    if ((aChangeIter.Value().Flags & Change_Erase) != 0
+     && theCtx->IsDisplayed(anObj))
+    {
+      theCtx->Erase(anObj, false);
+    }
+  }
+
+  // attributes and locations are assigned to objects directly; presentations of objects unknown to context
+  // are computed once with final attributes on displaying, and presentations of known objects are updated once
+  std::vector<Handle(AIS_InteractiveObject)> aMoved;
+  for (NCollection_IndexedDataMap<Handle(AIS_InteractiveObject), Change>::Iterator aChangeIter(myChanges); aChangeIter.More(); aChangeIter.Next())
+  {
+    const Handle(AIS_InteractiveObject)& anObj = aChangeIter.Key();
+    const Change& aChange = aChangeIter.Value();
+    const bool isKnown = theCtx->DisplayStatus(anObj) != AIS_DS_None;
+    if ((aChange.Flags & Change_Color) != 0)
+    {
+      anObj->SetColor(aChange.Color);
+    }
+    if ((aChange.Flags & Change_Transparency) != 0)
+    {
+      if (aChange.Transparency <= 0.005)
+        anObj->UnsetTransparency();
+      else
+        anObj->SetTransparency(aChange.Transparency);
+    }
+    if (isKnown
+     && (aChange.Flags & (Change_Color | Change_Transparency)) != 0)
+    {
+      anObj->UpdatePresentations();
+    }
+    if ((aChange.Flags & Change_Location) != 0)
+    {
+      // transformation of presentations is changed without recomputation, sensitive entities are updated below
+      anObj->SetLocalTransformation(aChange.Location);
+      if (isKnown)
+        aMoved.push_back(anObj);
+    }
+  }
+
+  // deferred selection update of moved objects: locations of sensitive entities are updated in one pass,
+  // and selection BVH is rebuilt lazily on the next picking
+  if (!aMoved.empty())
+  {
+    for (const Handle(AIS_InteractiveObject)& anObj : aMoved)
+    {
+      theCtx->SelectionManager()->Update(anObj, false);
+    }
+    // dynamic highlighting of moved object would stay at previous location
+    theCtx->ClearDetected(false);
+  }
+
+  // display without selection activation
+  for (NCollection_IndexedDataMap<Handle(AIS_InteractiveObject), Change>::Iterator aChangeIter(myChanges); aChangeIter.More(); aChangeIter.Next())
+  {
+    const Handle(AIS_InteractiveObject)& anObj = aChangeIter.Key();
+    const Change& aChange = aChangeIter.Value();
+    if ((aChange.Flags & Change_Display) == 0)
+      continue;
+
+    if (theCtx->IsDisplayed(anObj))
+    {
+      // only display mode might be changed for displayed object
+      if (aChange.DispMode >= 0
+       && (!anObj->HasDisplayMode() || anObj->DisplayMode() != aChange.DispMode)
+       && anObj->AcceptDisplayMode(aChange.DispMode))
+      {
+        theCtx->SetDisplayMode(anObj, aChange.DispMode, false);
+      }
+      continue;
+    }
+
+    int aDispMode = aChange.DispMode;
+    if (aDispMode < 0)
+    {
+      aDispMode = anObj->HasDisplayMode() ? anObj->DisplayMode() : theCtx->DisplayMode();
+      if (!anObj->AcceptDisplayMode(aDispMode))
+        aDispMode = 0;
+    }
+    theCtx->Display(anObj, aDispMode, -1, false);
+    if (aChange.SelMode != -1)
+      myPendingSel.push_back(std::make_pair(anObj, aChange.SelMode));
+  }
+
+  // update bounds of changed objects only instead of synchronizing the whole index
+  if (myBoundsIndex != NULL
+   && myBoundsIndex->IsEnabled())
+  {
+    for (NCollection_IndexedDataMap<Handle(AIS_InteractiveObject), Change>::Iterator aChangeIter(myChanges); aChangeIter.More(); aChangeIter.Next())
+    {
+      const Handle(AIS_InteractiveObject)& anObj = aChangeIter.Key();
+      if ((aChangeIter.Value().Flags & Change_Erase) != 0)
+        myBoundsIndex->Remove(anObj);
+      else if ((aChangeIter.Value().Flags & (Change_Display | Change_Location)) != 0
+             && theCtx->IsDisplayed(anObj))
+        myBoundsIndex->Update(anObj);
+    }
+  }
+
+  myChanges.Clear();
+  return aNbObjects;
+}
+
+// ================================================================
+// Function : ActivatePendingSelection
+// ================================================================
+bool OcctBatchUpdate::ActivatePendingSelection(const Handle(AIS_InteractiveContext)& theCtx,
+                                               double theTimeBudget)
+{
+  OSD_Timer aTimer;
+  aTimer.Start();
+  for (; myNbActivated < myPendingSel.size(); )
+  {
+    const std::pair<Handle(AIS_InteractiveObject), int>& aPending = myPendingSel[myNbActivated++];
+    if (theCtx->IsDisplayed(aPending.first))
+      theCtx->Activate(aPending.first, aPending.second);
+
+    if (theTimeBudget >= 0.0
+     && aTimer.ElapsedTime() > theTimeBudget)
+    {
+      break;
+    }
+  }
+
+  if (myNbActivated >= myPendingSel.size())
+  {
+    myPendingSel.clear();
+    myNbActivated = 0;
+    return false;
+  }
+  return true;
+}
+
+// ================================================================
+// Function : Benchmark
+// ================================================================
+void OcctBatchUpdate::Benchmark(const Handle(AIS_InteractiveContext)& theCtx,
+                                const Handle(V3d_View)& theView,
+                                int theNbObjects)
+{
+  if (theView->Window().IsNull())
+    return;
+
+  const int aNbObjects = theNbObjects > 0 ? theNbObjects : 50000;
+
+  // 3D grid of selectable boxes
+  const int aGridSize = std::max((int )std::ceil(std::cbrt(double(aNbObjects))), 1);
+  const TopoDS_Shape aBox = BRepPrimAPI_MakeBox(1.0, 1.0, 1.0).Shape();
+  std::vector<Handle(AIS_Shape)> anObjects(aNbObjects);
+  for (int anObjIter = 0; anObjIter < aNbObjects; ++anObjIter)
+  {
+    gp_Trsf aTrsf;
+    aTrsf.SetTranslation(gp_Vec(3.0 * (anObjIter % aGridSize),
+                                3.0 * ((anObjIter / aGridSize) % aGridSize),
+                                3.0 * (anObjIter / (aGridSize * aGridSize))));
+    anObjects[anObjIter] = new AIS_Shape(aBox);
+    anObjects[anObjIter]->SetLocalTransformation(aTrsf);
+    theCtx->Display(anObjects[anObjIter], AIS_Shaded, 0, false);
+  }
+  Handle(Graphic3d_Camera) aCamBack = new Graphic3d_Camera(theView->Camera());
+  theView->FitAll(0.01, false);
+  theView->Redraw();
+  Message::SendInfo() << "OcctBatchUpdate benchmark, " << aNbObjects << " objects (time includes a single redraw)";
+
+  static const char* THE_CONFIGS[] = { "Individual context calls", "Batch" };
+  for (int aConfIter = 0; aConfIter < 2; ++aConfIter)
+  {
+    const bool isBatch = aConfIter == 1;
+    OcctBatchUpdate aBatch;
+    OSD_Timer aTimerHide, aTimerShow, aTimerColor, aTimerMove, aTimerSel;
+
+    aTimerHide.Start();
+    for (const Handle(AIS_Shape)& anObj : anObjects)
+    {
+      if (isBatch)
+        aBatch.Erase(anObj);
+      else
+        theCtx->Erase(anObj, false);
+    }
+    aBatch.Apply(theCtx);
+    theView->Redraw();
+    aTimerHide.Stop();
+
+    aTimerShow.Start();
+    for (const Handle(AIS_Shape)& anObj : anObjects)
+    {
+      if (isBatch)
+        aBatch.Display(anObj, AIS_Shaded, 0);
+      else
+        theCtx->Display(anObj, AIS_Shaded, 0, false);
+    }
+    aBatch.Apply(theCtx);
+    theView->Redraw();
+    aTimerShow.Stop();
+
+    aTimerSel.Start();
+    aBatch.ActivatePendingSelection(theCtx);
+    aTimerSel.Stop();
+
+    aTimerColor.Start();
+    const Quantity_Color aColor = isBatch ? Quantity_NOC_GREEN : Quantity_NOC_RED;
+    for (const Handle(AIS_Shape)& anObj : anObjects)
+    {
+      if (isBatch)
+      {
+        aBatch.SetColor(anObj, aColor);
+        aBatch.SetTransparency(anObj, 0.5);
+      }
+      else
+      {
+        theCtx->SetColor(anObj, aColor, false);
+        theCtx->SetTransparency(anObj, 0.5, false);
+      }
+    }
+    aBatch.Apply(theCtx);
+    theView->Redraw();
+    aTimerColor.Stop();
+
+    aTimerMove.Start();
+    gp_Trsf aStep;
+    aStep.SetTranslation(gp_Vec(0.0, 0.0, isBatch ? -1.0 : 1.0));
+    for (const Handle(AIS_Shape)& anObj : anObjects)
+    {
+      const gp_Trsf aTrsf = aStep * anObj->LocalTransformation();
+      if (isBatch)
+        aBatch.SetLocation(anObj, aTrsf);
+      else
+        theCtx->SetLocation(anObj, TopLoc_Location(aTrsf));
+    }
+    aBatch.Apply(theCtx);
+    theView->Redraw();
+    aTimerMove.Stop();
+
+    Message_Messenger::StreamBuffer aMsg = Message::SendInfo();
+    aMsg << "  " << THE_CONFIGS[aConfIter] << " (ms): hide " << (aTimerHide.ElapsedTime() * 1000.0)
+         << ", show " << (aTimerShow.ElapsedTime() * 1000.0);
+    if (isBatch)
+      aMsg << " + deferred selection " << (aTimerSel.ElapsedTime() * 1000.0);
+    aMsg << ", colour and transparency " << (aTimerColor.ElapsedTime() * 1000.0)
+         << ", move " << (aTimerMove.ElapsedTime() * 1000.0);
+  }
+
+  theView->Camera()->Copy(aCamBack);
+  for (const Handle(AIS_Shape)& anObj : anObjects)
+  {
+    theCtx->Remove(anObj, false);
+  }
+  theView->Invalidate();
+}
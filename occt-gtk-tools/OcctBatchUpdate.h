@@ -0,0 +1,127 @@
+// Copyright (c) 2026 Kirill Gavrilov
+
+#ifndef _OcctBatchUpdate_HeaderFile
+#define _OcctBatchUpdate_HeaderFile
+
+#include <AIS_InteractiveContext.hxx>
+#include <NCollection_IndexedDataMap.hxx>
+#include <V3d_View.hxx>
+
+#include <utility>
+#include <vector>
+
+class OcctSceneBoundsIndex;
+
+//! Batch of display, erase, colour, transparency and location changes of interactive objects.
+//!
+//! Changes are collected per object (later changes of the same object override earlier ones)
+//! and applied by Apply() in one pass ordered to avoid redundant work:
+//! erasing first, then attributes and locations (so that presentations of objects to be displayed
+//! are computed once with final attributes), then displaying.
+//! Attributes and locations are assigned to objects directly instead of per-object AIS_InteractiveContext calls:
+//! presentations of an object are updated once for all its attribute changes,
+//! and locations of sensitive entities of moved objects are updated in a single pass afterwards.
+//! Objects are displayed without activating selection; selection is activated later by ActivatePendingSelection()
+//! in time-limited slices, so that computation of sensitive entities doesn't delay the first frame.
+//! Viewer and selection BVH trees are rebuilt lazily on the next redraw and picking,
+//! so that the caller should request a single redraw after Apply().
+class OcctBatchUpdate
+{
+public:
+
+  //! Benchmark on theNbObjects boxes (50000 by default): compares hiding, showing, recolouring and moving all objects
+  //! by individual AIS_InteractiveContext calls with the same changes applied by a batch.
+  static void Benchmark(const Handle(AIS_InteractiveContext)& theCtx,
+                        const Handle(V3d_View)& theView,
+                        int theNbObjects);
+
+public:
+
+  //! Empty constructor.
+  OcctBatchUpdate() {}
+
+  //! Return TRUE if there are no collected changes.
+  bool IsEmpty() const { return myChanges.IsEmpty(); }
+
+  //! Return number of objects with collected changes.
+  int NbObjects() const { return myChanges.Extent(); }
+
+  //! Display object (cancels erasing); display mode of already displayed object is changed to theDispMode.
+  //! @param[in] theObj      object to display
+  //! @param[in] theDispMode display mode, -1 for default (or current) mode of the object
+  //! @param[in] theSelMode  selection mode to activate later, -1 for not selectable object
+  void Display(const Handle(AIS_InteractiveObject)& theObj,
+               int theDispMode = -1,
+               int theSelMode  = 0);
+
+  //! Erase object (cancels displaying).
+  void Erase(const Handle(AIS_InteractiveObject)& theObj);
+
+  //! Set object colour.
+  void SetColor(const Handle(AIS_InteractiveObject)& theObj,
+                const Quantity_Color& theColor);
+
+  //! Set object transparency within [0, 1] range.
+  void SetTransparency(const Handle(AIS_InteractiveObject)& theObj,
+                       double theTransparency);
+
+  //! Set object location.
+  void SetLocation(const Handle(AIS_InteractiveObject)& theObj,
+                   const gp_Trsf& theTrsf);
+
+  //! Set bounds index to be updated for erased, moved and displayed objects by Apply() (NULL by default).
+  void SetBoundsIndex(OcctSceneBoundsIndex* theIndex) { myBoundsIndex = theIndex; }
+
+  //! Discard collected changes.
+  void Clear() { myChanges.Clear(); }
+
+  //! Apply collected changes to context without redrawing the viewer and clear the batch.
+  //! @return number of changed objects
+  int Apply(const Handle(AIS_InteractiveContext)& theCtx);
+
+  //! Return TRUE if some displayed objects wait for selection activation.
+  bool HasPendingSelection() const { return myPendingSel.size() > myNbActivated; }
+
+  //! Activate selection of objects displayed by Apply().
+  //! @param[in] theCtx         interactive context
+  //! @param[in] theTimeBudget  time limit in seconds, or negative value to activate all objects
+  //! @return TRUE if some objects still wait for activation
+  bool ActivatePendingSelection(const Handle(AIS_InteractiveContext)& theCtx,
+                                double theTimeBudget = -1.0);
+
+protected:
+
+  //! Change flags.
+  enum ChangeFlags
+  {
+    Change_Display      = 0x01,
+    Change_Erase        = 0x02,
+    Change_Color        = 0x04,
+    Change_Transparency = 0x08,
+    Change_Location     = 0x10,
+  };
+
+  //! Collected changes of the object.
+  struct Change
+  {
+    int            Flags = 0;
+    int            DispMode = -1;
+    int            SelMode  = 0;
+    Quantity_Color Color;
+    double         Transparency = 0.0;
+    gp_Trsf        Location;
+  };
+
+  //! Return changes of the object.
+  Change& changeOf(const Handle(AIS_InteractiveObject)& theObj);
+
+protected:
+
+  NCollection_IndexedDataMap<Handle(AIS_InteractiveObject), Change> myChanges; //!< changes in the order of requests
+  std::vector<std::pair<Handle(AIS_InteractiveObject), int>> myPendingSel;    //!< displayed objects with selection modes
+  OcctSceneBoundsIndex* myBoundsIndex = NULL; //!< optional bounds index of displayed objects
+  size_t myNbActivated = 0; //!< number of processed objects within myPendingSel
+
+};
+
+#endif // _OcctBatchUpdate_HeaderFile
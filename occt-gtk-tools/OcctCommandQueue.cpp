@@ -0,0 +1,292 @@
+// Copyright (c) 2026 Kirill Gavrilov
+
+#include "OcctCommandQueue.h"
+
+#include "OcctSceneBoundsIndex.h"
+
+#include <Message.hxx>
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+
+// ================================================================
+// Function : Post
+// ================================================================
+void OcctCommandQueue::Post(const Command& theCommand)
+{
+  post(theCommand, Handle(AIS_InteractiveObject)(), BoundsChange_Unknown);
+}
+
+// ================================================================
+// Function : post
+// ================================================================
+void OcctCommandQueue::post(const Command& theCommand,
+                            const Handle(AIS_InteractiveObject)& theObj,
+                            BoundsChange theBounds)
+{
+  Entry anEntry;
+  anEntry.Func = theCommand;
+  anEntry.PostTime = std::chrono::steady_clock::now();
+  anEntry.Object = theObj;
+  anEntry.Bounds = theBounds;
+
+  bool toNotify = false;
+  {
+    std::lock_guard<std::mutex> aLock(myMutex);
+    myCommands.push_back(std::move(anEntry));
+    myMaxDepth = std::max(myMaxDepth, myCommands.size());
+    ++myNbPosted;
+    if (!myIsNotified)
+    {
+      // wake up consumer only once per burst of commands
+      myIsNotified = true;
+      toNotify = true;
+    }
+  }
+  if (toNotify)
+  {
+    // callback is called under its own lock, so that SetPostedCallback() waits for it to return
+    std::lock_guard<std::mutex> aLock(myCallbackMutex);
+    if (myPostedCallback)
+      myPostedCallback();
+  }
+}
+
+// ================================================================
+// Function : PostDisplay
+// ================================================================
+void OcctCommandQueue::PostDisplay(const Handle(AIS_InteractiveObject)& theObj,
+                                   int theDispMode,
+                                   int theSelMode)
+{
+  post([theObj, theDispMode, theSelMode](const Handle(AIS_InteractiveContext)& theCtx, const Handle(V3d_View)& )
+  {
+    const int aDispMode = theDispMode >= 0 ? theDispMode
+                        : (theObj->HasDisplayMode() ? theObj->DisplayMode() : theCtx->DisplayMode());
+    theCtx->Display(theObj, aDispMode, theSelMode, false);
+  }, theObj, BoundsChange_Update);
+}
+
+// ================================================================
+// Function : PostErase
+// ================================================================
+void OcctCommandQueue::PostErase(const Handle(AIS_InteractiveObject)& theObj)
+{
+  post([theObj](const Handle(AIS_InteractiveContext)& theCtx, const Handle(V3d_View)& )
+  {
+    theCtx->Erase(theObj, false);
+  }, theObj, BoundsChange_Remove);
+}
+
+// ================================================================
+// Function : PostRemove
+// ================================================================
+void OcctCommandQueue::PostRemove(const Handle(AIS_InteractiveObject)& theObj)
+{
+  post([theObj](const Handle(AIS_InteractiveContext)& theCtx, const Handle(V3d_View)& )
+  {
+    theCtx->Remove(theObj, false);
+  }, theObj, BoundsChange_Remove);
+}
+
+// ================================================================
+// Function : PostRedisplay
+// ================================================================
+void OcctCommandQueue::PostRedisplay(const Handle(AIS_InteractiveObject)& theObj)
+{
+  post([theObj](const Handle(AIS_InteractiveContext)& theCtx, const Handle(V3d_View)& )
+  {
+    theCtx->Redisplay(theObj, false);
+  }, theObj, BoundsChange_Update);
+}
+
+// ================================================================
+// Function : PostCamera
+// ================================================================
+void OcctCommandQueue::PostCamera(const Handle(Graphic3d_Camera)& theCamera)
+{
+  // camera is copied to let producer modify its own instance after posting
+  Handle(Graphic3d_Camera) aCamera = new Graphic3d_Camera(theCamera);
+  post([aCamera](const Handle(AIS_InteractiveContext)& , const Handle(V3d_View)& theView)
+  {
+    theView->Camera()->Copy(aCamera);
+  }, Handle(AIS_InteractiveObject)(), BoundsChange_None);
+}
+
+// ================================================================
+// Function : PostFitAll
+// ================================================================
+void OcctCommandQueue::PostFitAll(double theMargin)
+{
+  post([theMargin](const Handle(AIS_InteractiveContext)& , const Handle(V3d_View)& theView)
+  {
+    theView->FitAll(theMargin, false);
+  }, Handle(AIS_InteractiveObject)(), BoundsChange_None);
+}
+
+// ================================================================
+// Function : Drain
+// ================================================================
+int OcctCommandQueue::Drain(const Handle(AIS_InteractiveContext)& theCtx,
+                            const Handle(V3d_View)& theView)
+{
+  {
+    std::lock_guard<std::mutex> aLock(myMutex);
+    const std::ptrdiff_t aNbTaken = (std::ptrdiff_t )std::min(myCommands.size(), (size_t )std::max(myMaxCommands, 1));
+    myDrained.assign(std::make_move_iterator(myCommands.begin()), std::make_move_iterator(myCommands.begin() + aNbTaken));
+    myCommands.erase(myCommands.begin(), myCommands.begin() + aNbTaken);
+    if (aNbTaken == 0)
+    {
+      myNbLastFrame = 0;
+      return 0;
+    }
+  }
+
+  // commands are executed without lock, so that producers are never blocked by slow commands
+  const std::chrono::steady_clock::time_point aStart = std::chrono::steady_clock::now();
+  double aLatencySum = 0.0, aLatencyMax = 0.0;
+  size_t aNbExecuted = 0;
+  while (aNbExecuted < myDrained.size())
+  {
+    const Entry& anEntry = myDrained[aNbExecuted++];
+    const std::chrono::steady_clock::time_point aNow = std::chrono::steady_clock::now();
+    const double aLatency = std::chrono::duration<double>(aNow - anEntry.PostTime).count();
+    aLatencySum += aLatency;
+    aLatencyMax = std::max(aLatencyMax, aLatency);
+    try
+    {
+      anEntry.Func(theCtx, theView);
+    }
+    catch (const Standard_Failure& theErr)
+    {
+      Message::SendFail() << "OcctCommandQueue: command failed with exception "
+                          << theErr.DynamicType()->Name() << ": " << theErr.GetMessageString();
+    }
+    catch (const std::exception& theErr)
+    {
+      Message::SendFail() << "OcctCommandQueue: command failed with exception " << theErr.what();
+    }
+    catch (...)
+    {
+      Message::SendFail() << "OcctCommandQueue: command failed with unknown exception";
+    }
+    updateBounds(theCtx, anEntry);
+    if (myTimeBudget > 0.0
+     && std::chrono::duration<double>(std::chrono::steady_clock::now() - aStart).count() > myTimeBudget)
+    {
+      break;
+    }
+  }
+
+  {
+    // return commands out of budget to the head of queue keeping their order
+    std::lock_guard<std::mutex> aLock(myMutex);
+    myCommands.insert(myCommands.begin(),
+                      std::make_move_iterator(myDrained.begin() + (std::ptrdiff_t )aNbExecuted),
+                      std::make_move_iterator(myDrained.end()));
+    myIsNotified = !myCommands.empty();
+    myNbExecuted += aNbExecuted;
+    myNbLastFrame = (int )aNbExecuted;
+    myLatencySum += aLatencySum;
+    myLatencyMax = std::max(myLatencyMax, aLatencyMax);
+  }
+  myDrained.clear();
+
+  theView->Invalidate();
+  return (int )aNbExecuted;
+}
+
+// ================================================================
+// Function : updateBounds
+// ================================================================
+void OcctCommandQueue::updateBounds(const Handle(AIS_InteractiveContext)& theCtx,
+                                    const Entry& theEntry)
+{
+  if (myBoundsIndex == NULL
+  || !myBoundsIndex->IsEnabled())
+  {
+    return;
+  }
+
+  switch (theEntry.Bounds)
+  {
+    case BoundsChange_None:
+    {
+      break;
+    }
+    case BoundsChange_Update:
+    {
+      if (theCtx->IsDisplayed(theEntry.Object))
+        myBoundsIndex->Update(theEntry.Object);
+      else
+        myBoundsIndex->Remove(theEntry.Object);
+      break;
+    }
+    case BoundsChange_Remove:
+    {
+      myBoundsIndex->Remove(theEntry.Object);
+      break;
+    }
+    case BoundsChange_Unknown:
+    {
+      myBoundsIndex->MarkDirty();
+      break;
+    }
+  }
+}
+
+// ================================================================
+// Function : Clear
+// ================================================================
+void OcctCommandQueue::Clear()
+{
+  std::lock_guard<std::mutex> aLock(myMutex);
+  myCommands.clear();
+  myIsNotified = false;
+}
+
+// ================================================================
+// Function : GetMetrics
+// ================================================================
+OcctCommandQueue::Metrics OcctCommandQueue::GetMetrics() const
+{
+  std::lock_guard<std::mutex> aLock(myMutex);
+  Metrics aMetrics;
+  aMetrics.Depth       = myCommands.size();
+  aMetrics.MaxDepth    = myMaxDepth;
+  aMetrics.NbPosted    = myNbPosted;
+  aMetrics.NbExecuted  = myNbExecuted;
+  aMetrics.NbLastFrame = myNbLastFrame;
+  aMetrics.AvgLatency  = myNbExecuted != 0 ? myLatencySum / double(myNbExecuted) : 0.0;
+  aMetrics.MaxLatency  = myLatencyMax;
+  return aMetrics;
+}
+
+// ================================================================
+// Function : ResetMetrics
+// ================================================================
+void OcctCommandQueue::ResetMetrics()
+{
+  std::lock_guard<std::mutex> aLock(myMutex);
+  myMaxDepth = myCommands.size();
+  myNbPosted = 0;
+  myNbExecuted = 0;
+  myNbLastFrame = 0;
+  myLatencySum = 0.0;
+  myLatencyMax = 0.0;
+}
+
+// ================================================================
+// Function : FormatMetrics
+// ================================================================
+TCollection_AsciiString OcctCommandQueue::FormatMetrics() const
+{
+  const Metrics aMetrics = GetMetrics();
+  return TCollection_AsciiString()
+       + "Queue depth: " + int(aMetrics.Depth) + " (max: " + int(aMetrics.MaxDepth) + ")\n"
+       + "Posted: " + int(aMetrics.NbPosted) + ", executed: " + int(aMetrics.NbExecuted)
+       + " (last frame: " + aMetrics.NbLastFrame + ")\n"
+       + "Latency: " + (aMetrics.AvgLatency * 1000.0) + " ms average, " + (aMetrics.MaxLatency * 1000.0) + " ms max";
+}
@@ -0,0 +1,186 @@
+// Copyright (c) 2026 Kirill Gavrilov
+
+#ifndef _OcctCommandQueue_HeaderFile
+#define _OcctCommandQueue_HeaderFile
+
+#include <AIS_InteractiveContext.hxx>
+#include <TCollection_AsciiString.hxx>
+#include <V3d_View.hxx>
+
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+class OcctSceneBoundsIndex;
+
+//! Multi-producer queue of scene commands posted by worker threads and executed by GUI thread.
+//!
+//! AIS_InteractiveContext and V3d_View may be modified only by GUI thread, so that worker threads
+//! post commands (display, erase, redisplay, camera changes or arbitrary functions) instead of touching them directly.
+//! Drain() should be called by GUI thread before redrawing the view: it executes commands in posting order
+//! in bounded batches - no more than MaxCommandsPerFrame() commands and within TimeBudget() per frame,
+//! leaving the rest for the next frames so that a burst of commands doesn't stall rendering.
+//! PostedCallback() is called by producer only when queue becomes non-empty, to wake up GUI thread once per burst.
+//! Commands throwing Standard_Failure are reported and skipped without interrupting the rest of the queue.
+//! Bounds index passed by SetBoundsIndex() is updated per executed command for objects of PostDisplay(), PostErase(),
+//! PostRemove() and PostRedisplay(); arbitrary commands of Post() mark the index dirty.
+//!
+//! Objects may be created by worker threads, but should not be modified by them after posting.
+class OcctCommandQueue
+{
+public:
+
+  //! Command executed by GUI thread.
+  typedef std::function<void(const Handle(AIS_InteractiveContext)& theCtx, const Handle(V3d_View)& theView)> Command;
+
+  //! Queue metrics.
+  struct Metrics
+  {
+    size_t   Depth       = 0;   //!< number of waiting commands
+    size_t   MaxDepth    = 0;   //!< maximum number of waiting commands
+    uint64_t NbPosted    = 0;   //!< number of posted commands
+    uint64_t NbExecuted  = 0;   //!< number of executed commands
+    int      NbLastFrame = 0;   //!< number of commands executed by the last Drain()
+    double   AvgLatency  = 0.0; //!< average time from posting to execution in seconds
+    double   MaxLatency  = 0.0; //!< maximum time from posting to execution in seconds
+  };
+
+public:
+
+  //! Empty constructor.
+  OcctCommandQueue() {}
+
+  //! Set callback called by producer thread when queue becomes non-empty;
+  //! the callback should wake up GUI thread to redraw the view (and call Drain()).
+  //! Callback is never called after resetting it, so that objects used by the callback may be destroyed afterwards.
+  void SetPostedCallback(const std::function<void()>& theCallback)
+  {
+    std::lock_guard<std::mutex> aLock(myCallbackMutex);
+    myPostedCallback = theCallback;
+  }
+
+  //! Set bounds index to be updated for objects of executed commands (NULL by default).
+  void SetBoundsIndex(OcctSceneBoundsIndex* theIndex) { myBoundsIndex = theIndex; }
+
+  //! Return maximum number of commands executed per frame (1000 by default).
+  int MaxCommandsPerFrame() const { return myMaxCommands; }
+
+  //! Set maximum number of commands executed per frame.
+  void SetMaxCommandsPerFrame(int theNbCommands) { myMaxCommands = theNbCommands; }
+
+  //! Return time budget for executing commands per frame in seconds (0.004 by default, 0 for no limit).
+  double TimeBudget() const { return myTimeBudget; }
+
+  //! Set time budget for executing commands per frame.
+  void SetTimeBudget(double theSeconds) { myTimeBudget = theSeconds; }
+
+public: //! @name producer interface (any thread)
+
+  //! Post arbitrary command.
+  void Post(const Command& theCommand);
+
+  //! Post displaying of the object.
+  //! @param[in] theObj      object to display
+  //! @param[in] theDispMode display mode, -1 for default mode of the object
+  //! @param[in] theSelMode  selection mode, -1 for not selectable object
+  void PostDisplay(const Handle(AIS_InteractiveObject)& theObj,
+                   int theDispMode = -1,
+                   int theSelMode  = 0);
+
+  //! Post erasing of the object.
+  void PostErase(const Handle(AIS_InteractiveObject)& theObj);
+
+  //! Post removing of the object from context.
+  void PostRemove(const Handle(AIS_InteractiveObject)& theObj);
+
+  //! Post recomputing presentation of the object after its modification.
+  void PostRedisplay(const Handle(AIS_InteractiveObject)& theObj);
+
+  //! Post copying camera definition into the view camera.
+  void PostCamera(const Handle(Graphic3d_Camera)& theCamera);
+
+  //! Post fitting camera to displayed objects.
+  void PostFitAll(double theMargin = 0.01);
+
+  //! Return number of waiting commands.
+  size_t Depth() const
+  {
+    std::lock_guard<std::mutex> aLock(myMutex);
+    return myCommands.size();
+  }
+
+  //! Return TRUE if no commands are waiting.
+  bool IsEmpty() const { return Depth() == 0; }
+
+public: //! @name consumer interface (GUI thread)
+
+  //! Execute waiting commands within per-frame limits and invalidate the view if some commands have been executed.
+  //! @return number of executed commands
+  int Drain(const Handle(AIS_InteractiveContext)& theCtx,
+            const Handle(V3d_View)& theView);
+
+  //! Discard waiting commands.
+  void Clear();
+
+  //! Return queue metrics.
+  Metrics GetMetrics() const;
+
+  //! Reset counters and latency statistics.
+  void ResetMetrics();
+
+  //! Format metrics as multi-line text.
+  TCollection_AsciiString FormatMetrics() const;
+
+protected:
+
+  //! Change of object bounds made by command.
+  enum BoundsChange
+  {
+    BoundsChange_None,    //!< command doesn't modify objects
+    BoundsChange_Update,  //!< object has been displayed or recomputed
+    BoundsChange_Remove,  //!< object has been erased or removed
+    BoundsChange_Unknown, //!< arbitrary command
+  };
+
+  //! Posted command.
+  struct Entry
+  {
+    Command Func;
+    std::chrono::steady_clock::time_point PostTime;
+    Handle(AIS_InteractiveObject) Object; //!< object modified by command
+    BoundsChange Bounds = BoundsChange_Unknown;
+  };
+
+  //! Post command modifying bounds of the object.
+  void post(const Command& theCommand,
+            const Handle(AIS_InteractiveObject)& theObj,
+            BoundsChange theBounds);
+
+  //! Update bounds index after executing the command.
+  void updateBounds(const Handle(AIS_InteractiveContext)& theCtx,
+                    const Entry& theEntry);
+
+protected:
+
+  mutable std::mutex    myMutex;
+  std::deque<Entry>     myCommands;         //!< waiting commands in posting order
+  std::vector<Entry>    myDrained;          //!< commands taken by Drain()
+  std::mutex            myCallbackMutex;    //!< lock held while calling or resetting myPostedCallback
+  std::function<void()> myPostedCallback;
+  OcctSceneBoundsIndex* myBoundsIndex = NULL; //!< optional bounds index of displayed objects
+  bool                  myIsNotified = false; //!< consumer has been woken up and queue is not empty
+  int                   myMaxCommands = 1000;
+  double                myTimeBudget  = 0.004;
+
+  size_t   myMaxDepth     = 0;
+  uint64_t myNbPosted     = 0;
+  uint64_t myNbExecuted   = 0;
+  int      myNbLastFrame  = 0;
+  double   myLatencySum   = 0.0;
+  double   myLatencyMax   = 0.0;
+
+};
+
+#endif // _OcctCommandQueue_HeaderFile
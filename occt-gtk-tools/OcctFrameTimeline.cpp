@@ -0,0 +1,123 @@
+// Copyright (c) 2026 Kirill Gavrilov
+
+#include "OcctFrameTimeline.h"
+
+#include <Media_Timer.hxx>
+#include <Message.hxx>
+
+#include <algorithm>
+
+// ================================================================
+// Function : AddAnimation
+// ================================================================
+void OcctFrameTimeline::AddAnimation(const Handle(AIS_Animation)& theAnim)
+{
+  if (theAnim.IsNull())
+    return;
+
+  for (const AnimState& aState : myAnims)
+  {
+    if (aState.Animation == theAnim)
+      return;
+  }
+
+  AnimState aState;
+  aState.Animation = theAnim;
+  myAnims.push_back(aState);
+}
+
+// ================================================================
+// Function : RemoveAnimation
+// ================================================================
+void OcctFrameTimeline::RemoveAnimation(const Handle(AIS_Animation)& theAnim)
+{
+  myAnims.erase(std::remove_if(myAnims.begin(), myAnims.end(),
+                               [&theAnim](const AnimState& theState) { return theState.Animation == theAnim; }),
+                myAnims.end());
+}
+
+// ================================================================
+// Function : Advance
+// ================================================================
+bool OcctFrameTimeline::Advance(int64_t theFrameTime,
+                                int64_t thePresentTime,
+                                int64_t theRefreshInterval)
+{
+  const int64_t aPresentTime = thePresentTime != 0 ? thePresentTime : theFrameTime;
+  if (myIsRunning
+   && theRefreshInterval > 0
+   && aPresentTime > myLastPresentTime)
+  {
+    // number of refresh intervals between two consecutive frames minus one
+    const int64_t aNbIntervals = (aPresentTime - myLastPresentTime + theRefreshInterval / 2) / theRefreshInterval;
+    if (aNbIntervals > 1)
+    {
+      myNbMissed    += aNbIntervals - 1;
+      mySeqNbMissed += aNbIntervals - 1;
+    }
+  }
+  myIsRunning = true;
+  myLastPresentTime = aPresentTime;
+  myRefreshInterval = theRefreshInterval;
+  ++myNbFrames;
+  ++mySeqNbFrames;
+
+  const double aTime = FrameTime();
+  bool isAnimating = false;
+  for (AnimState& aState : myAnims)
+  {
+    const Handle(Media_Timer)& aTimer = aState.Animation->Timer();
+    if (aState.Animation->IsStopped()
+     || aTimer.IsNull())
+    {
+      aState.StartTime = -1.0;
+      continue;
+    }
+
+    if (aTimer->IsStarted())
+    {
+      // animation has been (re)started by AIS_Animation::StartTimer() - take over its wall-clock timer
+      aState.StartTime = aTime;
+      aState.StartPts  = aTimer->ElapsedTime();
+      aTimer->Pause();
+    }
+    else if (aState.StartTime < 0.0)
+    {
+      // timer is stopped by application - nothing to drive
+      continue;
+    }
+
+    const double aPts = aState.StartPts + (aTime - aState.StartTime) * aTimer->PlaybackSpeed();
+    aTimer->Seek(aPts);
+    aState.Animation->UpdateTimer();
+    if (aPts >= aState.Animation->StartPts() + aState.Animation->Duration())
+    {
+      // last frame has been applied
+      aState.Animation->Stop();
+      aState.StartTime = -1.0;
+      continue;
+    }
+    isAnimating = true;
+  }
+  return isAnimating;
+}
+
+// ================================================================
+// Function : Stop
+// ================================================================
+void OcctFrameTimeline::Stop()
+{
+  if (!myIsRunning)
+    return;
+
+  myIsRunning = false;
+  if (mySeqNbFrames > 1)
+  {
+    Message_Messenger::StreamBuffer aMsg = Message::SendTrace();
+    aMsg << "OcctFrameTimeline: " << mySeqNbFrames << " frames, " << mySeqNbMissed << " missed vblanks";
+    if (myRefreshInterval > 0)
+      aMsg << " (refresh " << (1000000 / myRefreshInterval) << " Hz)";
+  }
+  mySeqNbFrames = 0;
+  mySeqNbMissed = 0;
+}
@@ -0,0 +1,88 @@
+// Copyright (c) 2026 Kirill Gavrilov
+
+#ifndef _OcctFrameTimeline_HeaderFile
+#define _OcctFrameTimeline_HeaderFile
+
+#include <AIS_Animation.hxx>
+
+#include <cstdint>
+#include <vector>
+
+//! Animation timeline driven by display frame clock instead of wall-clock time.
+//!
+//! AIS_Animation objects normally measure time using their own Media_Timer from the moment of start.
+//! Timeline takes over timers of registered animations once they are (re)started,
+//! keeps them paused and seeks them to the predicted presentation time of each frame,
+//! so that animation steps match display refresh and don't depend on when painting actually happens.
+//!
+//! Advance() should be called from the frame clock update phase (tick callback);
+//! it updates animations, so that painting phase just redraws the scene.
+//! Timeline also counts frames and missed vertical blanks (frames skipped between two consecutive ticks).
+class OcctFrameTimeline
+{
+public:
+
+  //! Empty constructor.
+  OcctFrameTimeline() {}
+
+  //! Register animation to be driven by timeline.
+  void AddAnimation(const Handle(AIS_Animation)& theAnim);
+
+  //! Unregister animation.
+  void RemoveAnimation(const Handle(AIS_Animation)& theAnim);
+
+  //! Advance timeline to the new frame.
+  //! @param[in] theFrameTime      frame clock time in microseconds
+  //! @param[in] thePresentTime    predicted presentation time in microseconds (0 if unknown)
+  //! @param[in] theRefreshInterval refresh interval in microseconds (0 if unknown)
+  //! @return TRUE if some animation is in progress
+  bool Advance(int64_t theFrameTime,
+               int64_t thePresentTime,
+               int64_t theRefreshInterval);
+
+  //! Finish sequence of continuous frames (when tick callback is removed) and print statistics.
+  void Stop();
+
+  //! Return predicted presentation time of the last frame in seconds.
+  double FrameTime() const { return double(myLastPresentTime) * 0.000001; }
+
+  //! Return refresh interval of the last frame in seconds.
+  double RefreshInterval() const { return double(myRefreshInterval) * 0.000001; }
+
+  //! Return total number of frames passed through timeline.
+  int64_t NbFrames() const { return myNbFrames; }
+
+  //! Return total number of missed vertical blanks.
+  int64_t NbMissedVBlanks() const { return myNbMissed; }
+
+  //! Reset frame counters.
+  void ResetCounters()
+  {
+    myNbFrames = 0;
+    myNbMissed = 0;
+  }
+
+protected:
+
+  //! Animation state.
+  struct AnimState
+  {
+    Handle(AIS_Animation) Animation;
+    double StartTime = -1.0; //!< frame time when timeline took over animation timer (-1 if not yet)
+    double StartPts  = 0.0;  //!< animation timer value at StartTime
+  };
+
+protected:
+
+  std::vector<AnimState> myAnims;
+  int64_t myLastPresentTime  = 0;  //!< last predicted presentation time
+  int64_t myRefreshInterval  = 0;  //!< last refresh interval
+  int64_t myNbFrames         = 0;  //!< total number of frames
+  int64_t myNbMissed         = 0;  //!< total number of missed vertical blanks
+  int64_t mySeqNbFrames      = 0;  //!< number of frames within current sequence
+  int64_t mySeqNbMissed      = 0;  //!< number of missed vertical blanks within current sequence
+  bool    myIsRunning        = false;
+
+};
+
+#endif // _OcctFrameTimeline_HeaderFile
@@ -165,7 +165,8 @@ bool OcctGlTools::InitializeGlWindow(const Handle(V3d_View)& theView,
 // ================================================================
 // Function : InitializeGlFbo
 // ================================================================
-bool OcctGlTools::InitializeGlFbo(const Handle(V3d_View)& theView)
+bool OcctGlTools::InitializeGlFbo(const Handle(V3d_View)& theView,
+                                  bool theToResizeView)
 {
   Handle(OpenGl_Context)    aGlCtx = OcctGlTools::GetGlContext(theView);
   Handle(OcctQtFrameBuffer) aDefaultFbo = Handle(OcctQtFrameBuffer)::DownCast(aGlCtx->DefaultFrameBuffer());
@@ -179,27 +180,44 @@ bool OcctGlTools::InitializeGlFbo(const Handle(V3d_View)& theView)
     return false;
   }
 
-  // workaround some bugs (legacy code in OpenGl_Window::init() for surface-less EGL context)
-  aGlCtx->SetDefaultFrameBuffer(Handle(OpenGl_FrameBuffer)());
+  aGlCtx->SetDefaultFrameBuffer(aDefaultFbo);
+  if (theToResizeView)
+    ResizeViewToFbo(theView);
+
+  return true;
+}
+
+// ================================================================
+// Function : ResizeViewToFbo
+// ================================================================
+bool OcctGlTools::ResizeViewToFbo(const Handle(V3d_View)& theView)
+{
+  Handle(OpenGl_Context)     aGlCtx = OcctGlTools::GetGlContext(theView);
+  Handle(OpenGl_FrameBuffer) aDefaultFbo = aGlCtx->DefaultFrameBuffer();
+  if (aDefaultFbo.IsNull())
+    return false;
 
   Graphic3d_Vec2i aViewSizeOld;
   const Graphic3d_Vec2i aViewSizeNew = aDefaultFbo->GetVPSize();
   Handle(OcctNeutralWindow)  aWindow = Handle(OcctNeutralWindow)::DownCast(theView->Window());
   aWindow->Size(aViewSizeOld.x(), aViewSizeOld.y());
-  if (aViewSizeNew != aViewSizeOld)
-  {
-    aWindow->SetSize(aViewSizeNew.x(), aViewSizeNew.y());
-    theView->MustBeResized();
-    theView->Invalidate();
+  if (aViewSizeNew == aViewSizeOld)
+    return false;
+
+  // workaround some bugs (legacy code in OpenGl_Window::init() for surface-less EGL context)
+  aGlCtx->SetDefaultFrameBuffer(Handle(OpenGl_FrameBuffer)());
+
+  aWindow->SetSize(aViewSizeNew.x(), aViewSizeNew.y());
+  theView->MustBeResized();
+  theView->Invalidate();
 #if (OCC_VERSION_HEX >= 0x070700)
-    for (const Handle(V3d_View)& aSubviewIter : theView->Subviews())
-    {
-      aSubviewIter->MustBeResized();
-      aSubviewIter->Invalidate();
-      aDefaultFbo->SetupViewport(aGlCtx);
-    }
-#endif
+  for (const Handle(V3d_View)& aSubviewIter : theView->Subviews())
+  {
+    aSubviewIter->MustBeResized();
+    aSubviewIter->Invalidate();
+    aDefaultFbo->SetupViewport(aGlCtx);
   }
+#endif
   aGlCtx->SetDefaultFrameBuffer(aDefaultFbo);
   return true;
 }
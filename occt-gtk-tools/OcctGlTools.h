@@ -52,7 +52,15 @@ public:
                                  const double thePixelRatio);
 
   //! Wrap FBO created by QOpenGLFramebufferObject to OCCT 3D Viewer target.
-  static bool InitializeGlFbo(const Handle(V3d_View)& theView);
+  //! @param[in] theView view to initialize
+  //! @param[in] theToResizeView when FALSE, view is not resized to new FBO dimensions (see ResizeViewToFbo())
+  static bool InitializeGlFbo(const Handle(V3d_View)& theView,
+                              bool theToResizeView = true);
+
+  //! Resize view to dimensions of default FBO (wrapped by InitializeGlFbo()),
+  //! which reallocates offscreen buffers of the view.
+  //! @return FALSE if view has the same dimensions
+  static bool ResizeViewToFbo(const Handle(V3d_View)& theView);
 
   //! Cleanup up global GL state after Qt before redrawing OCCT Viewer.
   static void ResetGlStateBeforeOcct(const Handle(V3d_View)& theView);
@@ -0,0 +1,381 @@
+// Copyright (c) 2026 Kirill Gavrilov
+
+#include "OcctHiddenLines.h"
+
+#include <Bnd_Box.hxx>
+#include <Bnd_Box2d.hxx>
+#include <BRep_Builder.hxx>
+#include <BRepBndLib.hxx>
+#include <HLRAlgo_Projector.hxx>
+#include <HLRBRep_Algo.hxx>
+#include <HLRBRep_HLRToShape.hxx>
+#include <Message.hxx>
+#include <OSD_Parallel.hxx>
+#include <Precision.hxx>
+#include <Prs3d_LineAspect.hxx>
+#include <TopoDS_Compound.hxx>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <numeric>
+#include <vector>
+
+namespace
+{
+  //! Add non-null shape into compound.
+  static void addToCompound(BRep_Builder& theBuilder, TopoDS_Compound& theComp, const TopoDS_Shape& theShape)
+  {
+    if (!theShape.IsNull())
+      theBuilder.Add(theComp, theShape);
+  }
+}
+
+// ================================================================
+// Function : CollectShapes
+// ================================================================
+void OcctHiddenLines::CollectShapes(const Handle(AIS_InteractiveContext)& theCtx,
+                                    NCollection_Sequence<TopoDS_Shape>& theShapes,
+                                    AIS_ListOfInteractive& theObjects)
+{
+  AIS_ListOfInteractive aDisplayed;
+  theCtx->DisplayedObjects(aDisplayed);
+  for (const Handle(AIS_InteractiveObject)& anObj : aDisplayed)
+  {
+    Handle(AIS_Shape) aShapePrs = Handle(AIS_Shape)::DownCast(anObj);
+    if (aShapePrs.IsNull()
+     || aShapePrs->Shape().IsNull())
+    {
+      continue;
+    }
+
+    // location can't carry scaling or mirroring - such objects are left shaded
+    TopoDS_Shape aShape;
+    try
+    {
+      aShape = aShapePrs->Shape().Moved(TopLoc_Location(aShapePrs->Transformation()));
+    }
+    catch (const Standard_Failure& theErr)
+    {
+      Message::SendWarning() << "OcctHiddenLines: object skipped due to transformation not applicable to shape: "
+                             << theErr.GetMessageString();
+      continue;
+    }
+    catch (const std::exception& theErr)
+    {
+      Message::SendWarning() << "OcctHiddenLines: object skipped due to transformation not applicable to shape: "
+                             << theErr.what();
+      continue;
+    }
+
+    theShapes.Append(aShape);
+    theObjects.Append(aShapePrs);
+  }
+}
+
+// ================================================================
+// Function : SetShapes
+// ================================================================
+void OcctHiddenLines::SetShapes(const NCollection_Sequence<TopoDS_Shape>& theShapes)
+{
+  std::lock_guard<std::mutex> aLock(myMutex);
+  myShapes = theShapes;
+  myCache.clear();
+  myCacheOrder.clear();
+}
+
+// ================================================================
+// Function : directionKey
+// ================================================================
+OcctHiddenLines::DirKey OcctHiddenLines::directionKey(const gp_Dir& theViewDir)
+{
+  // directions differing less than ~0.0001 radians share the same result
+  const double aScale = 10000.0;
+  DirKey aKey = {{ (int )std::lround(theViewDir.X() * aScale),
+                   (int )std::lround(theViewDir.Y() * aScale),
+                   (int )std::lround(theViewDir.Z() * aScale) }};
+  return aKey;
+}
+
+// ================================================================
+// Function : FindCached
+// ================================================================
+bool OcctHiddenLines::FindCached(const gp_Dir& theViewDir, Result& theResult) const
+{
+  std::lock_guard<std::mutex> aLock(myMutex);
+  std::map<DirKey, Result>::const_iterator aResIter = myCache.find(directionKey(theViewDir));
+  if (aResIter == myCache.end())
+    return false;
+
+  theResult = aResIter->second;
+  return true;
+}
+
+// ================================================================
+// Function : Perform
+// ================================================================
+bool OcctHiddenLines::Perform(const gp_Dir& theViewDir,
+                              const std::function<bool()>& theToCancel,
+                              Result& theResult)
+{
+  NCollection_Sequence<TopoDS_Shape> aShapes;
+  {
+    std::lock_guard<std::mutex> aLock(myMutex);
+    aShapes = myShapes;
+  }
+  if (aShapes.IsEmpty())
+    return false;
+
+  const std::chrono::steady_clock::time_point aStart = std::chrono::steady_clock::now();
+
+  // projection plane passes through the center of shapes, looking towards the eye
+  Bnd_Box aSceneBox;
+  std::vector<Bnd_Box> aBoxes(aShapes.Length());
+  for (int aShapeIter = 0; aShapeIter < aShapes.Length(); ++aShapeIter)
+  {
+    BRepBndLib::Add(aShapes.Value(aShapeIter + 1), aBoxes[aShapeIter]);
+    aSceneBox.Add(aBoxes[aShapeIter]);
+  }
+  if (aSceneBox.IsVoid())
+    return false;
+
+  const gp_Ax2 aPrjAx(gp_Pnt((aSceneBox.CornerMin().XYZ() + aSceneBox.CornerMax().XYZ()) * 0.5), theViewDir.Reversed());
+  const HLRAlgo_Projector aProjector(aPrjAx);
+  gp_Trsf aWorldToPlane;
+  aWorldToPlane.SetTransformation(gp_Ax3(aPrjAx));
+
+  // shapes may occlude each other only when their bounding boxes overlap on projection plane
+  const int aNbShapes = aShapes.Length();
+  std::vector<Bnd_Box2d> aBoxes2d(aNbShapes);
+  for (int aShapeIter = 0; aShapeIter < aNbShapes; ++aShapeIter)
+  {
+    if (aBoxes[aShapeIter].IsVoid())
+      continue;
+
+    const gp_Pnt aMin = aBoxes[aShapeIter].CornerMin(), aMax = aBoxes[aShapeIter].CornerMax();
+    for (int aCornerIter = 0; aCornerIter < 8; ++aCornerIter)
+    {
+      gp_Pnt aCorner((aCornerIter & 1) != 0 ? aMax.X() : aMin.X(),
+                     (aCornerIter & 2) != 0 ? aMax.Y() : aMin.Y(),
+                     (aCornerIter & 4) != 0 ? aMax.Z() : aMin.Z());
+      aCorner.Transform(aWorldToPlane);
+      aBoxes2d[aShapeIter].Add(gp_Pnt2d(aCorner.X(), aCorner.Y()));
+    }
+    aBoxes2d[aShapeIter].Enlarge(Precision::Confusion());
+  }
+
+  // find occluders of each shape sweeping boxes along X
+  std::vector<int> anOrder(aNbShapes);
+  std::iota(anOrder.begin(), anOrder.end(), 0);
+  std::vector<std::vector<int>> anOccluders(aNbShapes);
+  std::vector<double> aMinX(aNbShapes, 0.0), aMaxX(aNbShapes, 0.0), aMinY(aNbShapes, 0.0), aMaxY(aNbShapes, 0.0);
+  for (int aShapeIter = 0; aShapeIter < aNbShapes; ++aShapeIter)
+  {
+    if (!aBoxes2d[aShapeIter].IsVoid())
+      aBoxes2d[aShapeIter].Get(aMinX[aShapeIter], aMinY[aShapeIter], aMaxX[aShapeIter], aMaxY[aShapeIter]);
+  }
+  std::sort(anOrder.begin(), anOrder.end(), [&aMinX](int theLeft, int theRight) { return aMinX[theLeft] < aMinX[theRight]; });
+  int aNbPairs = 0;
+  for (int anIter = 0; anIter < aNbShapes; ++anIter)
+  {
+    const int aShape = anOrder[anIter];
+    if (aBoxes2d[aShape].IsVoid())
+      continue;
+
+    for (int aNextIter = anIter + 1; aNextIter < aNbShapes && aMinX[anOrder[aNextIter]] <= aMaxX[aShape]; ++aNextIter)
+    {
+      const int anOther = anOrder[aNextIter];
+      if (!aBoxes2d[anOther].IsVoid()
+       && aMinY[anOther] <= aMaxY[aShape]
+       && aMaxY[anOther] >= aMinY[aShape])
+      {
+        anOccluders[aShape].push_back(anOther);
+        anOccluders[anOther].push_back(aShape);
+        ++aNbPairs;
+      }
+    }
+  }
+
+  // start from shapes with more occluders to balance threads
+  std::vector<int> aTasks(aNbShapes);
+  std::iota(aTasks.begin(), aTasks.end(), 0);
+  std::stable_sort(aTasks.begin(), aTasks.end(), [&anOccluders](int theLeft, int theRight)
+  {
+    return anOccluders[theLeft].size() > anOccluders[theRight].size();
+  });
+
+  std::vector<Result> aShapeResults(aNbShapes);
+  std::atomic<bool> isCancelled(false);
+  OSD_Parallel::For(0, aNbShapes, [&](int theTaskIndex)
+  {
+    if (isCancelled
+     || (theToCancel && theToCancel()))
+    {
+      isCancelled = true;
+      return;
+    }
+
+    // the shape goes first, so that it has index 1 within algorithm
+    const int aShapeIndex = aTasks[theTaskIndex];
+    const TopoDS_Shape& aShape = aShapes.Value(aShapeIndex + 1);
+    try
+    {
+      Handle(HLRBRep_Algo) anAlgo = new HLRBRep_Algo();
+      anAlgo->Add(aShape);
+      for (int anOccluder : anOccluders[aShapeIndex])
+        anAlgo->Add(aShapes.Value(anOccluder + 1));
+
+      anAlgo->Projector(aProjector);
+      anAlgo->Update();
+
+      // hide edges of the shape by itself and by occluders; edges of occluders are computed by their own tasks
+      anAlgo->Hide(1);
+      for (int anOccluderIter = 2; anOccluderIter <= (int )anOccluders[aShapeIndex].size() + 1; ++anOccluderIter)
+        anAlgo->Hide(1, anOccluderIter);
+
+      HLRBRep_HLRToShape aToShape(anAlgo);
+      BRep_Builder aBuilder;
+      TopoDS_Compound aVisible, aHidden;
+      aBuilder.MakeCompound(aVisible);
+      aBuilder.MakeCompound(aHidden);
+      addToCompound(aBuilder, aVisible, aToShape.VCompound(aShape));
+      addToCompound(aBuilder, aVisible, aToShape.Rg1LineVCompound(aShape));
+      addToCompound(aBuilder, aVisible, aToShape.OutLineVCompound(aShape));
+      addToCompound(aBuilder, aHidden,  aToShape.HCompound(aShape));
+      addToCompound(aBuilder, aHidden,  aToShape.OutLineHCompound(aShape));
+      aShapeResults[aShapeIndex].Visible = aVisible;
+      aShapeResults[aShapeIndex].Hidden  = aHidden;
+    }
+    catch (const Standard_Failure& theErr)
+    {
+      // shape is left without lines instead of terminating the worker thread
+      Message::SendWarning() << "OcctHiddenLines: shape skipped due to exception "
+                             << theErr.DynamicType()->Name() << ": " << theErr.GetMessageString();
+    }
+    catch (const std::exception& theErr)
+    {
+      Message::SendWarning() << "OcctHiddenLines: shape skipped due to exception " << theErr.what();
+    }
+    catch (...)
+    {
+      Message::SendWarning() << "OcctHiddenLines: shape skipped due to unknown exception";
+    }
+  });
+  if (isCancelled)
+    return false;
+
+  // edges are computed on projection plane - move them back to world coordinates
+  BRep_Builder aBuilder;
+  TopoDS_Compound aVisible, aHidden;
+  aBuilder.MakeCompound(aVisible);
+  aBuilder.MakeCompound(aHidden);
+  for (const Result& aShapeRes : aShapeResults)
+  {
+    addToCompound(aBuilder, aVisible, aShapeRes.Visible);
+    addToCompound(aBuilder, aHidden,  aShapeRes.Hidden);
+  }
+  const TopLoc_Location aPlaneToWorld(aWorldToPlane.Inverted());
+  theResult.Visible = aVisible.Moved(aPlaneToWorld);
+  theResult.Hidden  = aHidden.Moved(aPlaneToWorld);
+
+  std::lock_guard<std::mutex> aLock(myMutex);
+  myLastNbPairs = aNbPairs;
+  myLastTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - aStart).count();
+  const DirKey aKey = directionKey(theViewDir);
+  if (myCache.find(aKey) == myCache.end())
+  {
+    myCacheOrder.push_back(aKey);
+    while ((int )myCacheOrder.size() > std::max(myMaxCacheSize, 1))
+    {
+      myCache.erase(myCacheOrder.front());
+      myCacheOrder.pop_front();
+    }
+  }
+  myCache[aKey] = theResult;
+  return true;
+}
+
+// ================================================================
+// Function : FormatStatistics
+// ================================================================
+TCollection_AsciiString OcctHiddenLines::FormatStatistics() const
+{
+  std::lock_guard<std::mutex> aLock(myMutex);
+  return TCollection_AsciiString()
+       + "Hidden lines of " + myShapes.Length() + " shapes with " + myLastNbPairs + " overlapping pairs"
+       + " computed in " + myLastTime + " s; cached views: " + (int )myCache.size();
+}
+
+// ================================================================
+// Function : Attach
+// ================================================================
+void OcctHiddenLines::Attach(const Handle(AIS_InteractiveContext)& theCtx)
+{
+  NCollection_Sequence<TopoDS_Shape> aShapes;
+  myObjects.Clear();
+  CollectShapes(theCtx, aShapes, myObjects);
+  SetShapes(aShapes);
+}
+
+// ================================================================
+// Function : Detach
+// ================================================================
+void OcctHiddenLines::Detach(const Handle(AIS_InteractiveContext)& theCtx,
+                             const Handle(V3d_View)& theView)
+{
+  ShowShaded(theCtx, theView);
+  myObjects.Clear();
+}
+
+// ================================================================
+// Function : Show
+// ================================================================
+void OcctHiddenLines::Show(const Handle(AIS_InteractiveContext)& theCtx,
+                           const Handle(V3d_View)& theView,
+                           const Result& theResult,
+                           const gp_Dir& theViewDir)
+{
+  if (!myVisiblePrs.IsNull())
+    theCtx->Remove(myVisiblePrs, false);
+  if (!myHiddenPrs.IsNull())
+    theCtx->Remove(myHiddenPrs, false);
+
+  // result is not selectable, as it is valid only for one view direction
+  myVisiblePrs = new AIS_Shape(theResult.Visible);
+  myVisiblePrs->Attributes()->SetWireAspect(new Prs3d_LineAspect(Quantity_NOC_WHITE, Aspect_TOL_SOLID, 1.5));
+  theCtx->Display(myVisiblePrs, AIS_WireFrame, -1, false);
+
+  myHiddenPrs = new AIS_Shape(theResult.Hidden);
+  myHiddenPrs->Attributes()->SetWireAspect(new Prs3d_LineAspect(Quantity_NOC_GRAY50, Aspect_TOL_DASH, 1.0));
+  theCtx->Display(myHiddenPrs, AIS_WireFrame, -1, false);
+
+  if (!myIsShown)
+  {
+    for (const Handle(AIS_InteractiveObject)& anObj : myObjects)
+      theCtx->SetViewAffinity(anObj, theView, false);
+  }
+  myShownKey = directionKey(theViewDir);
+  myIsShown = true;
+}
+
+// ================================================================
+// Function : ShowShaded
+// ================================================================
+bool OcctHiddenLines::ShowShaded(const Handle(AIS_InteractiveContext)& theCtx,
+                                 const Handle(V3d_View)& theView)
+{
+  if (!myIsShown)
+    return false;
+
+  for (const Handle(AIS_InteractiveObject)& anObj : myObjects)
+    theCtx->SetViewAffinity(anObj, theView, true);
+
+  theCtx->Remove(myVisiblePrs, false);
+  theCtx->Remove(myHiddenPrs, false);
+  myVisiblePrs.Nullify();
+  myHiddenPrs.Nullify();
+  myIsShown = false;
+  return true;
+}
@@ -0,0 +1,140 @@
+// Copyright (c) 2026 Kirill Gavrilov
+
+#ifndef _OcctHiddenLines_HeaderFile
+#define _OcctHiddenLines_HeaderFile
+
+#include <AIS_InteractiveContext.hxx>
+#include <AIS_Shape.hxx>
+#include <gp_Dir.hxx>
+#include <NCollection_Sequence.hxx>
+#include <TopoDS_Shape.hxx>
+#include <V3d_View.hxx>
+
+#include <array>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+
+//! Exact hidden line removal (HLRBRep_Algo) of a set of shapes for orthographic views,
+//! intended for technical-drawing style display.
+//!
+//! Perform() is a blocking call to be executed by worker thread.
+//! Each shape is computed in parallel by a separate algorithm together with its occluders - shapes which bounding boxes
+//! overlap its bounding box on projection plane; only edges of the shape itself are hidden by occluders and kept in result,
+//! so that a dense cluster of overlapping shapes doesn't collapse into a single sequential computation.
+//! Results are kept in world coordinates within a cache keyed by view direction, so that returning to already
+//! computed view (e.g. to a standard view by AIS_ViewCube) doesn't require computation.
+//! Show() displays result as wireframe presentations instead of shaded objects (hidden in the view),
+//! and ShowShaded() restores shaded objects while result for a new view direction is being computed.
+class OcctHiddenLines : public Standard_Transient
+{
+  DEFINE_STANDARD_RTTI_INLINE(OcctHiddenLines, Standard_Transient)
+public:
+
+  //! Edges after hidden line removal lying on projection plane through the center of shapes.
+  struct Result
+  {
+    TopoDS_Shape Visible; //!< visible sharp, smooth and outline edges
+    TopoDS_Shape Hidden;  //!< hidden sharp and outline edges
+  };
+
+  //! Collect shapes of displayed AIS_Shape objects with their transformations.
+  //! Objects with scaled or mirrored transformations (which can't be applied as shape location) are skipped.
+  //! @param[in]  theCtx     AIS context
+  //! @param[out] theShapes  shapes in world coordinates
+  //! @param[out] theObjects objects providing shapes
+  static void CollectShapes(const Handle(AIS_InteractiveContext)& theCtx,
+                            NCollection_Sequence<TopoDS_Shape>& theShapes,
+                            AIS_ListOfInteractive& theObjects);
+
+public:
+
+  //! Empty constructor.
+  OcctHiddenLines() {}
+
+  //! Return maximum number of cached results (32 by default).
+  int MaxCacheSize() const { return myMaxCacheSize; }
+
+  //! Set maximum number of cached results; the oldest results are dropped first.
+  void SetMaxCacheSize(int theSize) { myMaxCacheSize = theSize; }
+
+  //! Set shapes in world coordinates; clears cache.
+  void SetShapes(const NCollection_Sequence<TopoDS_Shape>& theShapes);
+
+  //! Return number of shapes.
+  int NbShapes() const
+  {
+    std::lock_guard<std::mutex> aLock(myMutex);
+    return myShapes.Length();
+  }
+
+  //! Find cached result for specified camera direction (from eye to target).
+  bool FindCached(const gp_Dir& theViewDir, Result& theResult) const;
+
+  //! Compute hidden line removal for specified camera direction (from eye to target) and put result into cache.
+  //! @param[in]  theViewDir  camera direction
+  //! @param[in]  theToCancel optional function checked before computing each shape, returning TRUE to abort computation;
+  //!                         it may block (e.g. OcctIdleScheduler::JobContext::Yield()) to pause computation while view is navigated
+  //! @param[out] theResult   computed result
+  //! @return FALSE if computation has been cancelled or there are no shapes
+  bool Perform(const gp_Dir& theViewDir,
+               const std::function<bool()>& theToCancel,
+               Result& theResult);
+
+  //! Format statistics of the last computation.
+  TCollection_AsciiString FormatStatistics() const;
+
+public: //! @name presentation (GUI thread)
+
+  //! Collect displayed shapes (see CollectShapes()) and remember their objects to be hidden while result is shown.
+  void Attach(const Handle(AIS_InteractiveContext)& theCtx);
+
+  //! Restore shaded objects and remove result presentations.
+  void Detach(const Handle(AIS_InteractiveContext)& theCtx,
+              const Handle(V3d_View)& theView);
+
+  //! Return TRUE if result for specified camera direction is displayed.
+  bool IsShown(const gp_Dir& theViewDir) const
+  {
+    return myIsShown && directionKey(theViewDir) == myShownKey;
+  }
+
+  //! Display result for specified camera direction instead of shaded objects.
+  void Show(const Handle(AIS_InteractiveContext)& theCtx,
+            const Handle(V3d_View)& theView,
+            const Result& theResult,
+            const gp_Dir& theViewDir);
+
+  //! Display shaded objects instead of result.
+  //! @return FALSE if shaded objects are already displayed
+  bool ShowShaded(const Handle(AIS_InteractiveContext)& theCtx,
+                  const Handle(V3d_View)& theView);
+
+protected:
+
+  //! Cache key - quantized view direction.
+  typedef std::array<int, 3> DirKey;
+
+  //! Return cache key for view direction.
+  static DirKey directionKey(const gp_Dir& theViewDir);
+
+protected:
+
+  mutable std::mutex                 myMutex;
+  NCollection_Sequence<TopoDS_Shape> myShapes;
+  std::map<DirKey, Result>           myCache;
+  std::deque<DirKey>                 myCacheOrder;        //!< cached keys from the oldest to the newest
+  int                                myMaxCacheSize = 32;
+  int                                myLastNbPairs  = 0;  //!< number of shape-occluder pairs in the last computation
+  double                             myLastTime     = 0.0; //!< duration of the last computation in seconds
+
+  AIS_ListOfInteractive              myObjects;           //!< shaded objects hidden while result is shown
+  Handle(AIS_Shape)                  myVisiblePrs;        //!< presentation of visible edges
+  Handle(AIS_Shape)                  myHiddenPrs;         //!< presentation of hidden edges
+  DirKey                             myShownKey = {{ 0, 0, 0 }}; //!< view direction of displayed result
+  bool                               myIsShown = false;   //!< result is displayed instead of shaded objects
+
+};
+
+#endif // _OcctHiddenLines_HeaderFile
@@ -0,0 +1,415 @@
+// Copyright (c) 2026 Kirill Gavrilov
+
+#include "OcctIdleScheduler.h"
+
+#include <algorithm>
+
+// ================================================================
+// Function : JobContext::Id
+// ================================================================
+int OcctIdleScheduler::JobContext::Id() const
+{
+  return myTask->Id;
+}
+
+// ================================================================
+// Function : JobContext::IsCancelled
+// ================================================================
+bool OcctIdleScheduler::JobContext::IsCancelled() const
+{
+  return myTask->IsCancelled.load(std::memory_order_relaxed);
+}
+
+// ================================================================
+// Function : JobContext::Yield
+// ================================================================
+bool OcctIdleScheduler::JobContext::Yield()
+{
+  std::unique_lock<std::mutex> aLock(myScheduler->myMutex);
+  myScheduler->myCondition.wait(aLock, [this]()
+  {
+    return !myScheduler->myIsPaused
+         || myScheduler->myToStop
+         || myTask->IsCancelled.load();
+  });
+  return !myTask->IsCancelled.load();
+}
+
+// ================================================================
+// Function : OcctIdleScheduler
+// ================================================================
+OcctIdleScheduler::OcctIdleScheduler()
+{
+  // leave most of the cores to interactive work
+  myNbWorkers = std::max((int )std::thread::hardware_concurrency() / 4, 1);
+}
+
+// ================================================================
+// Function : createTask
+// ================================================================
+std::shared_ptr<OcctIdleScheduler::Task> OcctIdleScheduler::createTask(const TCollection_AsciiString& theName,
+                                                                       Priority thePriority)
+{
+  std::shared_ptr<Task> aTask = std::make_shared<Task>();
+  aTask->Id = ++myLastId;
+  aTask->Name = theName;
+  aTask->Prio = thePriority;
+  aTask->PostTime = std::chrono::steady_clock::now();
+  myTasks[aTask->Id] = aTask;
+  return aTask;
+}
+
+// ================================================================
+// Function : PostIdle
+// ================================================================
+int OcctIdleScheduler::PostIdle(const TCollection_AsciiString& theName,
+                                Priority thePriority,
+                                const IdleStep& theStep)
+{
+  int anId = 0;
+  std::function<void()> aWakeCallback;
+  {
+    std::lock_guard<std::mutex> aLock(myMutex);
+    std::shared_ptr<Task> aTask = createTask(theName, thePriority);
+    aTask->Step = theStep;
+    mySteps[thePriority].push_back(aTask);
+    anId = aTask->Id;
+    aWakeCallback = myWakeCallback;
+  }
+  if (aWakeCallback)
+    aWakeCallback();
+
+  return anId;
+}
+
+// ================================================================
+// Function : PostJob
+// ================================================================
+int OcctIdleScheduler::PostJob(const TCollection_AsciiString& theName,
+                               Priority thePriority,
+                               const Job& theJob,
+                               const IdleStep& theDone)
+{
+  int anId = 0;
+  {
+    std::lock_guard<std::mutex> aLock(myMutex);
+    std::shared_ptr<Task> aTask = createTask(theName, thePriority);
+    aTask->Func = theJob;
+    aTask->Step = theDone;
+    myJobs[thePriority].push_back(aTask);
+    anId = aTask->Id;
+
+    // workers are started lazily, as many applications never post jobs
+    if (myWorkers.empty())
+    {
+      for (int aThreadIter = 0; aThreadIter < std::max(myNbWorkers, 1); ++aThreadIter)
+        myWorkers.emplace_back(&OcctIdleScheduler::workerLoop, this);
+    }
+  }
+  myCondition.notify_one();
+  return anId;
+}
+
+// ================================================================
+// Function : Cancel
+// ================================================================
+bool OcctIdleScheduler::Cancel(int theId)
+{
+  {
+    std::lock_guard<std::mutex> aLock(myMutex);
+    std::map<int, std::shared_ptr<Task>>::iterator aTaskIter = myTasks.find(theId);
+    if (aTaskIter == myTasks.end())
+      return false;
+
+    std::shared_ptr<Task> aTask = aTaskIter->second;
+    aTask->IsCancelled = true;
+    myTasks.erase(aTaskIter);
+    ++myNbCancelled;
+    TaskQueue& aJobs  = myJobs [aTask->Prio];
+    TaskQueue& aSteps = mySteps[aTask->Prio];
+    aJobs .erase(std::remove(aJobs .begin(), aJobs .end(), aTask), aJobs .end());
+    aSteps.erase(std::remove(aSteps.begin(), aSteps.end(), aTask), aSteps.end());
+  }
+  // wake up job waiting within Yield()
+  myCondition.notify_all();
+  return true;
+}
+
+// ================================================================
+// Function : CancelAll
+// ================================================================
+void OcctIdleScheduler::CancelAll()
+{
+  {
+    std::lock_guard<std::mutex> aLock(myMutex);
+    for (const std::pair<const int, std::shared_ptr<Task>>& aTaskIter : myTasks)
+      aTaskIter.second->IsCancelled = true;
+
+    myNbCancelled += myTasks.size();
+    myTasks.clear();
+    for (int aPrioIter = Priority_Low; aPrioIter <= Priority_High; ++aPrioIter)
+    {
+      myJobs [aPrioIter].clear();
+      mySteps[aPrioIter].clear();
+    }
+  }
+  myCondition.notify_all();
+}
+
+// ================================================================
+// Function : Stop
+// ================================================================
+void OcctIdleScheduler::Stop()
+{
+  CancelAll();
+  {
+    std::lock_guard<std::mutex> aLock(myMutex);
+    myToStop = true;
+  }
+  myCondition.notify_all();
+  for (std::thread& aWorker : myWorkers)
+    aWorker.join();
+
+  // workers will be started again by the next job
+  std::lock_guard<std::mutex> aLock(myMutex);
+  myWorkers.clear();
+  myToStop = false;
+}
+
+// ================================================================
+// Function : Pause
+// ================================================================
+void OcctIdleScheduler::Pause()
+{
+  std::lock_guard<std::mutex> aLock(myMutex);
+  if (!myIsPaused)
+  {
+    myIsPaused = true;
+    ++myNbPauses;
+  }
+}
+
+// ================================================================
+// Function : Resume
+// ================================================================
+void OcctIdleScheduler::Resume()
+{
+  {
+    std::lock_guard<std::mutex> aLock(myMutex);
+    if (!myIsPaused)
+      return;
+
+    myIsPaused = false;
+  }
+  myCondition.notify_all();
+}
+
+// ================================================================
+// Function : popTask
+// ================================================================
+std::shared_ptr<OcctIdleScheduler::Task> OcctIdleScheduler::popTask(TaskQueue* theQueues)
+{
+  for (int aPrioIter = Priority_High; aPrioIter >= Priority_Low; --aPrioIter)
+  {
+    if (!theQueues[aPrioIter].empty())
+    {
+      std::shared_ptr<Task> aTask = theQueues[aPrioIter].front();
+      theQueues[aPrioIter].pop_front();
+      return aTask;
+    }
+  }
+  return std::shared_ptr<Task>();
+}
+
+// ================================================================
+// Function : countTasks
+// ================================================================
+int OcctIdleScheduler::countTasks(const TaskQueue* theQueues)
+{
+  size_t aNbTasks = 0;
+  for (int aPrioIter = Priority_Low; aPrioIter <= Priority_High; ++aPrioIter)
+    aNbTasks += theQueues[aPrioIter].size();
+
+  return (int )aNbTasks;
+}
+
+// ================================================================
+// Function : startTask
+// ================================================================
+void OcctIdleScheduler::startTask(Task& theTask)
+{
+  if (theTask.IsStarted)
+    return;
+
+  theTask.IsStarted = true;
+  myWaitSum += std::chrono::duration<double>(std::chrono::steady_clock::now() - theTask.PostTime).count();
+  ++myNbStarted;
+}
+
+// ================================================================
+// Function : HasIdleSteps
+// ================================================================
+bool OcctIdleScheduler::HasIdleSteps() const
+{
+  std::lock_guard<std::mutex> aLock(myMutex);
+  return countTasks(mySteps) != 0;
+}
+
+// ================================================================
+// Function : RunIdleSteps
+// ================================================================
+bool OcctIdleScheduler::RunIdleSteps(double theBudget)
+{
+  const std::chrono::steady_clock::time_point aStart = std::chrono::steady_clock::now();
+  bool hasMore = false;
+  for (;;)
+  {
+    std::shared_ptr<Task> aTask;
+    {
+      std::lock_guard<std::mutex> aLock(myMutex);
+      if (myIsPaused)
+        break;
+
+      aTask = popTask(mySteps);
+      if (!aTask)
+        break;
+
+      startTask(*aTask);
+    }
+
+    // step is executed without lock, so that it may post or cancel other tasks
+    const bool toContinue = aTask->Step();
+    {
+      std::lock_guard<std::mutex> aLock(myMutex);
+      if (aTask->IsCancelled.load())
+      {
+        // cancelled from within step
+      }
+      else if (toContinue)
+      {
+        // keep position of unfinished task within its priority
+        mySteps[aTask->Prio].push_front(aTask);
+      }
+      else
+      {
+        ++myNbCompleted;
+        myTasks.erase(aTask->Id);
+      }
+    }
+
+    if (std::chrono::duration<double>(std::chrono::steady_clock::now() - aStart).count() >= theBudget)
+    {
+      std::lock_guard<std::mutex> aLock(myMutex);
+      hasMore = !myIsPaused && countTasks(mySteps) != 0;
+      break;
+    }
+  }
+
+  const double aSliceTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - aStart).count();
+  std::lock_guard<std::mutex> aLock(myMutex);
+  myIdleTime += aSliceTime;
+  myMaxSliceTime = std::max(myMaxSliceTime, aSliceTime);
+  return hasMore;
+}
+
+// ================================================================
+// Function : workerLoop
+// ================================================================
+void OcctIdleScheduler::workerLoop()
+{
+  for (;;)
+  {
+    std::shared_ptr<Task> aTask;
+    {
+      std::unique_lock<std::mutex> aLock(myMutex);
+      myCondition.wait(aLock, [this]() { return myToStop || (!myIsPaused && countTasks(myJobs) != 0); });
+      if (myToStop)
+        return;
+
+      aTask = popTask(myJobs);
+      startTask(*aTask);
+      ++myNbRunning;
+    }
+
+    const std::chrono::steady_clock::time_point aStart = std::chrono::steady_clock::now();
+    JobContext aCtx(this, aTask);
+    aTask->Func(aCtx);
+    const double aJobTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - aStart).count();
+
+    std::function<void()> aWakeCallback;
+    {
+      std::lock_guard<std::mutex> aLock(myMutex);
+      --myNbRunning;
+      myWorkerTime += aJobTime;
+      if (aTask->IsCancelled.load())
+      {
+        // result is discarded
+      }
+      else if (aTask->Step)
+      {
+        // apply result within GUI thread
+        mySteps[aTask->Prio].push_back(aTask);
+        aWakeCallback = myWakeCallback;
+      }
+      else
+      {
+        ++myNbCompleted;
+        myTasks.erase(aTask->Id);
+      }
+    }
+    if (aWakeCallback)
+      aWakeCallback();
+  }
+}
+
+// ================================================================
+// Function : GetMetrics
+// ================================================================
+OcctIdleScheduler::Metrics OcctIdleScheduler::GetMetrics() const
+{
+  std::lock_guard<std::mutex> aLock(myMutex);
+  Metrics aMetrics;
+  aMetrics.NbPendingJobs  = countTasks(myJobs);
+  aMetrics.NbRunningJobs  = myNbRunning;
+  aMetrics.NbPendingSteps = countTasks(mySteps);
+  aMetrics.NbCompleted    = myNbCompleted;
+  aMetrics.NbCancelled    = myNbCancelled;
+  aMetrics.NbPauses       = myNbPauses;
+  aMetrics.WorkerTime     = myWorkerTime;
+  aMetrics.IdleTime       = myIdleTime;
+  aMetrics.MaxSliceTime   = myMaxSliceTime;
+  aMetrics.AvgWaitTime    = myNbStarted != 0 ? myWaitSum / double(myNbStarted) : 0.0;
+  return aMetrics;
+}
+
+// ================================================================
+// Function : ResetMetrics
+// ================================================================
+void OcctIdleScheduler::ResetMetrics()
+{
+  std::lock_guard<std::mutex> aLock(myMutex);
+  myNbCompleted  = 0;
+  myNbCancelled  = 0;
+  myNbPauses     = 0;
+  myNbStarted    = 0;
+  myWorkerTime   = 0.0;
+  myIdleTime     = 0.0;
+  myMaxSliceTime = 0.0;
+  myWaitSum      = 0.0;
+}
+
+// ================================================================
+// Function : FormatMetrics
+// ================================================================
+TCollection_AsciiString OcctIdleScheduler::FormatMetrics() const
+{
+  const Metrics aMetrics = GetMetrics();
+  return TCollection_AsciiString()
+       + "Jobs: " + aMetrics.NbPendingJobs + " waiting, " + aMetrics.NbRunningJobs + " running"
+       + "; idle steps: " + aMetrics.NbPendingSteps + " waiting\n"
+       + "Completed: " + int(aMetrics.NbCompleted) + ", cancelled: " + int(aMetrics.NbCancelled)
+       + ", paused by input: " + int(aMetrics.NbPauses) + "\n"
+       + "Worker time: " + aMetrics.WorkerTime + " s, idle steps time: " + aMetrics.IdleTime + " s"
+       + " (max slice: " + (aMetrics.MaxSliceTime * 1000.0) + " ms)\n"
+       + "Wait time: " + (aMetrics.AvgWaitTime * 1000.0) + " ms average";
+}
@@ -0,0 +1,259 @@
+// Copyright (c) 2026 Kirill Gavrilov
+
+#ifndef _OcctIdleScheduler_HeaderFile
+#define _OcctIdleScheduler_HeaderFile
+
+#include <TCollection_AsciiString.hxx>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//! Scheduler of low-priority work (selection BVH prebuilds, mesh refinement, hidden line removal,
+//! cache writes, thumbnails) running only while the viewer is idle or has spare frame budget.
+//!
+//! Two kinds of tasks are supported:
+//! - idle steps executed by GUI thread in short slices by RunIdleSteps() - for work touching AIS context or view;
+//! - jobs executed by pool of worker threads, optionally followed by idle step applying their result in GUI thread.
+//! Tasks are taken in order of priority, and in posting order within the same priority.
+//!
+//! The viewer pauses scheduler on user input (Pause()) and resumes it once input settles for IdleDelay() (Resume()).
+//! Paused scheduler starts neither jobs nor idle steps, while long jobs are expected to call JobContext::Yield()
+//! regularly - it blocks the worker while scheduler is paused and returns FALSE if the job has been cancelled.
+class OcctIdleScheduler
+{
+public:
+
+  //! Task priority.
+  enum Priority
+  {
+    Priority_Low,
+    Priority_Normal,
+    Priority_High,
+  };
+
+  //! Task metrics.
+  struct Metrics
+  {
+    int      NbPendingJobs  = 0;   //!< jobs waiting for worker
+    int      NbRunningJobs  = 0;   //!< jobs being executed by workers
+    int      NbPendingSteps = 0;   //!< idle steps waiting for GUI thread
+    uint64_t NbCompleted    = 0;   //!< number of finished tasks
+    uint64_t NbCancelled    = 0;   //!< number of cancelled tasks
+    uint64_t NbPauses       = 0;   //!< number of pauses caused by input
+    double   WorkerTime     = 0.0; //!< total time spent by workers in jobs in seconds
+    double   IdleTime       = 0.0; //!< total time spent by GUI thread in idle steps in seconds
+    double   MaxSliceTime   = 0.0; //!< maximum duration of idle steps slice in seconds
+    double   AvgWaitTime    = 0.0; //!< average time from posting to start of task in seconds
+  };
+
+protected:
+
+  struct Task;
+
+public:
+
+  //! Context of the job passed to worker thread.
+  class JobContext
+  {
+    friend class OcctIdleScheduler;
+  public:
+
+    //! Return task id.
+    int Id() const;
+
+    //! Return TRUE if job has been cancelled and should return as soon as possible.
+    bool IsCancelled() const;
+
+    //! Wait while scheduler is paused by user input.
+    //! @return FALSE if job has been cancelled
+    bool Yield();
+
+  private:
+
+    JobContext(OcctIdleScheduler* theScheduler, const std::shared_ptr<Task>& theTask)
+    : myScheduler(theScheduler), myTask(theTask) {}
+
+  private:
+
+    OcctIdleScheduler*    myScheduler;
+    std::shared_ptr<Task> myTask;
+  };
+
+  //! Job executed by worker thread.
+  typedef std::function<void(JobContext& theCtx)> Job;
+
+  //! Step executed by GUI thread; should return TRUE if more steps remain.
+  typedef std::function<bool()> IdleStep;
+
+public:
+
+  //! Empty constructor.
+  OcctIdleScheduler();
+
+  //! Destructor, cancels tasks and stops workers.
+  ~OcctIdleScheduler() { Stop(); }
+
+  //! Return number of worker threads (a quarter of hardware threads by default).
+  int NbWorkers() const { return myNbWorkers; }
+
+  //! Set number of worker threads; should be set before posting the first job.
+  void SetNbWorkers(int theNbWorkers) { myNbWorkers = theNbWorkers; }
+
+  //! Return time without input after which scheduler is resumed in seconds (0.3 by default).
+  double IdleDelay() const { return myIdleDelay; }
+
+  //! Set time without input after which scheduler is resumed.
+  void SetIdleDelay(double theSeconds) { myIdleDelay = theSeconds; }
+
+  //! Return time budget of idle steps slice executed from idle callback in seconds (0.005 by default).
+  double SliceBudget() const { return mySliceBudget; }
+
+  //! Set time budget of idle steps slice.
+  void SetSliceBudget(double theSeconds) { mySliceBudget = theSeconds; }
+
+  //! Return frame time in seconds (0.012 by default) - idle steps may use the rest of this time
+  //! after rendering an animated frame, so that continuous animations don't block idle work.
+  double FrameBudget() const { return myFrameBudget; }
+
+  //! Set frame time which may be shared with idle steps.
+  void SetFrameBudget(double theSeconds) { myFrameBudget = theSeconds; }
+
+  //! Set callback called when idle step is posted, including steps posted by worker thread on job completion;
+  //! the callback should wake up GUI thread to call RunIdleSteps().
+  void SetWakeCallback(const std::function<void()>& theCallback)
+  {
+    std::lock_guard<std::mutex> aLock(myMutex);
+    myWakeCallback = theCallback;
+  }
+
+public: //! @name posting tasks (GUI thread)
+
+  //! Post step executed by GUI thread while viewer is idle; the step is called again while it returns TRUE.
+  //! @return task id
+  int PostIdle(const TCollection_AsciiString& theName,
+               Priority thePriority,
+               const IdleStep& theStep);
+
+  //! Post job executed by worker thread while viewer is idle.
+  //! @param[in] theDone optional step executed by GUI thread after job completion (skipped if job has been cancelled)
+  //! @return task id
+  int PostJob(const TCollection_AsciiString& theName,
+              Priority thePriority,
+              const Job& theJob,
+              const IdleStep& theDone = IdleStep());
+
+  //! Cancel waiting or running task; running job is notified via JobContext::IsCancelled().
+  //! @return FALSE if task is unknown or already finished
+  bool Cancel(int theId);
+
+  //! Cancel all tasks.
+  void CancelAll();
+
+  //! Cancel all tasks and wait for workers to finish.
+  void Stop();
+
+public: //! @name viewer interface (GUI thread)
+
+  //! Pause tasks on user input.
+  void Pause();
+
+  //! Resume tasks once input settles.
+  void Resume();
+
+  //! Return TRUE if scheduler has been paused.
+  bool IsPaused() const
+  {
+    std::lock_guard<std::mutex> aLock(myMutex);
+    return myIsPaused;
+  }
+
+  //! Return TRUE if idle steps are waiting for GUI thread.
+  bool HasIdleSteps() const;
+
+  //! Execute waiting idle steps in order of priority within specified time budget.
+  //! Step exceeding budget is not interrupted, so that steps should be kept short.
+  //! @return TRUE if more steps remain and scheduler is not paused
+  bool RunIdleSteps(double theBudget);
+
+  //! Return task metrics.
+  Metrics GetMetrics() const;
+
+  //! Reset counters and timings.
+  void ResetMetrics();
+
+  //! Format metrics as multi-line text.
+  TCollection_AsciiString FormatMetrics() const;
+
+protected:
+
+  //! Task definition.
+  struct Task
+  {
+    int                     Id = 0;
+    TCollection_AsciiString Name;
+    Priority                Prio = Priority_Normal;
+    Job                     Func;                 //!< job for worker thread, empty for idle step
+    IdleStep                Step;                 //!< idle step or step applying job result
+    std::atomic<bool>       IsCancelled { false };
+    bool                    IsStarted = false;
+    std::chrono::steady_clock::time_point PostTime;
+  };
+
+  //! Queue of tasks of the same priority.
+  typedef std::deque<std::shared_ptr<Task>> TaskQueue;
+
+protected:
+
+  //! Create new task and register it; should be called under lock.
+  std::shared_ptr<Task> createTask(const TCollection_AsciiString& theName, Priority thePriority);
+
+  //! Take the first task of the highest priority; should be called under lock.
+  static std::shared_ptr<Task> popTask(TaskQueue* theQueues);
+
+  //! Count tasks within queues; should be called under lock.
+  static int countTasks(const TaskQueue* theQueues);
+
+  //! Account waiting time of the task starting its execution; should be called under lock.
+  void startTask(Task& theTask);
+
+  //! Worker thread loop.
+  void workerLoop();
+
+protected:
+
+  mutable std::mutex      myMutex;
+  std::condition_variable myCondition;     //!< wakes up workers on new jobs, resuming, cancellation and stop
+  TaskQueue               myJobs [Priority_High + 1]; //!< jobs waiting for worker per priority
+  TaskQueue               mySteps[Priority_High + 1]; //!< idle steps waiting for GUI thread per priority
+  std::map<int, std::shared_ptr<Task>> myTasks;       //!< waiting and running tasks by id
+  std::vector<std::thread> myWorkers;      //!< worker threads started on the first job
+  std::function<void()>   myWakeCallback;
+  int                     myNbWorkers   = 1;
+  int                     myLastId      = 0;
+  int                     myNbRunning   = 0;
+  bool                    myIsPaused    = false;
+  bool                    myToStop      = false;
+  double                  myIdleDelay   = 0.3;
+  double                  mySliceBudget = 0.005;
+  double                  myFrameBudget = 0.012;
+
+  uint64_t myNbCompleted  = 0;
+  uint64_t myNbCancelled  = 0;
+  uint64_t myNbPauses     = 0;
+  uint64_t myNbStarted    = 0;
+  double   myWorkerTime   = 0.0;
+  double   myIdleTime     = 0.0;
+  double   myMaxSliceTime = 0.0;
+  double   myWaitSum      = 0.0;
+
+};
+
+#endif // _OcctIdleScheduler_HeaderFile
@@ -0,0 +1,192 @@
+// Copyright (c) 2026 Kirill Gavrilov
+
+#include "OcctInputPredictor.h"
+
+#include <Message.hxx>
+#include <OSD_OpenFile.hxx>
+
+#include <algorithm>
+
+// ================================================================
+// Function : AddSample
+// ================================================================
+void OcctInputPredictor::AddSample(double theTime, const Graphic3d_Vec2d& thePnt)
+{
+  Sample aSample;
+  aSample.Time = theTime;
+  aSample.Pnt  = thePnt;
+  evaluate(aSample);
+
+  mySamples.push_back(aSample);
+  while (mySamples.size() > 2
+      && (mySamples.size() > 16
+       || mySamples.front().Time < theTime - myFitWindow))
+  {
+    mySamples.pop_front();
+  }
+}
+
+// ================================================================
+// Function : Predict
+// ================================================================
+bool OcctInputPredictor::Predict(double theNow, double theTargetTime, Graphic3d_Vec2d& thePnt)
+{
+  if (mySamples.size() < 2)
+    return false;
+
+  const Sample& aLast = mySamples.back();
+  if (theNow - aLast.Time > myFitWindow)
+    return false; // pointer is not moving
+
+  // least squares fit of velocity over samples within the window
+  double aMeanTime = 0.0;
+  Graphic3d_Vec2d aMeanPnt;
+  int aNbSamples = 0;
+  for (const Sample& aSample : mySamples)
+  {
+    if (aSample.Time < aLast.Time - myFitWindow)
+      continue;
+
+    aMeanTime += aSample.Time - aLast.Time;
+    aMeanPnt  += aSample.Pnt;
+    ++aNbSamples;
+  }
+  if (aNbSamples < 2)
+    return false;
+
+  aMeanTime /= double(aNbSamples);
+  aMeanPnt  /= double(aNbSamples);
+  double aSumTT = 0.0;
+  Graphic3d_Vec2d aSumTP;
+  for (const Sample& aSample : mySamples)
+  {
+    if (aSample.Time < aLast.Time - myFitWindow)
+      continue;
+
+    const double aDT = aSample.Time - aLast.Time - aMeanTime;
+    aSumTT += aDT * aDT;
+    aSumTP += (aSample.Pnt - aMeanPnt) * aDT;
+  }
+  if (aSumTT <= 0.0)
+    return false;
+
+  const Graphic3d_Vec2d aVelocity = aSumTP / aSumTT;
+  const double aHorizon = std::min(std::max(theTargetTime - aLast.Time, 0.0), myMaxHorizon);
+
+  Prediction aPred;
+  aPred.Time       = theNow;
+  aPred.TargetTime = theTargetTime;
+  aPred.Raw        = aLast.Pnt;
+  aPred.Predicted  = aLast.Pnt + aVelocity * aHorizon;
+  aPred.IsApplied  = myIsEnabled && !myIsFallback;
+  myPending.push_back(aPred);
+  if (myPending.size() > 32)
+    myPending.pop_front();
+
+  thePnt = aPred.Predicted;
+  return aPred.IsApplied;
+}
+
+// ================================================================
+// Function : evaluate
+// ================================================================
+void OcctInputPredictor::evaluate(const Sample& theSample)
+{
+  if (mySamples.empty())
+    return;
+
+  const Sample& aPrev = mySamples.back();
+  while (!myPending.empty()
+       && myPending.front().TargetTime <= theSample.Time)
+  {
+    const Prediction& aPred = myPending.front();
+
+    // real position at target time interpolated between two samples
+    const double aDuration = theSample.Time - aPrev.Time;
+    const double aRatio = aDuration > 0.0 ? std::min(std::max((aPred.TargetTime - aPrev.Time) / aDuration, 0.0), 1.0) : 1.0;
+    const Graphic3d_Vec2d anActual = aPrev.Pnt + (theSample.Pnt - aPrev.Pnt) * aRatio;
+    const double anErrRaw  = (aPred.Raw - anActual).Modulus();
+    const double anErrPred = (aPred.Predicted - anActual).Modulus();
+
+    ++myNbEvaluated;
+    ++myGestureNbEvaluated;
+    mySumErrorRaw  += anErrRaw;
+    mySumErrorPred += anErrPred;
+    myEmaErrorRaw  = myEmaErrorRaw  * 0.8 + anErrRaw  * 0.2;
+    myEmaErrorPred = myEmaErrorPred * 0.8 + anErrPred * 0.2;
+    if (myGestureNbEvaluated >= 4)
+    {
+      // fallback to raw input while prediction makes things worse (with hysteresis)
+      if (!myIsFallback && myEmaErrorPred > myEmaErrorRaw)
+      {
+        myIsFallback = true;
+        Message::SendTrace() << "OcctInputPredictor: fallback to raw input";
+      }
+      else if (myIsFallback && myEmaErrorPred < myEmaErrorRaw * 0.75)
+      {
+        myIsFallback = false;
+      }
+    }
+
+    if (myTraceFile.is_open())
+    {
+      if (myTraceTimeOrigin < 0.0)
+        myTraceTimeOrigin = aPred.Time;
+
+      myTraceFile << (aPred.Time - myTraceTimeOrigin) << "," << (aPred.TargetTime - aPred.Time) << ","
+                  << aPred.Raw.x() << "," << aPred.Raw.y() << ","
+                  << aPred.Predicted.x() << "," << aPred.Predicted.y() << ","
+                  << anActual.x() << "," << anActual.y() << ","
+                  << anErrRaw << "," << anErrPred << "," << (aPred.IsApplied ? 1 : 0) << "\n";
+    }
+    myPending.pop_front();
+  }
+}
+
+// ================================================================
+// Function : Reset
+// ================================================================
+void OcctInputPredictor::Reset()
+{
+  if (myGestureNbEvaluated > 0)
+  {
+    Message::SendTrace() << "OcctInputPredictor: " << myNbEvaluated << " evaluated frames, mean error at presentation time "
+                         << MeanErrorRaw() << " px raw, " << MeanErrorPredicted() << " px predicted";
+  }
+
+  mySamples.clear();
+  myPending.clear();
+  myEmaErrorRaw  = 0.0;
+  myEmaErrorPred = 0.0;
+  myGestureNbEvaluated = 0;
+  myIsFallback = false;
+  if (myTraceFile.is_open())
+    myTraceFile.flush();
+}
+
+// ================================================================
+// Function : OpenTrace
+// ================================================================
+bool OcctInputPredictor::OpenTrace(const TCollection_AsciiString& thePath)
+{
+  CloseTrace();
+  OSD_OpenStream(myTraceFile, thePath.ToCString(), std::ios::out | std::ios::trunc);
+  if (!myTraceFile.is_open())
+  {
+    Message::SendFail() << "Error: unable to create latency trace file '" << thePath << "'";
+    return false;
+  }
+
+  myTraceTimeOrigin = -1.0;
+  myTraceFile << "time,latency,raw_x,raw_y,predicted_x,predicted_y,actual_x,actual_y,error_raw,error_predicted,applied\n";
+  return true;
+}
+
+// ================================================================
+// Function : CloseTrace
+// ================================================================
+void OcctInputPredictor::CloseTrace()
+{
+  if (myTraceFile.is_open())
+    myTraceFile.close();
+}
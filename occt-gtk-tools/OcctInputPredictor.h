@@ -0,0 +1,141 @@
+// Copyright (c) 2026 Kirill Gavrilov
+
+#ifndef _OcctInputPredictor_HeaderFile
+#define _OcctInputPredictor_HeaderFile
+
+#include <Graphic3d_Vec.hxx>
+#include <TCollection_AsciiString.hxx>
+
+#include <deque>
+#include <fstream>
+
+//! Pointer (mouse or single touch) position predictor hiding rendering latency of dragging gestures.
+//!
+//! Pointer velocity is fitted by linear least squares over samples within FitWindow(),
+//! and position is extrapolated from the last sample to the expected presentation time of the rendered frame
+//! (but not further than MaxHorizon()). AIS_ViewController maps pointer position to camera absolutely
+//! (relative to the gesture start), so that predicted position fed before the frame should be replaced by the last real one
+//! after the frame is rendered - otherwise overshoot would be kept when pointer stops.
+//!
+//! Each prediction is evaluated when real samples pass its target time:
+//! the error of predicted position and of the last known (raw) position against interpolated real position
+//! are accumulated for statistics and optional CSV trace.
+//! When prediction becomes worse than raw position (erratic movement), predictor falls back to raw input
+//! until prediction error gets lower again.
+class OcctInputPredictor
+{
+public:
+
+  //! Empty constructor.
+  OcctInputPredictor() {}
+
+  //! Destructor.
+  ~OcctInputPredictor() { CloseTrace(); }
+
+  //! Return TRUE if predicted positions should be applied (FALSE by default).
+  bool IsEnabled() const { return myIsEnabled; }
+
+  //! Enable/disable applying predicted positions; samples are still evaluated for statistics and trace.
+  void SetEnabled(bool theToEnable) { myIsEnabled = theToEnable; }
+
+  //! Return TRUE if samples should be collected (prediction is enabled or trace file is opened).
+  bool IsActive() const { return myIsEnabled || myTraceFile.is_open(); }
+
+  //! Return TRUE if predictor has fallen back to raw input.
+  bool IsFallback() const { return myIsFallback; }
+
+  //! Return maximum extrapolation time in seconds (0.05 by default).
+  double MaxHorizon() const { return myMaxHorizon; }
+
+  //! Set maximum extrapolation time in seconds.
+  void SetMaxHorizon(double theSeconds) { myMaxHorizon = theSeconds; }
+
+  //! Return time window for velocity fitting in seconds (0.05 by default);
+  //! pointer is considered stopped when no samples came within this window.
+  double FitWindow() const { return myFitWindow; }
+
+  //! Set time window for velocity fitting in seconds.
+  void SetFitWindow(double theSeconds) { myFitWindow = theSeconds; }
+
+  //! Return smoothed frame rendering duration in seconds.
+  double FrameDuration() const { return myFrameDuration; }
+
+  //! Add measured frame rendering duration.
+  void AddFrameDuration(double theSeconds)
+  {
+    myFrameDuration = myFrameDuration > 0.0 ? myFrameDuration * 0.9 + theSeconds * 0.1 : theSeconds;
+  }
+
+  //! Add new pointer sample.
+  //! @param[in] theTime time in seconds
+  //! @param[in] thePnt  pointer position in pixels
+  void AddSample(double theTime, const Graphic3d_Vec2d& thePnt);
+
+  //! Predict pointer position.
+  //! @param[in] theNow        current time in seconds
+  //! @param[in] theTargetTime expected presentation time in seconds
+  //! @param[out] thePnt       predicted position
+  //! @return FALSE if predicted position should not be applied (disabled, fallback or pointer is not moving)
+  bool Predict(double theNow, double theTargetTime, Graphic3d_Vec2d& thePnt);
+
+  //! Finish gesture - clear samples and print statistics.
+  void Reset();
+
+  //! Open CSV file for tracing evaluated predictions (path is UTF-8 encoded).
+  bool OpenTrace(const TCollection_AsciiString& thePath);
+
+  //! Close trace file.
+  void CloseTrace();
+
+  //! Return number of evaluated predictions.
+  int NbEvaluated() const { return myNbEvaluated; }
+
+  //! Return mean error of raw (last known) position at presentation time in pixels.
+  double MeanErrorRaw() const { return myNbEvaluated > 0 ? mySumErrorRaw / myNbEvaluated : 0.0; }
+
+  //! Return mean error of predicted position at presentation time in pixels.
+  double MeanErrorPredicted() const { return myNbEvaluated > 0 ? mySumErrorPred / myNbEvaluated : 0.0; }
+
+protected:
+
+  //! Pointer sample.
+  struct Sample
+  {
+    double          Time = 0.0;
+    Graphic3d_Vec2d Pnt;
+  };
+
+  //! Prediction waiting for evaluation.
+  struct Prediction
+  {
+    double          Time       = 0.0;   //!< time of prediction
+    double          TargetTime = 0.0;   //!< expected presentation time
+    Graphic3d_Vec2d Raw;                //!< last known position
+    Graphic3d_Vec2d Predicted;          //!< predicted position
+    bool            IsApplied  = false; //!< flag indicating that prediction has been applied
+  };
+
+  //! Evaluate pending predictions with target time before the new sample.
+  void evaluate(const Sample& theSample);
+
+protected:
+
+  std::deque<Sample>     mySamples;
+  std::deque<Prediction> myPending;
+  std::ofstream          myTraceFile;
+  double myTraceTimeOrigin = -1.0;
+  double myMaxHorizon      = 0.05;
+  double myFitWindow       = 0.05;
+  double myFrameDuration   = 0.0;
+  double myEmaErrorRaw     = 0.0;  //!< exponentially smoothed raw error for fallback decision
+  double myEmaErrorPred    = 0.0;  //!< exponentially smoothed prediction error for fallback decision
+  double mySumErrorRaw     = 0.0;
+  double mySumErrorPred    = 0.0;
+  int    myNbEvaluated     = 0;
+  int    myGestureNbEvaluated = 0;
+  bool   myIsEnabled       = false;
+  bool   myIsFallback      = false;
+
+};
+
+#endif // _OcctInputPredictor_HeaderFile
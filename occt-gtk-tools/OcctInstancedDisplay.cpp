@@ -0,0 +1,806 @@
+// Copyright (c) 2026 Kirill Gavrilov
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+#include "OcctInstancedDisplay.h"
+
+#include <AIS_Shape.hxx>
+#include <BRep_Tool.hxx>
+#include <BRepLib_ToolTriangulatedShape.hxx>
+#include <BRepPrimAPI_MakeBox.hxx>
+#include <Graphic3d_ArrayOfTriangles.hxx>
+#include <Graphic3d_FrameStatsData.hxx>
+#include <Graphic3d_ShaderAttribute.hxx>
+#include <Graphic3d_ShaderObject.hxx>
+#include <Message.hxx>
+#include <OpenGl_Context.hxx>
+#include <OpenGl_Element.hxx>
+#include <OpenGl_Group.hxx>
+#include <OpenGl_IndexBuffer.hxx>
+#include <OpenGl_ShaderManager.hxx>
+#include <OpenGl_ShaderProgram.hxx>
+#include <OpenGl_VertexBuffer.hxx>
+#include <OpenGl_Workspace.hxx>
+#include <OSD_Timer.hxx>
+#include <Prs3d_ShadingAspect.hxx>
+#include <Select3D_SensitiveTriangulation.hxx>
+#include <SelectMgr_SelectingVolumeManager.hxx>
+#include <SelectMgr_Selection.hxx>
+#include <StdPrs_ToolTriangulatedShape.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopoDS.hxx>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+  //! Vertex shader applying per-instance transformation passed as 4 matrix columns.
+  static const char THE_INSTANCED_VERT_SHADER[] =
+    "THE_ATTRIBUTE vec4 instanceCol0;\n"
+    "THE_ATTRIBUTE vec4 instanceCol1;\n"
+    "THE_ATTRIBUTE vec4 instanceCol2;\n"
+    "THE_ATTRIBUTE vec4 instanceCol3;\n"
+    "THE_SHADER_OUT vec3 Normal;\n"
+    "THE_SHADER_OUT vec4 PositionWorld;\n"
+    "void main()\n"
+    "{\n"
+    "  mat4 anInstance = mat4 (instanceCol0, instanceCol1, instanceCol2, instanceCol3);\n"
+    "  PositionWorld = occModelWorldMatrix * anInstance * occVertex;\n"
+    "  Normal = (occWorldViewMatrix * occModelWorldMatrix * anInstance * vec4 (occNormal, 0.0)).xyz;\n"
+    "  gl_Position = occProjectionMatrix * occWorldViewMatrix * PositionWorld;\n"
+    "}\n";
+
+  //! Fragment shader applying clipping planes (in the same way as built-in programs)
+  //! and shading by material with ambient and single directional light passed as uniforms.
+  static const char THE_INSTANCED_FRAG_SHADER[] =
+    "uniform vec3 instanceAmbient;\n"
+    "uniform vec4 instanceLightDir;\n"
+    "uniform vec3 instanceLightColor;\n"
+    "THE_SHADER_IN vec3 Normal;\n"
+    "THE_SHADER_IN vec4 PositionWorld;\n"
+    "void main()\n"
+    "{\n"
+    "#if defined(THE_MAX_CLIP_PLANES) && (THE_MAX_CLIP_PLANES > 0)\n"
+    "  for (int aPlaneIter = 0; aPlaneIter < occClipPlaneCount;)\n"
+    "  {\n"
+    "    vec4 anEquation = occClipPlaneEquations[aPlaneIter];\n"
+    "    if (dot (anEquation.xyz, PositionWorld.xyz / PositionWorld.w) + anEquation.w < 0.0)\n"
+    "    {\n"
+    "      if (occClipPlaneChains[aPlaneIter] == 1)\n"
+    "      {\n"
+    "        discard;\n"
+    "      }\n"
+    "      aPlaneIter += 1;\n"
+    "    }\n"
+    "    else\n"
+    "    {\n"
+    "      aPlaneIter += occClipPlaneChains[aPlaneIter];\n"
+    "    }\n"
+    "  }\n"
+    "#endif\n"
+    "  vec3 aNorm = normalize (gl_FrontFacing ? Normal : -Normal);\n"
+    "  vec4 aDiffuse  = occMaterial_Diffuse (gl_FrontFacing);\n"
+    "  vec3 anEmission = occMaterial_Emission (gl_FrontFacing).rgb;\n"
+    "  vec3 aLightDir = instanceLightDir.w > 0.5 ? instanceLightDir.xyz : (occWorldViewMatrix * vec4 (instanceLightDir.xyz, 0.0)).xyz;\n"
+    "  vec3 aLight = instanceAmbient + instanceLightColor * max (dot (aNorm, normalize (aLightDir)), 0.0);\n"
+    "  occSetFragColor (vec4 (anEmission + aDiffuse.rgb * aLight, aDiffuse.a));\n"
+    "}\n";
+
+  //! Release GL resource.
+  template<class T>
+  static void releaseResource(OpenGl_Context* theCtx, Handle(T)& theRes)
+  {
+    if (theRes.IsNull())
+      return;
+
+    if (theCtx != NULL)
+      theCtx->DelayedRelease(theRes);
+    theRes.Nullify();
+  }
+
+  //! OpenGL element drawing prototype triangulation for all instances by single instanced draw call.
+  //! Prototype is uploaded into VBOs on the first rendering, and instance matrices into per-instance attribute VBO.
+  class OcctInstancedElement : public OpenGl_Element
+  {
+  public:
+
+    //! Main constructor.
+    OcctInstancedElement(const Handle(Poly_Triangulation)& theTris,
+                         const NCollection_Vector<gp_Trsf>& theTrsfs)
+    : myTris(theTris)
+    {
+      myInstances.resize(theTrsfs.Size());
+      for (int anInstIter = 0; anInstIter < theTrsfs.Size(); ++anInstIter)
+      {
+        Graphic3d_Mat4d aMat;
+        theTrsfs.Value(anInstIter).GetMat4(aMat);
+        for (int aRowIter = 0; aRowIter < 4; ++aRowIter)
+        {
+          for (int aColIter = 0; aColIter < 4; ++aColIter)
+            myInstances[anInstIter].SetValue(aRowIter, aColIter, float(aMat.GetValue(aRowIter, aColIter)));
+        }
+      }
+    }
+
+    //! Render all instances.
+    virtual void Render(const Handle(OpenGl_Workspace)& theWorkspace) const override
+    {
+      const Handle(OpenGl_Context)& aCtx = theWorkspace->GetGlContext();
+      if (myInstances.empty()
+      || !initBuffers(aCtx))
+      {
+        return;
+      }
+
+      const OpenGl_Aspects* anAspect = theWorkspace->ApplyAspects();
+      const Handle(OpenGl_ShaderProgram)& aProgram = anAspect->ShaderProgramRes(aCtx);
+      if (aProgram.IsNull()
+      || !aCtx->ShaderManager()->BindFaceProgram(Handle(OpenGl_TextureSet)(), Graphic3d_TOSM_UNLIT,
+                                                 anAspect->Aspect()->AlphaMode(), false, false, aProgram))
+      {
+        return;
+      }
+      setLightUniforms(aCtx, aProgram);
+
+      myPosVbo ->BindAttribute(aCtx, Graphic3d_TOA_POS);
+      myNormVbo->BindAttribute(aCtx, Graphic3d_TOA_NORM);
+      myIndexVbo->Bind(aCtx);
+      const GLsizei aNbIndices = GLsizei(myIndexVbo->GetElemsNb());
+      if (aCtx->core33 != NULL)
+      {
+        // matrix columns are fetched once per instance
+        myInstanceVbo->Bind(aCtx);
+        for (int aColIter = 0; aColIter < 4; ++aColIter)
+        {
+          const GLuint anAttrib = GLuint(Graphic3d_TOA_CUSTOM + aColIter);
+          aCtx->core33->glEnableVertexAttribArray(anAttrib);
+          aCtx->core33->glVertexAttribPointer(anAttrib, 4, GL_FLOAT, GL_FALSE, sizeof(Graphic3d_Mat4),
+                                              (const GLvoid* )(sizeof(Graphic3d_Vec4) * aColIter));
+          aCtx->core33->glVertexAttribDivisor(anAttrib, 1);
+        }
+        aCtx->core33->glDrawElementsInstanced(GL_TRIANGLES, aNbIndices, GL_UNSIGNED_INT, NULL, GLsizei(myInstances.size()));
+        for (int aColIter = 0; aColIter < 4; ++aColIter)
+        {
+          const GLuint anAttrib = GLuint(Graphic3d_TOA_CUSTOM + aColIter);
+          aCtx->core33->glVertexAttribDivisor(anAttrib, 0);
+          aCtx->core33->glDisableVertexAttribArray(anAttrib);
+        }
+        myInstanceVbo->Unbind(aCtx);
+      }
+      else
+      {
+        // no instanced arrays - matrix is passed as constant attribute values of each draw call
+        for (const Graphic3d_Mat4& aMat : myInstances)
+        {
+          for (int aColIter = 0; aColIter < 4; ++aColIter)
+            aCtx->core20fwd->glVertexAttrib4fv(GLuint(Graphic3d_TOA_CUSTOM + aColIter), aMat.GetData() + aColIter * 4);
+          aCtx->core20fwd->glDrawElements(GL_TRIANGLES, aNbIndices, GL_UNSIGNED_INT, NULL);
+        }
+      }
+      myIndexVbo->Unbind(aCtx);
+      myNormVbo->UnbindAttribute(aCtx, Graphic3d_TOA_NORM);
+      myPosVbo ->UnbindAttribute(aCtx, Graphic3d_TOA_POS);
+    }
+
+    //! Release GL resources.
+    virtual void Release(OpenGl_Context* theCtx) override { releaseBuffers(theCtx); }
+
+    //! Element is drawn as filled triangles.
+    virtual bool IsFillDrawMode() const override { return true; }
+
+    //! Return GPU memory: prototype is uploaded once, and 64 bytes per instance.
+    virtual size_t EstimatedDataSize() const override
+    {
+      return size_t(myTris->NbNodes()) * sizeof(Graphic3d_Vec3) * 2
+           + size_t(myTris->NbTriangles()) * 3 * sizeof(unsigned int)
+           + myInstances.size() * sizeof(Graphic3d_Mat4);
+    }
+
+    //! Update memory statistics.
+    virtual void UpdateMemStats(Graphic3d_FrameStatsDataTmp& theStats) const override
+    {
+      theStats[Graphic3d_FrameStatsCounter_EstimatedBytesGeom] += EstimatedDataSize();
+    }
+
+    //! Update drawing statistics.
+    virtual void UpdateDrawStats(Graphic3d_FrameStatsDataTmp& theStats,
+                                 bool theIsDetailed) const override
+    {
+      ++theStats[Graphic3d_FrameStatsCounter_NbElemsNotCulled];
+      ++theStats[Graphic3d_FrameStatsCounter_NbElemsFillNotCulled];
+      if (theIsDetailed)
+        theStats[Graphic3d_FrameStatsCounter_NbTrianglesNotCulled] += size_t(myTris->NbTriangles()) * myInstances.size();
+    }
+
+  private:
+
+    //! Upload prototype and instance matrices on the first rendering.
+    bool initBuffers(const Handle(OpenGl_Context)& theCtx) const
+    {
+      if (!myIndexVbo.IsNull())
+        return true;
+      else if (myIsInitFailed)
+        return false;
+
+      const int aNbNodes = myTris->NbNodes(), aNbTris = myTris->NbTriangles();
+      std::vector<Graphic3d_Vec3> aPnts(aNbNodes), aNorms(aNbNodes);
+      for (int aNodeIter = 0; aNodeIter < aNbNodes; ++aNodeIter)
+      {
+        const gp_Pnt aPnt = myTris->Node(aNodeIter + 1);
+        const gp_Dir aNorm = myTris->Normal(aNodeIter + 1);
+        aPnts [aNodeIter] = Graphic3d_Vec3(float(aPnt.X()),  float(aPnt.Y()),  float(aPnt.Z()));
+        aNorms[aNodeIter] = Graphic3d_Vec3(float(aNorm.X()), float(aNorm.Y()), float(aNorm.Z()));
+      }
+      std::vector<GLuint> anIndices(aNbTris * 3);
+      for (int aTriIter = 0; aTriIter < aNbTris; ++aTriIter)
+      {
+        int aNodes[3] = { 0, 0, 0 };
+        myTris->Triangle(aTriIter + 1).Get(aNodes[0], aNodes[1], aNodes[2]);
+        for (int aNodeIter = 0; aNodeIter < 3; ++aNodeIter)
+          anIndices[aTriIter * 3 + aNodeIter] = GLuint(aNodes[aNodeIter] - 1);
+      }
+
+      myPosVbo      = new OpenGl_VertexBuffer();
+      myNormVbo     = new OpenGl_VertexBuffer();
+      myIndexVbo    = new OpenGl_IndexBuffer();
+      myInstanceVbo = new OpenGl_VertexBuffer();
+      if (aNbTris == 0
+      || !myPosVbo     ->Init(theCtx, 3, aNbNodes, aPnts.front().GetData())
+      || !myNormVbo    ->Init(theCtx, 3, aNbNodes, aNorms.front().GetData())
+      || !myIndexVbo   ->Init(theCtx, 1, aNbTris * 3, anIndices.data())
+      || !myInstanceVbo->Init(theCtx, 4, GLsizei(myInstances.size() * 4), myInstances.front().GetData()))
+      {
+        Message::SendFail() << "Error: unable to upload instanced geometry";
+        releaseBuffers(theCtx.get());
+        myIsInitFailed = true;
+        return false;
+      }
+      return true;
+    }
+
+    //! Release VBOs.
+    void releaseBuffers(OpenGl_Context* theCtx) const
+    {
+      releaseResource(theCtx, myPosVbo);
+      releaseResource(theCtx, myNormVbo);
+      releaseResource(theCtx, myIndexVbo);
+      releaseResource(theCtx, myInstanceVbo);
+    }
+
+    //! Pass ambient and the first directional light of the view to the program.
+    static void setLightUniforms(const Handle(OpenGl_Context)& theCtx,
+                                 const Handle(OpenGl_ShaderProgram)& theProgram)
+    {
+      Graphic3d_Vec3 anAmbient(0.0f), aLightColor(0.0f);
+      Graphic3d_Vec4 aLightDir(0.0f, 0.0f, 1.0f, 1.0f);
+      bool hasDirectional = false;
+      const Handle(Graphic3d_LightSet)& aLights = theCtx->ShaderManager()->LightSourceState().LightSources();
+      if (!aLights.IsNull())
+      {
+        for (Graphic3d_LightSet::Iterator aLightIter(aLights, Graphic3d_LightSet::IterationFilter_ExcludeDisabled);
+             aLightIter.More(); aLightIter.Next())
+        {
+          const Handle(Graphic3d_CLight)& aLight = aLightIter.Value();
+          const Graphic3d_Vec3 aColor = aLight->Color().Rgb() * float(aLight->Intensity());
+          if (aLight->Type() == Graphic3d_TOLS_AMBIENT)
+          {
+            anAmbient += aColor;
+          }
+          else if (aLight->Type() == Graphic3d_TOLS_DIRECTIONAL
+               && !hasDirectional)
+          {
+            // direction to the light; headlight direction is defined in view space
+            const gp_Dir aDir = aLight->Direction();
+            aLightDir = Graphic3d_Vec4(-float(aDir.X()), -float(aDir.Y()), -float(aDir.Z()), aLight->IsHeadlight() ? 1.0f : 0.0f);
+            aLightColor = aColor;
+            hasDirectional = true;
+          }
+        }
+      }
+      theProgram->SetUniform(theCtx, "instanceAmbient",    anAmbient);
+      theProgram->SetUniform(theCtx, "instanceLightDir",   aLightDir);
+      theProgram->SetUniform(theCtx, "instanceLightColor", aLightColor);
+    }
+
+  private:
+
+    Handle(Poly_Triangulation)  myTris;
+    std::vector<Graphic3d_Mat4> myInstances;
+    mutable Handle(OpenGl_VertexBuffer) myPosVbo;
+    mutable Handle(OpenGl_VertexBuffer) myNormVbo;
+    mutable Handle(OpenGl_IndexBuffer)  myIndexVbo;
+    mutable Handle(OpenGl_VertexBuffer) myInstanceVbo;
+    mutable bool myIsInitFailed = false;
+
+  };
+
+  //! Sensitive entity of a single instance testing shared prototype entity
+  //! against selecting volume transformed into prototype coordinates.
+  class OcctInstanceSensitive : public Select3D_SensitiveEntity
+  {
+    DEFINE_STANDARD_RTTI_INLINE(OcctInstanceSensitive, Select3D_SensitiveEntity)
+  public:
+
+    //! Main constructor.
+    OcctInstanceSensitive(const Handle(SelectMgr_EntityOwner)& theOwner,
+                          const Handle(Select3D_SensitiveEntity)& theProto,
+                          const gp_Trsf& theTrsf)
+    : Select3D_SensitiveEntity(theOwner),
+      myProto(theProto),
+      myTrsf(theTrsf),
+      myInvTrsf(theTrsf.Inverted())
+    {
+      const Select3D_BndBox3d aProtoBox = myProto->BoundingBox();
+      for (int aCornerIter = 0; aCornerIter < 8; ++aCornerIter)
+      {
+        const gp_Pnt aCorner((aCornerIter & 1) != 0 ? aProtoBox.CornerMax().x() : aProtoBox.CornerMin().x(),
+                             (aCornerIter & 2) != 0 ? aProtoBox.CornerMax().y() : aProtoBox.CornerMin().y(),
+                             (aCornerIter & 4) != 0 ? aProtoBox.CornerMax().z() : aProtoBox.CornerMin().z());
+        const gp_Pnt aPnt = aCorner.Transformed(myTrsf);
+        myBox.Add(SelectMgr_Vec3(aPnt.X(), aPnt.Y(), aPnt.Z()));
+      }
+    }
+
+    //! Test prototype against volume transformed by inverse instance transformation.
+    virtual bool Matches(SelectBasics_SelectingVolumeManager& theMgr,
+                         SelectBasics_PickResult& thePickResult) override
+    {
+      const SelectMgr_SelectingVolumeManager& aWorldMgr = static_cast<const SelectMgr_SelectingVolumeManager&>(theMgr);
+      SelectMgr_SelectingVolumeManager anInstMgr = aWorldMgr.ScaleAndTransform(1, myInvTrsf, Handle(SelectMgr_FrustumBuilder)());
+      anInstMgr.SetViewClipping(aWorldMgr.ViewClipping(), aWorldMgr.ObjectClipping(), &aWorldMgr);
+      if (!myProto->Matches(anInstMgr, thePickResult))
+        return false;
+
+      if (thePickResult.HasPickedPoint())
+        thePickResult.SetPickedPoint(thePickResult.PickedPoint().Transformed(myTrsf));
+      const Graphic3d_Vec3& aNorm = thePickResult.SurfaceNormal();
+      thePickResult.SetSurfaceNormal(gp_Vec(aNorm.x(), aNorm.y(), aNorm.z()).Transformed(myTrsf));
+      return true;
+    }
+
+    //! Return number of sub-elements of prototype.
+    virtual int NbSubElements() const override { return myProto->NbSubElements(); }
+
+    //! Return bounding box of the instance.
+    virtual Select3D_BndBox3d BoundingBox() override { return myBox; }
+
+    //! Prototype BVH is built once by OcctInstancedShape::ComputeSelection().
+    virtual bool ToBuildBVH() const override { return false; }
+
+    //! Return center of the instance.
+    virtual gp_Pnt CenterOfGeometry() const override { return myProto->CenterOfGeometry().Transformed(myTrsf); }
+
+  private:
+
+    Handle(Select3D_SensitiveEntity) myProto;
+    gp_Trsf           myTrsf;
+    gp_GTrsf          myInvTrsf;
+    Select3D_BndBox3d myBox;
+
+  };
+
+  //! Highlighting presentation of a single instance.
+  class OcctInstanceHighlight : public AIS_InteractiveObject
+  {
+    DEFINE_STANDARD_RTTI_INLINE(OcctInstanceHighlight, AIS_InteractiveObject)
+  public:
+
+    //! Main constructor.
+    OcctInstanceHighlight(const Handle(Poly_Triangulation)& theTris,
+                          const gp_Trsf& theTrsf)
+    : myTris(theTris), myTrsf(theTrsf) {}
+
+    //! Compute presentation of prototype triangulation; transformation is applied to vertices,
+    //! which is fine for a single highlighted occurrence.
+    virtual void Compute(const Handle(PrsMgr_PresentationManager)& ,
+                         const Handle(Prs3d_Presentation)& thePrs,
+                         const int theMode) override
+    {
+      if (theMode != 0)
+        return;
+
+      const int aNbNodes = myTris->NbNodes(), aNbTris = myTris->NbTriangles();
+      Handle(Graphic3d_ArrayOfTriangles) anArray = new Graphic3d_ArrayOfTriangles(aNbNodes, aNbTris * 3, Graphic3d_ArrayFlags_VertexNormal);
+      for (int aNodeIter = 1; aNodeIter <= aNbNodes; ++aNodeIter)
+      {
+        anArray->AddVertex(myTris->Node(aNodeIter).Transformed(myTrsf), myTris->Normal(aNodeIter).Transformed(myTrsf));
+      }
+      for (int aTriIter = 1; aTriIter <= aNbTris; ++aTriIter)
+      {
+        int aNodes[3] = { 0, 0, 0 };
+        myTris->Triangle(aTriIter).Get(aNodes[0], aNodes[1], aNodes[2]);
+        anArray->AddEdges(aNodes[0], aNodes[1], aNodes[2]);
+      }
+
+      Handle(Graphic3d_Group) aGroup = thePrs->NewGroup();
+      aGroup->SetGroupPrimitivesAspect(myDrawer->ShadingAspect()->Aspect());
+      aGroup->AddPrimitiveArray(anArray);
+    }
+
+    //! Not selectable.
+    virtual void ComputeSelection(const Handle(SelectMgr_Selection)& , const int ) override {}
+
+  private:
+
+    Handle(Poly_Triangulation) myTris;
+    gp_Trsf myTrsf;
+
+  };
+}
+
+// ================================================================
+// Function : OcctInstancedShape
+// ================================================================
+OcctInstancedShape::OcctInstancedShape(const TopoDS_Shape& theShape)
+: myShape(theShape.Located(TopLoc_Location()))
+{
+  SetDisplayMode(AIS_Shaded);
+  StdPrs_ToolTriangulatedShape::Tessellate(myShape, myDrawer);
+
+  // merge faces into single triangulation in prototype coordinates
+  int aNbNodes = 0, aNbTris = 0;
+  for (TopExp_Explorer aFaceIter(myShape, TopAbs_FACE); aFaceIter.More(); aFaceIter.Next())
+  {
+    TopLoc_Location aLoc;
+    const Handle(Poly_Triangulation)& aTris = BRep_Tool::Triangulation(TopoDS::Face(aFaceIter.Current()), aLoc);
+    if (!aTris.IsNull())
+    {
+      aNbNodes += aTris->NbNodes();
+      aNbTris  += aTris->NbTriangles();
+    }
+  }
+
+  if (aNbTris == 0)
+  {
+    myTris = new Poly_Triangulation();
+    return;
+  }
+
+  myTris = new Poly_Triangulation(aNbNodes, aNbTris, false, true);
+  int aNodeOffset = 0, aTriOffset = 0;
+  for (TopExp_Explorer aFaceIter(myShape, TopAbs_FACE); aFaceIter.More(); aFaceIter.Next())
+  {
+    const TopoDS_Face& aFace = TopoDS::Face(aFaceIter.Current());
+    TopLoc_Location aLoc;
+    const Handle(Poly_Triangulation)& aTris = BRep_Tool::Triangulation(aFace, aLoc);
+    if (aTris.IsNull())
+      continue;
+
+    if (!aTris->HasNormals())
+      BRepLib_ToolTriangulatedShape::ComputeNormals(aFace, aTris);
+
+    // winding follows face orientation and mirroring by location, normal follows face orientation
+    const gp_Trsf aTrsf = aLoc.Transformation();
+    const bool isReversed = aFace.Orientation() == TopAbs_REVERSED;
+    const bool toFlipTris = isReversed != (aTrsf.VectorialPart().Determinant() < 0.0);
+    for (int aNodeIter = 1; aNodeIter <= aTris->NbNodes(); ++aNodeIter)
+    {
+      gp_Dir aNorm = aTris->Normal(aNodeIter).Transformed(aTrsf);
+      if (isReversed)
+        aNorm.Reverse();
+      myTris->SetNode  (aNodeOffset + aNodeIter, aTris->Node(aNodeIter).Transformed(aTrsf));
+      myTris->SetNormal(aNodeOffset + aNodeIter, aNorm);
+    }
+    for (int aTriIter = 1; aTriIter <= aTris->NbTriangles(); ++aTriIter)
+    {
+      int aNodes[3] = { 0, 0, 0 };
+      aTris->Triangle(aTriIter).Get(aNodes[0], aNodes[1], aNodes[2]);
+      if (toFlipTris)
+        std::swap(aNodes[1], aNodes[2]);
+      myTris->SetTriangle(aTriOffset + aTriIter, Poly_Triangle(aNodeOffset + aNodes[0], aNodeOffset + aNodes[1], aNodeOffset + aNodes[2]));
+    }
+    aNodeOffset += aTris->NbNodes();
+    aTriOffset  += aTris->NbTriangles();
+  }
+}
+
+// ================================================================
+// Function : InstancedProgram
+// ================================================================
+const Handle(Graphic3d_ShaderProgram)& OcctInstancedShape::InstancedProgram()
+{
+  // program is shared by all prototypes, so that it is compiled once per GL context
+  static Handle(Graphic3d_ShaderProgram) THE_PROGRAM;
+  if (THE_PROGRAM.IsNull())
+  {
+    Graphic3d_ShaderAttributeList anAttribs;
+    for (int aColIter = 0; aColIter < 4; ++aColIter)
+    {
+      anAttribs.Append(new Graphic3d_ShaderAttribute(TCollection_AsciiString("instanceCol") + aColIter,
+                                                     Graphic3d_TOA_CUSTOM + aColIter));
+    }
+    THE_PROGRAM = new Graphic3d_ShaderProgram();
+    THE_PROGRAM->SetVertexAttributes(anAttribs);
+    THE_PROGRAM->SetNbClipPlanesMax(Graphic3d_ShaderProgram::THE_MAX_CLIP_PLANES_DEFAULT);
+    THE_PROGRAM->AttachShader(Graphic3d_ShaderObject::CreateFromSource(Graphic3d_TOS_VERTEX,   THE_INSTANCED_VERT_SHADER));
+    THE_PROGRAM->AttachShader(Graphic3d_ShaderObject::CreateFromSource(Graphic3d_TOS_FRAGMENT, THE_INSTANCED_FRAG_SHADER));
+  }
+  return THE_PROGRAM;
+}
+
+// ================================================================
+// Function : Compute
+// ================================================================
+void OcctInstancedShape::Compute(const Handle(PrsMgr_PresentationManager)& ,
+                                 const Handle(Prs3d_Presentation)& thePrs,
+                                 const int theMode)
+{
+  if (theMode != AIS_Shaded
+   || myTris->NbTriangles() == 0
+   || myTrsfs.IsEmpty())
+  {
+    return;
+  }
+
+  Handle(Graphic3d_Group) aGroup = thePrs->NewGroup();
+  Handle(OpenGl_Group) aGlGroup = Handle(OpenGl_Group)::DownCast(aGroup);
+  if (aGlGroup.IsNull())
+  {
+    Message::SendFail() << "Error: OcctInstancedShape requires OpenGL graphic driver";
+    return;
+  }
+
+  Handle(Graphic3d_Aspects) anAspect = new Graphic3d_Aspects(*myDrawer->ShadingAspect()->Aspect());
+  anAspect->SetShaderProgram(InstancedProgram());
+  aGlGroup->SetGroupPrimitivesAspect(anAspect);
+  aGlGroup->AddElement(new OcctInstancedElement(myTris, myTrsfs));
+
+  // group box is a union of boxes of instances
+  Bnd_Box aProtoBox, aBox;
+  for (int aNodeIter = 1; aNodeIter <= myTris->NbNodes(); ++aNodeIter)
+  {
+    aProtoBox.Add(myTris->Node(aNodeIter));
+  }
+  for (NCollection_Vector<gp_Trsf>::Iterator aTrsfIter(myTrsfs); aTrsfIter.More(); aTrsfIter.Next())
+  {
+    aBox.Add(aProtoBox.Transformed(aTrsfIter.Value()));
+  }
+  const gp_Pnt aMin = aBox.CornerMin(), aMax = aBox.CornerMax();
+  aGlGroup->SetMinMaxValues(aMin.X(), aMin.Y(), aMin.Z(), aMax.X(), aMax.Y(), aMax.Z());
+}
+
+// ================================================================
+// Function : ComputeSelection
+// ================================================================
+void OcctInstancedShape::ComputeSelection(const Handle(SelectMgr_Selection)& theSel,
+                                          const int theMode)
+{
+  if (theMode != 0
+   || myTris->NbTriangles() == 0)
+  {
+    return;
+  }
+
+  // prototype entity and its BVH are shared by sensitive entities of all occurrences
+  Handle(Select3D_SensitiveTriangulation) aProto = new Select3D_SensitiveTriangulation(new SelectMgr_EntityOwner(this), myTris, TopLoc_Location(), true);
+  aProto->BVH();
+  for (int anOccIter = 0; anOccIter < myTrsfs.Size(); ++anOccIter)
+  {
+    Handle(OcctInstanceOwner) anOwner = new OcctInstanceOwner(this, anOccIter);
+    theSel->Add(new OcctInstanceSensitive(anOwner, aProto, myTrsfs.Value(anOccIter)));
+  }
+}
+
+// ================================================================
+// Function : IsHilighted
+// ================================================================
+bool OcctInstanceOwner::IsHilighted(const Handle(PrsMgr_PresentationManager)& thePrsMgr,
+                                    const int ) const
+{
+  return !myPrs.IsNull()
+       && thePrsMgr->IsHighlighted(myPrs, 0);
+}
+
+// ================================================================
+// Function : HilightWithColor
+// ================================================================
+void OcctInstanceOwner::HilightWithColor(const Handle(PrsMgr_PresentationManager)& thePrsMgr,
+                                         const Handle(Prs3d_Drawer)& theStyle,
+                                         const int )
+{
+  if (myPrs.IsNull())
+  {
+    Handle(OcctInstancedShape) anObj = Handle(OcctInstancedShape)::DownCast(Selectable());
+    if (anObj.IsNull()
+     || myIndex >= anObj->NbOccurrences())
+    {
+      return;
+    }
+    myPrs = new OcctInstanceHighlight(anObj->Triangulation(), anObj->OccurrenceTransformation(myIndex));
+  }
+  thePrsMgr->Color(myPrs, theStyle, 0, Selectable());
+}
+
+// ================================================================
+// Function : Unhilight
+// ================================================================
+void OcctInstanceOwner::Unhilight(const Handle(PrsMgr_PresentationManager)& thePrsMgr,
+                                  const int )
+{
+  if (!myPrs.IsNull())
+    thePrsMgr->Unhighlight(myPrs);
+}
+
+// ================================================================
+// Function : Clear
+// ================================================================
+void OcctInstanceOwner::Clear(const Handle(PrsMgr_PresentationManager)& thePrsMgr,
+                              const int )
+{
+  if (!myPrs.IsNull())
+  {
+    thePrsMgr->Clear(myPrs, 0);
+    myPrs.Nullify();
+  }
+}
+
+// ================================================================
+// Function : Prototype
+// ================================================================
+Handle(OcctInstancedShape) OcctInstancedDisplay::Prototype(const TopoDS_Shape& theShape)
+{
+  // key keeps orientation (reversed occurrence flips normals) and drops location
+  const TopoDS_Shape aKey = theShape.Located(TopLoc_Location());
+  Handle(OcctInstancedShape) aProto;
+  if (!myPrototypes.Find(aKey, aProto))
+  {
+    aProto = new OcctInstancedShape(aKey);
+    myPrototypes.Bind(aKey, aProto);
+  }
+  return aProto;
+}
+
+// ================================================================
+// Function : Display
+// ================================================================
+Handle(AIS_InteractiveObject) OcctInstancedDisplay::Display(const TopoDS_Shape& theShape,
+                                                            int theDispMode,
+                                                            bool theToUpdate)
+{
+  if (theShape.IsNull())
+    return Handle(AIS_InteractiveObject)();
+
+  Handle(AIS_InteractiveObject) anObj;
+  if (myIsEnabled)
+  {
+    Handle(OcctInstancedShape) aProto = Prototype(theShape);
+    aProto->AddOccurrence(theShape.Location().Transformation());
+    myModified.Add(aProto);
+    anObj = aProto;
+  }
+  else
+  {
+    anObj = new AIS_Shape(theShape);
+    myCtx->Display(anObj, theDispMode, 0, false);
+    myStandalone.Append(anObj);
+  }
+
+  ++myNbOccurrences;
+  if (theToUpdate)
+    Commit(true);
+  return anObj;
+}
+
+// ================================================================
+// Function : Commit
+// ================================================================
+void OcctInstancedDisplay::Commit(bool theToUpdate)
+{
+  for (NCollection_Map<Handle(OcctInstancedShape)>::Iterator aProtoIter(myModified); aProtoIter.More(); aProtoIter.Next())
+  {
+    const Handle(OcctInstancedShape)& aProto = aProtoIter.Value();
+    if (myCtx->IsDisplayed(aProto))
+      myCtx->Redisplay(aProto, false);
+    else
+      myCtx->Display(aProto, AIS_Shaded, 0, false);
+  }
+  myModified.Clear();
+  if (theToUpdate)
+    myCtx->UpdateCurrentViewer();
+}
+
+// ================================================================
+// Function : Clear
+// ================================================================
+void OcctInstancedDisplay::Clear(bool theToUpdate)
+{
+  for (NCollection_DataMap<TopoDS_Shape, Handle(OcctInstancedShape), TopTools_OrientedShapeMapHasher>::Iterator aProtoIter(myPrototypes);
+       aProtoIter.More(); aProtoIter.Next())
+  {
+    myCtx->Remove(aProtoIter.Value(), false);
+  }
+  for (NCollection_Sequence<Handle(AIS_InteractiveObject)>::Iterator anObjIter(myStandalone); anObjIter.More(); anObjIter.Next())
+  {
+    myCtx->Remove(anObjIter.Value(), false);
+  }
+  myPrototypes.Clear();
+  myModified.Clear();
+  myStandalone.Clear();
+  myNbOccurrences = 0;
+  if (theToUpdate)
+    myCtx->UpdateCurrentViewer();
+}
+
+// ================================================================
+// Function : Benchmark
+// ================================================================
+void OcctInstancedDisplay::Benchmark(const Handle(AIS_InteractiveContext)& theCtx,
+                                     const Handle(V3d_View)& theView,
+                                     int theNbObjects)
+{
+  const int aNbObjects = theNbObjects > 0 ? theNbObjects : 10000;
+  const int aGridSize = (int )std::ceil(std::sqrt(double(aNbObjects)));
+  const TopoDS_Shape aBox = BRepPrimAPI_MakeBox(1.0, 1.0, 1.0).Shape();
+
+  Graphic3d_RenderingParams& aParams = theView->ChangeRenderingParams();
+  const Graphic3d_RenderingParams::PerfCounters aStatsPrev = aParams.CollectedStats;
+  const double aStatsIntervPrev = aParams.StatsUpdateInterval;
+  aParams.CollectedStats = Graphic3d_RenderingParams::PerfCounters_All;
+  aParams.StatsUpdateInterval = 0.0;
+
+  Graphic3d_Vec2i aWinSize;
+  theView->Window()->Size(aWinSize.x(), aWinSize.y());
+
+  Message::SendInfo() << "OcctInstancedDisplay benchmark, " << aNbObjects << " box occurrences";
+  for (int aModeIter = 0; aModeIter < 2; ++aModeIter)
+  {
+    OcctInstancedDisplay anInstDisplay(theCtx);
+    anInstDisplay.SetEnabled(aModeIter == 1);
+
+    OSD_Timer aTimer;
+    aTimer.Start();
+    for (int anObjIter = 0; anObjIter < aNbObjects; ++anObjIter)
+    {
+      gp_Trsf aTrsf;
+      aTrsf.SetTranslation(gp_Vec(2.0 * (anObjIter % aGridSize), 2.0 * (anObjIter / aGridSize), 0.0));
+      anInstDisplay.Display(aBox.Located(TopLoc_Location(aTrsf)), AIS_Shaded, false);
+    }
+    anInstDisplay.Commit(false);
+    theView->FitAll(0.01, false);
+    theView->Redraw();
+    aTimer.Stop();
+    const double aDisplayTime = aTimer.ElapsedTime();
+
+    aTimer.Reset();
+    aTimer.Start();
+    const int aNbFrames = 10;
+    for (int aFrameIter = 0; aFrameIter < aNbFrames; ++aFrameIter)
+    {
+      theView->Invalidate();
+      theView->Redraw();
+    }
+    aTimer.Stop();
+    const double aRedrawTime = aTimer.ElapsedTime() / aNbFrames;
+
+    // picking along window diagonal resolves individual occurrences
+    aTimer.Reset();
+    aTimer.Start();
+    const int aNbPicks = 100;
+    int aNbDetected = 0;
+    for (int aPickIter = 0; aPickIter < aNbPicks; ++aPickIter)
+    {
+      theCtx->MoveTo(aWinSize.x() * aPickIter / aNbPicks, aWinSize.y() * aPickIter / aNbPicks, theView, false);
+      if (theCtx->HasDetected())
+        ++aNbDetected;
+    }
+    theCtx->ClearDetected(false);
+    aTimer.Stop();
+
+    Message::SendInfo() << (anInstDisplay.IsEnabled() ? "Instanced" : "Standalone")
+                        << " (" << anInstDisplay.NbPrototypes() << " prototypes)"
+                        << ", display+first frame: " << (aDisplayTime * 1000.0) << " ms"
+                        << ", redraw: " << (aRedrawTime * 1000.0) << " ms/frame"
+                        << ", picking: " << (aTimer.ElapsedTime() * 1000.0 / aNbPicks) << " ms ("
+                        << aNbDetected << "/" << aNbPicks << " detected)\n"
+                        << theView->StatisticInformation();
+    anInstDisplay.Clear(false);
+  }
+
+  aParams.CollectedStats = aStatsPrev;
+  aParams.StatsUpdateInterval = aStatsIntervPrev;
+  theView->Invalidate();
+}
@@ -0,0 +1,201 @@
+// Copyright (c) 2026 Kirill Gavrilov
+
+#ifndef _OcctInstancedDisplay_HeaderFile
+#define _OcctInstancedDisplay_HeaderFile
+
+#include <AIS_InteractiveContext.hxx>
+#include <Graphic3d_ShaderProgram.hxx>
+#include <NCollection_DataMap.hxx>
+#include <NCollection_Map.hxx>
+#include <NCollection_Sequence.hxx>
+#include <NCollection_Vector.hxx>
+#include <Poly_Triangulation.hxx>
+#include <SelectMgr_EntityOwner.hxx>
+#include <TopTools_OrientedShapeMapHasher.hxx>
+#include <V3d_View.hxx>
+
+//! Presentation of all occurrences of the same shape geometry (TopoDS_TShape) with different locations.
+//!
+//! Prototype shape is tessellated once and merged into a single triangulation with normals;
+//! the presentation consists of a single OpenGl_Element uploading prototype into VBOs once,
+//! occurrence transformations into per-instance matrix VBO, and drawing all occurrences by one glDrawElementsInstanced().
+//! Transformation is applied by a custom GLSL program lit by ambient and a single directional light of the view
+//! and applying clipping planes in the same way as built-in programs;
+//! context without instanced arrays (OpenGL 3.3) falls back to a draw call per occurrence with the same VBOs.
+//!
+//! Each occurrence has its own selection owner (OcctInstanceOwner) and sensitive entity, which doesn't copy geometry:
+//! it tests the prototype triangulation (with its BVH built once) against selecting volume transformed
+//! by inverse occurrence transformation. Highlighting of individual occurrence is a small presentation
+//! computed on demand by the owner.
+//! Only shaded display mode (AIS_Shaded) is supported.
+class OcctInstancedShape : public AIS_InteractiveObject
+{
+  DEFINE_STANDARD_RTTI_INLINE(OcctInstancedShape, AIS_InteractiveObject)
+public:
+
+  //! Main constructor tessellating the shape (location is ignored).
+  OcctInstancedShape(const TopoDS_Shape& theShape);
+
+  //! Return prototype shape.
+  const TopoDS_Shape& Shape() const { return myShape; }
+
+  //! Return merged prototype triangulation with normals.
+  const Handle(Poly_Triangulation)& Triangulation() const { return myTris; }
+
+  //! Return number of occurrences.
+  int NbOccurrences() const { return myTrsfs.Size(); }
+
+  //! Return transformation of occurrence.
+  const gp_Trsf& OccurrenceTransformation(int theIndex) const { return myTrsfs.Value(theIndex); }
+
+  //! Return located shape of occurrence.
+  TopoDS_Shape Occurrence(int theIndex) const { return myShape.Located(TopLoc_Location(myTrsfs.Value(theIndex))); }
+
+  //! Add occurrence; presentation and selection should be recomputed (Redisplay()) to show it.
+  //! @return occurrence index
+  int AddOccurrence(const gp_Trsf& theTrsf)
+  {
+    myTrsfs.Append(theTrsf);
+    return myTrsfs.Upper();
+  }
+
+  //! Remove all occurrences.
+  void ClearOccurrences() { myTrsfs.Clear(); }
+
+  //! Only shaded mode is supported.
+  virtual bool AcceptDisplayMode(const int theMode) const override { return theMode == AIS_Shaded; }
+
+  //! Return GLSL program applying per-instance transformation.
+  static const Handle(Graphic3d_ShaderProgram)& InstancedProgram();
+
+protected:
+
+  //! Compute presentation with single instanced element.
+  virtual void Compute(const Handle(PrsMgr_PresentationManager)& thePrsMgr,
+                       const Handle(Prs3d_Presentation)& thePrs,
+                       const int theMode) override;
+
+  //! Compute selection with sensitive entity per occurrence.
+  virtual void ComputeSelection(const Handle(SelectMgr_Selection)& theSel,
+                                const int theMode) override;
+
+private:
+
+  TopoDS_Shape               myShape; //!< prototype shape without location
+  Handle(Poly_Triangulation) myTris;  //!< merged prototype triangulation with normals
+  NCollection_Vector<gp_Trsf> myTrsfs; //!< occurrence transformations
+
+};
+
+//! Selection owner of a single occurrence of OcctInstancedShape.
+class OcctInstanceOwner : public SelectMgr_EntityOwner
+{
+  DEFINE_STANDARD_RTTI_INLINE(OcctInstanceOwner, SelectMgr_EntityOwner)
+public:
+
+  //! Main constructor.
+  OcctInstanceOwner(const Handle(OcctInstancedShape)& theObj, int theIndex)
+  : SelectMgr_EntityOwner(theObj, 5), myIndex(theIndex)
+  {
+    // occurrence is highlighted by the owner itself instead of the whole object
+    SetComesFromDecomposition(true);
+  }
+
+  //! Return occurrence index.
+  int Index() const { return myIndex; }
+
+  //! Return TRUE if occurrence is highlighted.
+  virtual bool IsHilighted(const Handle(PrsMgr_PresentationManager)& thePrsMgr,
+                           const int theMode) const override;
+
+  //! Highlight occurrence by presentation of prototype triangulation moved to occurrence location.
+  virtual void HilightWithColor(const Handle(PrsMgr_PresentationManager)& thePrsMgr,
+                                const Handle(Prs3d_Drawer)& theStyle,
+                                const int theMode) override;
+
+  //! Remove highlighting.
+  virtual void Unhilight(const Handle(PrsMgr_PresentationManager)& thePrsMgr,
+                         const int theMode) override;
+
+  //! Clear highlighting presentation.
+  virtual void Clear(const Handle(PrsMgr_PresentationManager)& thePrsMgr,
+                     const int theMode) override;
+
+private:
+
+  Handle(AIS_InteractiveObject) myPrs; //!< highlighting presentation of occurrence
+  int myIndex;
+
+};
+
+//! Instanced display of shapes sharing the same geometry (TopoDS_TShape) with different locations,
+//! like fasteners repeated within an assembly.
+//!
+//! Each AIS_Shape computes its own presentation (primitive arrays and VBOs) even if the shape differs only by location.
+//! This tool keeps a single OcctInstancedShape per shared geometry, which uploads geometry to GPU once
+//! and draws all its occurrences by a single instanced draw call;
+//! picking and highlighting resolve individual occurrences via OcctInstanceOwner.
+//! Prototypes are distinguished by geometry and orientation, so that reversed occurrence gets its own prototype.
+class OcctInstancedDisplay
+{
+public:
+
+  //! Main constructor.
+  OcctInstancedDisplay(const Handle(AIS_InteractiveContext)& theCtx) : myCtx(theCtx) {}
+
+  //! Return interactive context.
+  const Handle(AIS_InteractiveContext)& Context() const { return myCtx; }
+
+  //! Return TRUE if instancing is enabled (TRUE by default);
+  //! when disabled, Display() creates a standalone AIS_Shape for each occurrence.
+  bool IsEnabled() const { return myIsEnabled; }
+
+  //! Enable/disable instancing; affects only newly displayed occurrences.
+  void SetEnabled(bool theToEnable) { myIsEnabled = theToEnable; }
+
+  //! Display shape occurrence.
+  //! Instanced occurrences are shown after Commit() (called by this method with theToUpdate=TRUE),
+  //! so that adding many occurrences recomputes every prototype only once.
+  //! @param[in] theShape    shape with location
+  //! @param[in] theDispMode display mode of standalone AIS_Shape (instanced occurrences are always shaded)
+  //! @param[in] theToUpdate commit added occurrences and update viewer
+  //! @return prototype presentation (OcctInstancedShape) or standalone AIS_Shape
+  Handle(AIS_InteractiveObject) Display(const TopoDS_Shape& theShape,
+                                        int theDispMode,
+                                        bool theToUpdate);
+
+  //! Display or recompute prototypes with added occurrences.
+  void Commit(bool theToUpdate);
+
+  //! Find or create prototype presentation for shape geometry and orientation (location is ignored).
+  Handle(OcctInstancedShape) Prototype(const TopoDS_Shape& theShape);
+
+  //! Remove all displayed occurrences and prototypes.
+  void Clear(bool theToUpdate);
+
+  //! Return number of prototypes (unique geometries).
+  int NbPrototypes() const { return myPrototypes.Extent(); }
+
+  //! Return number of displayed occurrences.
+  int NbOccurrences() const { return myNbOccurrences; }
+
+public:
+
+  //! Benchmark comparing standalone AIS_Shape presentations with instanced display.
+  //! Displays theNbObjects located boxes in both modes and prints display/redraw/picking timings and frame statistics.
+  static void Benchmark(const Handle(AIS_InteractiveContext)& theCtx,
+                        const Handle(V3d_View)& theView,
+                        int theNbObjects);
+
+private:
+
+  Handle(AIS_InteractiveContext) myCtx;
+  NCollection_DataMap<TopoDS_Shape, Handle(OcctInstancedShape), TopTools_OrientedShapeMapHasher> myPrototypes;
+  NCollection_Map<Handle(OcctInstancedShape)>         myModified;   //!< prototypes with occurrences added since Commit()
+  NCollection_Sequence<Handle(AIS_InteractiveObject)> myStandalone; //!< standalone AIS_Shape occurrences
+  int  myNbOccurrences = 0;
+  bool myIsEnabled = true;
+
+};
+
+#endif // _OcctInstancedDisplay_HeaderFile
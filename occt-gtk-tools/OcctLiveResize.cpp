@@ -0,0 +1,174 @@
+// Copyright (c) 2026 Kirill Gavrilov
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+#include "OcctLiveResize.h"
+
+#include "OcctGlTools.h"
+
+#include <OpenGl_ArbFBO.hxx>
+#include <OpenGl_Context.hxx>
+#include <OpenGl_FrameBuffer.hxx>
+
+// ================================================================
+// Function : OcctLiveResize
+// ================================================================
+OcctLiveResize::OcctLiveResize()
+{
+  myTimer.Start();
+}
+
+// ================================================================
+// Function : ~OcctLiveResize
+// ================================================================
+OcctLiveResize::~OcctLiveResize()
+{
+  //
+}
+
+// ================================================================
+// Function : Update
+// ================================================================
+bool OcctLiveResize::Update(const Handle(V3d_View)& theView)
+{
+  Handle(OpenGl_Context) aGlCtx = OcctGlTools::GetGlContext(theView);
+  const Handle(OpenGl_FrameBuffer)& aDefaultFbo = aGlCtx->DefaultFrameBuffer();
+  if (aDefaultFbo.IsNull())
+    return false;
+
+  Graphic3d_Vec2i aViewSize;
+  theView->Window()->Size(aViewSize.x(), aViewSize.y());
+  const Graphic3d_Vec2i aNewSize = aDefaultFbo->GetVPSize();
+  if (aNewSize == aViewSize)
+  {
+    myLastChange = -1.0;
+    myIsFrameStored = false;
+    return false;
+  }
+
+  const double aTime = myTimer.ElapsedTime();
+  if (myLastChange < 0.0
+   || aNewSize != myPendingSize)
+  {
+    myPendingSize = aNewSize;
+    myLastChange  = aTime;
+  }
+
+  if (myIsEnabled
+   && aTime - myLastChange < mySettleTimeout
+   && myIsFrameStored
+   && !myCacheFbo.IsNull()
+   && myCacheFbo->IsValid()
+   && blitFrame(aGlCtx, myCacheFbo, myCacheSize, aDefaultFbo, aNewSize, true))
+  {
+    ++myNbStretched;
+    return true;
+  }
+
+  // size has settled - reallocate view buffers once
+  myLastChange = -1.0;
+  myIsFrameStored = false;
+  OcctGlTools::ResizeViewToFbo(theView);
+  return false;
+}
+
+// ================================================================
+// Function : BeginResize
+// ================================================================
+void OcctLiveResize::BeginResize(const Handle(V3d_View)& theView)
+{
+  if (!myIsEnabled
+    || myIsFrameStored)
+  {
+    return;
+  }
+
+  myIsFrameStored = storeFrame(theView);
+}
+
+// ================================================================
+// Function : storeFrame
+// ================================================================
+bool OcctLiveResize::storeFrame(const Handle(V3d_View)& theView)
+{
+  Handle(OpenGl_Context) aGlCtx = OcctGlTools::GetGlContext(theView);
+  if (aGlCtx.IsNull())
+    return false;
+
+  // default FBO wrapper still refers to the buffer of the last rendered frame
+  const Handle(OpenGl_FrameBuffer)& aDefaultFbo = aGlCtx->DefaultFrameBuffer();
+  if (aDefaultFbo.IsNull())
+    return false;
+
+  const Graphic3d_Vec2i aSize = aDefaultFbo->GetVPSize();
+  if (myCacheFbo.IsNull())
+    myCacheFbo = new OpenGl_FrameBuffer();
+
+  // reallocate cache only when frame doesn't fit or becomes much smaller
+  if (!myCacheFbo->IsValid()
+   || aSize.x() > myCacheFbo->GetSizeX()
+   || aSize.y() > myCacheFbo->GetSizeY()
+   || aSize.x() * 2 < myCacheFbo->GetSizeX()
+   || aSize.y() * 2 < myCacheFbo->GetSizeY())
+  {
+    const Graphic3d_Vec2i aBucketSize(((aSize.x() + mySizeBucket - 1) / mySizeBucket) * mySizeBucket,
+                                      ((aSize.y() + mySizeBucket - 1) / mySizeBucket) * mySizeBucket);
+    if (!myCacheFbo->Init(aGlCtx, aBucketSize, GL_RGBA8, 0))
+    {
+      myCacheFbo->Release(aGlCtx.get());
+      return false;
+    }
+  }
+
+  if (!blitFrame(aGlCtx, aDefaultFbo, aSize, myCacheFbo, aSize, false))
+  {
+    myCacheFbo->Release(aGlCtx.get());
+    return false;
+  }
+  myCacheSize = aSize;
+  return true;
+}
+
+// ================================================================
+// Function : Release
+// ================================================================
+void OcctLiveResize::Release(const Handle(V3d_View)& theView)
+{
+  myIsFrameStored = false;
+  if (myCacheFbo.IsNull())
+    return;
+
+  Handle(OpenGl_Context) aGlCtx = OcctGlTools::GetGlContext(theView);
+  myCacheFbo->Release(aGlCtx.get());
+  myCacheFbo.Nullify();
+}
+
+// ================================================================
+// Function : blitFrame
+// ================================================================
+bool OcctLiveResize::blitFrame(const Handle(OpenGl_Context)& theGlCtx,
+                               const Handle(OpenGl_FrameBuffer)& theSrc,
+                               const Graphic3d_Vec2i& theSrcSize,
+                               const Handle(OpenGl_FrameBuffer)& theDst,
+                               const Graphic3d_Vec2i& theDstSize,
+                               bool theToFilter)
+{
+  if (theGlCtx->arbFBOBlit == nullptr
+   || theSrcSize.x() <= 0 || theSrcSize.y() <= 0)
+  {
+    return false;
+  }
+
+  theSrc->BindReadBuffer(theGlCtx);
+  theDst->BindDrawBuffer(theGlCtx);
+  theGlCtx->core11fwd->glDisable(GL_SCISSOR_TEST);
+  theGlCtx->arbFBOBlit->glBlitFramebuffer(0, 0, theSrcSize.x(), theSrcSize.y(),
+                                          0, 0, theDstSize.x(), theDstSize.y(),
+                                          GL_COLOR_BUFFER_BIT, theToFilter ? GL_LINEAR : GL_NEAREST);
+  if (!theGlCtx->DefaultFrameBuffer().IsNull())
+    theGlCtx->DefaultFrameBuffer()->BindBuffer(theGlCtx);
+
+  return true;
+}
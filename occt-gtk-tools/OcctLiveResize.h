@@ -0,0 +1,106 @@
+// Copyright (c) 2026 Kirill Gavrilov
+
+#ifndef _OcctLiveResize_HeaderFile
+#define _OcctLiveResize_HeaderFile
+
+#include <OSD_Timer.hxx>
+#include <V3d_View.hxx>
+
+class OpenGl_Context;
+class OpenGl_FrameBuffer;
+
+//! Helper avoiding reallocation of view offscreen buffers (including MSAA and OIT ones) on each step of interactive window resize.
+//!
+//! When resize starts, the last rendered frame is copied into a cache FBO allocated in size buckets
+//! (so that it is not reallocated on small size changes) and used as a sub-viewport.
+//! While window size keeps changing, the cached frame is stretched to the new window size instead of redrawing the view,
+//! and view is resized (and redrawn) only once size has settled for SettleTimeout().
+//!
+//! Usage:
+//! @code
+//!   // on widget size allocation, before default FBO is reallocated by GUI framework
+//!   myLiveResize.BeginResize(theView);
+//!
+//!   // within rendering callback
+//!   OcctGlTools::InitializeGlFbo(theView, false);
+//!   if (myLiveResize.Update(theView))
+//!     return true; // stretched - schedule redraw after SettleTimeout()
+//!   ... redraw view ...
+//! @endcode
+class OcctLiveResize
+{
+public:
+
+  //! Empty constructor.
+  OcctLiveResize();
+
+  //! Destructor.
+  ~OcctLiveResize();
+
+  //! Return TRUE if live resize is enabled (TRUE by default).
+  bool IsEnabled() const { return myIsEnabled; }
+
+  //! Enable/disable live resize; when disabled, view is resized on each step.
+  void SetEnabled(bool theToEnable) { myIsEnabled = theToEnable; }
+
+  //! Return time in seconds without size changes to consider resize as finished (0.2 by default).
+  double SettleTimeout() const { return mySettleTimeout; }
+
+  //! Set settle timeout in seconds.
+  void SetSettleTimeout(double theSeconds) { mySettleTimeout = theSeconds; }
+
+  //! Return size bucket in pixels for allocating cache FBO (256 by default).
+  int SizeBucket() const { return mySizeBucket; }
+
+  //! Set size bucket in pixels.
+  void SetSizeBucket(int theSize) { mySizeBucket = theSize; }
+
+  //! Return TRUE if window is being resized (size has been changed but not yet settled).
+  bool IsResizing() const { return myLastChange >= 0.0; }
+
+  //! Return number of frames stretched instead of redrawing.
+  int NbStretchedFrames() const { return myNbStretched; }
+
+  //! Compare dimensions of the default FBO (should be wrapped by OcctGlTools::InitializeGlFbo() without resizing view)
+  //! with view dimensions, and either stretch cached frame into default FBO while size is unsettled,
+  //! or resize view to new dimensions.
+  //! @return TRUE if cached frame has been stretched and view should not be redrawn
+  bool Update(const Handle(V3d_View)& theView);
+
+  //! Copy the last rendered frame from default FBO into cache, if it has not been yet copied since the last settled size.
+  //! Should be called on widget size allocation with bound OpenGL context, while default FBO still keeps the last frame.
+  void BeginResize(const Handle(V3d_View)& theView);
+
+  //! Release OpenGL resources.
+  void Release(const Handle(V3d_View)& theView);
+
+protected:
+
+  //! Copy rendered frame from default FBO into cache.
+  //! @return FALSE on failure
+  bool storeFrame(const Handle(V3d_View)& theView);
+
+  //! Copy color buffer between two framebuffers.
+  static bool blitFrame(const Handle(OpenGl_Context)& theGlCtx,
+                        const Handle(OpenGl_FrameBuffer)& theSrc,
+                        const Graphic3d_Vec2i& theSrcSize,
+                        const Handle(OpenGl_FrameBuffer)& theDst,
+                        const Graphic3d_Vec2i& theDstSize,
+                        bool theToFilter);
+
+protected:
+
+  Handle(OpenGl_FrameBuffer) myCacheFbo;      //!< cache of the last rendered frame
+  Graphic3d_Vec2i            myCacheSize;     //!< dimensions of the frame within cache FBO (sub-viewport)
+  Graphic3d_Vec2i            myPendingSize;   //!< last seen unsettled size
+  OSD_Timer                  myTimer;
+  double                     myLastChange     = -1.0; //!< time of last size change, -1 if not resizing
+  double                     mySettleTimeout  = 0.2;
+  int                        mySizeBucket     = 256;
+  int                        myNbStretched    = 0;
+  bool                       myIsEnabled      = true;
+  bool                       myIsFrameStored  = false; //!< frame has been copied for the current resize
+
+};
+
+#endif // _OcctLiveResize_HeaderFile
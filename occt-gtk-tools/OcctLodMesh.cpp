@@ -0,0 +1,1035 @@
+// Copyright (c) 2026 Kirill Gavrilov
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+#include "OcctLodMesh.h"
+
+#include "OcctGlTools.h"
+#include "OcctMemoryReport.h"
+#include "OcctMeshTools.h"
+
+#include <Graphic3d_Buffer.hxx>
+#include <Graphic3d_CullingTool.hxx>
+#include <Graphic3d_IndexBuffer.hxx>
+#include <Graphic3d_ShaderAttribute.hxx>
+#include <Graphic3d_ShaderObject.hxx>
+#include <Message.hxx>
+#include <OpenGl_Context.hxx>
+#include <OSD_Timer.hxx>
+#include <Prs3d_ShadingAspect.hxx>
+#include <Select3D_SensitiveBox.hxx>
+#include <SelectMgr_EntityOwner.hxx>
+#include <SelectMgr_Selection.hxx>
+#include <Standard_Version.hxx>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+  //! Symmetric 4x4 matrix of plane quadric, accumulating squared distances to planes.
+  struct Quadric
+  {
+    double XX = 0.0, XY = 0.0, XZ = 0.0, XW = 0.0;
+    double YY = 0.0, YZ = 0.0, YW = 0.0;
+    double ZZ = 0.0, ZW = 0.0;
+    double WW = 0.0;
+
+    //! Add plane (theNorm, theD) with specified weight.
+    void AddPlane(const gp_XYZ& theNorm, double theD, double theWeight)
+    {
+      const double a = theNorm.X(), b = theNorm.Y(), c = theNorm.Z(), d = theD;
+      XX += theWeight * a * a; XY += theWeight * a * b; XZ += theWeight * a * c; XW += theWeight * a * d;
+      YY += theWeight * b * b; YZ += theWeight * b * c; YW += theWeight * b * d;
+      ZZ += theWeight * c * c; ZW += theWeight * c * d;
+      WW += theWeight * d * d;
+    }
+
+    //! Add another quadric.
+    void Add(const Quadric& theOther)
+    {
+      XX += theOther.XX; XY += theOther.XY; XZ += theOther.XZ; XW += theOther.XW;
+      YY += theOther.YY; YZ += theOther.YZ; YW += theOther.YW;
+      ZZ += theOther.ZZ; ZW += theOther.ZW;
+      WW += theOther.WW;
+    }
+
+    //! Evaluate error of the point.
+    double Error(const gp_XYZ& thePnt) const
+    {
+      const double x = thePnt.X(), y = thePnt.Y(), z = thePnt.Z();
+      return x * x * XX + 2.0 * x * y * XY + 2.0 * x * z * XZ + 2.0 * x * XW
+           + y * y * YY + 2.0 * y * z * YZ + 2.0 * y * YW
+           + z * z * ZZ + 2.0 * z * ZW
+           + WW;
+    }
+  };
+
+  //! Edge collapse candidate moving one vertex into another.
+  struct Collapse
+  {
+    double Cost;
+    int    From;
+    int    To;
+  };
+
+  //! Triangle with 0-based node indices.
+  struct Tri
+  {
+    int Nodes[3];
+  };
+
+  //! Compact vertex: position quantized within bounding box and octahedral-encoded normal (8 bits per component).
+  struct CompactVertex
+  {
+    uint16_t Pos[3];
+    uint16_t Normal;
+  };
+
+  //! Maximum number of nodes addressed by 16-bit indices.
+  static const int THE_MAX_COMPACT_NODES = 65535;
+
+  //! Vertex shader decoding compact vertex layout;
+  //! each component is passed as a separate normalized 16-bit attribute (X within occVertex, normal within occNormal).
+  static const char THE_COMPACT_VERT_SHADER[] =
+    "uniform vec3 compactMin;\n"
+    "uniform vec3 compactRange;\n"
+    "THE_ATTRIBUTE float compactY;\n"
+    "THE_ATTRIBUTE float compactZ;\n"
+    "THE_SHADER_OUT vec3 Normal;\n"
+    "THE_SHADER_OUT vec4 PositionWorld;\n"
+    "vec3 compactNormal (in float thePacked)\n"
+    "{\n"
+    "  float aBits = floor (thePacked * 65535.0 + 0.5);\n"
+    "  float aHigh = floor (aBits / 256.0);\n"
+    "  vec2 anOct  = vec2 (aHigh, aBits - aHigh * 256.0) / 255.0 * 2.0 - 1.0;\n"
+    "  vec3 aNorm  = vec3 (anOct, 1.0 - abs (anOct.x) - abs (anOct.y));\n"
+    "  if (aNorm.z < 0.0)\n"
+    "  {\n"
+    "    aNorm.xy = (1.0 - abs (aNorm.yx)) * vec2 (aNorm.x >= 0.0 ? 1.0 : -1.0, aNorm.y >= 0.0 ? 1.0 : -1.0);\n"
+    "  }\n"
+    "  return normalize (aNorm);\n"
+    "}\n"
+    "void main()\n"
+    "{\n"
+    "  vec3 aPos = compactMin + vec3 (occVertex.x, compactY, compactZ) * compactRange;\n"
+    "  PositionWorld = occModelWorldMatrix * vec4 (aPos, 1.0);\n"
+    "  Normal = (occWorldViewMatrix * occModelWorldMatrix * vec4 (compactNormal (occNormal.x), 0.0)).xyz;\n"
+    "  gl_Position = occProjectionMatrix * occWorldViewMatrix * PositionWorld;\n"
+    "}\n";
+
+  //! Fragment shader applying clipping planes (in the same way as built-in programs)
+  //! and shading by material with ambient and single directional light passed as uniforms.
+  static const char THE_COMPACT_FRAG_SHADER[] =
+    "uniform vec3 compactAmbient;\n"
+    "uniform vec4 compactLightDir;\n"
+    "uniform vec3 compactLightColor;\n"
+    "THE_SHADER_IN vec3 Normal;\n"
+    "THE_SHADER_IN vec4 PositionWorld;\n"
+    "void main()\n"
+    "{\n"
+    "#if defined(THE_MAX_CLIP_PLANES) && (THE_MAX_CLIP_PLANES > 0)\n"
+    "  for (int aPlaneIter = 0; aPlaneIter < occClipPlaneCount;)\n"
+    "  {\n"
+    "    vec4 anEquation = occClipPlaneEquations[aPlaneIter];\n"
+    "    if (dot (anEquation.xyz, PositionWorld.xyz / PositionWorld.w) + anEquation.w < 0.0)\n"
+    "    {\n"
+    "      if (occClipPlaneChains[aPlaneIter] == 1)\n"
+    "      {\n"
+    "        discard;\n"
+    "      }\n"
+    "      aPlaneIter += 1;\n"
+    "    }\n"
+    "    else\n"
+    "    {\n"
+    "      aPlaneIter += occClipPlaneChains[aPlaneIter];\n"
+    "    }\n"
+    "  }\n"
+    "#endif\n"
+    "  vec3 aNorm = normalize (gl_FrontFacing ? Normal : -Normal);\n"
+#if (OCC_VERSION_HEX >= 0x070500)
+    "  vec4 aDiffuse  = occMaterial_Diffuse (gl_FrontFacing);\n"
+    "  vec3 anEmission = occMaterial_Emission (gl_FrontFacing).rgb;\n"
+#else
+    "  vec4 aDiffuse  = gl_FrontFacing ? occFrontMaterial_Diffuse() : occBackMaterial_Diffuse();\n"
+    "  vec3 anEmission = (gl_FrontFacing ? occFrontMaterial_Emission() : occBackMaterial_Emission()).rgb;\n"
+#endif
+    "  vec3 aLightDir = compactLightDir.w > 0.5 ? compactLightDir.xyz : (occWorldViewMatrix * vec4 (compactLightDir.xyz, 0.0)).xyz;\n"
+    "  vec3 aLight = compactAmbient + compactLightColor * max (dot (aNorm, normalize (aLightDir)), 0.0);\n"
+    "  occSetFragColor (vec4 (anEmission + aDiffuse.rgb * aLight, aDiffuse.a));\n"
+    "}\n";
+
+  //! Compute smooth normals weighted by triangle area.
+  static std::vector<Graphic3d_Vec3> computeNormals(const Handle(Poly_Triangulation)& theTris)
+  {
+    std::vector<Graphic3d_Vec3> aNormals(theTris->NbNodes(), Graphic3d_Vec3(0.0f));
+    for (int aTriIter = 1; aTriIter <= theTris->NbTriangles(); ++aTriIter)
+    {
+      int aNodes[3] = { 0, 0, 0 };
+      theTris->Triangle(aTriIter).Get(aNodes[0], aNodes[1], aNodes[2]);
+      const gp_XYZ aPnts[3] = { theTris->Node(aNodes[0]).XYZ(), theTris->Node(aNodes[1]).XYZ(), theTris->Node(aNodes[2]).XYZ() };
+      const gp_XYZ aNorm = (aPnts[1] - aPnts[0]).Crossed(aPnts[2] - aPnts[0]);
+      for (int aNodeIter = 0; aNodeIter < 3; ++aNodeIter)
+      {
+        aNormals[aNodes[aNodeIter] - 1] += Graphic3d_Vec3(float(aNorm.X()), float(aNorm.Y()), float(aNorm.Z()));
+      }
+    }
+    for (Graphic3d_Vec3& aNorm : aNormals)
+    {
+      const float aLen = aNorm.Modulus();
+      aNorm = aLen > 0.0f ? aNorm / aLen : Graphic3d_Vec3(0.0f, 0.0f, 1.0f);
+    }
+    return aNormals;
+  }
+
+  //! Encode unit normal into octahedral representation with 8 bits per component.
+  static uint16_t encodeOctNormal(const Graphic3d_Vec3& theNorm)
+  {
+    const float aSum = std::abs(theNorm.x()) + std::abs(theNorm.y()) + std::abs(theNorm.z());
+    float anOct[2] = { theNorm.x() / aSum, theNorm.y() / aSum };
+    if (theNorm.z() < 0.0f)
+    {
+      const float anX = anOct[0], anY = anOct[1];
+      anOct[0] = (1.0f - std::abs(anY)) * (anX >= 0.0f ? 1.0f : -1.0f);
+      anOct[1] = (1.0f - std::abs(anX)) * (anY >= 0.0f ? 1.0f : -1.0f);
+    }
+    const int aHigh = (int )std::floor((anOct[0] * 0.5f + 0.5f) * 255.0f + 0.5f);
+    const int aLow  = (int )std::floor((anOct[1] * 0.5f + 0.5f) * 255.0f + 0.5f);
+    return uint16_t(std::min(std::max(aHigh, 0), 255) * 256 + std::min(std::max(aLow, 0), 255));
+  }
+}
+
+// ================================================================
+// Function : Simplify
+// ================================================================
+Handle(Poly_Triangulation) OcctLodMesh::Simplify(const Handle(Poly_Triangulation)& theTris,
+                                                 int theTargetNbTriangles)
+{
+  const int aNbNodes = theTris->NbNodes();
+  std::vector<gp_XYZ> aPnts(aNbNodes);
+  for (int aNodeIter = 0; aNodeIter < aNbNodes; ++aNodeIter)
+  {
+    aPnts[aNodeIter] = theTris->Node(aNodeIter + 1).XYZ();
+  }
+
+  std::vector<Tri> aTris(theTris->NbTriangles());
+  for (int aTriIter = 0; aTriIter < theTris->NbTriangles(); ++aTriIter)
+  {
+    Tri& aTri = aTris[aTriIter];
+    theTris->Triangle(aTriIter + 1).Get(aTri.Nodes[0], aTri.Nodes[1], aTri.Nodes[2]);
+    --aTri.Nodes[0]; --aTri.Nodes[1]; --aTri.Nodes[2];
+  }
+
+  // quadrics of triangle planes weighted by triangle area
+  std::vector<Quadric> aQuadrics(aNbNodes);
+  for (const Tri& aTri : aTris)
+  {
+    gp_XYZ aNorm = (aPnts[aTri.Nodes[1]] - aPnts[aTri.Nodes[0]]).Crossed(aPnts[aTri.Nodes[2]] - aPnts[aTri.Nodes[0]]);
+    const double aLen = aNorm.Modulus();
+    if (aLen <= 0.0)
+      continue;
+
+    aNorm /= aLen;
+    const double aD = -aNorm.Dot(aPnts[aTri.Nodes[0]]);
+    for (int aNodeIter = 0; aNodeIter < 3; ++aNodeIter)
+    {
+      aQuadrics[aTri.Nodes[aNodeIter]].AddPlane(aNorm, aD, aLen * 0.5);
+    }
+  }
+
+  // lock vertices of open (or non-manifold) edges - borders of chunks should stay the same on all levels
+  std::vector<bool> aLocked(aNbNodes, false);
+  {
+    std::vector<uint64_t> anEdges;
+    anEdges.reserve(aTris.size() * 3);
+    for (const Tri& aTri : aTris)
+    {
+      for (int aNodeIter = 0; aNodeIter < 3; ++aNodeIter)
+      {
+        const uint32_t aNode1 = uint32_t(aTri.Nodes[aNodeIter]), aNode2 = uint32_t(aTri.Nodes[(aNodeIter + 1) % 3]);
+        anEdges.push_back(uint64_t(std::min(aNode1, aNode2)) << 32 | std::max(aNode1, aNode2));
+      }
+    }
+    std::sort(anEdges.begin(), anEdges.end());
+    for (size_t anEdgeIter = 0; anEdgeIter < anEdges.size();)
+    {
+      size_t aNext = anEdgeIter + 1;
+      while (aNext < anEdges.size() && anEdges[aNext] == anEdges[anEdgeIter])
+        ++aNext;
+
+      if (aNext - anEdgeIter != 2)
+      {
+        aLocked[size_t(anEdges[anEdgeIter] >> 32)] = true;
+        aLocked[size_t(anEdges[anEdgeIter] & 0xFFFFFFFFu)] = true;
+      }
+      anEdgeIter = aNext;
+    }
+  }
+
+  // collapse cheapest edges in passes; each pass collapses an independent set of edges
+  // (neighborhoods of collapsed vertices do not overlap), so that flip checks remain valid within the pass
+  std::vector<int> aRemap(aNbNodes);
+  for (int aNodeIter = 0; aNodeIter < aNbNodes; ++aNodeIter)
+    aRemap[aNodeIter] = aNodeIter;
+
+  std::vector<int> aTriOffsets, aTriList, aFill;
+  std::vector<Collapse> aCollapses;
+  std::vector<bool> aTouched;
+  for (int aPassIter = 0; aPassIter < 64 && (int )aTris.size() > theTargetNbTriangles; ++aPassIter)
+  {
+    // vertex -> triangles adjacency
+    aTriOffsets.assign(aNbNodes + 1, 0);
+    for (const Tri& aTri : aTris)
+    {
+      for (int aNodeIter = 0; aNodeIter < 3; ++aNodeIter)
+        ++aTriOffsets[aTri.Nodes[aNodeIter] + 1];
+    }
+    for (int aNodeIter = 0; aNodeIter < aNbNodes; ++aNodeIter)
+      aTriOffsets[aNodeIter + 1] += aTriOffsets[aNodeIter];
+
+    aTriList.resize(aTriOffsets[aNbNodes]);
+    aFill.assign(aTriOffsets.begin(), aTriOffsets.end() - 1);
+    for (int aTriIter = 0; aTriIter < (int )aTris.size(); ++aTriIter)
+    {
+      for (int aNodeIter = 0; aNodeIter < 3; ++aNodeIter)
+        aTriList[aFill[aTris[aTriIter].Nodes[aNodeIter]]++] = aTriIter;
+    }
+
+    // candidate collapses of each edge into one of its end points
+    aCollapses.clear();
+    for (const Tri& aTri : aTris)
+    {
+      for (int aNodeIter = 0; aNodeIter < 3; ++aNodeIter)
+      {
+        const int aNode1 = aTri.Nodes[aNodeIter], aNode2 = aTri.Nodes[(aNodeIter + 1) % 3];
+        if (aNode1 > aNode2
+         || (aLocked[aNode1] && aLocked[aNode2]))
+        {
+          continue; // interior edge is visited twice
+        }
+
+        Quadric aQuadric = aQuadrics[aNode1];
+        aQuadric.Add(aQuadrics[aNode2]);
+        Collapse aCollapse = { 0.0, aNode1, aNode2 };
+        aCollapse.Cost = aLocked[aNode1] ? DBL_MAX : aQuadric.Error(aPnts[aNode2]);
+        if (!aLocked[aNode2])
+        {
+          const double aCost = aQuadric.Error(aPnts[aNode1]);
+          if (aCost < aCollapse.Cost)
+          {
+            aCollapse.Cost = aCost;
+            aCollapse.From = aNode2;
+            aCollapse.To   = aNode1;
+          }
+        }
+        aCollapses.push_back(aCollapse);
+      }
+    }
+    if (aCollapses.empty())
+      break;
+
+    std::sort(aCollapses.begin(), aCollapses.end(),
+              [](const Collapse& theLeft, const Collapse& theRight) { return theLeft.Cost < theRight.Cost; });
+
+    // each collapse removes about 2 triangles
+    const int aMaxCollapses = ((int )aTris.size() - theTargetNbTriangles) / 2 + 1;
+    int aNbCollapsed = 0;
+    aTouched.assign(aNbNodes, false);
+    for (const Collapse& aCollapse : aCollapses)
+    {
+      if (aNbCollapsed >= aMaxCollapses)
+        break;
+      if (aTouched[aCollapse.From] || aTouched[aCollapse.To])
+        continue;
+
+      // reject collapses flipping remaining triangles
+      bool isFlipped = false;
+      for (int anAdjIter = aTriOffsets[aCollapse.From]; anAdjIter < aTriOffsets[aCollapse.From + 1] && !isFlipped; ++anAdjIter)
+      {
+        const Tri& aTri = aTris[aTriList[anAdjIter]];
+        if (aTri.Nodes[0] == aCollapse.To || aTri.Nodes[1] == aCollapse.To || aTri.Nodes[2] == aCollapse.To)
+          continue; // triangle becomes degenerated
+
+        gp_XYZ anOld[3], aNew[3];
+        for (int aNodeIter = 0; aNodeIter < 3; ++aNodeIter)
+        {
+          anOld[aNodeIter] = aPnts[aTri.Nodes[aNodeIter]];
+          aNew[aNodeIter]  = aTri.Nodes[aNodeIter] == aCollapse.From ? aPnts[aCollapse.To] : anOld[aNodeIter];
+        }
+        const gp_XYZ anOldNorm = (anOld[1] - anOld[0]).Crossed(anOld[2] - anOld[0]);
+        const gp_XYZ aNewNorm  = (aNew[1] - aNew[0]).Crossed(aNew[2] - aNew[0]);
+        isFlipped = anOldNorm.Dot(aNewNorm) <= 0.0;
+      }
+      if (isFlipped)
+        continue;
+
+      aRemap[aCollapse.From] = aCollapse.To;
+      aQuadrics[aCollapse.To].Add(aQuadrics[aCollapse.From]);
+      for (int anAdjIter = aTriOffsets[aCollapse.From]; anAdjIter < aTriOffsets[aCollapse.From + 1]; ++anAdjIter)
+      {
+        const Tri& aTri = aTris[aTriList[anAdjIter]];
+        for (int aNodeIter = 0; aNodeIter < 3; ++aNodeIter)
+          aTouched[aTri.Nodes[aNodeIter]] = true;
+      }
+      ++aNbCollapsed;
+    }
+    if (aNbCollapsed == 0)
+      break;
+
+    // apply collapses and remove degenerated triangles
+    size_t aNbKept = 0;
+    for (size_t aTriIter = 0; aTriIter < aTris.size(); ++aTriIter)
+    {
+      Tri aTri = aTris[aTriIter];
+      for (int aNodeIter = 0; aNodeIter < 3; ++aNodeIter)
+        aTri.Nodes[aNodeIter] = aRemap[aTri.Nodes[aNodeIter]];
+
+      if (aTri.Nodes[0] != aTri.Nodes[1]
+       && aTri.Nodes[0] != aTri.Nodes[2]
+       && aTri.Nodes[1] != aTri.Nodes[2])
+      {
+        aTris[aNbKept++] = aTri;
+      }
+    }
+    aTris.resize(aNbKept);
+  }
+
+  // compact remaining nodes in order of their use
+  std::vector<int> aNewIndices(aNbNodes, 0);
+  int aNbUsed = 0;
+  for (const Tri& aTri : aTris)
+  {
+    for (int aNodeIter = 0; aNodeIter < 3; ++aNodeIter)
+    {
+      if (aNewIndices[aTri.Nodes[aNodeIter]] == 0)
+        aNewIndices[aTri.Nodes[aNodeIter]] = ++aNbUsed;
+    }
+  }
+
+  Handle(Poly_Triangulation) aResult = new Poly_Triangulation();
+  aResult->SetDoublePrecision(false);
+  aResult->ResizeNodes(aNbUsed, false);
+  aResult->ResizeTriangles((int )aTris.size(), false);
+  Bnd_Box aBox;
+  for (int aNodeIter = 0; aNodeIter < aNbNodes; ++aNodeIter)
+  {
+    if (aNewIndices[aNodeIter] != 0)
+    {
+      aResult->SetNode(aNewIndices[aNodeIter], gp_Pnt(aPnts[aNodeIter]));
+      aBox.Add(gp_Pnt(aPnts[aNodeIter]));
+    }
+  }
+  for (size_t aTriIter = 0; aTriIter < aTris.size(); ++aTriIter)
+  {
+    const Tri& aTri = aTris[aTriIter];
+    aResult->SetTriangle((int )aTriIter + 1, Poly_Triangle(aNewIndices[aTri.Nodes[0]], aNewIndices[aTri.Nodes[1]], aNewIndices[aTri.Nodes[2]]));
+  }
+  aResult->SetCachedMinMax(aBox);
+  return aResult;
+}
+
+// ================================================================
+// Function : BuildLevels
+// ================================================================
+NCollection_Vector<Handle(Poly_Triangulation)> OcctLodMesh::BuildLevels(const Handle(Poly_Triangulation)& theTris,
+                                                                        int theMaxLevels,
+                                                                        int theMinTriangles)
+{
+  NCollection_Vector<Handle(Poly_Triangulation)> aLevels;
+  aLevels.Append(theTris);
+  while (aLevels.Size() < theMaxLevels)
+  {
+    const Handle(Poly_Triangulation) aPrev = aLevels.Last();
+    const int aTarget = aPrev->NbTriangles() / 4;
+    if (aTarget < theMinTriangles)
+      break;
+
+    // simplification might stop much earlier on chunks with long borders
+    Handle(Poly_Triangulation) aLevel = Simplify(aPrev, aTarget);
+    if (aLevel->NbTriangles() > aPrev->NbTriangles() * 3 / 4)
+      break;
+
+    aLevels.Append(aLevel);
+  }
+  return aLevels;
+}
+
+// ================================================================
+// Function : Benchmark
+// ================================================================
+void OcctLodMesh::Benchmark(const Handle(AIS_InteractiveContext)& theCtx,
+                            const Handle(V3d_View)& theView,
+                            int theNbTriangles)
+{
+  const int aNbTriangles = theNbTriangles > 0 ? theNbTriangles : 4000000;
+  const int aNbFrames = 100;
+  Handle(OpenGl_Context) aGlCtx = OcctGlTools::GetGlContext(theView);
+
+  // wavy surface tessellated by regular grid, split into chunks of rows (~262144 triangles per chunk)
+  const int aGridSize = OcctMeshTools::GridSize(aNbTriangles);
+  const int aChunkRows = std::max(131072 / aGridSize, 1);
+  Handle(OcctLodMesh) aMesh = new OcctLodMesh();
+  for (int aRowIter = 0; aRowIter < aGridSize; aRowIter += aChunkRows)
+  {
+    NCollection_Vector<Handle(Poly_Triangulation)> aLevels;
+    aLevels.Append(OcctMeshTools::WavyGrid(aGridSize, aRowIter, aChunkRows));
+    aMesh->AddChunk(aLevels);
+  }
+
+  theCtx->Display(aMesh, 0, -1, false);
+  Handle(Graphic3d_Camera) aCamBack = new Graphic3d_Camera(theView->Camera());
+  theView->FitAll(0.01, false);
+
+  Message::SendInfo() << "OcctLodMesh benchmark, " << aMesh->NbFullTriangles() << " triangles in " << aMesh->NbChunks() << " chunks, "
+                      << aNbFrames << " frames of camera orbiting";
+  static const char* THE_CONFIGS[] = { "Default layout (24 bytes per vertex)", "Compact layout (8 bytes per vertex)" };
+  for (int aConfIter = 0; aConfIter < 2; ++aConfIter)
+  {
+    aMesh->SetCompactVertices(aConfIter == 1);
+
+    // warm-up frame uploading arrays and compiling shaders
+    theView->Invalidate();
+    theView->Redraw();
+    aGlCtx->core11fwd->glFinish();
+
+    OSD_Timer aTimer;
+    aTimer.Start();
+    for (int aFrameIter = 0; aFrameIter < aNbFrames; ++aFrameIter)
+    {
+      const Handle(Graphic3d_Camera)& aCam = theView->Camera();
+      gp_Trsf aRot;
+      aRot.SetRotation(gp_Ax1(aCam->Center(), aCam->Up()), 2.0 * M_PI / aNbFrames);
+      aCam->Transform(aRot);
+      theView->Invalidate();
+      theView->Redraw();
+    }
+    aGlCtx->core11fwd->glFinish();
+    aTimer.Stop();
+
+    // whole mesh is within the view, so that all vertex and index data is fetched every frame
+    const double aFrameTime = aTimer.ElapsedTime() / aNbFrames;
+    const Standard_Size aGpuBytes = OcctMemoryReport::EstimateGpuBytes(aMesh);
+    Message::SendInfo() << THE_CONFIGS[aConfIter] << ": GPU geometry " << (double(aGpuBytes) / (1024.0 * 1024.0)) << " MiB, "
+                        << (aFrameTime * 1000.0) << " ms/frame ("
+                        << (aFrameTime > 0.0 ? 1.0 / aFrameTime : 0.0) << " fps), vertex fetch "
+                        << (aFrameTime > 0.0 ? double(aGpuBytes) / aFrameTime / 1.0e9 : 0.0) << " GB/s";
+  }
+
+  theView->Camera()->Copy(aCamBack);
+  theCtx->Remove(aMesh, false);
+  theView->Invalidate();
+}
+
+// ================================================================
+// Function : OcctLodMesh
+// ================================================================
+OcctLodMesh::OcctLodMesh()
+{
+  myDrawer->SetShadingAspect(new Prs3d_ShadingAspect());
+  myDrawer->ShadingAspect()->SetMaterial(Graphic3d_NameOfMaterial_Plastified);
+  myDrawer->ShadingAspect()->SetColor(Quantity_NOC_GRAY70);
+  SetDisplayMode(0);
+  SetInfiniteState(false);
+}
+
+// ================================================================
+// Function : AddChunk
+// ================================================================
+int OcctLodMesh::AddChunk(const NCollection_Vector<Handle(Poly_Triangulation)>& theLevels)
+{
+  return addChunk(theLevels, Handle(Graphic3d_Aspects)());
+}
+
+// ================================================================
+// Function : AddChunk
+// ================================================================
+int OcctLodMesh::AddChunk(const NCollection_Vector<Handle(Poly_Triangulation)>& theLevels,
+                          const Quantity_ColorRGBA& theColor)
+{
+  Handle(Prs3d_ShadingAspect) anAspect = new Prs3d_ShadingAspect();
+  anAspect->SetMaterial(myDrawer->ShadingAspect()->Material());
+  anAspect->SetColor(theColor.GetRGB());
+  anAspect->SetTransparency(1.0 - theColor.Alpha());
+  return addChunk(theLevels, anAspect->Aspect());
+}
+
+// ================================================================
+// Function : addChunk
+// ================================================================
+int OcctLodMesh::addChunk(const NCollection_Vector<Handle(Poly_Triangulation)>& theLevels,
+                          const Handle(Graphic3d_Aspects)& theAspect)
+{
+  Chunk& aChunk = myChunks.Appended();
+  aChunk.Levels = theLevels;
+  aChunk.Aspect = theAspect;
+  theLevels.First()->MinMax(aChunk.Box, gp_Trsf());
+  myNbFullTriangles += theLevels.First()->NbTriangles();
+  for (NCollection_Vector<Handle(Poly_Triangulation)>::Iterator aLevelIter(theLevels); aLevelIter.More(); aLevelIter.Next())
+  {
+    myLevelsMemory += aLevelIter.Value()->NbNodes() * int64_t(sizeof(Graphic3d_Vec3))
+                    + aLevelIter.Value()->NbTriangles() * int64_t(sizeof(Poly_Triangle));
+  }
+
+  // streamed chunk outside of quantization box - re-upload already displayed chunks
+  if (myToUseCompact
+  && !myPrs.IsNull()
+  &&  updateCompactBox(aChunk.Box))
+  {
+    for (NCollection_Vector<Chunk>::Iterator aChunkIter(myChunks); aChunkIter.More(); aChunkIter.Next())
+    {
+      if (aChunkIter.Value().Level != -1)
+        setChunkLevel(aChunkIter.ChangeValue(), aChunkIter.Value().Level);
+    }
+  }
+
+  setChunkLevel(aChunk, theLevels.Size() - 1);
+  if (!myPrs.IsNull())
+    myPrs->CalculateBoundBox();
+  return myChunks.Size() - 1;
+}
+
+// ================================================================
+// Function : ClearChunks
+// ================================================================
+void OcctLodMesh::ClearChunks()
+{
+  for (NCollection_Vector<Chunk>::Iterator aChunkIter(myChunks); aChunkIter.More(); aChunkIter.Next())
+  {
+    if (!aChunkIter.Value().Group.IsNull())
+      aChunkIter.ChangeValue().Group->Remove();
+  }
+  myChunks.Clear();
+  myNbDisplayedTriangles = 0;
+  myNbFullTriangles = 0;
+  myLevelsMemory = 0;
+}
+
+// ================================================================
+// Function : SetCompactVertices
+// ================================================================
+void OcctLodMesh::SetCompactVertices(bool theToUse)
+{
+  if (myToUseCompact == theToUse)
+    return;
+
+  myToUseCompact = theToUse;
+  myCompactBox.SetVoid();
+  myCompactProgram.Nullify();
+  if (myPrs.IsNull())
+    return;
+
+  Bnd_Box aBox;
+  for (NCollection_Vector<Chunk>::Iterator aChunkIter(myChunks); aChunkIter.More(); aChunkIter.Next())
+  {
+    aBox.Add(aChunkIter.Value().Box);
+  }
+  if (myToUseCompact)
+    updateCompactBox(aBox);
+
+  for (NCollection_Vector<Chunk>::Iterator aChunkIter(myChunks); aChunkIter.More(); aChunkIter.Next())
+  {
+    setChunkLevel(aChunkIter.ChangeValue(), aChunkIter.Value().Level);
+  }
+}
+
+// ================================================================
+// Function : updateCompactBox
+// ================================================================
+bool OcctLodMesh::updateCompactBox(const Bnd_Box& theBox)
+{
+  if (theBox.IsVoid())
+    return false;
+  if (!myCompactProgram.IsNull()
+   && !myCompactBox.IsOut(theBox.CornerMin())
+   && !myCompactBox.IsOut(theBox.CornerMax()))
+  {
+    return false;
+  }
+
+  // quantization step is defined by the exact box of chunks to keep full 16-bit precision
+  myCompactBox.Add(theBox);
+  updateCompactProgram();
+  return true;
+}
+
+// ================================================================
+// Function : updateCompactLights
+// ================================================================
+bool OcctLodMesh::updateCompactLights(const Handle(V3d_View)& theView)
+{
+  Graphic3d_Vec3 anAmbient(0.0f), aLightColor(0.0f);
+  Graphic3d_Vec4 aLightDir(0.0f, 0.0f, 1.0f, 1.0f);
+  int  aNbDirectional = 0;
+  bool isSupported = true;
+  for (V3d_ListOfLightIterator aLightIter(theView->ActiveLightIterator()); aLightIter.More(); aLightIter.Next())
+  {
+    const Handle(V3d_Light)& aLight = aLightIter.Value();
+    if (!aLight->IsEnabled())
+      continue;
+
+    const Graphic3d_Vec3 aColor = aLight->Color().Rgb() * float(aLight->Intensity());
+    if (aLight->Type() == Graphic3d_TOLS_AMBIENT)
+    {
+      anAmbient += aColor;
+    }
+    else if (aLight->Type() == Graphic3d_TOLS_DIRECTIONAL
+          && ++aNbDirectional == 1)
+    {
+      // direction to the light; headlight direction is defined in view space
+      const gp_Dir aDir = aLight->Direction();
+      aLightDir = Graphic3d_Vec4(-float(aDir.X()), -float(aDir.Y()), -float(aDir.Z()), aLight->IsHeadlight() ? 1.0f : 0.0f);
+      aLightColor = aColor;
+    }
+    else
+    {
+      isSupported = false;
+    }
+  }
+  if (isSupported  == myIsCompactLit
+   && anAmbient    == myCompactAmbient
+   && aLightDir    == myCompactLightDir
+   && aLightColor  == myCompactLightColor)
+  {
+    return false;
+  }
+
+  myIsCompactLit = isSupported;
+  myCompactAmbient = anAmbient;
+  myCompactLightDir = aLightDir;
+  myCompactLightColor = aLightColor;
+  if (!myCompactProgram.IsNull())
+    updateCompactProgram();
+  return true;
+}
+
+// ================================================================
+// Function : updateCompactProgram
+// ================================================================
+void OcctLodMesh::updateCompactProgram()
+{
+  // quantization box and lights are passed to the program as uniforms, so that all chunks share the same program
+  const gp_XYZ aRange = myCompactBox.CornerMax().XYZ() - myCompactBox.CornerMin().XYZ();
+  Graphic3d_ShaderAttributeList anAttribs;
+  anAttribs.Append(new Graphic3d_ShaderAttribute("compactY", Graphic3d_TOA_CUSTOM));
+  anAttribs.Append(new Graphic3d_ShaderAttribute("compactZ", Graphic3d_TOA_CUSTOM + 1));
+  myCompactProgram = new Graphic3d_ShaderProgram();
+  myCompactProgram->SetVertexAttributes(anAttribs);
+  myCompactProgram->SetNbClipPlanesMax(Graphic3d_ShaderProgram::THE_MAX_CLIP_PLANES_DEFAULT);
+  myCompactProgram->AttachShader(Graphic3d_ShaderObject::CreateFromSource(Graphic3d_TOS_VERTEX,   THE_COMPACT_VERT_SHADER));
+  myCompactProgram->AttachShader(Graphic3d_ShaderObject::CreateFromSource(Graphic3d_TOS_FRAGMENT, THE_COMPACT_FRAG_SHADER));
+  myCompactProgram->PushVariableVec3("compactMin", Graphic3d_Vec3(float(myCompactBox.CornerMin().X()),
+                                                                  float(myCompactBox.CornerMin().Y()),
+                                                                  float(myCompactBox.CornerMin().Z())));
+  myCompactProgram->PushVariableVec3("compactRange", Graphic3d_Vec3(float(Max(aRange.X(), 1.0e-7)),
+                                                                    float(Max(aRange.Y(), 1.0e-7)),
+                                                                    float(Max(aRange.Z(), 1.0e-7))));
+  myCompactProgram->PushVariableVec3("compactAmbient", myCompactAmbient);
+  myCompactProgram->PushVariableVec4("compactLightDir", myCompactLightDir);
+  myCompactProgram->PushVariableVec3("compactLightColor", myCompactLightColor);
+}
+
+// ================================================================
+// Function : addCompactArrays
+// ================================================================
+void OcctLodMesh::addCompactArrays(const Handle(Graphic3d_Group)& theGroup,
+                                   const Handle(Poly_Triangulation)& theTris) const
+{
+  static const Graphic3d_Attribute THE_ATTRIBS[4] =
+  {
+    { Graphic3d_TOA_POS,  Graphic3d_TOD_USHORT },
+    { Graphic3d_TOA_CUSTOM, Graphic3d_TOD_USHORT },
+    { (Graphic3d_TypeOfAttribute )(Graphic3d_TOA_CUSTOM + 1), Graphic3d_TOD_USHORT },
+    { Graphic3d_TOA_NORM, Graphic3d_TOD_USHORT }
+  };
+
+  const gp_XYZ aMin = myCompactBox.CornerMin().XYZ();
+  const gp_XYZ aRange = myCompactBox.CornerMax().XYZ() - aMin;
+  const double aScale[3] = { aRange.X() > 0.0 ? 65535.0 / aRange.X() : 0.0,
+                             aRange.Y() > 0.0 ? 65535.0 / aRange.Y() : 0.0,
+                             aRange.Z() > 0.0 ? 65535.0 / aRange.Z() : 0.0 };
+  const std::vector<Graphic3d_Vec3> aNormals = computeNormals(theTris);
+  const int aNbTris = theTris->NbTriangles();
+
+  // split triangulation into consecutive ranges of triangles referring no more than 65535 nodes
+  std::vector<int> aLocalIndices(theTris->NbNodes(), -1);
+  std::vector<int> aPartNodes;
+  aPartNodes.reserve(THE_MAX_COMPACT_NODES);
+  int aPartFirstTri = 1;
+  for (int aTriIter = 1; aTriIter <= aNbTris + 1; ++aTriIter)
+  {
+    int aNodes[3] = { 0, 0, 0 };
+    int aNbNew = 0;
+    if (aTriIter <= aNbTris)
+    {
+      theTris->Triangle(aTriIter).Get(aNodes[0], aNodes[1], aNodes[2]);
+      for (int aNodeIter = 0; aNodeIter < 3; ++aNodeIter)
+      {
+        if (aLocalIndices[aNodes[aNodeIter] - 1] == -1)
+          ++aNbNew;
+      }
+    }
+    if (!aPartNodes.empty()
+     && (aTriIter > aNbTris || (int )aPartNodes.size() + aNbNew > THE_MAX_COMPACT_NODES))
+    {
+      Handle(Graphic3d_Buffer) anAttribs = new Graphic3d_Buffer(NCollection_BaseAllocator::CommonBaseAllocator());
+      Handle(Graphic3d_IndexBuffer) anIndices = new Graphic3d_IndexBuffer(NCollection_BaseAllocator::CommonBaseAllocator());
+      if (!anAttribs->Init((int )aPartNodes.size(), THE_ATTRIBS, 4)
+       || !anIndices->Init<unsigned short>((aTriIter - aPartFirstTri) * 3))
+      {
+        Message::SendFail() << "Error: unable to allocate compact vertex arrays";
+        return;
+      }
+
+      CompactVertex* aVerts = reinterpret_cast<CompactVertex*>(anAttribs->ChangeData());
+      for (size_t aNodeIter = 0; aNodeIter < aPartNodes.size(); ++aNodeIter)
+      {
+        const gp_XYZ aPnt = theTris->Node(aPartNodes[aNodeIter] + 1).XYZ() - aMin;
+        CompactVertex& aVert = aVerts[aNodeIter];
+        for (int aCoordIter = 0; aCoordIter < 3; ++aCoordIter)
+        {
+          const double aValue = std::floor(aPnt.Coord(aCoordIter + 1) * aScale[aCoordIter] + 0.5);
+          aVert.Pos[aCoordIter] = uint16_t(std::min(std::max(aValue, 0.0), 65535.0));
+        }
+        aVert.Normal = encodeOctNormal(aNormals[aPartNodes[aNodeIter]]);
+      }
+      int anIndexIter = 0;
+      for (int aPartTriIter = aPartFirstTri; aPartTriIter < aTriIter; ++aPartTriIter)
+      {
+        int aTriNodes[3] = { 0, 0, 0 };
+        theTris->Triangle(aPartTriIter).Get(aTriNodes[0], aTriNodes[1], aTriNodes[2]);
+        for (int aNodeIter = 0; aNodeIter < 3; ++aNodeIter)
+          anIndices->SetIndex(anIndexIter++, aLocalIndices[aTriNodes[aNodeIter] - 1]);
+      }
+      theGroup->AddPrimitiveArray(Graphic3d_TOPA_TRIANGLES, anIndices, anAttribs, Handle(Graphic3d_BoundBuffer)(), false);
+
+      for (int aNode : aPartNodes)
+        aLocalIndices[aNode] = -1;
+      aPartNodes.clear();
+      aPartFirstTri = aTriIter;
+    }
+    if (aTriIter > aNbTris)
+      break;
+
+    for (int aNodeIter = 0; aNodeIter < 3; ++aNodeIter)
+    {
+      int& aLocal = aLocalIndices[aNodes[aNodeIter] - 1];
+      if (aLocal == -1)
+      {
+        aLocal = (int )aPartNodes.size();
+        aPartNodes.push_back(aNodes[aNodeIter] - 1);
+      }
+    }
+  }
+}
+
+// ================================================================
+// Function : setChunkLevel
+// ================================================================
+void OcctLodMesh::setChunkLevel(Chunk& theChunk, int theLevel)
+{
+  if (theChunk.Level != -1)
+    myNbDisplayedTriangles -= theChunk.Levels.Value(theChunk.Level)->NbTriangles();
+
+  theChunk.Level = theLevel;
+  myNbDisplayedTriangles += theChunk.Levels.Value(theLevel)->NbTriangles();
+  if (!theChunk.Group.IsNull())
+  {
+    theChunk.Group->Remove();
+    theChunk.Group.Nullify();
+  }
+  if (myPrs.IsNull())
+    return;
+
+  // array data is released by OpenGL driver after uploading into GPU memory
+  theChunk.Group = myPrs->NewGroup();
+  Handle(Graphic3d_Aspects) anAspect = theChunk.Aspect;
+  if (anAspect.IsNull())
+    anAspect = myDrawer->ShadingAspect()->Aspect();
+  if (myToUseCompact
+   && myIsCompactLit
+  && !myCompactProgram.IsNull())
+  {
+    anAspect = new Graphic3d_Aspects(*anAspect);
+    anAspect->SetShaderProgram(myCompactProgram);
+    theChunk.Group->SetGroupPrimitivesAspect(anAspect);
+    addCompactArrays(theChunk.Group, theChunk.Levels.Value(theLevel));
+  }
+  else
+  {
+    theChunk.Group->SetGroupPrimitivesAspect(anAspect);
+    theChunk.Group->AddPrimitiveArray(createArray(theChunk.Levels.Value(theLevel)), false);
+  }
+  if (!theChunk.Box.IsVoid())
+  {
+    const gp_Pnt aMin = theChunk.Box.CornerMin(), aMax = theChunk.Box.CornerMax();
+    theChunk.Group->SetMinMaxValues(aMin.X(), aMin.Y(), aMin.Z(), aMax.X(), aMax.Y(), aMax.Z());
+  }
+}
+
+// ================================================================
+// Function : createArray
+// ================================================================
+Handle(Graphic3d_ArrayOfTriangles) OcctLodMesh::createArray(const Handle(Poly_Triangulation)& theTris)
+{
+  const int aNbNodes = theTris->NbNodes();
+  const int aNbTris  = theTris->NbTriangles();
+
+  const std::vector<Graphic3d_Vec3> aNormals = computeNormals(theTris);
+  Handle(Graphic3d_ArrayOfTriangles) anArray = new Graphic3d_ArrayOfTriangles(aNbNodes, aNbTris * 3, Graphic3d_ArrayFlags_VertexNormal);
+  for (int aNodeIter = 1; aNodeIter <= aNbNodes; ++aNodeIter)
+  {
+    const gp_Pnt aPnt = theTris->Node(aNodeIter);
+    const Graphic3d_Vec3& aNorm = aNormals[aNodeIter - 1];
+    anArray->AddVertex(float(aPnt.X()), float(aPnt.Y()), float(aPnt.Z()), aNorm.x(), aNorm.y(), aNorm.z());
+  }
+  for (int aTriIter = 1; aTriIter <= aNbTris; ++aTriIter)
+  {
+    int aNodes[3] = { 0, 0, 0 };
+    theTris->Triangle(aTriIter).Get(aNodes[0], aNodes[1], aNodes[2]);
+    anArray->AddEdges(aNodes[0], aNodes[1], aNodes[2]);
+  }
+  return anArray;
+}
+
+// ================================================================
+// Function : Compute
+// ================================================================
+void OcctLodMesh::Compute(const Handle(PrsMgr_PresentationManager)& ,
+                          const Handle(Prs3d_Presentation)& thePrs,
+                          const int theMode)
+{
+  if (theMode != 0)
+    return;
+
+  myPrs = thePrs;
+  if (myToUseCompact)
+  {
+    Bnd_Box aBox;
+    for (NCollection_Vector<Chunk>::Iterator aChunkIter(myChunks); aChunkIter.More(); aChunkIter.Next())
+    {
+      aBox.Add(aChunkIter.Value().Box);
+    }
+    myCompactBox.SetVoid();
+    myCompactProgram.Nullify();
+    updateCompactBox(aBox);
+  }
+  for (NCollection_Vector<Chunk>::Iterator aChunkIter(myChunks); aChunkIter.More(); aChunkIter.Next())
+  {
+    Chunk& aChunk = aChunkIter.ChangeValue();
+    aChunk.Group.Nullify(); // groups of previous presentation are already cleared
+    setChunkLevel(aChunk, aChunk.Level);
+  }
+}
+
+// ================================================================
+// Function : ComputeSelection
+// ================================================================
+void OcctLodMesh::ComputeSelection(const Handle(SelectMgr_Selection)& theSel,
+                                   const int theMode)
+{
+  if (theMode != 0)
+    return;
+
+  Handle(SelectMgr_EntityOwner) anOwner = new SelectMgr_EntityOwner(this);
+  for (NCollection_Vector<Chunk>::Iterator aChunkIter(myChunks); aChunkIter.More(); aChunkIter.Next())
+  {
+    if (!aChunkIter.Value().Box.IsVoid())
+      theSel->Add(new Select3D_SensitiveBox(anOwner, aChunkIter.Value().Box));
+  }
+}
+
+// ================================================================
+// Function : UpdateLevels
+// ================================================================
+bool OcctLodMesh::UpdateLevels(const Handle(V3d_View)& theView)
+{
+  if (myPrs.IsNull() || myChunks.IsEmpty() || theView->Window().IsNull())
+    return false;
+
+  if (myToUseCompact
+   && updateCompactLights(theView))
+  {
+    // lights are passed to compact program as uniforms, and unsupported lighting switches chunks to default layout
+    for (NCollection_Vector<Chunk>::Iterator aChunkIter(myChunks); aChunkIter.More(); aChunkIter.Next())
+    {
+      if (aChunkIter.Value().Level != -1)
+        setChunkLevel(aChunkIter.ChangeValue(), aChunkIter.Value().Level);
+    }
+    theView->Invalidate();
+  }
+
+  const Handle(Graphic3d_Camera)& aCam = theView->Camera();
+  Graphic3d_Vec2i aWinSize;
+  theView->Window()->Size(aWinSize.x(), aWinSize.y());
+  const gp_Trsf aTrsf = LocalTransformation();
+  Graphic3d_Mat4d aModelMat;
+  aTrsf.GetMat4(aModelMat);
+
+  Graphic3d_CullingTool aCuller;
+  aCuller.SetViewVolume(aCam, aModelMat);
+  aCuller.SetViewportSize(aWinSize.x(), aWinSize.y(), 1.0);
+  Graphic3d_CullingTool::CullingContext aCullCtx;
+  aCuller.SetCullingDistance(aCullCtx, -1.0);
+  aCuller.SetCullingSize(aCullCtx, -1.0);
+
+  std::vector<std::pair<double, int>> aSwitches;
+  std::vector<int> aWantedLevels(myChunks.Size(), 0);
+  for (int aChunkIter = 0; aChunkIter < myChunks.Size(); ++aChunkIter)
+  {
+    const Chunk& aChunk = myChunks.Value(aChunkIter);
+    if (aChunk.Levels.Size() < 2
+     || aChunk.Box.IsVoid())
+    {
+      continue;
+    }
+
+    const gp_Pnt aBoxMin = aChunk.Box.CornerMin(), aBoxMax = aChunk.Box.CornerMax();
+    const Graphic3d_Vec3d aMin(aBoxMin.X(), aBoxMin.Y(), aBoxMin.Z());
+    const Graphic3d_Vec3d aMax(aBoxMax.X(), aBoxMax.Y(), aBoxMax.Z());
+    int aLevel = aChunk.Levels.Size() - 1;
+    double aSizePx = 0.0;
+    if (!aCuller.IsCulled(aCullCtx, aMin, aMax))
+    {
+      // projected size of chunk diagonal in pixels
+      gp_Pnt aCenter((aMin.x() + aMax.x()) * 0.5, (aMin.y() + aMax.y()) * 0.5, (aMin.z() + aMax.z()) * 0.5);
+      aCenter.Transform(aTrsf);
+      const double aDiag  = (aMax - aMin).Modulus() * aTrsf.ScaleFactor();
+      const double aDepth = gp_Vec(aCam->Eye(), aCenter).Dot(gp_Vec(aCam->Direction()));
+      const double aViewHeight = aDepth > aCam->ZNear() ? aCam->ViewDimensions(aDepth).Y() : 0.0;
+      aSizePx = aViewHeight > 0.0 ? aDiag / aViewHeight * aWinSize.y() : double(aWinSize.y());
+
+      // the coarsest level having enough triangles for the projected area
+      const double aWantedTris = aSizePx * aSizePx * 0.5 * myTriangleDensity;
+      while (aLevel > 0
+          && aChunk.Levels.Value(aLevel)->NbTriangles() < aWantedTris)
+      {
+        --aLevel;
+      }
+    }
+    if (aLevel != aChunk.Level)
+    {
+      aWantedLevels[aChunkIter] = aLevel;
+      aSwitches.push_back(std::make_pair(aSizePx, aChunkIter));
+    }
+  }
+  if (aSwitches.empty())
+    return false;
+
+  // re-upload limited number of chunks per frame starting from larger ones
+  std::sort(aSwitches.begin(), aSwitches.end(),
+            [](const std::pair<double, int>& theLeft, const std::pair<double, int>& theRight)
+            { return theLeft.first > theRight.first; });
+  const int aNbSwitches = std::min((int )aSwitches.size(), myMaxSwitches);
+  for (int aSwitchIter = 0; aSwitchIter < aNbSwitches; ++aSwitchIter)
+  {
+    const int aChunkIter = aSwitches[aSwitchIter].second;
+    setChunkLevel(myChunks.ChangeValue(aChunkIter), aWantedLevels[aChunkIter]);
+  }
+  theView->Invalidate();
+  return (int )aSwitches.size() > aNbSwitches;
+}
@@ -0,0 +1,184 @@
+// Copyright (c) 2026 Kirill Gavrilov
+
+#ifndef _OcctLodMesh_HeaderFile
+#define _OcctLodMesh_HeaderFile
+
+#include <AIS_InteractiveObject.hxx>
+#include <Bnd_Box.hxx>
+#include <Graphic3d_ArrayOfTriangles.hxx>
+#include <Graphic3d_ShaderProgram.hxx>
+#include <NCollection_Vector.hxx>
+#include <Poly_Triangulation.hxx>
+#include <Quantity_ColorRGBA.hxx>
+#include <V3d_View.hxx>
+
+//! Presentation of triangulation-only mesh (without B-Rep to re-tessellate) split into chunks,
+//! each chunk having several levels of detail.
+//!
+//! Coarser levels are built by BuildLevels() using edge collapse simplification driven by quadric error metrics;
+//! it is expected to be called from worker threads. Vertices on open boundaries are never collapsed,
+//! so that neighboring chunks displayed at different levels keep sharing the same border without cracks.
+//!
+//! UpdateLevels() should be called before redrawing the view: it selects the level of each chunk
+//! from its projected screen size (TriangleDensity() triangles per pixel area) and rebuilds groups
+//! of chunks which level has been changed; chunks outside of view frustum are switched to the coarsest level.
+//!
+//! Optional compact vertex layout (SetCompactVertices()) uploads 8 bytes per vertex instead of 24:
+//! positions quantized to 16 bits within the exact bounding box of the chunks, normals octahedral-encoded into 16 bits,
+//! and 16-bit indices (chunks are split into parts with no more than 65535 nodes).
+//! The layout is decoded by a custom GLSL program applying view and object clipping planes and material colors
+//! lit by ambient and a single directional light of the view (taken by UpdateLevels());
+//! other lighting setups (several directional, positional or spot lights) fall back to the default layout.
+class OcctLodMesh : public AIS_InteractiveObject
+{
+  DEFINE_STANDARD_RTTI_INLINE(OcctLodMesh, AIS_InteractiveObject)
+public:
+
+  //! Simplify triangulation by edge collapses down to target number of triangles (or until no collapse is possible).
+  //! @return new single-precision triangulation
+  static Handle(Poly_Triangulation) Simplify(const Handle(Poly_Triangulation)& theTris,
+                                             int theTargetNbTriangles);
+
+  //! Build levels of detail: the first level is the input triangulation,
+  //! and each next level has ~4 times less triangles than previous one.
+  //! @param[in] theTris         input triangulation
+  //! @param[in] theMaxLevels    maximum number of levels including the input one
+  //! @param[in] theMinTriangles coarser level is not built for smaller triangulations
+  static NCollection_Vector<Handle(Poly_Triangulation)> BuildLevels(const Handle(Poly_Triangulation)& theTris,
+                                                                    int theMaxLevels = 5,
+                                                                    int theMinTriangles = 512);
+
+  //! Benchmark comparing default and compact vertex layouts on tessellated wavy surface of theNbTriangles triangles:
+  //! prints GPU memory, frame time of camera orbiting and resulting vertex fetch bandwidth.
+  static void Benchmark(const Handle(AIS_InteractiveContext)& theCtx,
+                        const Handle(V3d_View)& theView,
+                        int theNbTriangles);
+
+public:
+
+  //! Empty constructor.
+  OcctLodMesh();
+
+  //! Add chunk with levels of detail (the finest first); should be called from GUI thread.
+  //! The chunk is shown at the coarsest level until the next UpdateLevels().
+  //! @return chunk index
+  int AddChunk(const NCollection_Vector<Handle(Poly_Triangulation)>& theLevels);
+
+  //! Add chunk with its own color.
+  int AddChunk(const NCollection_Vector<Handle(Poly_Triangulation)>& theLevels,
+               const Quantity_ColorRGBA& theColor);
+
+  //! Remove all chunks.
+  void ClearChunks();
+
+  //! Return number of chunks.
+  int NbChunks() const { return myChunks.Size(); }
+
+  //! Return levels of the chunk.
+  const NCollection_Vector<Handle(Poly_Triangulation)>& ChunkLevels(int theChunk) const { return myChunks.Value(theChunk).Levels; }
+
+  //! Return number of triangles within displayed levels.
+  int64_t NbDisplayedTriangles() const { return myNbDisplayedTriangles; }
+
+  //! Return number of triangles within the finest levels.
+  int64_t NbFullTriangles() const { return myNbFullTriangles; }
+
+  //! Return memory occupied by triangulations of all levels in bytes.
+  int64_t LevelsMemory() const { return myLevelsMemory; }
+
+  //! Return requested number of triangles per pixel of projected chunk area (0.25 by default).
+  float TriangleDensity() const { return myTriangleDensity; }
+
+  //! Set requested number of triangles per pixel.
+  void SetTriangleDensity(float theDensity) { myTriangleDensity = theDensity; }
+
+  //! Return maximum number of chunks re-uploaded per frame (16 by default).
+  int MaxSwitchesPerFrame() const { return myMaxSwitches; }
+
+  //! Set maximum number of chunks re-uploaded per frame.
+  void SetMaxSwitchesPerFrame(int theNbChunks) { myMaxSwitches = theNbChunks; }
+
+  //! Return TRUE if compact vertex layout is used (FALSE by default).
+  bool ToUseCompactVertices() const { return myToUseCompact; }
+
+  //! Set if compact vertex layout should be used; re-uploads displayed chunks when changed.
+  void SetCompactVertices(bool theToUse);
+
+  //! Select chunk levels for the view camera; should be called from GUI thread before redrawing the view.
+  //! @return TRUE if some chunks are still waiting for switching and view should be redrawn once more
+  bool UpdateLevels(const Handle(V3d_View)& theView);
+
+public:
+
+  //! Return TRUE for supported display modes (only 0 is supported).
+  virtual bool AcceptDisplayMode(const int theMode) const override { return theMode == 0; }
+
+protected:
+
+  //! Compute presentation - adds chunks at their current levels.
+  virtual void Compute(const Handle(PrsMgr_PresentationManager)& thePrsMgr,
+                       const Handle(Prs3d_Presentation)& thePrs,
+                       const int theMode) override;
+
+  //! Compute selection - each chunk is selected by its bounding box.
+  virtual void ComputeSelection(const Handle(SelectMgr_Selection)& theSel,
+                                const int theMode) override;
+
+protected:
+
+  //! Mesh chunk.
+  struct Chunk
+  {
+    NCollection_Vector<Handle(Poly_Triangulation)> Levels; //!< levels of detail, the finest first
+    Bnd_Box                   Box;        //!< bounding box
+    Handle(Graphic3d_Aspects) Aspect;     //!< chunk aspect (NULL to use drawer)
+    int                       Level = -1; //!< displayed level
+    Handle(Graphic3d_Group)   Group;      //!< presentation group
+  };
+
+  //! Add chunk with specified aspect (NULL to use drawer).
+  int addChunk(const NCollection_Vector<Handle(Poly_Triangulation)>& theLevels,
+               const Handle(Graphic3d_Aspects)& theAspect);
+
+  //! Create triangulation array with smooth normals.
+  static Handle(Graphic3d_ArrayOfTriangles) createArray(const Handle(Poly_Triangulation)& theTris);
+
+  //! Add compact arrays of triangulation into the group.
+  void addCompactArrays(const Handle(Graphic3d_Group)& theGroup,
+                        const Handle(Poly_Triangulation)& theTris) const;
+
+  //! Extend quantization box of compact layout to include specified box.
+  //! When box is extended, the shader program is recreated and displayed chunks should be re-uploaded.
+  //! @return TRUE if box has been extended
+  bool updateCompactBox(const Bnd_Box& theBox);
+
+  //! Fetch lights of the view passed to compact program.
+  //! @return TRUE if lighting has been changed and displayed chunks should be re-created
+  bool updateCompactLights(const Handle(V3d_View)& theView);
+
+  //! (Re)create compact program for current quantization box and lights.
+  void updateCompactProgram();
+
+  //! (Re)create group of the chunk for specified level.
+  void setChunkLevel(Chunk& theChunk, int theLevel);
+
+protected:
+
+  NCollection_Vector<Chunk>  myChunks;
+  Handle(Prs3d_Presentation) myPrs;
+  int64_t myNbDisplayedTriangles = 0;
+  int64_t myNbFullTriangles = 0;
+  int64_t myLevelsMemory = 0;
+  float   myTriangleDensity = 0.25f;
+  int     myMaxSwitches = 16;
+  bool    myToUseCompact = false;
+  Bnd_Box myCompactBox;                             //!< quantization box of compact layout
+  Handle(Graphic3d_ShaderProgram) myCompactProgram; //!< program decoding compact layout
+  Graphic3d_Vec3  myCompactAmbient    = Graphic3d_Vec3(0.3f); //!< ambient light of compact program
+  Graphic3d_Vec4  myCompactLightDir   = Graphic3d_Vec4(0.0f, 0.0f, 1.0f, 1.0f); //!< direction to light, W=1 for headlight
+  Graphic3d_Vec3  myCompactLightColor = Graphic3d_Vec3(0.7f); //!< directional light color
+  bool            myIsCompactLit = true; //!< FALSE if view lighting cannot be reproduced by compact program
+
+};
+
+#endif // _OcctLodMesh_HeaderFile
@@ -0,0 +1,149 @@
+// Copyright (c) 2026 Kirill Gavrilov
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "OcctMappedFile.h"
+
+#include <Message.hxx>
+#include <TCollection_ExtendedString.hxx>
+
+#include <algorithm>
+
+// ================================================================
+// Function : Open
+// ================================================================
+bool OcctMappedFile::Open(const TCollection_AsciiString& thePath,
+                          bool theToAccessRandomly)
+{
+  Close();
+  myPath = thePath;
+#ifdef _WIN32
+  const TCollection_ExtendedString aPathW(thePath, true);
+  HANDLE aFile = ::CreateFileW(aPathW.ToWideString(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                               theToAccessRandomly ? FILE_FLAG_RANDOM_ACCESS : FILE_ATTRIBUTE_NORMAL, NULL);
+  if (aFile == INVALID_HANDLE_VALUE)
+  {
+    Message::SendFail() << "Error: unable to open file '" << thePath << "'";
+    return false;
+  }
+
+  LARGE_INTEGER aSize;
+  if (!::GetFileSizeEx(aFile, &aSize)
+   || aSize.QuadPart == 0)
+  {
+    Message::SendFail() << "Error: file '" << thePath << "' is empty";
+    ::CloseHandle(aFile);
+    return false;
+  }
+
+  HANDLE aMapping = ::CreateFileMappingW(aFile, NULL, PAGE_READONLY, 0, 0, NULL);
+  const void* aData = aMapping != NULL ? ::MapViewOfFile(aMapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+  if (aData == NULL)
+  {
+    Message::SendFail() << "Error: unable to map file '" << thePath << "'";
+    if (aMapping != NULL)
+      ::CloseHandle(aMapping);
+    ::CloseHandle(aFile);
+    return false;
+  }
+
+  myFile    = aFile;
+  myMapping = aMapping;
+  myData    = (const uint8_t* )aData;
+  mySize    = (uint64_t )aSize.QuadPart;
+#else
+  const int aFile = ::open(thePath.ToCString(), O_RDONLY);
+  if (aFile == -1)
+  {
+    Message::SendFail() << "Error: unable to open file '" << thePath << "'";
+    return false;
+  }
+
+  struct stat aStat;
+  if (::fstat(aFile, &aStat) != 0
+   || aStat.st_size == 0)
+  {
+    Message::SendFail() << "Error: file '" << thePath << "' is empty";
+    ::close(aFile);
+    return false;
+  }
+
+  void* aData = ::mmap(NULL, (size_t )aStat.st_size, PROT_READ, MAP_PRIVATE, aFile, 0);
+  if (aData == MAP_FAILED)
+  {
+    Message::SendFail() << "Error: unable to map file '" << thePath << "'";
+    ::close(aFile);
+    return false;
+  }
+  if (theToAccessRandomly)
+    ::madvise(aData, (size_t )aStat.st_size, MADV_RANDOM);
+
+  myFile = aFile;
+  myData = (const uint8_t* )aData;
+  mySize = (uint64_t )aStat.st_size;
+#endif
+  return true;
+}
+
+// ================================================================
+// Function : Close
+// ================================================================
+void OcctMappedFile::Close()
+{
+#ifdef _WIN32
+  if (myData != NULL)
+    ::UnmapViewOfFile(myData);
+  if (myMapping != NULL)
+    ::CloseHandle((HANDLE )myMapping);
+  if (myFile != NULL)
+    ::CloseHandle((HANDLE )myFile);
+  myMapping = NULL;
+  myFile = NULL;
+#else
+  if (myData != NULL)
+    ::munmap((void* )myData, (size_t )mySize);
+  if (myFile != -1)
+    ::close(myFile);
+  myFile = -1;
+#endif
+  myData = NULL;
+  mySize = 0;
+}
+
+// ================================================================
+// Function : ReleasePages
+// ================================================================
+void OcctMappedFile::ReleasePages(uint64_t theOffset, uint64_t theSize) const
+{
+  if (myData == NULL
+   || theOffset >= mySize)
+  {
+    return;
+  }
+
+#ifdef _WIN32
+  SYSTEM_INFO aSysInfo;
+  ::GetSystemInfo(&aSysInfo);
+  const uint64_t aPageSize = aSysInfo.dwPageSize;
+#else
+  const uint64_t aPageSize = (uint64_t )::sysconf(_SC_PAGESIZE);
+#endif
+  const uint64_t aFrom = (theOffset + aPageSize - 1) / aPageSize * aPageSize;
+  const uint64_t aTo   = (std::min)(theOffset + theSize, mySize) / aPageSize * aPageSize;
+  if (aTo <= aFrom)
+    return;
+
+#ifdef _WIN32
+  // unlocking pages which are not locked removes them from working set
+  ::VirtualUnlock((LPVOID )(myData + aFrom), (SIZE_T )(aTo - aFrom));
+#else
+  ::madvise((void* )(myData + aFrom), (size_t )(aTo - aFrom), MADV_DONTNEED);
+#endif
+}
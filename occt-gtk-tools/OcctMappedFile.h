@@ -0,0 +1,68 @@
+// Copyright (c) 2026 Kirill Gavrilov
+
+#ifndef _OcctMappedFile_HeaderFile
+#define _OcctMappedFile_HeaderFile
+
+#include <Standard_TypeDef.hxx>
+#include <TCollection_AsciiString.hxx>
+
+#include <cstdint>
+
+//! Read-only memory-mapped file.
+//! Pages are loaded on demand by the system and could be dropped at any time,
+//! so that process memory usage doesn't grow with file size.
+class OcctMappedFile
+{
+public:
+
+  //! Empty constructor.
+  OcctMappedFile() {}
+
+  //! Destructor, unmaps the file.
+  ~OcctMappedFile() { Close(); }
+
+  //! Map file into memory.
+  //! @param[in] thePath file path (UTF-8)
+  //! @param[in] theToAccessRandomly hint system that pages will be accessed in random order (no read-ahead)
+  bool Open(const TCollection_AsciiString& thePath,
+            bool theToAccessRandomly = false);
+
+  //! Unmap the file.
+  void Close();
+
+  //! Return TRUE if file is mapped.
+  bool IsOpen() const { return myData != NULL; }
+
+  //! Return mapped data.
+  const uint8_t* Data() const { return myData; }
+
+  //! Return file size in bytes.
+  uint64_t Size() const { return mySize; }
+
+  //! Hint system to drop already processed pages from process working set;
+  //! pages will be loaded again on next access. The range is shrunk to whole pages.
+  void ReleasePages(uint64_t theOffset, uint64_t theSize) const;
+
+  //! Return file path.
+  const TCollection_AsciiString& Path() const { return myPath; }
+
+private:
+
+  OcctMappedFile(const OcctMappedFile& ) = delete;
+  OcctMappedFile& operator=(const OcctMappedFile& ) = delete;
+
+private:
+
+  TCollection_AsciiString myPath;
+  const uint8_t* myData = NULL;
+  uint64_t       mySize = 0;
+#ifdef _WIN32
+  void*          myFile    = NULL; //!< file handle
+  void*          myMapping = NULL; //!< file mapping handle
+#else
+  int            myFile = -1;      //!< file descriptor
+#endif
+
+};
+
+#endif // _OcctMappedFile_HeaderFile
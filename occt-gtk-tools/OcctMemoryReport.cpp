@@ -0,0 +1,399 @@
+// Copyright (c) 2026 Kirill Gavrilov
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+#include "OcctMemoryReport.h"
+
+#include <AIS_ConnectedInteractive.hxx>
+#include <AIS_Shape.hxx>
+#include <BRep_CurveRepresentation.hxx>
+#include <BRep_TEdge.hxx>
+#include <BRep_TFace.hxx>
+#include <Geom_BezierSurface.hxx>
+#include <Geom_BSplineCurve.hxx>
+#include <Geom_BSplineSurface.hxx>
+#include <Geom_OffsetSurface.hxx>
+#include <Geom_RectangularTrimmedSurface.hxx>
+#include <Geom_TrimmedCurve.hxx>
+#include <Geom2d_BSplineCurve.hxx>
+#include <Geom2d_TrimmedCurve.hxx>
+#include <Graphic3d_FrameStatsData.hxx>
+#include <Message.hxx>
+#include <OpenGl_Group.hxx>
+#include <OpenGl_PrimitiveArray.hxx>
+#include <OSD_OpenFile.hxx>
+#include <Poly_PolygonOnTriangulation.hxx>
+#include <Poly_Triangulation.hxx>
+#include <Select3D_SensitiveSet.hxx>
+#include <SelectMgr_Selection.hxx>
+#include <Standard_Version.hxx>
+#include <TopAbs.hxx>
+#include <TopoDS_Iterator.hxx>
+
+#include <fstream>
+#include <string>
+
+namespace
+{
+  //! Estimated size of BVH data per element of Select3D_SensitiveSet:
+  //! primitive index and about one BVH node (min/max corners and node info) per two elements.
+  static const Standard_Size THE_BVH_BYTES_PER_ELEM = sizeof(int) + (2 * sizeof(BVH_Vec3d) + sizeof(BVH_Vec4i)) / 2;
+
+  //! Estimate size of geometry (curve or surface) including arrays of poles and knots.
+  static Standard_Size estimateGeometry(const Handle(Standard_Transient)& theGeom)
+  {
+    if (theGeom.IsNull())
+      return 0;
+
+    Standard_Size aSize = theGeom->DynamicType()->Size();
+    if (Handle(Geom_BSplineSurface) aBSpline = Handle(Geom_BSplineSurface)::DownCast(theGeom))
+    {
+      const bool isRational = aBSpline->IsURational() || aBSpline->IsVRational();
+      aSize += Standard_Size(aBSpline->NbUPoles()) * aBSpline->NbVPoles() * (sizeof(gp_Pnt) + (isRational ? sizeof(double) : 0))
+             + Standard_Size(aBSpline->NbUKnots() + aBSpline->NbVKnots()) * (sizeof(double) + sizeof(int));
+    }
+    else if (Handle(Geom_BezierSurface) aBezier = Handle(Geom_BezierSurface)::DownCast(theGeom))
+    {
+      const bool isRational = aBezier->IsURational() || aBezier->IsVRational();
+      aSize += Standard_Size(aBezier->NbUPoles()) * aBezier->NbVPoles() * (sizeof(gp_Pnt) + (isRational ? sizeof(double) : 0));
+    }
+    else if (Handle(Geom_BSplineCurve) aCurve = Handle(Geom_BSplineCurve)::DownCast(theGeom))
+    {
+      aSize += Standard_Size(aCurve->NbPoles()) * (sizeof(gp_Pnt) + (aCurve->IsRational() ? sizeof(double) : 0))
+             + Standard_Size(aCurve->NbKnots()) * (sizeof(double) + sizeof(int));
+    }
+    else if (Handle(Geom2d_BSplineCurve) aCurve2d = Handle(Geom2d_BSplineCurve)::DownCast(theGeom))
+    {
+      aSize += Standard_Size(aCurve2d->NbPoles()) * (sizeof(gp_Pnt2d) + (aCurve2d->IsRational() ? sizeof(double) : 0))
+             + Standard_Size(aCurve2d->NbKnots()) * (sizeof(double) + sizeof(int));
+    }
+    else if (Handle(Geom_RectangularTrimmedSurface) aTrimSurf = Handle(Geom_RectangularTrimmedSurface)::DownCast(theGeom))
+    {
+      aSize += estimateGeometry(aTrimSurf->BasisSurface());
+    }
+    else if (Handle(Geom_OffsetSurface) anOffsetSurf = Handle(Geom_OffsetSurface)::DownCast(theGeom))
+    {
+      aSize += estimateGeometry(anOffsetSurf->BasisSurface());
+    }
+    else if (Handle(Geom_TrimmedCurve) aTrimCurve = Handle(Geom_TrimmedCurve)::DownCast(theGeom))
+    {
+      aSize += estimateGeometry(aTrimCurve->BasisCurve());
+    }
+    else if (Handle(Geom2d_TrimmedCurve) aTrimCurve2d = Handle(Geom2d_TrimmedCurve)::DownCast(theGeom))
+    {
+      aSize += estimateGeometry(aTrimCurve2d->BasisCurve());
+    }
+    return aSize;
+  }
+
+  //! Estimate size of triangulation arrays.
+  static Standard_Size estimateTriangulation(const Handle(Poly_Triangulation)& theTris)
+  {
+    Standard_Size aSize = sizeof(Poly_Triangulation)
+                        + Standard_Size(theTris->NbNodes()) * sizeof(gp_Pnt)
+                        + Standard_Size(theTris->NbTriangles()) * sizeof(Poly_Triangle);
+    if (theTris->HasUVNodes())
+      aSize += Standard_Size(theTris->NbNodes()) * sizeof(gp_Pnt2d);
+    if (theTris->HasNormals())
+      aSize += Standard_Size(theTris->NbNodes()) * sizeof(Graphic3d_Vec3);
+    return aSize;
+  }
+
+  //! Format size in MiB.
+  static TCollection_AsciiString formatMiB(Standard_Size theBytes)
+  {
+    return TCollection_AsciiString(double(theBytes) / (1024.0 * 1024.0)) + " MiB";
+  }
+
+  //! Write string into JSON with escaping.
+  static void writeJsonString(std::ostream& theStream, const TCollection_AsciiString& theStr)
+  {
+    theStream << "\"";
+    for (int aCharIter = 1; aCharIter <= theStr.Length(); ++aCharIter)
+    {
+      const char aChar = theStr.Value(aCharIter);
+      if (aChar == '\"' || aChar == '\\')
+        theStream << '\\' << aChar;
+      else if ((unsigned char )aChar >= 0x20)
+        theStream << aChar;
+    }
+    theStream << "\"";
+  }
+
+  //! Write object statistics into JSON.
+  static void writeJsonStats(std::ostream& theStream, const OcctMemoryReport::ObjectStats& theStats)
+  {
+    theStream << "\"brep\": "            << theStats.BRepBytes
+              << ", \"triangulation\": " << theStats.TriangulationBytes
+              << ", \"triangles\": "     << theStats.NbTriangles
+              << ", \"primArrays\": "    << theStats.PrimArrayBytes
+              << ", \"gpuGeometry\": "   << theStats.GpuGeomBytes
+              << ", \"gpuTextures\": "   << theStats.GpuTextureBytes
+              << ", \"selection\": "     << theStats.SelectionBytes
+              << ", \"cpuTotal\": "      << theStats.CpuBytes()
+              << ", \"gpuTotal\": "      << theStats.GpuBytes();
+  }
+}
+
+// ================================================================
+// Function : Perform
+// ================================================================
+void OcctMemoryReport::Perform(const Handle(AIS_InteractiveContext)& theCtx)
+{
+  myObjects.Clear();
+  myTotals = ObjectStats();
+  myTotals.Name = "Totals";
+  mySharedData.Clear();
+
+  AIS_ListOfInteractive aDispList;
+  theCtx->DisplayedObjects(aDispList);
+  for (AIS_ListOfInteractive::Iterator anObjIter(aDispList); anObjIter.More(); anObjIter.Next())
+  {
+    const Handle(AIS_InteractiveObject)& anObj = anObjIter.Value();
+    ObjectStats& aStats = myObjects.Appended();
+    aStats.Object = anObj;
+    aStats.Name = TCollection_AsciiString(myObjects.Size()) + " " + anObj->DynamicType()->Name();
+    myObjectData.Clear();
+
+    // account prototype of connected object, which is computed but not displayed itself
+    Handle(AIS_InteractiveObject) aSrcObj = anObj;
+    if (Handle(AIS_ConnectedInteractive) aConnected = Handle(AIS_ConnectedInteractive)::DownCast(anObj))
+    {
+      if (aConnected->HasConnection())
+      {
+        aSrcObj = aConnected->ConnectedTo();
+        addPresentations(aSrcObj, aStats);
+      }
+    }
+    if (Handle(AIS_Shape) aShapePrs = Handle(AIS_Shape)::DownCast(aSrcObj))
+    {
+      aStats.Name += TCollection_AsciiString(" (") + TopAbs::ShapeTypeToString(aShapePrs->Shape().ShapeType()) + ")";
+      addShape(aShapePrs->Shape(), aStats);
+    }
+    addPresentations(anObj, aStats);
+    addSelections(anObj, aStats);
+  }
+  myObjectData.Clear();
+}
+
+// ================================================================
+// Function : EstimateGpuBytes
+// ================================================================
+Standard_Size OcctMemoryReport::EstimateGpuBytes(const Handle(AIS_InteractiveObject)& theObj)
+{
+  OcctMemoryReport aReport;
+  ObjectStats aStats;
+  aReport.addPresentations(theObj, aStats);
+  return aStats.GpuBytes();
+}
+
+// ================================================================
+// Function : addData
+// ================================================================
+void OcctMemoryReport::addData(const void* theData,
+                               const ObjectStats& theDelta,
+                               ObjectStats& theStats)
+{
+  if (theData == NULL || myObjectData.Add((Standard_Address )theData))
+    theStats.Add(theDelta);
+  if (theData == NULL || mySharedData.Add((Standard_Address )theData))
+    myTotals.Add(theDelta);
+}
+
+// ================================================================
+// Function : addShape
+// ================================================================
+void OcctMemoryReport::addShape(const TopoDS_Shape& theShape,
+                                ObjectStats& theStats)
+{
+  if (theShape.IsNull())
+    return;
+
+  // sub-shapes of already counted TShape have been counted as well
+  const Handle(TopoDS_TShape)& aTShape = theShape.TShape();
+  if (myObjectData.Contains(aTShape.get()))
+    return;
+
+  ObjectStats aTopoDelta;
+  Standard_Size& aTopoSize = aTopoDelta.BRepBytes;
+  aTopoSize = aTShape->DynamicType()->Size() + Standard_Size(aTShape->NbChildren()) * sizeof(TopoDS_Shape);
+  switch (theShape.ShapeType())
+  {
+    case TopAbs_FACE:
+    {
+      const Handle(BRep_TFace)& aTFace = Handle(BRep_TFace)::DownCast(aTShape);
+      aTopoSize += estimateGeometry(aTFace->Surface());
+      const Handle(Poly_Triangulation)& aTris = aTFace->Triangulation();
+      if (!aTris.IsNull())
+      {
+        ObjectStats aTrisDelta;
+        aTrisDelta.TriangulationBytes = estimateTriangulation(aTris);
+        aTrisDelta.NbTriangles = Standard_Size(aTris->NbTriangles());
+        addData(aTris.get(), aTrisDelta, theStats);
+      }
+      break;
+    }
+    case TopAbs_EDGE:
+    {
+      const Handle(BRep_TEdge)& aTEdge = Handle(BRep_TEdge)::DownCast(aTShape);
+      for (BRep_ListOfCurveRepresentation::Iterator aRepIter(aTEdge->Curves()); aRepIter.More(); aRepIter.Next())
+      {
+        const Handle(BRep_CurveRepresentation)& aRep = aRepIter.Value();
+        aTopoSize += aRep->DynamicType()->Size();
+        if (aRep->IsCurve3D())
+        {
+          aTopoSize += estimateGeometry(aRep->Curve3D());
+        }
+        else if (aRep->IsCurveOnSurface())
+        {
+          aTopoSize += estimateGeometry(aRep->PCurve());
+          if (aRep->IsCurveOnClosedSurface())
+            aTopoSize += estimateGeometry(aRep->PCurve2());
+        }
+        else if (aRep->IsPolygonOnTriangulation())
+        {
+          const Handle(Poly_PolygonOnTriangulation)& aPoly = aRep->PolygonOnTriangulation();
+          ObjectStats aPolyDelta;
+          aPolyDelta.TriangulationBytes = sizeof(Poly_PolygonOnTriangulation) + Standard_Size(aPoly->NbNodes()) * sizeof(int);
+          addData(aPoly.get(), aPolyDelta, theStats);
+        }
+      }
+      break;
+    }
+    default:
+      break;
+  }
+  addData(aTShape.get(), aTopoDelta, theStats);
+
+  for (TopoDS_Iterator aSubIter(theShape, false, false); aSubIter.More(); aSubIter.Next())
+  {
+    addShape(aSubIter.Value(), theStats);
+  }
+}
+
+// ================================================================
+// Function : addPresentations
+// ================================================================
+void OcctMemoryReport::addPresentations(const Handle(AIS_InteractiveObject)& theObj,
+                                        ObjectStats& theStats)
+{
+#if (OCC_VERSION_HEX >= 0x070600)
+  for (PrsMgr_Presentations::Iterator aPrsIter(theObj->Presentations()); aPrsIter.More(); aPrsIter.Next())
+  {
+    const Handle(PrsMgr_Presentation)& aPrs = aPrsIter.Value();
+    for (Graphic3d_SequenceOfGroup::Iterator aGroupIter(aPrs->Groups()); aGroupIter.More(); aGroupIter.Next())
+    {
+      const OpenGl_Group* aGlGroup = dynamic_cast<const OpenGl_Group*>(aGroupIter.Value().get());
+      if (aGlGroup == NULL)
+        continue;
+
+      for (const OpenGl_ElementNode* aNodeIter = aGlGroup->FirstNode(); aNodeIter != NULL; aNodeIter = aNodeIter->next)
+      {
+        const OpenGl_Element* anElem = aNodeIter->elem;
+        ObjectStats anElemDelta;
+        if (const OpenGl_PrimitiveArray* anArray = dynamic_cast<const OpenGl_PrimitiveArray*>(anElem))
+        {
+          // CPU copies of arrays might be released after uploading to VBO
+          if (!anArray->Attributes().IsNull())
+            anElemDelta.PrimArrayBytes += anArray->Attributes()->Size();
+          if (!anArray->Indices().IsNull())
+            anElemDelta.PrimArrayBytes += anArray->Indices()->Size();
+        }
+
+        // use the same estimation as OpenGl_FrameStats
+        Graphic3d_FrameStatsDataTmp aGlStats;
+        anElem->UpdateMemStats(aGlStats);
+        anElemDelta.GpuGeomBytes    = aGlStats[Graphic3d_FrameStatsCounter_EstimatedBytesGeom];
+        anElemDelta.GpuTextureBytes = aGlStats[Graphic3d_FrameStatsCounter_EstimatedBytesTextures];
+        addData(anElem, anElemDelta, theStats);
+      }
+    }
+  }
+#else
+  (void)theObj; (void)theStats;
+#endif
+}
+
+// ================================================================
+// Function : addSelections
+// ================================================================
+void OcctMemoryReport::addSelections(const Handle(AIS_InteractiveObject)& theObj,
+                                     ObjectStats& theStats)
+{
+  for (SelectMgr_SequenceOfSelection::Iterator aSelIter(theObj->Selections()); aSelIter.More(); aSelIter.Next())
+  {
+    const Handle(SelectMgr_Selection)& aSel = aSelIter.Value();
+    for (NCollection_Vector<Handle(SelectMgr_SensitiveEntity)>::Iterator anEntIter(aSel->Entities()); anEntIter.More(); anEntIter.Next())
+    {
+      const Handle(Select3D_SensitiveEntity)& anEntity = anEntIter.Value()->BaseSensitive();
+      ObjectStats anEntityDelta;
+      anEntityDelta.SelectionBytes = sizeof(SelectMgr_SensitiveEntity) + anEntity->DynamicType()->Size();
+      if (Handle(Select3D_SensitiveSet) aSet = Handle(Select3D_SensitiveSet)::DownCast(anEntity))
+      {
+        anEntityDelta.SelectionBytes += Standard_Size(aSet->Size()) * THE_BVH_BYTES_PER_ELEM;
+      }
+      addData(anEntity.get(), anEntityDelta, theStats);
+    }
+  }
+}
+
+// ================================================================
+// Function : FormatTotals
+// ================================================================
+TCollection_AsciiString OcctMemoryReport::FormatTotals() const
+{
+  return TCollection_AsciiString()
+       + "Objects: " + myObjects.Size() + "\n"
+       + "B-rep: " + formatMiB(myTotals.BRepBytes) + "\n"
+       + "Triangulation: " + formatMiB(myTotals.TriangulationBytes) + " (" + std::to_string(myTotals.NbTriangles).c_str() + " triangles)\n"
+       + "Primitive arrays: " + formatMiB(myTotals.PrimArrayBytes) + "\n"
+       + "Selection: " + formatMiB(myTotals.SelectionBytes) + "\n"
+       + "GPU geometry: " + formatMiB(myTotals.GpuGeomBytes) + "\n"
+       + "GPU textures: " + formatMiB(myTotals.GpuTextureBytes) + "\n"
+       + "Total CPU: " + formatMiB(myTotals.CpuBytes()) + ", GPU: " + formatMiB(myTotals.GpuBytes());
+}
+
+// ================================================================
+// Function : DumpJson
+// ================================================================
+void OcctMemoryReport::DumpJson(std::ostream& theStream) const
+{
+  theStream << "{\n  \"totals\": { \"objects\": " << myObjects.Size() << ", ";
+  writeJsonStats(theStream, myTotals);
+  theStream << " },\n  \"objects\": [";
+  for (NCollection_Vector<ObjectStats>::Iterator anObjIter(myObjects); anObjIter.More(); anObjIter.Next())
+  {
+    theStream << (anObjIter.Index() == 0 ? "\n" : ",\n") << "    { \"name\": ";
+    writeJsonString(theStream, anObjIter.Value().Name);
+    theStream << ", ";
+    writeJsonStats(theStream, anObjIter.Value());
+    theStream << " }";
+  }
+  theStream << "\n  ]\n}\n";
+}
+
+// ================================================================
+// Function : ExportJson
+// ================================================================
+bool OcctMemoryReport::ExportJson(const TCollection_AsciiString& thePath) const
+{
+  std::ofstream aFile;
+  OSD_OpenStream(aFile, thePath.ToCString(), std::ios::out | std::ios::binary);
+  if (!aFile.is_open())
+  {
+    Message::SendFail() << "Error: unable to create file '" << thePath << "'";
+    return false;
+  }
+
+  DumpJson(aFile);
+  aFile.flush();
+  if (!aFile.good())
+  {
+    Message::SendFail() << "Error: unable to write file '" << thePath << "'";
+    return false;
+  }
+  Message::SendInfo() << "Memory report has been written into '" << thePath << "'";
+  return true;
+}
@@ -0,0 +1,119 @@
+// Copyright (c) 2026 Kirill Gavrilov
+
+#ifndef _OcctMemoryReport_HeaderFile
+#define _OcctMemoryReport_HeaderFile
+
+#include <AIS_InteractiveContext.hxx>
+#include <NCollection_Map.hxx>
+#include <NCollection_Vector.hxx>
+#include <TCollection_AsciiString.hxx>
+
+#include <ostream>
+
+//! Memory accounting report for objects displayed in AIS_InteractiveContext.
+//!
+//! For each displayed object the report estimates:
+//! - B-rep size (topology and geometry of AIS_Shape);
+//! - triangulation bytes (Poly_Triangulation attached to faces);
+//! - CPU-side presentation primitive arrays (Graphic3d_ArrayOfPrimitives kept by OpenGl_PrimitiveArray);
+//! - GPU-side VBO and texture bytes, as estimated by OpenGl driver;
+//! - selection entities and their BVH.
+//!
+//! Numbers are estimations (based on array sizes and sizeof() of the classes) rather than precise heap measurements.
+//! Shared data (like triangulation of shapes sharing the same TopoDS_TShape or presentation of AIS_ConnectedInteractive prototype)
+//! is counted per object, but only once within Totals().
+class OcctMemoryReport
+{
+public:
+
+  //! Memory statistics of a single object.
+  struct ObjectStats
+  {
+    TCollection_AsciiString       Name;               //!< object name
+    Handle(AIS_InteractiveObject) Object;             //!< object
+    Standard_Size BRepBytes          = 0;             //!< B-rep topology and geometry
+    Standard_Size TriangulationBytes = 0;             //!< triangulation of faces
+    Standard_Size PrimArrayBytes     = 0;             //!< CPU copies of presentation primitive arrays
+    Standard_Size GpuGeomBytes       = 0;             //!< VBOs on GPU
+    Standard_Size GpuTextureBytes    = 0;             //!< textures on GPU
+    Standard_Size SelectionBytes     = 0;             //!< selection entities and BVH
+    Standard_Size NbTriangles        = 0;             //!< number of triangles in triangulation
+
+    //! Return total CPU memory.
+    Standard_Size CpuBytes() const { return BRepBytes + TriangulationBytes + PrimArrayBytes + SelectionBytes; }
+
+    //! Return total GPU memory.
+    Standard_Size GpuBytes() const { return GpuGeomBytes + GpuTextureBytes; }
+
+    //! Increment counters.
+    void Add(const ObjectStats& theOther)
+    {
+      BRepBytes          += theOther.BRepBytes;
+      TriangulationBytes += theOther.TriangulationBytes;
+      PrimArrayBytes     += theOther.PrimArrayBytes;
+      GpuGeomBytes       += theOther.GpuGeomBytes;
+      GpuTextureBytes    += theOther.GpuTextureBytes;
+      SelectionBytes     += theOther.SelectionBytes;
+      NbTriangles        += theOther.NbTriangles;
+    }
+  };
+
+public:
+
+  //! Empty constructor.
+  OcctMemoryReport() {}
+
+  //! Collect statistics for all objects displayed in context.
+  void Perform(const Handle(AIS_InteractiveContext)& theCtx);
+
+  //! Return per-object statistics.
+  const NCollection_Vector<ObjectStats>& Objects() const { return myObjects; }
+
+  //! Return totals (with shared data counted once).
+  const ObjectStats& Totals() const { return myTotals; }
+
+  //! Format totals as a short multi-line text.
+  TCollection_AsciiString FormatTotals() const;
+
+  //! Dump report in JSON format.
+  void DumpJson(std::ostream& theStream) const;
+
+  //! Export report into JSON file.
+  bool ExportJson(const TCollection_AsciiString& thePath) const;
+
+  //! Estimate GPU memory (VBOs and textures) of object's own presentations;
+  //! presentations of AIS_ConnectedInteractive prototype are not included.
+  static Standard_Size EstimateGpuBytes(const Handle(AIS_InteractiveObject)& theObj);
+
+protected:
+
+  //! Account data which might be shared between objects.
+  //! @param[in] theData  data pointer used as a key or NULL for non-shared data
+  //! @param[in] theDelta counters to add
+  //! @param[in,out] theStats object statistics
+  void addData(const void* theData,
+               const ObjectStats& theDelta,
+               ObjectStats& theStats);
+
+  //! Append statistics of shape B-rep and triangulation.
+  void addShape(const TopoDS_Shape& theShape,
+                ObjectStats& theStats);
+
+  //! Append statistics of presentations.
+  void addPresentations(const Handle(AIS_InteractiveObject)& theObj,
+                        ObjectStats& theStats);
+
+  //! Append statistics of selections.
+  void addSelections(const Handle(AIS_InteractiveObject)& theObj,
+                     ObjectStats& theStats);
+
+private:
+
+  NCollection_Vector<ObjectStats> myObjects;
+  ObjectStats                     myTotals;
+  NCollection_Map<Standard_Address> mySharedData; //!< data already counted within totals
+  NCollection_Map<Standard_Address> myObjectData; //!< data already counted within current object
+
+};
+
+#endif // _OcctMemoryReport_HeaderFile
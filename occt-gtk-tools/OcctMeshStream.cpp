@@ -0,0 +1,718 @@
+// Copyright (c) 2026 Kirill Gavrilov
+
+#include "OcctMeshStream.h"
+
+#include "OcctMeshTools.h"
+
+#include <Message.hxx>
+#include <OSD_Environment.hxx>
+#include <OSD_File.hxx>
+#include <OSD_OpenFile.hxx>
+#include <OSD_Parallel.hxx>
+#include <OSD_Path.hxx>
+#include <OSD_Process.hxx>
+
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+namespace
+{
+  //! Size of binary STL header including number of triangles.
+  static const size_t THE_STL_HEADER_SIZE = 84;
+
+  //! Size of binary STL triangle record (normal, 3 vertices and attribute).
+  static const size_t THE_STL_TRIANGLE_SIZE = 50;
+
+  //! Node key - either bits of STL vertex position or PLY vertex index.
+  struct NodeKey
+  {
+    uint32_t Values[3];
+
+    bool operator==(const NodeKey& theOther) const
+    {
+      return Values[0] == theOther.Values[0]
+          && Values[1] == theOther.Values[1]
+          && Values[2] == theOther.Values[2];
+    }
+  };
+
+  //! Hash table with open addressing mapping node keys to indices in order of insertion.
+  //! Memory is allocated once per chunk, unlike node-based maps.
+  class NodeMap
+  {
+  public:
+
+    //! Create table for specified maximum number of keys.
+    NodeMap(int theMaxKeys)
+    {
+      size_t aSize = 16;
+      while (aSize < size_t(theMaxKeys) * 2)
+        aSize *= 2;
+
+      myTable.resize(aSize, -1);
+      myMask = aSize - 1;
+      myKeys.reserve(size_t(theMaxKeys) / 2);
+    }
+
+    //! Add key and return its index.
+    int Add(const NodeKey& theKey)
+    {
+      uint64_t aHash = uint64_t(theKey.Values[0]) * 73856093ULL
+                     ^ uint64_t(theKey.Values[1]) * 19349663ULL
+                     ^ uint64_t(theKey.Values[2]) * 83492791ULL;
+      aHash ^= aHash >> 29;
+      for (size_t aSlot = size_t(aHash) & myMask;; aSlot = (aSlot + 1) & myMask)
+      {
+        const int anIndex = myTable[aSlot];
+        if (anIndex == -1)
+        {
+          myTable[aSlot] = (int )myKeys.size();
+          myKeys.push_back(theKey);
+          return myTable[aSlot];
+        }
+        else if (myKeys[anIndex] == theKey)
+        {
+          return anIndex;
+        }
+      }
+    }
+
+    //! Return keys in order of insertion.
+    const std::vector<NodeKey>& Keys() const { return myKeys; }
+
+  private:
+
+    std::vector<int>     myTable;
+    std::vector<NodeKey> myKeys;
+    size_t               myMask = 0;
+
+  };
+
+  //! Return size of PLY scalar type (0 for unknown type).
+  static size_t plyTypeSize(const std::string& theType)
+  {
+    if (theType == "char"  || theType == "uchar"  || theType == "int8"  || theType == "uint8")   return 1;
+    if (theType == "short" || theType == "ushort" || theType == "int16" || theType == "uint16")  return 2;
+    if (theType == "int"   || theType == "uint"   || theType == "int32" || theType == "uint32"
+     || theType == "float" || theType == "float32") return 4;
+    if (theType == "double" || theType == "float64") return 8;
+    return 0;
+  }
+
+  //! Return path to a file within temporary directory.
+  static TCollection_AsciiString tempFilePath(const TCollection_AsciiString& theName)
+  {
+  #ifdef _WIN32
+    const TCollection_AsciiString aDir = OSD_Environment("TEMP").Value();
+  #else
+    TCollection_AsciiString aDir = OSD_Environment("TMPDIR").Value();
+    if (aDir.IsEmpty())
+      aDir = "/tmp";
+  #endif
+    if (aDir.IsEmpty())
+      return theName;
+
+    const char aLast = aDir.Value(aDir.Length());
+    return aDir + (aLast == '/' || aLast == '\\' ? "" : "/") + theName;
+  }
+}
+
+// ================================================================
+// Function : IsSupportedFormat
+// ================================================================
+bool OcctMeshStream::IsSupportedFormat(const TCollection_AsciiString& thePath)
+{
+  const int aDotPos = thePath.SearchFromEnd(".");
+  if (aDotPos <= 0)
+    return false;
+
+  TCollection_AsciiString anExt = thePath.SubString(aDotPos + 1, thePath.Length());
+  anExt.LowerCase();
+  return anExt == "stl" || anExt == "ply";
+}
+
+// ================================================================
+// Function : Benchmark
+// ================================================================
+Handle(OcctMeshStream) OcctMeshStream::Benchmark(const Handle(AIS_InteractiveContext)& theCtx,
+                                                 const Handle(V3d_View)& theView,
+                                                 int theNbTriangles)
+{
+  const int aNbTriangles = theNbTriangles > 0 ? theNbTriangles : 10000000;
+  const TCollection_AsciiString aPath = tempFilePath(TCollection_AsciiString("occt-meshstream-bench-") + OSD_Process().ProcessId() + ".stl");
+
+  // wavy surface tessellated by regular grid, each triangle stored with its own vertices
+  OSD_Timer aTimer;
+  aTimer.Start();
+  const int aGridSize = OcctMeshTools::GridSize(aNbTriangles);
+  const uint32_t aNbWritten = uint32_t(aGridSize) * uint32_t(aGridSize) * 2;
+  {
+    std::ofstream aFile;
+    OSD_OpenStream(aFile, aPath.ToCString(), std::ios::out | std::ios::binary);
+    if (!aFile.is_open())
+    {
+      Message::SendFail() << "Error: unable to create file '" << aPath << "'";
+      return Handle(OcctMeshStream)();
+    }
+
+    char aHeader[THE_STL_HEADER_SIZE] = {};
+    std::memcpy(aHeader + 80, &aNbWritten, sizeof(aNbWritten));
+    aFile.write(aHeader, sizeof(aHeader));
+    auto aSurfPnt = [aGridSize](int theX, int theY)
+    {
+      const gp_Pnt aPnt = OcctMeshTools::WavyGridPoint(aGridSize, theX, theY);
+      return Graphic3d_Vec3((float )aPnt.X(), (float )aPnt.Y(), (float )aPnt.Z());
+    };
+    std::vector<char> aRow(size_t(aGridSize) * 2 * THE_STL_TRIANGLE_SIZE, 0);
+    for (int aY = 0; aY < aGridSize; ++aY)
+    {
+      char* aRec = aRow.data();
+      for (int aX = 0; aX < aGridSize; ++aX)
+      {
+        const Graphic3d_Vec3 aQuad[4] = { aSurfPnt(aX, aY), aSurfPnt(aX + 1, aY), aSurfPnt(aX + 1, aY + 1), aSurfPnt(aX, aY + 1) };
+        const int aTriNodes[2][3] = { { 0, 1, 2 }, { 0, 2, 3 } };
+        for (int aTriIter = 0; aTriIter < 2; ++aTriIter, aRec += THE_STL_TRIANGLE_SIZE)
+        {
+          for (int aNodeIter = 0; aNodeIter < 3; ++aNodeIter)
+          {
+            std::memcpy(aRec + 12 + aNodeIter * 12, aQuad[aTriNodes[aTriIter][aNodeIter]].GetData(), 12);
+          }
+        }
+      }
+      aFile.write(aRow.data(), (std::streamsize )aRow.size());
+    }
+    if (!aFile.good())
+    {
+      Message::SendFail() << "Error: unable to write file '" << aPath << "'";
+      aFile.close();
+      OSD_File(OSD_Path(aPath)).Remove();
+      return Handle(OcctMeshStream)();
+    }
+  }
+  aTimer.Stop();
+  const double aWriteTime = aTimer.ElapsedTime();
+
+  Handle(OcctMeshStream) aMesh = new OcctMeshStream();
+  if (!aMesh->Open(aPath))
+  {
+    OSD_File(OSD_Path(aPath)).Remove();
+    return Handle(OcctMeshStream)();
+  }
+
+  theCtx->Display(aMesh, 0, 0, false);
+  while (aMesh->IsLoading())
+  {
+    if (!aMesh->UpdateStreaming())
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  theView->FitAll(0.01, false);
+
+  // loaded mesh doesn't refer to the file anymore
+  aMesh->StopLoading();
+  aMesh->myFile.Close();
+  OSD_File(OSD_Path(aPath)).Remove();
+
+  const double aFileMiB = double(aMesh->myFileSize) / (1024.0 * 1024.0);
+  Message::SendInfo() << "OcctMeshStream benchmark, " << (int64_t )aNbWritten << " triangles (" << aMesh->NbChunks() << " chunks)\n"
+                      << "  file writing: " << aWriteTime << " s, " << aFileMiB << " MiB\n"
+                      << "  loading: " << aMesh->myTimer.ElapsedTime() << " s (" << aMesh->Throughput() << " MB/s)\n"
+                      << "  triangulations: " << (double(aMesh->LoadedMemory()) / (1024.0 * 1024.0)) << " MiB, "
+                      << aMesh->NbLoadedNodes() << " nodes\n"
+                      << "  levels of detail: " << (double(aMesh->LevelsMemory()) / (1024.0 * 1024.0)) << " MiB, "
+                      << aMesh->NbDisplayedTriangles() << " triangles displayed at coarsest levels";
+  while (aMesh->UpdateLevels(theView)) {}
+  Message::SendInfo() << "  after level selection: " << aMesh->NbDisplayedTriangles() << " triangles displayed";
+  theView->Invalidate();
+  return aMesh;
+}
+
+// ================================================================
+// Function : OcctMeshStream
+// ================================================================
+OcctMeshStream::OcctMeshStream()
+: myNextChunk(0),
+  myToStop(false),
+  myIsFailed(false)
+{}
+
+// ================================================================
+// Function : ~OcctMeshStream
+// ================================================================
+OcctMeshStream::~OcctMeshStream()
+{
+  StopLoading();
+}
+
+// ================================================================
+// Function : Open
+// ================================================================
+bool OcctMeshStream::Open(const TCollection_AsciiString& thePath)
+{
+  StopLoading();
+  ClearChunks();
+  myFile.Close();
+  myPlyChunkOffsets.clear();
+  myFileSize = 0;
+  myNbFaces = 0;
+  myNbTriangles = 0;
+  myNbLoadedTriangles = 0;
+  myNbLoadedNodes = 0;
+  myNbFileChunks  = 0;
+  myNbAddedChunks = 0;
+  myFormat = Format_Unknown;
+  myIsFailed = false;
+  if (!IsSupportedFormat(thePath))
+  {
+    Message::SendFail() << "Error: file '" << thePath << "' is not STL or PLY";
+    return false;
+  }
+  if (!myFile.Open(thePath))
+    return false;
+
+  const int aDotPos = thePath.SearchFromEnd(".");
+  TCollection_AsciiString anExt = thePath.SubString(aDotPos + 1, thePath.Length());
+  anExt.LowerCase();
+  if (anExt == "stl")
+  {
+    uint32_t aNbTris = 0;
+    if (myFile.Size() >= THE_STL_HEADER_SIZE)
+      std::memcpy(&aNbTris, myFile.Data() + 80, sizeof(aNbTris));
+
+    if (myFile.Size() < THE_STL_HEADER_SIZE + uint64_t(aNbTris) * THE_STL_TRIANGLE_SIZE)
+    {
+      const bool isAscii = myFile.Size() >= 5 && std::memcmp(myFile.Data(), "solid", 5) == 0;
+      Message::SendFail() << "Error: file '" << thePath << "' is " << (isAscii ? "ASCII STL (only binary STL is supported)" : "truncated");
+      myFile.Close();
+      return false;
+    }
+
+    myFormat = Format_StlBinary;
+    myNbFaces = aNbTris;
+    myNbTriangles = aNbTris;
+    myFacesOffset = THE_STL_HEADER_SIZE;
+    myFaceStride  = THE_STL_TRIANGLE_SIZE;
+  }
+  else if (!parsePlyHeader())
+  {
+    myFile.Close();
+    return false;
+  }
+
+  const int aNbChunks = int((myNbFaces + myChunkSize - 1) / myChunkSize);
+  myNbFileChunks = aNbChunks;
+  myFileSize = myFile.Size();
+
+  Message::SendInfo() << "Mesh '" << thePath << "': " << myNbTriangles << " triangles in " << aNbChunks << " chunks";
+  myTimer.Reset();
+  myTimer.Start();
+  myNextChunk = 0;
+  myToStop = false;
+  const int aNbWorkers = std::min(myNbWorkers > 0 ? myNbWorkers : OSD_Parallel::NbLogicalProcessors(), aNbChunks);
+  for (int aThreadIter = 0; aThreadIter < aNbWorkers; ++aThreadIter)
+  {
+    myWorkers.push_back(std::thread(&OcctMeshStream::workerLoop, this));
+  }
+  return true;
+}
+
+// ================================================================
+// Function : parsePlyHeader
+// ================================================================
+bool OcctMeshStream::parsePlyHeader()
+{
+  const std::string aText((const char* )myFile.Data(), (size_t )std::min<uint64_t>(myFile.Size(), 65536));
+  const size_t anEndPos  = aText.find("end_header");
+  const size_t aDataPos  = anEndPos != std::string::npos ? aText.find('\n', anEndPos) : std::string::npos;
+  if (aText.compare(0, 3, "ply") != 0
+   || aDataPos == std::string::npos)
+  {
+    Message::SendFail() << "Error: file '" << myFile.Path() << "' is not PLY";
+    return false;
+  }
+
+  std::istringstream aStream(aText.substr(0, anEndPos));
+  std::string aLine, anError, anElement;
+  bool isBinaryLE = false, hasList = false;
+  int64_t aNbFaces = -1;
+  int aNbCoords = 0, aNbDoubleCoords = 0;
+  myPlyNbVerts = -1;
+  myPlyVertStride = 0;
+  myFaceStride = 0;
+  while (anError.empty() && std::getline(aStream, aLine))
+  {
+    std::istringstream aTokens(aLine);
+    std::string aKey;
+    aTokens >> aKey;
+    if (aKey == "format")
+    {
+      std::string aFormat;
+      aTokens >> aFormat;
+      isBinaryLE = aFormat == "binary_little_endian";
+    }
+    else if (aKey == "element")
+    {
+      int64_t aCount = 0;
+      aTokens >> anElement >> aCount;
+      if (anElement == "vertex")
+        myPlyNbVerts = aCount;
+      else if (anElement == "face")
+        aNbFaces = aCount;
+      else if (aNbFaces == -1)
+        anError = "unsupported element '" + anElement + "' before faces";
+    }
+    else if (aKey == "property")
+    {
+      std::string aType, aName;
+      aTokens >> aType;
+      if (aType == "list")
+      {
+        std::string aCountType, anIndexType;
+        aTokens >> aCountType >> anIndexType;
+        if (anElement != "face" || hasList || myFaceStride != 0
+         || plyTypeSize(aCountType) == 0 || plyTypeSize(anIndexType) != 4)
+        {
+          anError = "unsupported list property";
+          continue;
+        }
+        hasList = true;
+        myPlyListSize  = (int )plyTypeSize(aCountType);
+        myPlyFaceExtra = 0;
+        continue;
+      }
+
+      aTokens >> aName;
+      const size_t aSize = plyTypeSize(aType);
+      if (aSize == 0)
+      {
+        anError = "unknown property type '" + aType + "'";
+      }
+      else if (anElement == "vertex")
+      {
+        if (aName == "x" || aName == "y" || aName == "z")
+        {
+          myPlyCoordOffset[aName[0] - 'x'] = myPlyVertStride;
+          ++aNbCoords;
+          if (aType == "double" || aType == "float64")
+            ++aNbDoubleCoords;
+          else if (aSize != 4 || aType.find("int") != std::string::npos)
+            anError = "vertex coordinates should be float or double";
+        }
+        myPlyVertStride += aSize;
+      }
+      else if (anElement == "face")
+      {
+        if (!hasList)
+          anError = "face properties before vertex indices are not supported";
+        myPlyFaceExtra += aSize;
+      }
+    }
+  }
+
+  if (anError.empty() && !isBinaryLE)
+    anError = "only binary little-endian PLY is supported";
+  else if (anError.empty() && (myPlyNbVerts <= 0 || aNbFaces <= 0 || !hasList || aNbCoords != 3))
+    anError = "vertex coordinates or faces are not defined";
+  else if (anError.empty() && aNbDoubleCoords != 0 && aNbDoubleCoords != 3)
+    anError = "mixed precision of vertex coordinates";
+  if (!anError.empty())
+  {
+    Message::SendFail() << "Error: PLY file '" << myFile.Path() << "' cannot be read - " << anError.c_str();
+    return false;
+  }
+
+  myPlyIsDouble    = aNbDoubleCoords == 3;
+  myPlyVertsOffset = aDataPos + 1;
+  myFacesOffset    = myPlyVertsOffset + uint64_t(myPlyNbVerts) * myPlyVertStride;
+  myFaceStride     = size_t(myPlyListSize) + 3 * sizeof(uint32_t) + myPlyFaceExtra;
+  myNbFaces        = aNbFaces;
+  myNbTriangles    = aNbFaces;
+  myFormat         = Format_PlyBinary;
+  if (myFile.Size() < myFacesOffset)
+  {
+    Message::SendFail() << "Error: PLY file '" << myFile.Path() << "' is truncated";
+    return false;
+  }
+
+  // file ending right after triangular faces is read without indexing (face sizes are still checked on reading)
+  if (myFile.Size() == myFacesOffset + uint64_t(aNbFaces) * myFaceStride)
+    return true;
+
+  return indexPlyFaces();
+}
+
+// ================================================================
+// Function : indexPlyFaces
+// ================================================================
+bool OcctMeshStream::indexPlyFaces()
+{
+  myPlyChunkOffsets.clear();
+  myPlyChunkOffsets.reserve(size_t((myNbFaces + myChunkSize - 1) / myChunkSize) + 1);
+  uint64_t anOffset = myFacesOffset;
+  int64_t aNbTris = 0;
+  for (int64_t aFaceIter = 0; aFaceIter < myNbFaces; ++aFaceIter)
+  {
+    if (aFaceIter % myChunkSize == 0)
+      myPlyChunkOffsets.push_back(anOffset);
+    if (anOffset + uint64_t(myPlyListSize) > myFile.Size())
+      break;
+
+    uint32_t aNbIndices = 0;
+    std::memcpy(&aNbIndices, myFile.Data() + anOffset, myPlyListSize);
+    anOffset += uint64_t(myPlyListSize) + uint64_t(aNbIndices) * sizeof(uint32_t) + myPlyFaceExtra;
+    aNbTris  += aNbIndices >= 3 ? int64_t(aNbIndices) - 2 : 0;
+  }
+  if (anOffset > myFile.Size()
+   || myPlyChunkOffsets.size() != size_t((myNbFaces + myChunkSize - 1) / myChunkSize))
+  {
+    Message::SendFail() << "Error: PLY file '" << myFile.Path() << "' is truncated";
+    myPlyChunkOffsets.clear();
+    return false;
+  }
+
+  myPlyChunkOffsets.push_back(anOffset);
+  myNbTriangles = aNbTris;
+  return true;
+}
+
+// ================================================================
+// Function : StopLoading
+// ================================================================
+void OcctMeshStream::StopLoading()
+{
+  myToStop = true;
+  for (std::thread& aThread : myWorkers)
+  {
+    aThread.join();
+  }
+  myWorkers.clear();
+
+  std::lock_guard<std::mutex> aLock(myMutex);
+  myResults.clear();
+}
+
+// ================================================================
+// Function : Throughput
+// ================================================================
+double OcctMeshStream::Throughput() const
+{
+  const double aTime = myTimer.ElapsedTime();
+  if (aTime <= 0.0 || myNbFileChunks == 0)
+    return 0.0;
+
+  const double aBytes = double(myNbAddedChunks) / double(myNbFileChunks) * double(myFileSize);
+  return aBytes / aTime / 1000000.0;
+}
+
+// ================================================================
+// Function : workerLoop
+// ================================================================
+void OcctMeshStream::workerLoop()
+{
+  for (;;)
+  {
+    const int aChunk = myNextChunk++;
+    if (myToStop
+     || myIsFailed
+     || aChunk >= myNbFileChunks)
+    {
+      return;
+    }
+
+    LoadResult aResult;
+    aResult.Chunk = aChunk;
+    const Handle(Poly_Triangulation) aTris = readChunk(aChunk);
+    if (aTris.IsNull())
+      myIsFailed = true;
+    else if (myNbLevels > 1)
+      aResult.Levels = BuildLevels(aTris, myNbLevels);
+    else
+      aResult.Levels.Append(aTris);
+
+    std::function<void()> aCallback;
+    {
+      std::lock_guard<std::mutex> aLock(myMutex);
+      if (myToStop)
+        return;
+
+      if (!aTris.IsNull())
+        myResults.push_back(aResult);
+      aCallback = myLoadedCallback;
+    }
+    if (aCallback)
+      aCallback();
+  }
+}
+
+// ================================================================
+// Function : readChunk
+// ================================================================
+Handle(Poly_Triangulation) OcctMeshStream::readChunk(int theChunk)
+{
+  const int64_t aFirstFace = int64_t(theChunk) * myChunkSize;
+  const int aNbFaces = (int )std::min<int64_t>(myChunkSize, myNbFaces - aFirstFace);
+  const uint64_t aChunkOffset = !myPlyChunkOffsets.empty()
+                              ? myPlyChunkOffsets[theChunk]
+                              : myFacesOffset + uint64_t(aFirstFace) * myFaceStride;
+  const uint64_t aChunkEnd = !myPlyChunkOffsets.empty()
+                           ? myPlyChunkOffsets[theChunk + 1]
+                           : aChunkOffset + uint64_t(aNbFaces) * myFaceStride;
+  const uint8_t* aData    = myFile.Data() + aChunkOffset;
+  const uint8_t* aDataEnd = myFile.Data() + aChunkEnd;
+
+  // merge coincident STL vertices / gather referenced PLY vertices within the chunk;
+  // number of PLY vertex references is limited by the size of chunk data
+  const int aMaxKeys = myFormat == Format_StlBinary
+                     ? aNbFaces * 3
+                     : int((aChunkEnd - aChunkOffset - uint64_t(aNbFaces) * (myPlyListSize + myPlyFaceExtra)) / sizeof(uint32_t));
+  NodeMap aNodeMap(aMaxKeys);
+  std::vector<Poly_Triangle> aTris;
+  std::vector<int> aFaceNodes;
+  aTris.reserve(aNbFaces);
+  for (int aFaceIter = 0; aFaceIter < aNbFaces; ++aFaceIter)
+  {
+    aFaceNodes.clear();
+    if (myFormat == Format_StlBinary)
+    {
+      for (int aNodeIter = 0; aNodeIter < 3; ++aNodeIter)
+      {
+        NodeKey aKey = { { 0, 0, 0 } };
+        std::memcpy(aKey.Values, aData + 12 + aNodeIter * 12, 12);
+        for (uint32_t& aValue : aKey.Values)
+        {
+          if (aValue == 0x80000000u)
+            aValue = 0; // -0.0f
+        }
+        aFaceNodes.push_back(aNodeMap.Add(aKey) + 1);
+      }
+      aData += myFaceStride;
+    }
+    else
+    {
+      uint32_t aNbIndices = 0;
+      std::memcpy(&aNbIndices, aData, myPlyListSize);
+      const size_t aRecSize = size_t(myPlyListSize) + size_t(aNbIndices) * sizeof(uint32_t) + myPlyFaceExtra;
+      if (size_t(aDataEnd - aData) < aRecSize
+       || (myPlyChunkOffsets.empty() && aNbIndices != 3))
+      {
+        return Handle(Poly_Triangulation)();
+      }
+
+      for (uint32_t anIndexIter = 0; anIndexIter < aNbIndices; ++anIndexIter)
+      {
+        NodeKey aKey = { { 0, 0, 0 } };
+        std::memcpy(&aKey.Values[0], aData + myPlyListSize + anIndexIter * sizeof(uint32_t), sizeof(uint32_t));
+        if (int64_t(aKey.Values[0]) >= myPlyNbVerts)
+          return Handle(Poly_Triangulation)();
+
+        aFaceNodes.push_back(aNodeMap.Add(aKey) + 1);
+      }
+      aData += aRecSize;
+    }
+
+    // polygon is split into triangle fan
+    for (size_t aNodeIter = 2; aNodeIter < aFaceNodes.size(); ++aNodeIter)
+    {
+      const int aNodes[3] = { aFaceNodes[0], aFaceNodes[aNodeIter - 1], aFaceNodes[aNodeIter] };
+      if (aNodes[0] != aNodes[1]
+       && aNodes[0] != aNodes[2]
+       && aNodes[1] != aNodes[2])
+      {
+        aTris.push_back(Poly_Triangle(aNodes[0], aNodes[1], aNodes[2]));
+      }
+    }
+  }
+
+  // faces are read only once - drop them from working set
+  myFile.ReleasePages(aChunkOffset, aChunkEnd - aChunkOffset);
+
+  const std::vector<NodeKey>& aKeys = aNodeMap.Keys();
+  Handle(Poly_Triangulation) aTriangulation = new Poly_Triangulation();
+  aTriangulation->SetDoublePrecision(false);
+  aTriangulation->ResizeNodes((int )aKeys.size(), false);
+  aTriangulation->ResizeTriangles((int )aTris.size(), false);
+  Bnd_Box aBox;
+  for (size_t aNodeIter = 0; aNodeIter < aKeys.size(); ++aNodeIter)
+  {
+    gp_Pnt aPnt;
+    if (myFormat == Format_StlBinary)
+    {
+      Graphic3d_Vec3 aVec;
+      std::memcpy(aVec.ChangeData(), aKeys[aNodeIter].Values, sizeof(aVec));
+      aPnt.SetCoord(aVec.x(), aVec.y(), aVec.z());
+    }
+    else
+    {
+      const uint8_t* aVert = myFile.Data() + myPlyVertsOffset + uint64_t(aKeys[aNodeIter].Values[0]) * myPlyVertStride;
+      for (int aCoordIter = 0; aCoordIter < 3; ++aCoordIter)
+      {
+        if (myPlyIsDouble)
+        {
+          double aValue = 0.0;
+          std::memcpy(&aValue, aVert + myPlyCoordOffset[aCoordIter], sizeof(aValue));
+          aPnt.SetCoord(aCoordIter + 1, aValue);
+        }
+        else
+        {
+          float aValue = 0.0f;
+          std::memcpy(&aValue, aVert + myPlyCoordOffset[aCoordIter], sizeof(aValue));
+          aPnt.SetCoord(aCoordIter + 1, aValue);
+        }
+      }
+    }
+    aTriangulation->SetNode((int )aNodeIter + 1, aPnt);
+    aBox.Add(aPnt);
+  }
+  for (size_t aTriIter = 0; aTriIter < aTris.size(); ++aTriIter)
+  {
+    aTriangulation->SetTriangle((int )aTriIter + 1, aTris[aTriIter]);
+  }
+  aTriangulation->SetCachedMinMax(aBox);
+  return aTriangulation;
+}
+
+// ================================================================
+// Function : UpdateStreaming
+// ================================================================
+bool OcctMeshStream::UpdateStreaming()
+{
+  std::vector<LoadResult> aResults;
+  {
+    std::lock_guard<std::mutex> aLock(myMutex);
+    aResults.swap(myResults);
+  }
+  if (aResults.empty())
+  {
+    if (myIsFailed && !myWorkers.empty())
+    {
+      StopLoading();
+      Message::SendFail() << "Error: mesh file '" << myFile.Path() << "' has unsupported or corrupted faces";
+    }
+    return false;
+  }
+
+  for (const LoadResult& aResult : aResults)
+  {
+    // bounding box of presentation grows while chunks are loaded
+    myNbLoadedTriangles += aResult.Levels.First()->NbTriangles();
+    myNbLoadedNodes     += aResult.Levels.First()->NbNodes();
+    AddChunk(aResult.Levels);
+    ++myNbAddedChunks;
+  }
+
+  if (myNbAddedChunks == myNbFileChunks)
+  {
+    myTimer.Stop();
+    StopLoading();
+    Message::SendInfo() << "Mesh '" << myFile.Path() << "' loaded in " << myTimer.ElapsedTime() << " s ("
+                        << Throughput() << " MB/s): " << myNbLoadedTriangles << " triangles, " << myNbLoadedNodes << " nodes, "
+                        << (double(LoadedMemory()) / (1024.0 * 1024.0)) << " MiB ("
+                        << (double(LevelsMemory()) / (1024.0 * 1024.0)) << " MiB with levels of detail)";
+    myFile.Close();
+    if (HasInteractiveContext())
+      GetContext()->RecomputeSelectionOnly(this);
+  }
+  return true;
+}
@@ -0,0 +1,175 @@
+// Copyright (c) 2026 Kirill Gavrilov
+
+#ifndef _OcctMeshStream_HeaderFile
+#define _OcctMeshStream_HeaderFile
+
+#include "OcctLodMesh.h"
+#include "OcctMappedFile.h"
+
+#include <Graphic3d_Vec.hxx>
+#include <OSD_Timer.hxx>
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//! Presentation of large binary STL or PLY mesh streamed from memory-mapped file.
+//!
+//! The file is split into chunks of ChunkSize() triangles which are read by worker threads in parallel;
+//! each chunk is converted into single-precision Poly_Triangulation with coincident STL vertices merged
+//! (or referenced PLY vertices gathered), simplified into levels of detail by the same worker (see OcctLodMesh)
+//! and added to presentation as a separate chunk as soon as it is loaded,
+//! so that the mesh is shown while the rest of the file is still being read.
+//! Processed file pages are released from process working set, and temporary buffers are bounded per worker,
+//! so that peak memory stays close to the size of resulting triangulations rather than the file size.
+//! Vertices shared by neighboring chunks are not merged between them.
+//! The file is closed once all chunks have been loaded.
+//!
+//! Supported formats: binary STL and binary little-endian PLY.
+//! Polygonal PLY faces are triangulated as fans; as their records have variable size,
+//! chunk offsets are found by sequential pass over faces on opening (skipped for files with only triangles).
+class OcctMeshStream : public OcctLodMesh
+{
+  DEFINE_STANDARD_RTTI_INLINE(OcctMeshStream, OcctLodMesh)
+public:
+
+  //! Return TRUE if file extension corresponds to supported format (STL or PLY).
+  static bool IsSupportedFormat(const TCollection_AsciiString& thePath);
+
+  //! Benchmark loading: writes binary STL file with theNbTriangles triangles (tessellated wavy surface),
+  //! displays it and prints loading time, throughput and memory of resulting triangulations.
+  //! @return displayed mesh
+  static Handle(OcctMeshStream) Benchmark(const Handle(AIS_InteractiveContext)& theCtx,
+                                          const Handle(V3d_View)& theView,
+                                          int theNbTriangles);
+
+public:
+
+  //! Empty constructor.
+  OcctMeshStream();
+
+  //! Destructor.
+  virtual ~OcctMeshStream();
+
+  //! Open mesh file and start loading.
+  bool Open(const TCollection_AsciiString& thePath);
+
+  //! Stop worker threads; should be called before destroying objects used by LoadedCallback().
+  void StopLoading();
+
+  //! Return number of triangles in file (after triangulation of polygonal faces).
+  int64_t NbTriangles() const { return myNbTriangles; }
+
+  //! Return number of loaded triangles (without degenerated ones).
+  int64_t NbLoadedTriangles() const { return myNbLoadedTriangles; }
+
+  //! Return number of loaded nodes.
+  int64_t NbLoadedNodes() const { return myNbLoadedNodes; }
+
+  //! Return memory occupied by loaded triangulations in bytes (without coarser levels, see LevelsMemory()).
+  int64_t LoadedMemory() const { return myNbLoadedNodes * int64_t(sizeof(Graphic3d_Vec3)) + myNbLoadedTriangles * int64_t(sizeof(Poly_Triangle)); }
+
+  //! Return loading throughput in MB/s of file data.
+  double Throughput() const;
+
+  //! Return number of faces per chunk (262144 by default).
+  int ChunkSize() const { return myChunkSize; }
+
+  //! Set number of faces per chunk; should be called before Open().
+  void SetChunkSize(int theNbTriangles) { myChunkSize = theNbTriangles; }
+
+  //! Return number of worker threads (number of logical processors by default).
+  int NbWorkers() const { return myNbWorkers; }
+
+  //! Set number of worker threads; should be called before Open().
+  void SetNbWorkers(int theNbWorkers) { myNbWorkers = theNbWorkers; }
+
+  //! Return maximum number of levels of detail per chunk including the full one (4 by default).
+  int NbLevels() const { return myNbLevels; }
+
+  //! Set maximum number of levels of detail; 1 disables simplification. Should be called before Open().
+  void SetNbLevels(int theNbLevels) { myNbLevels = theNbLevels; }
+
+  //! Set callback called from worker thread when new chunk has been loaded.
+  //! The callback should wake up GUI thread to redraw the view (and call UpdateStreaming()).
+  void SetLoadedCallback(const std::function<void()>& theCallback)
+  {
+    std::lock_guard<std::mutex> aLock(myMutex);
+    myLoadedCallback = theCallback;
+  }
+
+  //! Return TRUE if some chunks are being loaded or waiting to be added to presentation.
+  bool IsLoading() const { return myNbAddedChunks < myNbFileChunks && !myIsFailed; }
+
+  //! Add loaded chunks into presentation; should be called from GUI thread before redrawing the view.
+  //! @return TRUE if presentation has been modified
+  bool UpdateStreaming();
+
+protected:
+
+  //! File format.
+  enum Format
+  {
+    Format_Unknown,
+    Format_StlBinary,
+    Format_PlyBinary
+  };
+
+  //! Loaded chunk.
+  struct LoadResult
+  {
+    int Chunk = -1;
+    NCollection_Vector<Handle(Poly_Triangulation)> Levels; //!< levels of detail, the finest first
+  };
+
+  //! Parse binary PLY header.
+  bool parsePlyHeader();
+
+  //! Find offsets of chunks and number of triangles of PLY file with polygonal faces.
+  bool indexPlyFaces();
+
+  //! Worker thread loop.
+  void workerLoop();
+
+  //! Read chunk from mapped file.
+  Handle(Poly_Triangulation) readChunk(int theChunk);
+
+protected:
+
+  OcctMappedFile myFile;
+  Format         myFormat = Format_Unknown;
+  OSD_Timer      myTimer;               //!< loading timer
+  uint64_t       myFileSize = 0;        //!< size of loaded file
+  int64_t        myNbFaces = 0;         //!< number of STL triangles or PLY faces
+  int64_t        myNbTriangles = 0;
+  int64_t        myNbLoadedTriangles = 0;
+  int64_t        myNbLoadedNodes = 0;
+  uint64_t       myFacesOffset = 0;     //!< offset to the first STL triangle or PLY face
+  size_t         myFaceStride  = 0;     //!< size of STL triangle or triangular PLY face record
+  std::vector<uint64_t> myPlyChunkOffsets; //!< offsets of chunks of polygonal PLY faces (empty for triangles)
+  uint64_t       myPlyVertsOffset = 0;  //!< offset to the first PLY vertex
+  size_t         myPlyVertStride  = 0;  //!< size of PLY vertex record
+  size_t         myPlyCoordOffset[3] = { 0, 0, 0 }; //!< offsets of PLY vertex coordinates within record
+  int64_t        myPlyNbVerts = 0;
+  bool           myPlyIsDouble = false; //!< PLY vertex coordinates are double precision
+  int            myPlyListSize = 1;     //!< size of PLY face list counter
+  size_t         myPlyFaceExtra = 0;    //!< size of PLY face properties following vertex indices
+  int            myChunkSize  = 262144;
+  int            myNbWorkers  = 0;
+  int            myNbLevels   = 4;
+  int            myNbFileChunks  = 0;
+  int            myNbAddedChunks = 0;
+
+  std::function<void()>    myLoadedCallback;
+  std::vector<std::thread> myWorkers;
+  std::mutex               myMutex;
+  std::vector<LoadResult>  myResults;  //!< loaded chunks to be added to presentation
+  std::atomic<int>         myNextChunk;
+  std::atomic<bool>        myToStop;
+  std::atomic<bool>        myIsFailed;
+
+};
+
+#endif // _OcctMeshStream_HeaderFile
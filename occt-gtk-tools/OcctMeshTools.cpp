@@ -0,0 +1,59 @@
+// Copyright (c) 2026 Kirill Gavrilov
+
+#include "OcctMeshTools.h"
+
+#include <algorithm>
+#include <cmath>
+
+// ================================================================
+// Function : GridSize
+// ================================================================
+int OcctMeshTools::GridSize(int theNbTriangles)
+{
+  return std::max((int )std::sqrt(double(theNbTriangles) * 0.5), 1);
+}
+
+// ================================================================
+// Function : WavyGridPoint
+// ================================================================
+gp_Pnt OcctMeshTools::WavyGridPoint(int theGridSize,
+                                    int theX,
+                                    int theY)
+{
+  const double anX = 1000.0 * double(theX) / theGridSize;
+  const double anY = 1000.0 * double(theY) / theGridSize;
+  return gp_Pnt(anX, anY, 20.0 * std::sin(anX * 0.02) * std::cos(anY * 0.03));
+}
+
+// ================================================================
+// Function : WavyGrid
+// ================================================================
+Handle(Poly_Triangulation) OcctMeshTools::WavyGrid(int theGridSize,
+                                                   int theFirstRow,
+                                                   int theNbRows)
+{
+  const int aNbRows = theNbRows >= 0 ? std::min(theNbRows, theGridSize - theFirstRow) : theGridSize - theFirstRow;
+  Handle(Poly_Triangulation) aTris = new Poly_Triangulation();
+  aTris->SetDoublePrecision(false);
+  aTris->ResizeNodes((theGridSize + 1) * (aNbRows + 1), false);
+  aTris->ResizeTriangles(theGridSize * aNbRows * 2, false);
+  for (int aY = 0; aY <= aNbRows; ++aY)
+  {
+    for (int aX = 0; aX <= theGridSize; ++aX)
+    {
+      aTris->SetNode(aY * (theGridSize + 1) + aX + 1, WavyGridPoint(theGridSize, aX, theFirstRow + aY));
+    }
+  }
+
+  int aTriIter = 1;
+  for (int aY = 0; aY < aNbRows; ++aY)
+  {
+    for (int aX = 0; aX < theGridSize; ++aX)
+    {
+      const int aNode0 = aY * (theGridSize + 1) + aX + 1;
+      aTris->SetTriangle(aTriIter++, Poly_Triangle(aNode0, aNode0 + 1, aNode0 + theGridSize + 2));
+      aTris->SetTriangle(aTriIter++, Poly_Triangle(aNode0, aNode0 + theGridSize + 2, aNode0 + theGridSize + 1));
+    }
+  }
+  return aTris;
+}
@@ -0,0 +1,32 @@
+// Copyright (c) 2026 Kirill Gavrilov
+
+#ifndef _OcctMeshTools_HeaderFile
+#define _OcctMeshTools_HeaderFile
+
+#include <gp_Pnt.hxx>
+#include <Poly_Triangulation.hxx>
+
+//! Auxiliary tools generating synthetic meshes for benchmarks.
+class OcctMeshTools
+{
+public:
+
+  //! Return size of regular grid having approximately theNbTriangles triangles (two per cell).
+  static int GridSize(int theNbTriangles);
+
+  //! Return node of wavy surface (1000x1000 in XY) tessellated by regular grid.
+  static gp_Pnt WavyGridPoint(int theGridSize,
+                              int theX,
+                              int theY);
+
+  //! Triangulate rows of wavy surface by regular grid with single precision nodes.
+  //! @param[in] theGridSize  number of grid cells along each axis
+  //! @param[in] theFirstRow  first row of cells
+  //! @param[in] theNbRows    number of rows of cells, -1 for all rows starting from theFirstRow
+  static Handle(Poly_Triangulation) WavyGrid(int theGridSize,
+                                             int theFirstRow = 0,
+                                             int theNbRows = -1);
+
+};
+
+#endif // _OcctMeshTools_HeaderFile
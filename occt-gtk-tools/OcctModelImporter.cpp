@@ -0,0 +1,963 @@
+// Copyright (c) 2026 Kirill Gavrilov
+
+#include "OcctModelImporter.h"
+
+#include "OcctAssemblyTree.h"
+
+#include <Message_ProgressIndicator.hxx>
+#include <Message_ProgressScope.hxx>
+#include <OSD.hxx>
+#include <OSD_Parallel.hxx>
+#include <OSD_Timer.hxx>
+#include <Standard_Version.hxx>
+
+#include <algorithm>
+#include <exception>
+#include <map>
+#include <string>
+
+#ifdef HAVE_DATAEXCHANGE
+  #include <BRep_Tool.hxx>
+  #include <BRepBndLib.hxx>
+  #include <BRepCheck_Analyzer.hxx>
+  #include <BRepMesh_IncrementalMesh.hxx>
+  #include <BRepTools_ReShape.hxx>
+  #include <Message_ListOfMsg.hxx>
+  #include <Message_Msg.hxx>
+  #include <RWGltf_CafReader.hxx>
+  #include <ShapeBuild_ReShape.hxx>
+  #include <ShapeExtend_DataMapOfShapeListOfMsg.hxx>
+  #include <ShapeExtend_MsgRegistrator.hxx>
+  #include <ShapeFix_Shape.hxx>
+  #include <STEPCAFControl_Reader.hxx>
+  #include <TDataStd_Name.hxx>
+  #include <TDF_LabelSequence.hxx>
+  #include <TNaming_Builder.hxx>
+  #include <TopExp.hxx>
+  #include <TopExp_Explorer.hxx>
+  #include <TopoDS.hxx>
+  #include <TopTools_IndexedDataMapOfShapeListOfShape.hxx>
+  #include <TopTools_MapOfShape.hxx>
+  #include <TopTools_ShapeMapHasher.hxx>
+  #include <XCAFApp_Application.hxx>
+  #include <XCAFDoc_DocumentTool.hxx>
+  #include <XCAFDoc_ShapeTool.hxx>
+  #include <XCAFDoc_VisMaterial.hxx>
+  #include <XCAFPrs.hxx>
+  #include <XCAFPrs_AISObject.hxx>
+  #include <XCAFPrs_DocumentExplorer.hxx>
+  #include <XCAFPrs_IndexedDataMapOfShapeStyle.hxx>
+#endif
+
+//! Progress indicator passing position to importer and checking cancellation flag.
+class OcctModelImporter::ImportProgress : public Message_ProgressIndicator
+{
+public:
+
+  //! Main constructor.
+  ImportProgress(OcctModelImporter* theImporter) : myImporter(theImporter) {}
+
+  //! Pass position to importer.
+  virtual void Show(const Message_ProgressScope& , const Standard_Boolean ) override
+  {
+    myImporter->updateProgress(GetPosition());
+  }
+
+  //! Return cancellation flag.
+  virtual Standard_Boolean UserBreak() override { return myImporter->myToCancel; }
+
+private:
+
+  OcctModelImporter* myImporter;
+
+};
+
+// ================================================================
+// Function : StageName
+// ================================================================
+const char* OcctModelImporter::StageName(Stage theStage)
+{
+  switch (theStage)
+  {
+    case Stage_Parse:    return "parse";
+    case Stage_Transfer: return "transfer";
+    case Stage_Heal:     return "heal";
+    case Stage_Mesh:     return "mesh";
+    case Stage_Display:  return "display";
+    case Stage_NB:       break;
+  }
+  return "";
+}
+
+// ================================================================
+// Function : IsSupported
+// ================================================================
+bool OcctModelImporter::IsSupported()
+{
+#ifdef HAVE_DATAEXCHANGE
+  return true;
+#else
+  return false;
+#endif
+}
+
+// ================================================================
+// Function : IsSupportedFormat
+// ================================================================
+bool OcctModelImporter::IsSupportedFormat(const TCollection_AsciiString& thePath)
+{
+  const int aDotPos = thePath.SearchFromEnd(".");
+  if (aDotPos <= 0)
+    return false;
+
+  TCollection_AsciiString anExt = thePath.SubString(aDotPos + 1, thePath.Length());
+  anExt.LowerCase();
+  return anExt == "step" || anExt == "stp"
+      || anExt == "gltf" || anExt == "glb";
+}
+
+// ================================================================
+// Function : OcctModelImporter
+// ================================================================
+OcctModelImporter::OcctModelImporter()
+: myProgress(0.0),
+  myStage(Stage_Parse),
+  myReportedPercent(-1),
+  myToCancel(false),
+  myIsDone(false)
+{
+  for (double& aTime : myStageTimes)
+    aTime = -1.0;
+}
+
+// ================================================================
+// Function : ~OcctModelImporter
+// ================================================================
+OcctModelImporter::~OcctModelImporter()
+{
+  Cancel();
+  Wait();
+}
+
+// ================================================================
+// Function : Start
+// ================================================================
+bool OcctModelImporter::Start(const TCollection_AsciiString& thePath)
+{
+  myPath = thePath;
+  if (!IsSupported())
+  {
+    myError = "samples are built without data exchange components (USE_DATAEXCHANGE)";
+    return false;
+  }
+  if (!IsSupportedFormat(thePath))
+  {
+    myError = "unsupported file format (STEP and glTF are expected)";
+    return false;
+  }
+  if (myWorker.joinable())
+  {
+    myError = "import is already started";
+    return false;
+  }
+
+  // parallel decoding and meshing are executed by OSD_Parallel - use OSD_ThreadPool even if OCCT is built with TBB
+  OSD_Parallel::SetUseOcctThreads(true);
+  myWorker = std::thread(&OcctModelImporter::performImport, this);
+  return true;
+}
+
+// ================================================================
+// Function : Wait
+// ================================================================
+bool OcctModelImporter::Wait()
+{
+  if (myWorker.joinable())
+    myWorker.join();
+
+  return myIsImported;
+}
+
+// ================================================================
+// Function : performImport
+// ================================================================
+void OcctModelImporter::performImport()
+{
+  // convert signals (like access violation) into C++ exceptions within this thread
+  OSD::SetThreadLocalSignal(OSD::SignalMode(), false);
+  try
+  {
+  #ifdef HAVE_DATAEXCHANGE
+    Handle(ImportProgress) aProgress = new ImportProgress(this);
+    Message_ProgressScope aPS(aProgress->Start(), "Import", 100);
+
+    XCAFApp_Application::GetApplication()->NewDocument("BinXCAF", myDoc);
+    const int aDotPos = myPath.SearchFromEnd(".");
+    TCollection_AsciiString anExt = myPath.SubString(aDotPos + 1, myPath.Length());
+    anExt.LowerCase();
+    if (anExt == "gltf" || anExt == "glb")
+    {
+      myIsImported = readGltf(aPS.Next(70))
+                  && (myToLoadOnDemand ? collectParts(aPS.Next(30)) : buildMeshLevels(aPS.Next(30)));
+    }
+    else
+    {
+      // STEP reader cannot translate parts separately, so that on-demand mode defers only meshing and presentations
+      myIsImported = readStep(aPS.Next(myToHealShapes ? 50 : 70))
+                  && (!myToHealShapes || healShapes(aPS.Next(20)))
+                  && (myToLoadOnDemand ? collectParts(aPS.Next(30)) : meshShapes(aPS.Next(30)));
+    }
+    if (!myIsImported
+     && myToCancel)
+    {
+      myError = "import has been cancelled";
+    }
+  #endif
+  }
+  catch (const Standard_Failure& theErr)
+  {
+    myIsImported = false;
+    myError = TCollection_AsciiString("exception ") + theErr.DynamicType()->Name() + ": " + theErr.GetMessageString();
+  }
+  catch (const std::exception& theErr)
+  {
+    myIsImported = false;
+    myError = TCollection_AsciiString("exception ") + theErr.what();
+  }
+  catch (...)
+  {
+    myIsImported = false;
+    myError = "unknown exception";
+  }
+
+  myIsDone = true;
+  if (myProgressCallback)
+    myProgressCallback();
+}
+
+// ================================================================
+// Function : readStep
+// ================================================================
+bool OcctModelImporter::readStep(const Message_ProgressRange& theRange)
+{
+#ifdef HAVE_DATAEXCHANGE
+  Message_ProgressScope aPS(theRange, "STEP import", 100);
+  OSD_Timer aTimer;
+  aTimer.Start();
+  setStage(Stage_Parse);
+  STEPCAFControl_Reader aReader;
+  aReader.SetColorMode(true);
+  aReader.SetNameMode(true);
+  aReader.SetLayerMode(true);
+  if (aReader.ReadFile(myPath.ToCString()) != IFSelect_RetDone)
+  {
+    myError = "STEP file cannot be read";
+    return false;
+  }
+  myStageTimes[Stage_Parse] = aTimer.ElapsedTime();
+  aPS.Next(30);
+  if (aPS.UserBreak())
+    return false;
+
+  // STEP translation is sequential, while shape healing is done within the transfer
+  // according to 'read.step.resource.name' and 'read.step.sequence' parameters
+  setStage(Stage_Transfer);
+  aTimer.Reset();
+  aTimer.Start();
+  const bool isDone = aReader.Transfer(myDoc, aPS.Next(70));
+  myStageTimes[Stage_Transfer] = aTimer.ElapsedTime();
+  if (!isDone)
+  {
+    if (!aPS.UserBreak())
+      myError = "STEP file cannot be translated";
+    return false;
+  }
+  return !aPS.UserBreak();
+#else
+  (void )theRange;
+  return false;
+#endif
+}
+
+// ================================================================
+// Function : readGltf
+// ================================================================
+bool OcctModelImporter::readGltf(const Message_ProgressRange& theRange)
+{
+#ifdef HAVE_DATAEXCHANGE
+  OSD_Timer aTimer;
+  aTimer.Start();
+  setStage(Stage_Parse);
+  RWGltf_CafReader aReader;
+  aReader.SetSystemLengthUnit(0.001);
+  aReader.SetSystemCoordinateSystem(RWMesh_CoordinateSystem_Zup);
+  aReader.SetDocument(myDoc);
+  aReader.SetParallel(true);
+#if (OCC_VERSION_HEX >= 0x070600)
+  if (myToLoadOnDemand)
+  {
+    // keep triangulation data in file until part becomes visible
+    aReader.SetToSkipLateDataLoading(true);
+    aReader.SetToKeepLateData(true);
+  }
+#endif
+  const bool isDone = aReader.Perform(myPath, theRange);
+  myStageTimes[Stage_Parse] = aTimer.ElapsedTime();
+  if (!isDone
+   && !myToCancel)
+  {
+    myError = "glTF file cannot be read";
+  }
+  return isDone && !myToCancel;
+#else
+  (void )theRange;
+  return false;
+#endif
+}
+
+#ifdef HAVE_DATAEXCHANGE
+namespace
+{
+  //! Shape healed by a single ShapeFix_Shape.
+  struct HealTask
+  {
+    int          Part = 0;     //!< index of part report
+    TopoDS_Shape Shape;        //!< solid without location or whole part
+    TopoDS_Shape Result;       //!< healed shape
+    Handle(ShapeBuild_ReShape) Context; //!< replacements recorded by healing
+    bool         IsSkipped = false; //!< shape is already valid and has not been healed
+    double       Time = 0.0;   //!< healing time in seconds
+    std::map<std::string, int> Fixes; //!< recorded fixes by message key
+  };
+
+  //! Return TRUE if shape consists only of solids not sharing faces, edges or vertices,
+  //! so that they can be healed independently.
+  static bool hasIndependentSolids(const TopoDS_Shape& theShape)
+  {
+    if (!TopExp_Explorer(theShape, TopAbs_SOLID).More()
+     || TopExp_Explorer(theShape, TopAbs_SHELL, TopAbs_SOLID).More()
+     || TopExp_Explorer(theShape, TopAbs_FACE,  TopAbs_SHELL).More()
+     || TopExp_Explorer(theShape, TopAbs_EDGE,  TopAbs_FACE).More())
+    {
+      return false;
+    }
+
+    // healing of one solid may modify its boundary shared with another one
+    static const TopAbs_ShapeEnum THE_SHARED_TYPES[3] = { TopAbs_FACE, TopAbs_EDGE, TopAbs_VERTEX };
+    for (TopAbs_ShapeEnum aSharedType : THE_SHARED_TYPES)
+    {
+      TopTools_IndexedDataMapOfShapeListOfShape aSubSolids;
+      TopExp::MapShapesAndUniqueAncestors(theShape, aSharedType, TopAbs_SOLID, aSubSolids);
+      for (int aSubIter = 1; aSubIter <= aSubSolids.Extent(); ++aSubIter)
+      {
+        if (aSubSolids.FindFromIndex(aSubIter).Extent() > 1)
+          return false;
+      }
+    }
+    return true;
+  }
+
+  //! Find healed sub-shape (face, edge, or compound of them) following replacements recorded by healing of the part.
+  //! @return NULL shape if sub-shape has been removed
+  static TopoDS_Shape healedSubShape(const std::vector<Handle(ShapeBuild_ReShape)>& theContexts,
+                                     const TopoDS_Shape& theSubShape)
+  {
+    // replacements are applied regardless of locations, so that all occurrences of instanced solid are found
+    TopoDS_Shape aSubShape = theSubShape;
+    for (const Handle(ShapeBuild_ReShape)& aContext : theContexts)
+    {
+      aSubShape = aContext->Apply(aSubShape);
+      if (aSubShape.IsNull())
+        break;
+    }
+    return aSubShape;
+  }
+}
+#endif
+
+// ================================================================
+// Function : healShapes
+// ================================================================
+bool OcctModelImporter::healShapes(const Message_ProgressRange& theRange)
+{
+#ifdef HAVE_DATAEXCHANGE
+  OSD_Timer aTimer;
+  aTimer.Start();
+  setStage(Stage_Heal);
+  myHealReports.clear();
+
+  // split parts (not assemblies) into tasks - one per solid, or one per part which solids cannot be healed separately
+  Handle(XCAFDoc_ShapeTool) aShapeTool = XCAFDoc_DocumentTool::ShapeTool(myDoc->Main());
+  TDF_LabelSequence aLabels, aPartLabels;
+  aShapeTool->GetShapes(aLabels);
+  std::vector<HealTask> aTasks;
+  for (TDF_LabelSequence::Iterator aLabIter(aLabels); aLabIter.More(); aLabIter.Next())
+  {
+    const TDF_Label& aLabel = aLabIter.Value();
+    const TopoDS_Shape aShape = XCAFDoc_ShapeTool::GetShape(aLabel);
+    if (XCAFDoc_ShapeTool::IsAssembly(aLabel)
+     || aShape.IsNull())
+    {
+      continue;
+    }
+
+    HealReport aReport;
+    Handle(TDataStd_Name) aName;
+    aReport.Name = aLabel.FindAttribute(TDataStd_Name::GetID(), aName)
+                 ? TCollection_AsciiString(aName->Get())
+                 : TCollection_AsciiString("part ") + (aPartLabels.Length() + 1);
+
+    HealTask aTask;
+    aTask.Part = aPartLabels.Length();
+    if (hasIndependentSolids(aShape))
+    {
+      // solid instanced several times (same TShape with different locations) is healed once
+      TopTools_MapOfShape aSolids;
+      for (TopExp_Explorer aSolidIter(aShape, TopAbs_SOLID); aSolidIter.More(); aSolidIter.Next())
+      {
+        const TopoDS_Shape aSolid = aSolidIter.Current().Located(TopLoc_Location());
+        if (!aSolids.Add(aSolid))
+          continue;
+
+        aTask.Shape = aSolid;
+        aTasks.push_back(aTask);
+        ++aReport.NbShapes;
+      }
+    }
+    else
+    {
+      aTask.Shape = aShape;
+      aTasks.push_back(aTask);
+      aReport.NbShapes = 1;
+    }
+    aPartLabels.Append(aLabel);
+    myHealReports.push_back(aReport);
+  }
+
+  // progress ranges are created upfront, as progress scope cannot be advanced from several threads
+  Message_ProgressScope aPS(theRange, "Healing", (double )aTasks.size());
+  std::vector<Message_ProgressRange> aRanges;
+  aRanges.reserve(aTasks.size());
+  for (size_t aTaskIter = 0; aTaskIter < aTasks.size(); ++aTaskIter)
+    aRanges.push_back(aPS.Next());
+
+  // the largest shapes are healed first to balance threads
+  std::vector<int> anOrder(aTasks.size());
+  for (size_t aTaskIter = 0; aTaskIter < aTasks.size(); ++aTaskIter)
+    anOrder[aTaskIter] = (int )aTaskIter;
+  {
+    std::vector<int> aNbFaces(aTasks.size(), 0);
+    for (size_t aTaskIter = 0; aTaskIter < aTasks.size(); ++aTaskIter)
+    {
+      for (TopExp_Explorer aFaceIter(aTasks[aTaskIter].Shape, TopAbs_FACE); aFaceIter.More(); aFaceIter.Next())
+        ++aNbFaces[aTaskIter];
+    }
+    std::stable_sort(anOrder.begin(), anOrder.end(), [&aNbFaces](int theLeft, int theRight)
+    {
+      return aNbFaces[theLeft] > aNbFaces[theRight];
+    });
+  }
+
+  OSD_Parallel::For(0, (int )aTasks.size(), [&](int theIndex)
+  {
+    const int aTaskIndex = anOrder[theIndex];
+    HealTask& aTask = aTasks[aTaskIndex];
+    aTask.Result = aTask.Shape;
+    if (myToCancel)
+      return;
+
+    OSD_Timer aTaskTimer;
+    aTaskTimer.Start();
+    try
+    {
+      // shapes already fixed within STEP transfer (see 'read.step.sequence') are not healed once again
+      if (BRepCheck_Analyzer(aTask.Shape).IsValid())
+      {
+        aTask.IsSkipped = true;
+        aTask.Time = aTaskTimer.ElapsedTime();
+        return;
+      }
+
+      Handle(ShapeExtend_MsgRegistrator) aMsgReg = new ShapeExtend_MsgRegistrator();
+      Handle(ShapeFix_Shape) aFixer = new ShapeFix_Shape(aTask.Shape);
+      aFixer->SetMsgRegistrator(aMsgReg);
+
+      // replacements are kept for remapping sub-shape labels; they are recorded without locations
+      Handle(ShapeBuild_ReShape) aContext = new ShapeBuild_ReShape();
+      aContext->ModeConsiderLocation() = true;
+      aFixer->SetContext(aContext);
+      if (aFixer->Perform(aRanges[aTaskIndex]))
+      {
+        aTask.Result  = aFixer->Shape();
+        aTask.Context = aContext;
+      }
+
+      for (ShapeExtend_DataMapOfShapeListOfMsg::Iterator aShapeIter(aMsgReg->MapShape()); aShapeIter.More(); aShapeIter.Next())
+      {
+        for (Message_ListOfMsg::Iterator aMsgIter(aShapeIter.Value()); aMsgIter.More(); aMsgIter.Next())
+          ++aTask.Fixes[TCollection_AsciiString(aMsgIter.Value().Original()).ToCString()];
+      }
+    }
+    catch (const Standard_Failure& theErr)
+    {
+      // keep original shape
+      aTask.Result = aTask.Shape;
+      ++aTask.Fixes[std::string("exception ") + theErr.DynamicType()->Name()];
+    }
+    catch (const std::exception& theErr)
+    {
+      aTask.Result = aTask.Shape;
+      ++aTask.Fixes[std::string("exception ") + theErr.what()];
+    }
+    catch (...)
+    {
+      aTask.Result = aTask.Shape;
+      ++aTask.Fixes["unknown exception"];
+    }
+    aTask.Time = aTaskTimer.ElapsedTime();
+  });
+  if (aPS.UserBreak()
+   || myToCancel)
+  {
+    return false;
+  }
+
+  // put healed shapes into the document
+  std::vector<Handle(BRepTools_ReShape)> aReShapes(myHealReports.size());
+  std::vector<std::map<std::string, int>> aPartFixes(myHealReports.size());
+  std::vector<std::vector<Handle(ShapeBuild_ReShape)>> aPartContexts(myHealReports.size());
+  for (const HealTask& aTask : aTasks)
+  {
+    HealReport& aReport = myHealReports[aTask.Part];
+    aReport.Time += aTask.Time;
+    if (aTask.IsSkipped)
+      ++aReport.NbSkipped;
+    for (const std::pair<const std::string, int>& aFix : aTask.Fixes)
+    {
+      aPartFixes[aTask.Part][aFix.first] += aFix.second;
+      aReport.NbFixes += aFix.second;
+    }
+    if (!aTask.Result.IsSame(aTask.Shape))
+    {
+      ++aReport.NbModified;
+      if (aReShapes[aTask.Part].IsNull())
+      {
+        // replacement is applied to all occurrences of the shape regardless of their locations
+        aReShapes[aTask.Part] = new BRepTools_ReShape();
+        aReShapes[aTask.Part]->ModeConsiderLocation() = true;
+      }
+      aReShapes[aTask.Part]->Replace(aTask.Shape, aTask.Result);
+      if (!aTask.Context.IsNull())
+        aPartContexts[aTask.Part].push_back(aTask.Context);
+    }
+  }
+
+  bool hasModified = false;
+  for (size_t aPartIter = 0; aPartIter < myHealReports.size(); ++aPartIter)
+  {
+    HealReport& aReport = myHealReports[aPartIter];
+    for (const std::pair<const std::string, int>& aFix : aPartFixes[aPartIter])
+      aReport.Fixes += TCollection_AsciiString(aReport.Fixes.IsEmpty() ? "" : ", ") + aFix.first.c_str() + " x" + aFix.second;
+
+    if (aReport.NbModified == 0)
+      continue;
+
+    const TDF_Label& aLabel = aPartLabels.Value((int )aPartIter + 1);
+    aShapeTool->SetShape(aLabel, aReShapes[aPartIter]->Apply(XCAFDoc_ShapeTool::GetShape(aLabel)));
+    hasModified = true;
+
+    // sub-shape labels carrying colors and names should refer to healed sub-shapes, otherwise they are lost
+    TDF_LabelSequence aSubLabels;
+    XCAFDoc_ShapeTool::GetSubShapes(aLabel, aSubLabels);
+    for (TDF_LabelSequence::Iterator aSubIter(aSubLabels); aSubIter.More(); aSubIter.Next())
+    {
+      const TopoDS_Shape aSubShape = XCAFDoc_ShapeTool::GetShape(aSubIter.Value());
+      const TopoDS_Shape aNewSubShape = healedSubShape(aPartContexts[aPartIter], aSubShape);
+      if (!aNewSubShape.IsNull()
+       && !aNewSubShape.IsEqual(aSubShape))
+      {
+        TNaming_Builder aBuilder(aSubIter.Value());
+        aBuilder.Generated(aNewSubShape);
+      }
+    }
+  }
+  if (hasModified)
+    aShapeTool->UpdateAssemblies();
+
+  myStageTimes[Stage_Heal] = aTimer.ElapsedTime();
+  return true;
+#else
+  (void )theRange;
+  return false;
+#endif
+}
+
+// ================================================================
+// Function : meshShapes
+// ================================================================
+bool OcctModelImporter::meshShapes(const Message_ProgressRange& theRange)
+{
+#ifdef HAVE_DATAEXCHANGE
+  OSD_Timer aTimer;
+  aTimer.Start();
+  setStage(Stage_Mesh);
+  TDF_LabelSequence aLabels;
+  XCAFDoc_DocumentTool::ShapeTool(myDoc->Main())->GetFreeShapes(aLabels);
+  Message_ProgressScope aPS(theRange, "Meshing", aLabels.Length());
+  for (TDF_LabelSequence::Iterator aLabIter(aLabels); aLabIter.More() && aPS.More(); aLabIter.Next())
+  {
+    const TopoDS_Shape aShape = XCAFDoc_ShapeTool::GetShape(aLabIter.Value());
+    Bnd_Box aBox;
+    BRepBndLib::Add(aShape, aBox, false);
+    if (aBox.IsVoid())
+    {
+      aPS.Next();
+      continue;
+    }
+
+    // deflection computed in the same way as Prs3d::GetDeflection() with default drawer parameters,
+    // so that presentations reuse triangulation instead of meshing shapes once again
+    double aXmin = 0.0, aYmin = 0.0, aZmin = 0.0, aXmax = 0.0, aYmax = 0.0, aZmax = 0.0;
+    aBox.Get(aXmin, aYmin, aZmin, aXmax, aYmax, aZmax);
+    const double aMaxSize = Max(aXmax - aXmin, Max(aYmax - aYmin, aZmax - aZmin));
+
+    IMeshTools_Parameters aMeshParams;
+    aMeshParams.Deflection = aMaxSize * 0.001 * 4.0;
+    aMeshParams.Angle      = 20.0 * M_PI / 180.0;
+    aMeshParams.InParallel = true;
+    BRepMesh_IncrementalMesh aMesher(aShape, aMeshParams, aPS.Next());
+  }
+  myStageTimes[Stage_Mesh] = aTimer.ElapsedTime();
+  return !aPS.UserBreak();
+#else
+  (void )theRange;
+  return false;
+#endif
+}
+
+// ================================================================
+// Function : buildMeshLevels
+// ================================================================
+bool OcctModelImporter::buildMeshLevels(const Message_ProgressRange& theRange)
+{
+#ifdef HAVE_DATAEXCHANGE
+  OSD_Timer aTimer;
+  aTimer.Start();
+  setStage(Stage_Mesh);
+  myMeshChunks.clear();
+  myMeshParts.clear();
+  myMeshOccurrences.clear();
+
+  // leaf occurrences referring to the same part share its triangulations (glTF mesh instancing)
+  NCollection_DataMap<TopoDS_Shape, int, TopTools_ShapeMapHasher> aPartMap;
+  std::vector<TDF_Label> aPartLabels;
+  std::vector<int> aPartNbTris;
+  int64_t aNbTris = 0;
+  for (XCAFPrs_DocumentExplorer aDocExp(myDoc, XCAFPrs_DocumentExplorerFlags_OnlyLeafNodes); aDocExp.More(); aDocExp.Next())
+  {
+    const XCAFPrs_DocumentNode& aNode = aDocExp.Current();
+    const TopoDS_Shape aShape = XCAFDoc_ShapeTool::GetShape(aNode.RefLabel);
+    if (aShape.IsNull())
+      continue;
+
+    int aPartIndex = 0;
+    if (!aPartMap.Find(aShape, aPartIndex))
+    {
+      aPartIndex = (int )aPartLabels.size();
+      aPartMap.Bind(aShape, aPartIndex);
+      aPartLabels.push_back(aNode.RefLabel);
+      int aPartTris = 0;
+      for (TopExp_Explorer aFaceIter(aShape, TopAbs_FACE); aFaceIter.More(); aFaceIter.Next())
+      {
+        TopLoc_Location aLoc;
+        const Handle(Poly_Triangulation)& aTris = BRep_Tool::Triangulation(TopoDS::Face(aFaceIter.Current()), aLoc);
+        if (!aTris.IsNull())
+          aPartTris += aTris->NbTriangles();
+      }
+      aPartNbTris.push_back(aPartTris);
+    }
+
+    MeshOccurrence anOcc;
+    anOcc.Id = aNode.Id;
+    anOcc.Location = aNode.Location.Transformation();
+    anOcc.Part = aPartIndex;
+    if (aNode.Style.IsSetColorSurf())
+    {
+      anOcc.Color = aNode.Style.GetColorSurfRGBA();
+      anOcc.HasColor = true;
+    }
+    else if (!aNode.Style.Material().IsNull())
+    {
+      anOcc.Color = aNode.Style.Material()->BaseColor();
+      anOcc.HasColor = true;
+    }
+    myMeshOccurrences.push_back(anOcc);
+    aNbTris += aPartNbTris[aPartIndex];
+  }
+  if (aNbTris < (int64_t )myLodNbTriangles)
+  {
+    // regular XCAF presentations keep names, styles and sub-shape selection of small models
+    myMeshOccurrences.clear();
+    myStageTimes[Stage_Mesh] = aTimer.ElapsedTime();
+    return true;
+  }
+
+  // copy face triangulations of each part once, keeping them in part coordinates
+  std::vector<Handle(Poly_Triangulation)> aFaceTris;
+  myMeshParts.resize(aPartLabels.size());
+  for (size_t aPartIter = 0; aPartIter < aPartLabels.size(); ++aPartIter)
+  {
+    // face colors defined by the document
+    XCAFPrs_IndexedDataMapOfShapeStyle aStyles;
+    XCAFPrs::CollectStyleSettings(aPartLabels[aPartIter], TopLoc_Location(), aStyles);
+    NCollection_DataMap<TopoDS_Shape, Quantity_ColorRGBA, TopTools_ShapeMapHasher> aFaceColors;
+    for (int aStyleIter = 1; aStyleIter <= aStyles.Extent(); ++aStyleIter)
+    {
+      const XCAFPrs_Style& aStyle = aStyles.FindFromIndex(aStyleIter);
+      Quantity_ColorRGBA aColor;
+      if (aStyle.IsSetColorSurf())
+        aColor = aStyle.GetColorSurfRGBA();
+      else if (!aStyle.Material().IsNull())
+        aColor = aStyle.Material()->BaseColor();
+      else
+        continue;
+
+      for (TopExp_Explorer aFaceIter(aStyles.FindKey(aStyleIter), TopAbs_FACE); aFaceIter.More(); aFaceIter.Next())
+        aFaceColors.Bind(aFaceIter.Current(), aColor);
+    }
+
+    MeshPart& aPart = myMeshParts[aPartIter];
+    aPart.FirstChunk = (int )myMeshChunks.size();
+    const TopoDS_Shape aShape = XCAFDoc_ShapeTool::GetShape(aPartLabels[aPartIter]);
+    for (TopExp_Explorer aFaceIter(aShape, TopAbs_FACE); aFaceIter.More(); aFaceIter.Next())
+    {
+      const TopoDS_Face& aFace = TopoDS::Face(aFaceIter.Current());
+      TopLoc_Location aLoc;
+      const Handle(Poly_Triangulation)& aTris = BRep_Tool::Triangulation(aFace, aLoc);
+      if (aTris.IsNull() || aTris->NbTriangles() == 0)
+        continue;
+
+      // only face location within the part is applied - occurrence location remains object transformation
+      const gp_Trsf aTrsf = aLoc.Transformation();
+      const bool isReversed = aFace.Orientation() == TopAbs_REVERSED;
+      Handle(Poly_Triangulation) aCopy = new Poly_Triangulation();
+      aCopy->SetDoublePrecision(false);
+      aCopy->ResizeNodes(aTris->NbNodes(), false);
+      aCopy->ResizeTriangles(aTris->NbTriangles(), false);
+      for (int aNodeIter = 1; aNodeIter <= aTris->NbNodes(); ++aNodeIter)
+        aCopy->SetNode(aNodeIter, aTris->Node(aNodeIter).Transformed(aTrsf));
+
+      for (int aTriIter = 1; aTriIter <= aTris->NbTriangles(); ++aTriIter)
+      {
+        int aNodes[3] = { 0, 0, 0 };
+        aTris->Triangle(aTriIter).Get(aNodes[0], aNodes[1], aNodes[2]);
+        if (isReversed)
+          std::swap(aNodes[1], aNodes[2]);
+        aCopy->SetTriangle(aTriIter, Poly_Triangle(aNodes[0], aNodes[1], aNodes[2]));
+      }
+
+      MeshChunk aChunk;
+      aChunk.HasColor = aFaceColors.Find(aFace, aChunk.Color);
+      myMeshChunks.push_back(aChunk);
+      aFaceTris.push_back(aCopy);
+      ++aPart.NbChunks;
+    }
+  }
+
+  // simplify faces in parallel; progress ranges are created in advance, as scopes cannot be shared by threads
+  Message_ProgressScope aPS(theRange, "Simplification", (double )aFaceTris.size());
+  std::vector<Message_ProgressRange> aRanges;
+  for (size_t aFaceIter = 0; aFaceIter < aFaceTris.size(); ++aFaceIter)
+    aRanges.push_back(aPS.Next());
+
+  OSD_Parallel::For(0, (int )aFaceTris.size(), [&](int theIndex)
+  {
+    Message_ProgressScope aFacePS(aRanges[theIndex], NULL, 1);
+    if (!aFacePS.UserBreak())
+      myMeshChunks[theIndex].Levels = OcctLodMesh::BuildLevels(aFaceTris[theIndex]);
+  });
+  myStageTimes[Stage_Mesh] = aTimer.ElapsedTime();
+  if (aPS.UserBreak())
+  {
+    myMeshChunks.clear();
+    myMeshParts.clear();
+    myMeshOccurrences.clear();
+    return false;
+  }
+  return true;
+#else
+  (void )theRange;
+  return false;
+#endif
+}
+
+// ================================================================
+// Function : collectParts
+// ================================================================
+bool OcctModelImporter::collectParts(const Message_ProgressRange& theRange)
+{
+  OSD_Timer aTimer;
+  aTimer.Start();
+  setStage(Stage_Mesh);
+  Handle(OcctOnDemandAssembly) anAssembly = new OcctOnDemandAssembly();
+  const bool isDone = anAssembly->Init(myDoc, theRange);
+  myStageTimes[Stage_Mesh] = aTimer.ElapsedTime();
+  if (!isDone
+   || myToCancel)
+  {
+    if (!myToCancel)
+      myError = "document has no parts";
+    return false;
+  }
+
+  myAssembly = anAssembly;
+  return true;
+}
+
+// ================================================================
+// Function : Display
+// ================================================================
+int OcctModelImporter::Display(const Handle(AIS_InteractiveContext)& theCtx)
+{
+  int aNbDisplayed = 0;
+#ifdef HAVE_DATAEXCHANGE
+  if (myDoc.IsNull()
+  || !myIsImported)
+  {
+    return 0;
+  }
+
+  setStage(Stage_Display);
+  OSD_Timer aTimer;
+  aTimer.Start();
+  TDF_LabelSequence aLabels;
+  XCAFDoc_DocumentTool::ShapeTool(myDoc->Main())->GetFreeShapes(aLabels);
+  if (!myAssembly.IsNull())
+  {
+    // parts are displayed by the assembly itself once they become visible
+    theCtx->Display(myAssembly, 0, -1, false);
+    aNbDisplayed = myAssembly->NbParts();
+  }
+  else if (!myMeshOccurrences.empty())
+  {
+    // large triangulation-only model - one mesh per leaf occurrence sharing levels of detail of its part
+    for (const MeshOccurrence& anOcc : myMeshOccurrences)
+    {
+      const MeshPart& aPart = myMeshParts[anOcc.Part];
+      if (aPart.NbChunks == 0)
+        continue;
+
+      Handle(OcctLodMesh) aMesh = new OcctLodMesh();
+      for (int aChunkIter = aPart.FirstChunk; aChunkIter < aPart.FirstChunk + aPart.NbChunks; ++aChunkIter)
+      {
+        const MeshChunk& aChunk = myMeshChunks[aChunkIter];
+        if (aChunk.HasColor)
+          aMesh->AddChunk(aChunk.Levels, aChunk.Color);
+        else if (anOcc.HasColor)
+          aMesh->AddChunk(aChunk.Levels, anOcc.Color);
+        else
+          aMesh->AddChunk(aChunk.Levels);
+      }
+      aMesh->SetLocalTransformation(anOcc.Location);
+      OcctAssemblyTree::SetObjectId(aMesh, anOcc.Id);
+      theCtx->Display(aMesh, 0, 0, false);
+      ++aNbDisplayed;
+    }
+    myMeshChunks.clear();
+    myMeshParts.clear();
+    myMeshOccurrences.clear();
+  }
+  else
+  {
+    for (TDF_LabelSequence::Iterator aLabIter(aLabels); aLabIter.More(); aLabIter.Next())
+    {
+      Handle(XCAFPrs_AISObject) aPrs = new XCAFPrs_AISObject(aLabIter.Value());
+      OcctAssemblyTree::SetObjectId(aPrs, XCAFPrs_DocumentExplorer::DefineChildId(aLabIter.Value(), TCollection_AsciiString()));
+      aPrs->SetDisplayMode(AIS_Shaded);
+      theCtx->Display(aPrs, AIS_Shaded, 0, false);
+      ++aNbDisplayed;
+    }
+  }
+  myStageTimes[Stage_Display] = aTimer.ElapsedTime();
+#else
+  (void )theCtx;
+#endif
+  return aNbDisplayed;
+}
+
+// ================================================================
+// Function : FormatTimings
+// ================================================================
+TCollection_AsciiString OcctModelImporter::FormatTimings() const
+{
+  TCollection_AsciiString aText;
+  double aTotal = 0.0;
+  for (int aStageIter = 0; aStageIter < Stage_NB; ++aStageIter)
+  {
+    const double aTime = myStageTimes[aStageIter];
+    aText += TCollection_AsciiString(StageName((Stage )aStageIter)) + ": ";
+    if (aTime >= 0.0)
+    {
+      aText += TCollection_AsciiString(aTime) + " s, ";
+      aTotal += aTime;
+    }
+    else
+    {
+      aText += "-, ";
+    }
+  }
+  aText += TCollection_AsciiString("total: ") + aTotal + " s";
+  return aText;
+}
+
+// ================================================================
+// Function : FormatHealReport
+// ================================================================
+TCollection_AsciiString OcctModelImporter::FormatHealReport() const
+{
+  if (myHealReports.empty())
+    return TCollection_AsciiString();
+
+  int aNbModified = 0, aNbSkipped = 0, aNbFixes = 0;
+  TCollection_AsciiString aParts;
+  for (const HealReport& aReport : myHealReports)
+  {
+    aNbModified += aReport.NbModified;
+    aNbSkipped  += aReport.NbSkipped;
+    aNbFixes    += aReport.NbFixes;
+    if (aReport.NbFixes == 0
+     && aReport.Time < 0.1)
+    {
+      continue;
+    }
+
+    aParts += TCollection_AsciiString("\n  ") + aReport.Name + ": " + aReport.NbModified + "/" + aReport.NbShapes
+            + " solids modified, " + aReport.Time + " s" + (aReport.Fixes.IsEmpty() ? "" : "; ") + aReport.Fixes;
+  }
+  return TCollection_AsciiString("Healed ") + int(myHealReports.size()) + " parts in " + myStageTimes[Stage_Heal] + " s: "
+       + aNbModified + " solids modified, " + aNbSkipped + " valid solids skipped, " + aNbFixes + " fixes" + aParts;
+}
+
+// ================================================================
+// Function : setStage
+// ================================================================
+void OcctModelImporter::setStage(Stage theStage)
+{
+  myStage = theStage;
+  if (myProgressCallback)
+    myProgressCallback();
+}
+
+// ================================================================
+// Function : updateProgress
+// ================================================================
+void OcctModelImporter::updateProgress(double thePosition)
+{
+  myProgress = thePosition;
+  const int aPercent = int(thePosition * 100.0);
+  if (myReportedPercent.exchange(aPercent) != aPercent
+   && myProgressCallback)
+  {
+    myProgressCallback();
+  }
+}
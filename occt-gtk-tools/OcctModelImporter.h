@@ -0,0 +1,236 @@
+// Copyright (c) 2026 Kirill Gavrilov
+
+#ifndef _OcctModelImporter_HeaderFile
+#define _OcctModelImporter_HeaderFile
+
+#include "OcctLodMesh.h"
+#include "OcctOnDemandAssembly.h"
+
+#include <AIS_InteractiveContext.hxx>
+#include <Message_ProgressRange.hxx>
+#include <TDocStd_Document.hxx>
+
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <vector>
+
+//! Import of STEP and glTF files into XCAF document on a background thread.
+//!
+//! Import is split into stages timed separately:
+//! - Stage_Parse    - reading file; glTF reader decodes buffers in parallel and fills the document within this stage;
+//! - Stage_Transfer - translation of STEP entities into shapes, including shape healing;
+//! - Stage_Heal     - optional healing of STEP shapes by ShapeFix_Shape (see SetHealShapes()),
+//!                    executed in parallel per solid (or per part with shared or non-solid geometry);
+//! - Stage_Mesh     - parallel meshing of STEP shapes, or parallel simplification of glTF triangulations
+//!                    into levels of detail (glTF models larger than LodTriangles() are displayed by OcctLodMesh
+//!                    per leaf occurrence, sharing levels of detail between instances of the same part);
+//!                    in on-demand mode this stage only collects parts with their bounding boxes (see OcctOnDemandAssembly);
+//! - Stage_Display  - computing presentations within GUI thread (see Display()).
+//! Parallel algorithms are executed by OSD_Parallel on OCCT thread pool.
+//! Progress is reported through Message_ProgressIndicator, which also checks cancellation flag.
+//!
+//! Readers are available only when samples are built with HAVE_DATAEXCHANGE (USE_DATAEXCHANGE CMake option).
+class OcctModelImporter : public Standard_Transient
+{
+  DEFINE_STANDARD_RTTI_INLINE(OcctModelImporter, Standard_Transient)
+public:
+
+  //! Import stage.
+  enum Stage
+  {
+    Stage_Parse,
+    Stage_Transfer,
+    Stage_Heal,
+    Stage_Mesh,
+    Stage_Display,
+    Stage_NB
+  };
+
+  //! Return stage name.
+  static const char* StageName(Stage theStage);
+
+  //! Return TRUE if samples have been built with data exchange components.
+  static bool IsSupported();
+
+  //! Return TRUE if file extension corresponds to supported format (STEP or glTF).
+  static bool IsSupportedFormat(const TCollection_AsciiString& thePath);
+
+  //! Healing report of a part.
+  struct HealReport
+  {
+    TCollection_AsciiString Name;           //!< part name
+    int                     NbShapes   = 0; //!< number of healed solids (1 for part healed as a whole)
+    int                     NbModified = 0; //!< number of solids modified by healing
+    int                     NbSkipped  = 0; //!< number of valid solids skipped (e.g. already fixed by STEP reader)
+    int                     NbFixes    = 0; //!< number of recorded fixes
+    TCollection_AsciiString Fixes;          //!< recorded fix kinds with counters
+    double                  Time = 0.0;     //!< healing time in seconds summed over solids
+  };
+
+public:
+
+  //! Empty constructor.
+  OcctModelImporter();
+
+  //! Destructor, cancels import and waits for worker thread.
+  virtual ~OcctModelImporter();
+
+  //! Set callback called from worker thread on progress change and on import completion;
+  //! should be set before Start(). The callback should wake up GUI thread to check Progress() and IsDone().
+  void SetProgressCallback(const std::function<void()>& theCallback) { myProgressCallback = theCallback; }
+
+  //! Return TRUE if parts should be loaded on demand (FALSE by default).
+  bool ToLoadPartsOnDemand() const { return myToLoadOnDemand; }
+
+  //! Set if parts should be loaded on demand: the model is displayed by OcctOnDemandAssembly,
+  //! glTF triangulation data is read and STEP shapes are meshed only for parts becoming visible;
+  //! should be set before Start().
+  void SetLoadPartsOnDemand(bool theToLoad) { myToLoadOnDemand = theToLoad; }
+
+  //! Return TRUE if STEP shapes should be healed after transfer (FALSE by default).
+  bool ToHealShapes() const { return myToHealShapes; }
+
+  //! Set if STEP shapes should be healed after transfer (Stage_Heal); should be set before Start().
+  void SetHealShapes(bool theToHeal) { myToHealShapes = theToHeal; }
+
+  //! Return minimal number of triangles of glTF model to be displayed by OcctLodMesh (1000000 by default).
+  int LodTriangles() const { return myLodNbTriangles; }
+
+  //! Set minimal number of triangles of glTF model to be displayed by OcctLodMesh;
+  //! smaller models are displayed by XCAFPrs_AISObject; should be set before Start().
+  void SetLodTriangles(int theNbTris) { myLodNbTriangles = theNbTris; }
+
+  //! Start import on background thread.
+  //! @return FALSE if import cannot be started (see Error())
+  bool Start(const TCollection_AsciiString& thePath);
+
+  //! Request cancellation of running import.
+  void Cancel() { myToCancel = true; }
+
+  //! Return imported file path.
+  const TCollection_AsciiString& Path() const { return myPath; }
+
+  //! Return TRUE if worker thread has finished (successfully or not).
+  bool IsDone() const { return myIsDone; }
+
+  //! Return current stage.
+  Stage CurrentStage() const { return (Stage )myStage.load(); }
+
+  //! Return overall progress within [0, 1] range.
+  double Progress() const { return myProgress; }
+
+  //! Wait for worker thread.
+  //! @return TRUE if model has been imported
+  bool Wait();
+
+  //! Return error description of failed import.
+  const TCollection_AsciiString& Error() const { return myError; }
+
+  //! Display imported model; should be called from GUI thread after Wait().
+  //! @return number of displayed objects
+  int Display(const Handle(AIS_InteractiveContext)& theCtx);
+
+  //! Return stage duration in seconds (negative for skipped stages).
+  double StageTime(Stage theStage) const { return myStageTimes[theStage]; }
+
+  //! Format per-stage timings.
+  TCollection_AsciiString FormatTimings() const;
+
+  //! Return healing report per part (empty if healing has been skipped).
+  const std::vector<HealReport>& HealReports() const { return myHealReports; }
+
+  //! Format healing report - one line per part with fixes or slow healing.
+  TCollection_AsciiString FormatHealReport() const;
+
+  //! Return imported document.
+  const Handle(TDocStd_Document)& Document() const { return myDoc; }
+
+  //! Return assembly displayed in on-demand mode (NULL otherwise).
+  const Handle(OcctOnDemandAssembly)& OnDemandAssembly() const { return myAssembly; }
+
+protected:
+
+  //! Progress indicator passing position to importer and checking cancellation flag.
+  class ImportProgress;
+
+  //! Worker thread function.
+  void performImport();
+
+  //! Read STEP file (Stage_Parse and Stage_Transfer).
+  bool readStep(const Message_ProgressRange& theRange);
+
+  //! Read glTF file (Stage_Parse).
+  bool readGltf(const Message_ProgressRange& theRange);
+
+  //! Heal shapes of the document parts in parallel (Stage_Heal).
+  bool healShapes(const Message_ProgressRange& theRange);
+
+  //! Mesh free shapes of the document (Stage_Mesh).
+  bool meshShapes(const Message_ProgressRange& theRange);
+
+  //! Build levels of detail for triangulations of free shapes (Stage_Mesh).
+  bool buildMeshLevels(const Message_ProgressRange& theRange);
+
+  //! Collect parts of the document for on-demand loading (Stage_Mesh).
+  bool collectParts(const Message_ProgressRange& theRange);
+
+  //! Switch current stage.
+  void setStage(Stage theStage);
+
+  //! Store progress position and notify callback on noticeable change.
+  void updateProgress(double thePosition);
+
+protected:
+
+  //! Face triangulation with levels of detail, defined in part coordinates.
+  struct MeshChunk
+  {
+    Quantity_ColorRGBA Color;
+    bool               HasColor = false;
+    NCollection_Vector<Handle(Poly_Triangulation)> Levels;
+  };
+
+  //! Range of chunks of the same part.
+  struct MeshPart
+  {
+    int FirstChunk = 0;
+    int NbChunks   = 0;
+  };
+
+  //! Leaf occurrence of the part within assembly.
+  struct MeshOccurrence
+  {
+    TCollection_AsciiString Id;       //!< occurrence path within assembly tree
+    gp_Trsf                 Location; //!< occurrence location applied as object transformation
+    Quantity_ColorRGBA      Color;    //!< occurrence color used for chunks without own color
+    bool                    HasColor = false;
+    int                     Part = 0;
+  };
+
+protected:
+
+  TCollection_AsciiString  myPath;
+  TCollection_AsciiString  myError;
+  Handle(TDocStd_Document) myDoc;
+  std::vector<MeshChunk>   myMeshChunks; //!< levels of detail of triangulation-only (glTF) model
+  std::vector<MeshPart>    myMeshParts;  //!< chunk ranges of unique parts
+  std::vector<MeshOccurrence> myMeshOccurrences; //!< leaf occurrences displayed by OcctLodMesh
+  std::vector<HealReport>  myHealReports; //!< healing report per part
+  Handle(OcctOnDemandAssembly) myAssembly; //!< parts loaded on demand
+  std::function<void()>    myProgressCallback;
+  std::thread              myWorker;
+  double                   myStageTimes[Stage_NB];
+  std::atomic<double>      myProgress;
+  std::atomic<int>         myStage;
+  std::atomic<int>         myReportedPercent; //!< last progress percentage passed to callback
+  std::atomic<bool>        myToCancel;
+  std::atomic<bool>        myIsDone;
+  bool                     myIsImported = false;
+  bool                     myToLoadOnDemand = false;
+  bool                     myToHealShapes = false;
+  int                      myLodNbTriangles = 1000000;
+
+};
+
+#endif // _OcctModelImporter_HeaderFile
@@ -0,0 +1,658 @@
+// Copyright (c) 2026 Kirill Gavrilov
+
+#include "OcctOnDemandAssembly.h"
+
+#include "OcctAssemblyTree.h"
+#include "OcctSceneBoundsIndex.h"
+
+#include <Graphic3d_ArrayOfSegments.hxx>
+#include <Graphic3d_CullingTool.hxx>
+#include <Message.hxx>
+#include <Message_ProgressScope.hxx>
+#include <OSD.hxx>
+#include <OSD_Parallel.hxx>
+#include <Prs3d_LineAspect.hxx>
+#include <Standard_Version.hxx>
+
+#include <algorithm>
+#include <exception>
+
+#ifdef HAVE_DATAEXCHANGE
+  #include <BRep_Tool.hxx>
+  #include <BRepBndLib.hxx>
+  #include <BRepMesh_IncrementalMesh.hxx>
+  #include <BRepTools.hxx>
+  #include <TopExp_Explorer.hxx>
+  #include <TopoDS.hxx>
+  #include <TopTools_ShapeMapHasher.hxx>
+  #include <XCAFDoc_ShapeTool.hxx>
+  #include <XCAFPrs_AISObject.hxx>
+  #include <XCAFPrs_DocumentExplorer.hxx>
+#endif
+
+namespace
+{
+  //! Number of parts per proxy group.
+  static const int THE_PROXY_BLOCK = 1024;
+
+  //! Box edges defined by indices of corners.
+  static const int THE_BOX_EDGES[12][2] =
+  {
+    { 0, 1 }, { 2, 3 }, { 4, 5 }, { 6, 7 },
+    { 0, 2 }, { 1, 3 }, { 4, 6 }, { 5, 7 },
+    { 0, 4 }, { 1, 5 }, { 2, 6 }, { 3, 7 }
+  };
+}
+
+// ================================================================
+// Function : OcctOnDemandAssembly
+// ================================================================
+OcctOnDemandAssembly::OcctOnDemandAssembly()
+{
+  myDrawer->SetLineAspect(new Prs3d_LineAspect(Quantity_NOC_GRAY50, Aspect_TOL_SOLID, 1.0));
+  SetDisplayMode(0);
+  SetInfiniteState(false);
+  myTimer.Start();
+}
+
+// ================================================================
+// Function : ~OcctOnDemandAssembly
+// ================================================================
+OcctOnDemandAssembly::~OcctOnDemandAssembly()
+{
+  StopLoading();
+}
+
+// ================================================================
+// Function : Init
+// ================================================================
+bool OcctOnDemandAssembly::Init(const Handle(TDocStd_Document)& theDoc,
+                                const Message_ProgressRange& theRange)
+{
+#ifdef HAVE_DATAEXCHANGE
+  myParts.clear();
+  myShapes.clear();
+  myBox.SetVoid();
+
+  // leaf occurrences of product structure; instances of the same product share the shape
+  NCollection_DataMap<TopoDS_Shape, int, TopTools_ShapeMapHasher> aShapeIndices;
+  for (XCAFPrs_DocumentExplorer aDocExp(theDoc, XCAFPrs_DocumentExplorerFlags_OnlyLeafNodes); aDocExp.More(); aDocExp.Next())
+  {
+    const XCAFPrs_DocumentNode& aNode = aDocExp.Current();
+    const TopoDS_Shape aShape = XCAFDoc_ShapeTool::GetShape(aNode.RefLabel);
+    if (aShape.IsNull())
+      continue;
+
+    Part aPart;
+    aPart.Label = aNode.RefLabel;
+    aPart.Id = aNode.Id;
+    aPart.Location = aNode.Location.Transformation();
+    aPart.HasColor = aNode.Style.IsSetColorSurf();
+    if (aPart.HasColor)
+      aPart.Color = aNode.Style.GetColorSurfRGBA();
+
+    if (const int* aShapeIndex = aShapeIndices.Seek(aShape))
+    {
+      aPart.Shape = *aShapeIndex;
+    }
+    else
+    {
+      aPart.Shape = (int )myShapes.size();
+      aShapeIndices.Bind(aShape, aPart.Shape);
+      SharedShape aShared;
+      aShared.Shape = aShape;
+      myShapes.push_back(aShared);
+    }
+    myParts.push_back(aPart);
+  }
+
+  // bounding boxes of shared shapes in parallel; progress ranges are created in advance, as scopes cannot be shared by threads
+  Message_ProgressScope aPS(theRange, "Bounding boxes", (double )myShapes.size());
+  std::vector<Message_ProgressRange> aRanges;
+  for (size_t aShapeIter = 0; aShapeIter < myShapes.size(); ++aShapeIter)
+    aRanges.push_back(aPS.Next());
+
+  std::vector<Bnd_Box> aShapeBoxes(myShapes.size());
+  OSD_Parallel::For(0, (int )myShapes.size(), [&](int theIndex)
+  {
+    Message_ProgressScope aShapePS(aRanges[theIndex], NULL, 1);
+    if (!aShapePS.UserBreak())
+      BRepBndLib::Add(myShapes[theIndex].Shape, aShapeBoxes[theIndex], true);
+  });
+  if (aPS.UserBreak())
+  {
+    myParts.clear();
+    myShapes.clear();
+    return false;
+  }
+
+  for (Part& aPart : myParts)
+  {
+    const Bnd_Box& aShapeBox = aShapeBoxes[aPart.Shape];
+    if (!aShapeBox.IsVoid())
+    {
+      aPart.Box = aShapeBox.Transformed(aPart.Location);
+      myBox.Add(aPart.Box);
+    }
+  }
+  Message::SendInfo() << "OcctOnDemandAssembly: " << (int )myParts.size() << " parts referring "
+                      << (int )myShapes.size() << " shapes";
+  return !myParts.empty();
+#else
+  (void )theDoc;
+  (void )theRange;
+  return false;
+#endif
+}
+
+// ================================================================
+// Function : StopLoading
+// ================================================================
+void OcctOnDemandAssembly::StopLoading()
+{
+  {
+    std::lock_guard<std::mutex> aLock(myMutex);
+    myToStop = true;
+    myRequests.clear();
+    myResults.clear();
+  }
+  myCondition.notify_all();
+  for (std::thread& aThread : myWorkers)
+  {
+    aThread.join();
+  }
+  myWorkers.clear();
+
+  // dropped requests and results are requested again once workers are restarted by Update()
+  for (SharedShape& aShape : myShapes)
+  {
+    aShape.IsPending = false;
+  }
+}
+
+// ================================================================
+// Function : workerLoop
+// ================================================================
+void OcctOnDemandAssembly::workerLoop()
+{
+  // convert signals (like access violation) into C++ exceptions within this thread
+  OSD::SetThreadLocalSignal(OSD::SignalMode(), false);
+  for (;;)
+  {
+    int aShapeIndex = -1;
+    {
+      std::unique_lock<std::mutex> aLock(myMutex);
+      myCondition.wait(aLock, [this]() { return myToStop || !myRequests.empty(); });
+      if (myToStop)
+        return;
+
+      aShapeIndex = myRequests.front();
+      myRequests.pop_front();
+    }
+
+    try
+    {
+      loadShape(myShapes[aShapeIndex].Shape);
+    }
+    catch (const Standard_Failure& theErr)
+    {
+      Message::SendFail() << "OcctOnDemandAssembly: part loading failed with exception "
+                          << theErr.DynamicType()->Name() << ": " << theErr.GetMessageString();
+    }
+    catch (const std::exception& theErr)
+    {
+      Message::SendFail() << "OcctOnDemandAssembly: part loading failed with exception " << theErr.what();
+    }
+    catch (...)
+    {
+      Message::SendFail() << "OcctOnDemandAssembly: part loading failed with unknown exception";
+    }
+
+    std::function<void()> aCallback;
+    {
+      std::lock_guard<std::mutex> aLock(myMutex);
+      if (myToStop)
+        return;
+
+      myResults.push_back(aShapeIndex);
+      aCallback = myLoadedCallback;
+    }
+    if (aCallback)
+      aCallback();
+  }
+}
+
+// ================================================================
+// Function : loadShape
+// ================================================================
+void OcctOnDemandAssembly::loadShape(const TopoDS_Shape& theShape)
+{
+#ifdef HAVE_DATAEXCHANGE
+  bool toMesh = false;
+  for (TopExp_Explorer aFaceIter(theShape, TopAbs_FACE); aFaceIter.More(); aFaceIter.Next())
+  {
+    TopLoc_Location aLoc;
+    const Handle(Poly_Triangulation)& aTris = BRep_Tool::Triangulation(TopoDS::Face(aFaceIter.Current()), aLoc);
+    if (aTris.IsNull())
+    {
+      toMesh = true;
+    }
+  #if (OCC_VERSION_HEX >= 0x070600)
+    else if (aTris->HasDeferredData())
+    {
+      // read triangulation data skipped by glTF reader
+      aTris->LoadDeferredData();
+    }
+  #endif
+  }
+  if (!toMesh)
+    return;
+
+  Bnd_Box aBox;
+  BRepBndLib::Add(theShape, aBox, false);
+  if (aBox.IsVoid())
+    return;
+
+  // the same parameters as within OcctModelImporter::meshShapes(),
+  // so that presentations reuse triangulation instead of meshing shapes once again
+  double aXmin = 0.0, aYmin = 0.0, aZmin = 0.0, aXmax = 0.0, aYmax = 0.0, aZmax = 0.0;
+  aBox.Get(aXmin, aYmin, aZmin, aXmax, aYmax, aZmax);
+  const double aMaxSize = Max(aXmax - aXmin, Max(aYmax - aYmin, aZmax - aZmin));
+
+  IMeshTools_Parameters aMeshParams;
+  aMeshParams.Deflection = aMaxSize * 0.001 * 4.0;
+  aMeshParams.Angle      = 20.0 * M_PI / 180.0;
+  aMeshParams.InParallel = false; // shapes are already loaded by several workers
+  BRepMesh_IncrementalMesh aMesher(theShape, aMeshParams);
+#else
+  (void )theShape;
+#endif
+}
+
+// ================================================================
+// Function : unloadShape
+// ================================================================
+void OcctOnDemandAssembly::unloadShape(const TopoDS_Shape& theShape)
+{
+#ifdef HAVE_DATAEXCHANGE
+  bool hasDeferred = false;
+#if (OCC_VERSION_HEX >= 0x070600)
+  for (TopExp_Explorer aFaceIter(theShape, TopAbs_FACE); aFaceIter.More(); aFaceIter.Next())
+  {
+    TopLoc_Location aLoc;
+    const Handle(Poly_Triangulation)& aTris = BRep_Tool::Triangulation(TopoDS::Face(aFaceIter.Current()), aLoc);
+    if (!aTris.IsNull()
+     && aTris->HasDeferredData())
+    {
+      aTris->UnloadDeferredData();
+      hasDeferred = true;
+    }
+  }
+#endif
+  if (!hasDeferred)
+  {
+    // remove mesh of B-rep faces (triangulation-only faces are kept)
+    BRepTools::Clean(theShape);
+  }
+#else
+  (void )theShape;
+#endif
+}
+
+// ================================================================
+// Function : displayPart
+// ================================================================
+void OcctOnDemandAssembly::displayPart(const Handle(AIS_InteractiveContext)& theCtx,
+                                       Part& thePart)
+{
+#ifdef HAVE_DATAEXCHANGE
+  if (thePart.IsHidden)
+    return;
+
+  Handle(XCAFPrs_AISObject) aPrs = new XCAFPrs_AISObject(thePart.Label);
+  aPrs->SetLocalTransformation(thePart.Location);
+  if (thePart.HasColor)
+    aPrs->SetColor(thePart.Color.GetRGB());
+
+  OcctAssemblyTree::SetObjectId(aPrs, thePart.Id);
+  aPrs->SetDisplayMode(AIS_Shaded);
+  theCtx->Display(aPrs, AIS_Shaded, 0, false);
+  thePart.Presentation = aPrs;
+  if (myTree != NULL)
+    myTree->AddObject(aPrs);
+  if (myBoundsIndex != NULL
+   && myBoundsIndex->IsEnabled())
+  {
+    myBoundsIndex->Update(aPrs);
+  }
+#else
+  (void )theCtx;
+  (void )thePart;
+#endif
+}
+
+// ================================================================
+// Function : addProxyGroup
+// ================================================================
+void OcctOnDemandAssembly::addProxyGroup(int theBlock)
+{
+  myDirtyBlocks[theBlock] = false;
+  if (myPrs.IsNull())
+    return;
+
+  const int aFirst = theBlock * THE_PROXY_BLOCK;
+  const int aLast  = std::min(aFirst + THE_PROXY_BLOCK, NbParts());
+  int aNbProxies = 0;
+  for (int aPartIter = aFirst; aPartIter < aLast; ++aPartIter)
+  {
+    if (myParts[aPartIter].Presentation.IsNull()
+    && !myParts[aPartIter].Box.IsVoid()
+    && !myParts[aPartIter].IsHidden)
+    {
+      ++aNbProxies;
+    }
+  }
+  if (aNbProxies == 0)
+    return;
+
+  Handle(Graphic3d_ArrayOfSegments) aSegs = new Graphic3d_ArrayOfSegments(aNbProxies * 8, aNbProxies * 24);
+  for (int aPartIter = aFirst; aPartIter < aLast; ++aPartIter)
+  {
+    const Part& aPart = myParts[aPartIter];
+    if (!aPart.Presentation.IsNull()
+     || aPart.Box.IsVoid()
+     || aPart.IsHidden)
+    {
+      continue;
+    }
+
+    const gp_Pnt aMin = aPart.Box.CornerMin(), aMax = aPart.Box.CornerMax();
+    const int aFirstVert = aSegs->VertexNumber() + 1;
+    for (int aCornerIter = 0; aCornerIter < 8; ++aCornerIter)
+    {
+      aSegs->AddVertex((aCornerIter & 1) != 0 ? aMax.X() : aMin.X(),
+                       (aCornerIter & 2) != 0 ? aMax.Y() : aMin.Y(),
+                       (aCornerIter & 4) != 0 ? aMax.Z() : aMin.Z());
+    }
+    for (int anEdgeIter = 0; anEdgeIter < 12; ++anEdgeIter)
+    {
+      aSegs->AddEdges(aFirstVert + THE_BOX_EDGES[anEdgeIter][0], aFirstVert + THE_BOX_EDGES[anEdgeIter][1]);
+    }
+  }
+
+  myProxyGroups[theBlock] = myPrs->NewGroup();
+  myProxyGroups[theBlock]->SetGroupPrimitivesAspect(myDrawer->LineAspect()->Aspect());
+  myProxyGroups[theBlock]->AddPrimitiveArray(aSegs);
+}
+
+// ================================================================
+// Function : Compute
+// ================================================================
+void OcctOnDemandAssembly::Compute(const Handle(PrsMgr_PresentationManager)& ,
+                                   const Handle(Prs3d_Presentation)& thePrs,
+                                   const int theMode)
+{
+  if (theMode != 0 || myParts.empty() || myBox.IsVoid())
+    return;
+
+  // empty group defines bounding box of the whole assembly, including displayed parts
+  myPrs = thePrs;
+  const gp_Pnt aMin = myBox.CornerMin(), aMax = myBox.CornerMax();
+  Handle(Graphic3d_Group) aBndGroup = thePrs->NewGroup();
+  aBndGroup->SetMinMaxValues(aMin.X(), aMin.Y(), aMin.Z(), aMax.X(), aMax.Y(), aMax.Z());
+
+  const int aNbBlocks = (NbParts() + THE_PROXY_BLOCK - 1) / THE_PROXY_BLOCK;
+  myProxyGroups.assign(aNbBlocks, Handle(Graphic3d_Group)());
+  myDirtyBlocks.assign(aNbBlocks, false);
+  for (int aBlockIter = 0; aBlockIter < aNbBlocks; ++aBlockIter)
+  {
+    addProxyGroup(aBlockIter);
+  }
+}
+
+// ================================================================
+// Function : ComputeSelection
+// ================================================================
+void OcctOnDemandAssembly::ComputeSelection(const Handle(SelectMgr_Selection)& ,
+                                            const int )
+{
+  //
+}
+
+// ================================================================
+// Function : Update
+// ================================================================
+bool OcctOnDemandAssembly::Update(const Handle(AIS_InteractiveContext)& theCtx,
+                                  const Handle(V3d_View)& theView)
+{
+  if (myPrs.IsNull() || myParts.empty() || theView->Window().IsNull())
+    return false;
+
+  const double aTime = myTimer.ElapsedTime();
+
+  // loaded shapes
+  std::vector<int> aResults;
+  {
+    std::lock_guard<std::mutex> aLock(myMutex);
+    aResults.swap(myResults);
+  }
+  for (int aShapeIndex : aResults)
+  {
+    SharedShape& aShape = myShapes[aShapeIndex];
+    aShape.IsPending = false;
+    if (!aShape.IsLoaded)
+    {
+      aShape.IsLoaded = true;
+      ++myNbLoadedShapes;
+    }
+  }
+
+  // hidden state of parts follows nodes of assembly tree, rechecked only when tree visibility has been changed
+  if (myTree != NULL
+   && myTree->VisibilityRevision() != myTreeRevision)
+  {
+    myTreeRevision = myTree->VisibilityRevision();
+    for (int aPartIter = 0; aPartIter < NbParts(); ++aPartIter)
+    {
+      Part& aPart = myParts[aPartIter];
+      const bool isHidden = myTree->IsHidden(aPart.Id);
+      if (aPart.IsHidden != isHidden)
+      {
+        aPart.IsHidden = isHidden;
+        myDirtyBlocks[aPartIter / THE_PROXY_BLOCK] = true;
+      }
+    }
+  }
+
+  const Handle(Graphic3d_Camera)& aCam = theView->Camera();
+  Graphic3d_Vec2i aWinSize;
+  theView->Window()->Size(aWinSize.x(), aWinSize.y());
+  Graphic3d_CullingTool aCuller;
+  aCuller.SetViewVolume(aCam);
+  aCuller.SetViewportSize(aWinSize.x(), aWinSize.y(), 1.0);
+  Graphic3d_CullingTool::CullingContext aCullCtx;
+  aCuller.SetCullingDistance(aCullCtx, -1.0);
+  aCuller.SetCullingSize(aCullCtx, -1.0);
+
+  std::vector<bool> aShapeWanted(myShapes.size(), false);
+  std::vector<std::pair<double, int>> aToDisplay, aToLoad;
+  int aNbUnloaded = 0;
+  for (int aPartIter = 0; aPartIter < NbParts(); ++aPartIter)
+  {
+    Part& aPart = myParts[aPartIter];
+    if (aPart.Box.IsVoid())
+      continue;
+
+    const gp_Pnt aBoxMin = aPart.Box.CornerMin(), aBoxMax = aPart.Box.CornerMax();
+    const Graphic3d_Vec3d aMin(aBoxMin.X(), aBoxMin.Y(), aBoxMin.Z());
+    const Graphic3d_Vec3d aMax(aBoxMax.X(), aBoxMax.Y(), aBoxMax.Z());
+    double aSizePx = 0.0;
+    if (!aPart.IsHidden
+     && !aCuller.IsCulled(aCullCtx, aMin, aMax))
+    {
+      aPart.LastVisible = aTime;
+
+      // projected size of part diagonal in pixels
+      const gp_Pnt aCenter((aMin.x() + aMax.x()) * 0.5, (aMin.y() + aMax.y()) * 0.5, (aMin.z() + aMax.z()) * 0.5);
+      const double aDepth = gp_Vec(aCam->Eye(), aCenter).Dot(gp_Vec(aCam->Direction()));
+      const double aViewHeight = aDepth > aCam->ZNear() ? aCam->ViewDimensions(aDepth).Y() : 0.0;
+      aSizePx = aViewHeight > 0.0 ? (aMax - aMin).Modulus() / aViewHeight * aWinSize.y() : double(aWinSize.y());
+    }
+
+    if (aSizePx >= myMinSizePx)
+    {
+      aShapeWanted[aPart.Shape] = true;
+      if (aPart.Presentation.IsNull())
+      {
+        if (myShapes[aPart.Shape].IsLoaded)
+          aToDisplay.push_back(std::make_pair(aSizePx, aPartIter));
+        else
+          aToLoad.push_back(std::make_pair(aSizePx, aPart.Shape));
+      }
+    }
+    else if (!aPart.Presentation.IsNull()
+           && aTime - aPart.LastVisible > myUnloadTimeout)
+    {
+      // part stays off-screen (or hidden) - show proxy instead
+      theCtx->Remove(aPart.Presentation, false);
+      if (myTree != NULL)
+        myTree->RemoveObject(aPart.Presentation);
+      if (myBoundsIndex != NULL)
+        myBoundsIndex->Remove(aPart.Presentation);
+      aPart.Presentation.Nullify();
+      --myShapes[aPart.Shape].NbUsers;
+      --myNbDisplayed;
+      myDirtyBlocks[aPartIter / THE_PROXY_BLOCK] = true;
+      ++aNbUnloaded;
+    }
+  }
+
+  // compute presentations of loaded parts within GUI thread starting from larger ones, limited per frame
+  std::sort(aToDisplay.begin(), aToDisplay.end(),
+            [](const std::pair<double, int>& theLeft, const std::pair<double, int>& theRight)
+            { return theLeft.first > theRight.first; });
+  const int aNbToDisplay = std::min((int )aToDisplay.size(), myMaxDisplays);
+  for (int aDispIter = 0; aDispIter < aNbToDisplay; ++aDispIter)
+  {
+    const int aPartIter = aToDisplay[aDispIter].second;
+    Part& aPart = myParts[aPartIter];
+    displayPart(theCtx, aPart);
+    if (!aPart.Presentation.IsNull())
+    {
+      ++myShapes[aPart.Shape].NbUsers;
+      ++myNbDisplayed;
+      myDirtyBlocks[aPartIter / THE_PROXY_BLOCK] = true;
+    }
+  }
+
+  // release triangulations of shapes which are neither displayed nor wanted
+  for (size_t aShapeIter = 0; aShapeIter < myShapes.size(); ++aShapeIter)
+  {
+    SharedShape& aShape = myShapes[aShapeIter];
+    if (aShape.IsLoaded
+     && aShape.NbUsers == 0
+     && !aShapeWanted[aShapeIter])
+    {
+      unloadShape(aShape.Shape);
+      aShape.IsLoaded = false;
+      --myNbLoadedShapes;
+    }
+  }
+
+  // resubmit loading requests in priority order
+  std::sort(aToLoad.begin(), aToLoad.end(),
+            [](const std::pair<double, int>& theLeft, const std::pair<double, int>& theRight)
+            { return theLeft.first > theRight.first; });
+  {
+    std::lock_guard<std::mutex> aLock(myMutex);
+    for (int aShapeIndex : myRequests)
+    {
+      myShapes[aShapeIndex].IsPending = false;
+    }
+    myRequests.clear();
+    for (const std::pair<double, int>& aLoadIter : aToLoad)
+    {
+      SharedShape& aShape = myShapes[aLoadIter.second];
+      if (!aShape.IsPending)
+      {
+        aShape.IsPending = true;
+        myRequests.push_back(aLoadIter.second);
+      }
+    }
+  }
+  if (!aToLoad.empty())
+  {
+    if (myWorkers.empty())
+    {
+      // restart workers stopped by StopLoading() or RemoveParts()
+      {
+        std::lock_guard<std::mutex> aLock(myMutex);
+        myToStop = false;
+      }
+      const int aNbWorkers = myNbWorkers > 0 ? myNbWorkers : OSD_Parallel::NbLogicalProcessors();
+      for (int aThreadIter = 0; aThreadIter < aNbWorkers; ++aThreadIter)
+      {
+        myWorkers.push_back(std::thread(&OcctOnDemandAssembly::workerLoop, this));
+      }
+    }
+    myCondition.notify_all();
+  }
+
+  // rebuild proxies of changed blocks
+  bool isChanged = false;
+  for (size_t aBlockIter = 0; aBlockIter < myDirtyBlocks.size(); ++aBlockIter)
+  {
+    if (!myDirtyBlocks[aBlockIter])
+      continue;
+
+    if (!myProxyGroups[aBlockIter].IsNull())
+    {
+      myProxyGroups[aBlockIter]->Remove();
+      myProxyGroups[aBlockIter].Nullify();
+    }
+    addProxyGroup((int )aBlockIter);
+    isChanged = true;
+  }
+  if (isChanged)
+  {
+    theView->Invalidate();
+    Message::SendTrace() << "OcctOnDemandAssembly: displayed " << aNbToDisplay << ", unloaded " << aNbUnloaded
+                         << " parts (" << myNbDisplayed << " of " << NbParts() << " parts displayed, "
+                         << myNbLoadedShapes << " of " << (int )myShapes.size() << " shapes loaded)";
+  }
+  return (int )aToDisplay.size() > aNbToDisplay;
+}
+
+// ================================================================
+// Function : RemoveParts
+// ================================================================
+void OcctOnDemandAssembly::RemoveParts(const Handle(AIS_InteractiveContext)& theCtx)
+{
+  StopLoading();
+  for (size_t aPartIter = 0; aPartIter < myParts.size(); ++aPartIter)
+  {
+    Part& aPart = myParts[aPartIter];
+    if (aPart.Presentation.IsNull())
+      continue;
+
+    theCtx->Remove(aPart.Presentation, false);
+    if (myTree != NULL)
+      myTree->RemoveObject(aPart.Presentation);
+    if (myBoundsIndex != NULL)
+      myBoundsIndex->Remove(aPart.Presentation);
+    aPart.Presentation.Nullify();
+    if (!myDirtyBlocks.empty())
+      myDirtyBlocks[aPartIter / THE_PROXY_BLOCK] = true;
+  }
+  for (SharedShape& aShape : myShapes)
+  {
+    if (aShape.IsLoaded)
+      unloadShape(aShape.Shape);
+
+    aShape.NbUsers = 0;
+    aShape.IsLoaded = false;
+    aShape.IsPending = false;
+  }
+  myNbDisplayed = 0;
+  myNbLoadedShapes = 0;
+}
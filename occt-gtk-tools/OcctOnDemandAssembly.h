@@ -0,0 +1,203 @@
+// Copyright (c) 2026 Kirill Gavrilov
+
+#ifndef _OcctOnDemandAssembly_HeaderFile
+#define _OcctOnDemandAssembly_HeaderFile
+
+#include <AIS_InteractiveContext.hxx>
+#include <Bnd_Box.hxx>
+#include <Message_ProgressRange.hxx>
+#include <OSD_Timer.hxx>
+#include <Quantity_ColorRGBA.hxx>
+#include <TDF_Label.hxx>
+#include <TDocStd_Document.hxx>
+#include <TopoDS_Shape.hxx>
+#include <V3d_View.hxx>
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class OcctAssemblyTree;
+class OcctSceneBoundsIndex;
+
+//! Presentation of assembly showing proxy boxes of parts, which are loaded on demand.
+//!
+//! Init() collects leaf parts from product structure of XCAF document with their bounding boxes,
+//! so that only boxes are shown initially. Update() should be called before redrawing the view:
+//! parts within view frustum and larger than MinSizePx() pixels are loaded by worker threads
+//! (deferred glTF triangulation data is read from file, B-rep shapes without triangulation are meshed)
+//! and displayed by XCAFPrs_AISObject instead of their proxies, a limited number of parts per frame.
+//! Parts staying outside of view frustum longer than UnloadTimeout() are removed from context,
+//! and triangulations of their shapes are released once no displayed part refers to them.
+//! Shapes shared by several parts (instances of the same product) are loaded once.
+//!
+//! Available only when samples are built with HAVE_DATAEXCHANGE (USE_DATAEXCHANGE CMake option).
+class OcctOnDemandAssembly : public AIS_InteractiveObject
+{
+  DEFINE_STANDARD_RTTI_INLINE(OcctOnDemandAssembly, AIS_InteractiveObject)
+public:
+
+  //! Empty constructor.
+  OcctOnDemandAssembly();
+
+  //! Destructor.
+  virtual ~OcctOnDemandAssembly();
+
+  //! Collect leaf parts of the document and compute their bounding boxes;
+  //! could be called from worker thread before displaying the object.
+  //! Deferred triangulations (glTF file read with late data loading) provide boxes without loading data.
+  bool Init(const Handle(TDocStd_Document)& theDoc,
+            const Message_ProgressRange& theRange = Message_ProgressRange());
+
+  //! Return number of parts.
+  int NbParts() const { return (int )myParts.size(); }
+
+  //! Return number of displayed (loaded) parts.
+  int NbDisplayedParts() const { return myNbDisplayed; }
+
+  //! Return number of shared shapes with loaded triangulation.
+  int NbLoadedShapes() const { return myNbLoadedShapes; }
+
+  //! Return minimal projected size of part in pixels to be loaded (32 by default).
+  double MinSizePx() const { return myMinSizePx; }
+
+  //! Set minimal projected size of part in pixels to be loaded.
+  void SetMinSizePx(double theSize) { myMinSizePx = theSize; }
+
+  //! Return time in seconds after which part outside of view frustum is unloaded (10 seconds by default).
+  double UnloadTimeout() const { return myUnloadTimeout; }
+
+  //! Set unloading timeout.
+  void SetUnloadTimeout(double theSeconds) { myUnloadTimeout = theSeconds; }
+
+  //! Return maximum number of parts displayed per frame (8 by default).
+  int MaxDisplaysPerFrame() const { return myMaxDisplays; }
+
+  //! Set maximum number of parts displayed per frame.
+  void SetMaxDisplaysPerFrame(int theNbParts) { myMaxDisplays = theNbParts; }
+
+  //! Return number of worker threads (number of logical processors by default).
+  int NbWorkers() const { return myNbWorkers; }
+
+  //! Set number of worker threads; should be called before the first Update().
+  void SetNbWorkers(int theNbWorkers) { myNbWorkers = theNbWorkers; }
+
+  //! Set bounds index to be updated on displaying and removing parts (NULL by default).
+  void SetBoundsIndex(OcctSceneBoundsIndex* theIndex) { myBoundsIndex = theIndex; }
+
+  //! Set assembly tree (NULL by default): displayed parts are bound to tree nodes,
+  //! and parts of hidden nodes are neither loaded nor shown by proxies.
+  void SetAssemblyTree(OcctAssemblyTree* theTree) { myTree = theTree; myTreeRevision = -1; }
+
+  //! Set callback called from worker thread when a shape has been loaded.
+  //! The callback should wake up GUI thread to redraw the view (and call Update()).
+  void SetLoadedCallback(const std::function<void()>& theCallback)
+  {
+    std::lock_guard<std::mutex> aLock(myMutex);
+    myLoadedCallback = theCallback;
+  }
+
+  //! Stop worker threads; should be called before destroying objects used by LoadedCallback().
+  //! Workers are started again by the next Update() requesting parts.
+  void StopLoading();
+
+  //! Request loading of visible parts, display loaded ones and unload parts staying off-screen;
+  //! should be called from GUI thread before redrawing the view.
+  //! @return TRUE if some loaded parts are still waiting for display and view should be redrawn once more
+  bool Update(const Handle(AIS_InteractiveContext)& theCtx,
+              const Handle(V3d_View)& theView);
+
+  //! Remove displayed parts from context (e.g. before removing the assembly itself).
+  void RemoveParts(const Handle(AIS_InteractiveContext)& theCtx);
+
+public:
+
+  //! Return TRUE for supported display modes (only 0 is supported).
+  virtual bool AcceptDisplayMode(const int theMode) const override { return theMode == 0; }
+
+protected:
+
+  //! Compute presentation - boxes of not displayed parts.
+  virtual void Compute(const Handle(PrsMgr_PresentationManager)& thePrsMgr,
+                       const Handle(Prs3d_Presentation)& thePrs,
+                       const int theMode) override;
+
+  //! Compute selection - proxies are not selectable.
+  virtual void ComputeSelection(const Handle(SelectMgr_Selection)& theSel,
+                                const int theMode) override;
+
+protected:
+
+  //! Leaf part (product occurrence).
+  struct Part
+  {
+    TDF_Label          Label;         //!< label of referred shape
+    TCollection_AsciiString Id;       //!< occurrence path (see OcctAssemblyTree)
+    gp_Trsf            Location;      //!< location of the occurrence
+    Quantity_ColorRGBA Color;         //!< surface color inherited from assembly
+    bool               HasColor = false;
+    Bnd_Box            Box;           //!< bounding box in world coordinates
+    int                Shape = -1;    //!< index of shared shape
+    double             LastVisible = 0.0; //!< last time part has been within view frustum
+    bool               IsHidden = false;  //!< part is hidden within assembly tree
+    Handle(AIS_InteractiveObject) Presentation; //!< displayed presentation (NULL if shown by proxy)
+  };
+
+  //! Shape shared by parts.
+  struct SharedShape
+  {
+    TopoDS_Shape Shape;             //!< shape without location
+    int          NbUsers = 0;       //!< number of displayed parts
+    bool         IsLoaded  = false; //!< triangulation is loaded
+    bool         IsPending = false; //!< loading has been requested
+  };
+
+  //! Worker thread loop.
+  void workerLoop();
+
+  //! Load triangulation of the shape (called from worker thread).
+  static void loadShape(const TopoDS_Shape& theShape);
+
+  //! Release triangulation of the shape.
+  static void unloadShape(const TopoDS_Shape& theShape);
+
+  //! Create and display presentation of the part.
+  void displayPart(const Handle(AIS_InteractiveContext)& theCtx,
+                   Part& thePart);
+
+  //! Add group with proxies of the block of parts.
+  void addProxyGroup(int theBlock);
+
+protected:
+
+  std::vector<Part>        myParts;
+  std::vector<SharedShape> myShapes;
+  Bnd_Box                  myBox;            //!< bounding box of the whole assembly
+  Handle(Prs3d_Presentation) myPrs;
+  std::vector<Handle(Graphic3d_Group)> myProxyGroups; //!< proxy groups per block of parts
+  std::vector<bool>        myDirtyBlocks;    //!< blocks which proxies should be rebuilt
+  OSD_Timer                myTimer;
+  OcctSceneBoundsIndex*    myBoundsIndex   = NULL; //!< optional bounds index of displayed objects
+  OcctAssemblyTree*        myTree          = NULL; //!< optional assembly tree defining hidden parts
+  int                      myTreeRevision  = -1;   //!< visibility revision of the tree applied to parts
+  double                   myMinSizePx     = 32.0;
+  double                   myUnloadTimeout = 10.0;
+  int                      myMaxDisplays   = 8;
+  int                      myNbDisplayed   = 0;
+  int                      myNbLoadedShapes = 0;
+  int                      myNbWorkers     = 0;
+
+  std::function<void()>    myLoadedCallback;
+  std::vector<std::thread> myWorkers;
+  std::mutex               myMutex;
+  std::condition_variable  myCondition;
+  std::deque<int>          myRequests;  //!< shapes to load sorted by priority
+  std::vector<int>         myResults;   //!< loaded shapes
+  bool                     myToStop = false;
+
+};
+
+#endif // _OcctOnDemandAssembly_HeaderFile
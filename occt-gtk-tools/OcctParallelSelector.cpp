@@ -0,0 +1,390 @@
+// Copyright (c) 2026 Kirill Gavrilov
+
+#include "OcctParallelSelector.h"
+
+#include <AIS_Shape.hxx>
+#include <BRepPrimAPI_MakeBox.hxx>
+#include <Message.hxx>
+#include <NCollection_Map.hxx>
+#include <OSD_ThreadPool.hxx>
+#include <OSD_Timer.hxx>
+#include <SelectMgr_FrustumBuilder.hxx>
+#include <SelectBasics_PickResult.hxx>
+#include <SelectMgr_AndOrFilter.hxx>
+#include <SelectMgr_SensitiveEntity.hxx>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+  //! Sensitive entity to be tested by parallel selector.
+  struct OcctSelEntity
+  {
+    Handle(Select3D_SensitiveEntity) Entity;
+    Handle(SelectMgr_EntityOwner)    Owner;
+    int                              VolumeIndex = 0; //!< index of selecting volume (transformed per object)
+  };
+
+#if (OCC_VERSION_HEX >= 0x070600)
+  //! Functor building BVH of sensitive entities in parallel.
+  class OcctSelBvhFunctor
+  {
+  public:
+    OcctSelBvhFunctor(const std::vector<OcctSelEntity>& theEntities)
+    : myEntities(theEntities) {}
+
+    void operator()(int theThreadIndex, int theIndex) const
+    {
+      (void)theThreadIndex;
+      const Handle(Select3D_SensitiveEntity)& anEntity = myEntities[theIndex].Entity;
+      if (anEntity->ToBuildBVH())
+        anEntity->BVH();
+    }
+  private:
+    const std::vector<OcctSelEntity>& myEntities;
+  };
+
+  //! Functor testing sensitive entities against selecting volume in parallel.
+  class OcctSelPickFunctor
+  {
+  public:
+    //! @param[in] theVolumes selecting volumes per thread index
+    OcctSelPickFunctor(const std::vector<OcctSelEntity>& theEntities,
+                       std::vector<std::vector<SelectMgr_SelectingVolumeManager>>& theVolumes,
+                       std::vector<char>& theResults)
+    : myEntities(theEntities), myVolumes(theVolumes), myResults(theResults) {}
+
+    void operator()(int theThreadIndex, int theIndex) const
+    {
+      const OcctSelEntity& anEntity = myEntities[theIndex];
+      SelectMgr_SelectingVolumeManager& aMgr = myVolumes[theThreadIndex][anEntity.VolumeIndex];
+      SelectBasics_PickResult aPickResult;
+      myResults[theIndex] = anEntity.Entity->Matches(aMgr, aPickResult) ? 1 : 0;
+    }
+  private:
+    const std::vector<OcctSelEntity>& myEntities;
+    std::vector<std::vector<SelectMgr_SelectingVolumeManager>>& myVolumes;
+    std::vector<char>& myResults;
+  };
+#endif
+}
+
+// ================================================================
+// Function : OcctParallelSelector
+// ================================================================
+OcctParallelSelector::OcctParallelSelector()
+{
+#if (OCC_VERSION_HEX < 0x070600)
+  myIsEnabled = false;
+#endif
+}
+
+// ================================================================
+// Function : SetEnabled
+// ================================================================
+void OcctParallelSelector::SetEnabled(bool theToEnable)
+{
+#if (OCC_VERSION_HEX >= 0x070600)
+  myIsEnabled = theToEnable;
+#else
+  (void)theToEnable;
+#endif
+}
+
+#if (OCC_VERSION_HEX >= 0x070600)
+// ================================================================
+// Function : SelectRectangle
+// ================================================================
+AIS_StatusOfPick OcctParallelSelector::SelectRectangle(const Handle(AIS_InteractiveContext)& theCtx,
+                                                       const Graphic3d_Vec2i& thePntMin,
+                                                       const Graphic3d_Vec2i& thePntMax,
+                                                       const Handle(V3d_View)& theView,
+                                                       const AIS_SelectionScheme theSelScheme,
+                                                       const bool theToAllowOverlap)
+{
+  AIS_NListOfEntityOwner anOwners;
+  PickRectangle(theCtx, thePntMin, thePntMax, theView, theToAllowOverlap, anOwners);
+  return applySelection(theCtx, anOwners, theSelScheme);
+}
+
+// ================================================================
+// Function : SelectPolygon
+// ================================================================
+AIS_StatusOfPick OcctParallelSelector::SelectPolygon(const Handle(AIS_InteractiveContext)& theCtx,
+                                                     const TColgp_Array1OfPnt2d& thePolyline,
+                                                     const Handle(V3d_View)& theView,
+                                                     const AIS_SelectionScheme theSelScheme)
+{
+  AIS_NListOfEntityOwner anOwners;
+  PickPolygon(theCtx, thePolyline, theView, anOwners);
+  return applySelection(theCtx, anOwners, theSelScheme);
+}
+
+// ================================================================
+// Function : applySelection
+// ================================================================
+AIS_StatusOfPick OcctParallelSelector::applySelection(const Handle(AIS_InteractiveContext)& theCtx,
+                                                      const AIS_NListOfEntityOwner& theOwners,
+                                                      const AIS_SelectionScheme theSelScheme)
+{
+  // selection scheme is applied by context in one pass with a single highlighting update,
+  // the same way as for owners picked by AIS_InteractiveContext::SelectRectangle()
+  AIS_NArray1OfEntityOwner anOwners;
+  if (!theOwners.IsEmpty())
+  {
+    anOwners.Resize(0, theOwners.Size() - 1, false);
+    int anOwnerIndex = 0;
+    for (AIS_NListOfEntityOwner::Iterator anOwnerIter(theOwners); anOwnerIter.More(); anOwnerIter.Next(), ++anOwnerIndex)
+      anOwners.SetValue(anOwnerIndex, anOwnerIter.Value());
+  }
+
+  return theCtx->Select(anOwners, theSelScheme);
+}
+#endif
+
+// ================================================================
+// Function : PickRectangle
+// ================================================================
+int OcctParallelSelector::PickRectangle(const Handle(AIS_InteractiveContext)& theCtx,
+                                        const Graphic3d_Vec2i& thePntMin,
+                                        const Graphic3d_Vec2i& thePntMax,
+                                        const Handle(V3d_View)& theView,
+                                        const bool theToAllowOverlap,
+                                        AIS_NListOfEntityOwner& theOwners)
+{
+#if (OCC_VERSION_HEX >= 0x070600)
+  if (theView->Window().IsNull())
+    return 0;
+
+  Graphic3d_Vec2i aWinSize;
+  theView->Window()->Size(aWinSize.x(), aWinSize.y());
+
+  SelectMgr_SelectingVolumeManager aMgr;
+  aMgr.InitBoxSelectingVolume(gp_Pnt2d(thePntMin.x(), thePntMin.y()),
+                              gp_Pnt2d(thePntMax.x(), thePntMax.y()));
+  aMgr.SetCamera(theView->Camera());
+  aMgr.SetWindowSize(aWinSize.x(), aWinSize.y());
+  aMgr.BuildSelectingVolume();
+  aMgr.SetViewClipping(theView->ClipPlanes(), Handle(Graphic3d_SequenceOfHClipPlane)(), NULL);
+  aMgr.AllowOverlapDetection(theToAllowOverlap);
+  return pickVolume(theCtx, aMgr, theOwners);
+#else
+  (void)theCtx; (void)thePntMin; (void)thePntMax; (void)theView; (void)theToAllowOverlap; (void)theOwners;
+  return 0;
+#endif
+}
+
+// ================================================================
+// Function : PickPolygon
+// ================================================================
+int OcctParallelSelector::PickPolygon(const Handle(AIS_InteractiveContext)& theCtx,
+                                      const TColgp_Array1OfPnt2d& thePolyline,
+                                      const Handle(V3d_View)& theView,
+                                      AIS_NListOfEntityOwner& theOwners)
+{
+#if (OCC_VERSION_HEX >= 0x070600)
+  if (theView->Window().IsNull())
+    return 0;
+
+  Graphic3d_Vec2i aWinSize;
+  theView->Window()->Size(aWinSize.x(), aWinSize.y());
+
+  SelectMgr_SelectingVolumeManager aMgr;
+  aMgr.InitPolylineSelectingVolume(thePolyline);
+  aMgr.SetCamera(theView->Camera());
+  aMgr.SetWindowSize(aWinSize.x(), aWinSize.y());
+  aMgr.BuildSelectingVolume();
+  aMgr.SetViewClipping(theView->ClipPlanes(), Handle(Graphic3d_SequenceOfHClipPlane)(), NULL);
+  return pickVolume(theCtx, aMgr, theOwners);
+#else
+  (void)theCtx; (void)thePolyline; (void)theView; (void)theOwners;
+  return 0;
+#endif
+}
+
+// ================================================================
+// Function : pickVolume
+// ================================================================
+int OcctParallelSelector::pickVolume(const Handle(AIS_InteractiveContext)& theCtx,
+                                     const SelectMgr_SelectingVolumeManager& theVolumeMgr,
+                                     AIS_NListOfEntityOwner& theOwners)
+{
+#if (OCC_VERSION_HEX >= 0x070600)
+  OSD_Timer aTimer;
+  aTimer.Start();
+
+  // flatten activated sensitive entities of displayed objects (in display order)
+  std::vector<OcctSelEntity> anEntities;
+  std::vector<SelectMgr_SelectingVolumeManager> aVolumes;
+  aVolumes.push_back(theVolumeMgr);
+
+  AIS_ListOfInteractive anObjects;
+  theCtx->DisplayedObjects(anObjects);
+  for (AIS_ListOfInteractive::Iterator anObjIter(anObjects); anObjIter.More(); anObjIter.Next())
+  {
+    const Handle(AIS_InteractiveObject)& anObj = anObjIter.Value();
+    if (!anObj->TransformPersistence().IsNull())
+      continue; // 2D overlays are left to AIS_InteractiveContext
+
+    // volume in object coordinates clipped by view and object planes, as done by SelectMgr_ViewerSelector
+    int aVolumeIndex = 0;
+    const bool hasObjClipping = !anObj->ClipPlanes().IsNull()
+                             && (!anObj->ClipPlanes()->IsEmpty() || anObj->ClipPlanes()->ToOverrideGlobal());
+    if (anObj->HasTransformation()
+     || hasObjClipping)
+    {
+      SelectMgr_SelectingVolumeManager anObjMgr = anObj->HasTransformation()
+                                                ? theVolumeMgr.ScaleAndTransform(1, anObj->InversedTransformation(),
+                                                                                 Handle(SelectMgr_FrustumBuilder)())
+                                                : theVolumeMgr.ScaleAndTransform(1, gp_GTrsf(), Handle(SelectMgr_FrustumBuilder)());
+      anObjMgr.SetViewClipping(theVolumeMgr.ViewClipping(), anObj->ClipPlanes(), &theVolumeMgr);
+      aVolumes.push_back(anObjMgr);
+      aVolumeIndex = int(aVolumes.size()) - 1;
+    }
+
+    for (SelectMgr_SequenceOfSelection::Iterator aSelIter(anObj->Selections()); aSelIter.More(); aSelIter.Next())
+    {
+      const Handle(SelectMgr_Selection)& aSel = aSelIter.Value();
+      if (aSel->GetSelectionState() != SelectMgr_SOS_Activated)
+        continue;
+
+      for (NCollection_Vector<Handle(SelectMgr_SensitiveEntity)>::Iterator anEntIter(aSel->Entities());
+           anEntIter.More(); anEntIter.Next())
+      {
+        const Handle(SelectMgr_SensitiveEntity)& aSensEnt = anEntIter.Value();
+        if (!aSensEnt->IsActiveForSelection())
+          continue;
+
+        OcctSelEntity anEntity;
+        anEntity.Entity = aSensEnt->BaseSensitive();
+        anEntity.Owner  = anEntity.Entity->OwnerId();
+        anEntity.VolumeIndex = aVolumeIndex;
+        if (!anEntity.Owner.IsNull())
+          anEntities.push_back(anEntity);
+      }
+    }
+  }
+
+  const int aNbEntities = int(anEntities.size());
+  std::vector<char> aResults(anEntities.size(), 0);
+  if (aNbEntities > 0)
+  {
+    const Handle(OSD_ThreadPool)& aPool = OSD_ThreadPool::DefaultPool();
+    {
+      // lazy BVH building is not thread-safe, so that it is done as a separate pass
+      OSD_ThreadPool::Launcher aLauncher(*aPool, myNbThreads > 0 ? myNbThreads : -1);
+      aLauncher.Perform(0, aNbEntities, OcctSelBvhFunctor(anEntities));
+    }
+    {
+      // Matches() takes non-const manager, so that every thread gets deep copies of selecting volumes
+      OSD_ThreadPool::Launcher aLauncher(*aPool, myNbThreads > 0 ? myNbThreads : -1);
+      std::vector<std::vector<SelectMgr_SelectingVolumeManager>> aThreadVolumes(aLauncher.NbThreads());
+      aThreadVolumes[0] = aVolumes;
+      for (size_t aThreadIter = 1; aThreadIter < aThreadVolumes.size(); ++aThreadIter)
+      {
+        aThreadVolumes[aThreadIter].reserve(aVolumes.size());
+        for (const SelectMgr_SelectingVolumeManager& aVolume : aVolumes)
+          aThreadVolumes[aThreadIter].push_back(aVolume.ScaleAndTransform(1, gp_GTrsf(), Handle(SelectMgr_FrustumBuilder)()));
+      }
+      aLauncher.Perform(0, aNbEntities, OcctSelPickFunctor(anEntities, aThreadVolumes, aResults));
+    }
+  }
+
+  // merge results in deterministic order, skipping duplicated owners
+  const Handle(SelectMgr_AndOrFilter)& aFilter = theCtx->GlobalFilter();
+  NCollection_Map<Handle(SelectMgr_EntityOwner)> aDetectedMap;
+  int aNbDetected = 0;
+  for (int anEntIter = 0; anEntIter < aNbEntities; ++anEntIter)
+  {
+    const Handle(SelectMgr_EntityOwner)& anOwner = anEntities[anEntIter].Owner;
+    if (aResults[anEntIter] == 0
+    || !aDetectedMap.Add(anOwner))
+      continue;
+
+    if (!aFilter->IsEmpty()
+     && !aFilter->IsOk(anOwner))
+      continue;
+
+    theOwners.Append(anOwner);
+    ++aNbDetected;
+  }
+
+  aTimer.Stop();
+  myNbLastEntities = aNbEntities;
+  myLastPickTime   = aTimer.ElapsedTime();
+  Message::SendTrace() << "OcctParallelSelector: " << aNbDetected << " owners from " << aNbEntities
+                       << " entities in " << (myLastPickTime * 1000.0) << " ms";
+  return aNbDetected;
+#else
+  (void)theCtx; (void)theVolumeMgr; (void)theOwners;
+  return 0;
+#endif
+}
+
+// ================================================================
+// Function : Benchmark
+// ================================================================
+void OcctParallelSelector::Benchmark(const Handle(AIS_InteractiveContext)& theCtx,
+                                     const Handle(V3d_View)& theView,
+                                     int theMaxNbObjects)
+{
+#if (OCC_VERSION_HEX >= 0x070600)
+  if (theView->Window().IsNull())
+    return;
+
+  const int aMaxNbObjects = theMaxNbObjects > 0 ? theMaxNbObjects : 16000;
+  const int aGridSize = (int )std::ceil(std::sqrt(double(aMaxNbObjects)));
+  const TopoDS_Shape aBox = BRepPrimAPI_MakeBox(1.0, 1.0, 1.0).Shape();
+
+  Graphic3d_Vec2i aWinSize;
+  theView->Window()->Size(aWinSize.x(), aWinSize.y());
+
+  Message::SendInfo() << "OcctParallelSelector benchmark, rectangle selection of the whole view ("
+                      << OSD_ThreadPool::DefaultPool()->NbThreads() << " threads)";
+  OcctParallelSelector aSelector;
+  int aNbDisplayed = 0;
+  for (int aNbObjects = std::min(1000, aMaxNbObjects);; aNbObjects = std::min(aNbObjects * 2, aMaxNbObjects))
+  {
+    for (; aNbDisplayed < aNbObjects; ++aNbDisplayed)
+    {
+      gp_Trsf aTrsf;
+      aTrsf.SetTranslation(gp_Vec(2.0 * (aNbDisplayed % aGridSize), 2.0 * (aNbDisplayed / aGridSize), 0.0));
+      Handle(AIS_Shape) aPrs = new AIS_Shape(aBox.Located(TopLoc_Location(aTrsf)));
+      theCtx->Display(aPrs, AIS_Shaded, 0, false);
+    }
+    theView->FitAll(0.01, false);
+
+    // warm up lazily built structures for both paths
+    theCtx->SelectRectangle(Graphic3d_Vec2i(0, 0), aWinSize, theView, AIS_SelectionScheme_Replace);
+    aSelector.SelectRectangle(theCtx, Graphic3d_Vec2i(0, 0), aWinSize, theView, AIS_SelectionScheme_Replace, false);
+
+    OSD_Timer aTimer;
+    aTimer.Start();
+    theCtx->SelectRectangle(Graphic3d_Vec2i(0, 0), aWinSize, theView, AIS_SelectionScheme_Replace);
+    aTimer.Stop();
+    const double aSeqTime = aTimer.ElapsedTime();
+    const int    aNbSeq   = theCtx->NbSelected();
+
+    aTimer.Reset();
+    aTimer.Start();
+    aSelector.SelectRectangle(theCtx, Graphic3d_Vec2i(0, 0), aWinSize, theView, AIS_SelectionScheme_Replace, false);
+    aTimer.Stop();
+    const double aParTime = aTimer.ElapsedTime();
+    const int    aNbPar   = theCtx->NbSelected();
+
+    Message::SendInfo() << "  objects: " << aNbObjects << ", entities: " << aSelector.NbLastEntities()
+                        << ", sequential: " << (aSeqTime * 1000.0) << " ms (" << aNbSeq << " selected)"
+                        << ", parallel: " << (aParTime * 1000.0) << " ms (" << aNbPar << " selected)"
+                        << ", pick only: " << (aSelector.LastPickTime() * 1000.0) << " ms";
+    if (aNbObjects >= aMaxNbObjects)
+      break;
+  }
+  theCtx->ClearSelected(false);
+  theView->Invalidate();
+#else
+  (void)theCtx; (void)theView; (void)theMaxNbObjects;
+  Message::SendWarning() << "OcctParallelSelector benchmark requires OCCT 7.6.0+";
+#endif
+}
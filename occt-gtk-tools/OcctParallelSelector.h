@@ -0,0 +1,123 @@
+// Copyright (c) 2026 Kirill Gavrilov
+
+#ifndef _OcctParallelSelector_HeaderFile
+#define _OcctParallelSelector_HeaderFile
+
+#include <AIS_InteractiveContext.hxx>
+#include <AIS_NListOfEntityOwner.hxx>
+#include <SelectMgr_SelectingVolumeManager.hxx>
+#include <Standard_Version.hxx>
+#include <TColgp_Array1OfPnt2d.hxx>
+#include <V3d_View.hxx>
+
+#if (OCC_VERSION_HEX >= 0x070600)
+  #include <AIS_SelectionScheme.hxx>
+#endif
+
+//! Parallel area (rubber-band rectangle and polyline) selection engine.
+//!
+//! AIS_InteractiveContext::SelectRectangle() traverses sensitive entities of all objects within a single thread.
+//! This tool flattens sensitive entities of displayed objects (e.g. faces of AIS_Shape) into one list
+//! and splits the frustum test across them using OCCT thread pool; each thread works on its own copy of selecting volumes.
+//! Detected owners are merged in deterministic order (object display order, then entity order),
+//! so that the result doesn't depend on the number of threads.
+//! Parallelism is limited to entity granularity - a single large entity (like Select3D_SensitiveTriangulation
+//! of a whole mesh) is traversed by one thread, as OCCT doesn't expose tests of its BVH subtrees.
+//!
+//! Selection semantics are the same as for AIS_InteractiveContext:
+//! only activated selection modes are considered, context filters are applied, view and object clipping planes are respected,
+//! and overlap detection follows the same rubber-band direction convention as AIS_ViewController.
+//! Detected owners are applied to context selection in one pass by AIS_InteractiveContext::Select().
+//! Objects with transformation persistence (like AIS_ViewCube) are skipped.
+//!
+//! Requires OCCT 7.6.0+, otherwise IsEnabled() returns FALSE.
+class OcctParallelSelector
+{
+public:
+
+  //! Empty constructor.
+  OcctParallelSelector();
+
+  //! Return TRUE if parallel selection is enabled (TRUE by default).
+  bool IsEnabled() const { return myIsEnabled; }
+
+  //! Enable/disable parallel selection.
+  void SetEnabled(bool theToEnable);
+
+  //! Return number of threads to use; 0 (default) means all threads of the default pool.
+  int NbThreads() const { return myNbThreads; }
+
+  //! Set number of threads to use.
+  void SetNbThreads(int theNbThreads) { myNbThreads = theNbThreads; }
+
+  //! Return number of sensitive entities tested by the last pick.
+  int NbLastEntities() const { return myNbLastEntities; }
+
+  //! Return elapsed time of the last pick in seconds.
+  double LastPickTime() const { return myLastPickTime; }
+
+#if (OCC_VERSION_HEX >= 0x070600)
+  //! Select owners within the rectangle (in window pixels) and update AIS_InteractiveContext selection.
+  AIS_StatusOfPick SelectRectangle(const Handle(AIS_InteractiveContext)& theCtx,
+                                   const Graphic3d_Vec2i& thePntMin,
+                                   const Graphic3d_Vec2i& thePntMax,
+                                   const Handle(V3d_View)& theView,
+                                   const AIS_SelectionScheme theSelScheme,
+                                   const bool theToAllowOverlap);
+
+  //! Select owners within the closed polyline (in window pixels) and update AIS_InteractiveContext selection.
+  AIS_StatusOfPick SelectPolygon(const Handle(AIS_InteractiveContext)& theCtx,
+                                 const TColgp_Array1OfPnt2d& thePolyline,
+                                 const Handle(V3d_View)& theView,
+                                 const AIS_SelectionScheme theSelScheme);
+#endif
+
+  //! Collect owners within the rectangle without modifying selection.
+  //! @return number of detected owners
+  int PickRectangle(const Handle(AIS_InteractiveContext)& theCtx,
+                    const Graphic3d_Vec2i& thePntMin,
+                    const Graphic3d_Vec2i& thePntMax,
+                    const Handle(V3d_View)& theView,
+                    const bool theToAllowOverlap,
+                    AIS_NListOfEntityOwner& theOwners);
+
+  //! Collect owners within the polyline without modifying selection.
+  //! @return number of detected owners
+  int PickPolygon(const Handle(AIS_InteractiveContext)& theCtx,
+                  const TColgp_Array1OfPnt2d& thePolyline,
+                  const Handle(V3d_View)& theView,
+                  AIS_NListOfEntityOwner& theOwners);
+
+public:
+
+  //! Benchmark comparing AIS_InteractiveContext::SelectRectangle() with parallel selection.
+  //! Displays a grid of boxes doubling the number of objects up to theMaxNbObjects
+  //! and prints timings for rectangle selection covering the whole view.
+  static void Benchmark(const Handle(AIS_InteractiveContext)& theCtx,
+                        const Handle(V3d_View)& theView,
+                        int theMaxNbObjects);
+
+protected:
+
+  //! Perform selection using initialized volume manager.
+  int pickVolume(const Handle(AIS_InteractiveContext)& theCtx,
+                 const SelectMgr_SelectingVolumeManager& theVolumeMgr,
+                 AIS_NListOfEntityOwner& theOwners);
+
+#if (OCC_VERSION_HEX >= 0x070600)
+  //! Apply selection scheme to detected owners.
+  AIS_StatusOfPick applySelection(const Handle(AIS_InteractiveContext)& theCtx,
+                                  const AIS_NListOfEntityOwner& theOwners,
+                                  const AIS_SelectionScheme theSelScheme);
+#endif
+
+private:
+
+  int    myNbThreads      = 0;
+  int    myNbLastEntities = 0;
+  double myLastPickTime   = 0.0;
+  bool   myIsEnabled      = true;
+
+};
+
+#endif // _OcctParallelSelector_HeaderFile
@@ -0,0 +1,704 @@
+// Copyright (c) 2026 Kirill Gavrilov
+
+#include "OcctPointCloud.h"
+
+#include <Graphic3d_CullingTool.hxx>
+#include <Message.hxx>
+#include <OSD_OpenFile.hxx>
+#include <OSD_Timer.hxx>
+#include <Prs3d_PointAspect.hxx>
+#include <Select3D_SensitiveBox.hxx>
+#include <SelectMgr_EntityOwner.hxx>
+#include <SelectMgr_Selection.hxx>
+
+#include <cfloat>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <queue>
+#include <thread>
+
+namespace
+{
+  //! File format signature.
+  static const char THE_PTS_MAGIC[8] = { 'O', 'C', 'P', 'T', 'C', 'L', 'D', '2' };
+
+  //! Maximum octree depth defined by precision of Morton code.
+  static const int THE_PTS_MAX_DEPTH = 21;
+
+  //! File header flags.
+  enum
+  {
+    PtsFlags_HasColors = 0x01 //!< each point position (3 floats) is followed by RGBA8 color
+  };
+
+  //! File header (little-endian).
+  struct PtsHeader
+  {
+    char     Magic[8];
+    uint64_t NbPoints;
+    uint32_t NbNodes;
+    uint32_t Flags;
+    float    BndMin[3];
+    float    BndMax[3];
+  };
+
+  //! Octree node table entry following the header; nodes are stored in pre-order starting from the root.
+  struct PtsNode
+  {
+    uint64_t FirstPoint;
+    uint32_t NbPoints;
+    uint32_t Reserved;
+    uint32_t Children[8]; //!< child node indices, 0 if none (root is never a child)
+    float    BndMin[3];
+    float    BndMax[3];
+  };
+
+  //! Spread lower 21 bits of value to every third bit.
+  static uint64_t mortonSpread(uint64_t theValue)
+  {
+    theValue &= 0x1fffff;
+    theValue = (theValue | theValue << 32) & 0x1f00000000ffffULL;
+    theValue = (theValue | theValue << 16) & 0x1f0000ff0000ffULL;
+    theValue = (theValue | theValue << 8)  & 0x100f00f00f00f00fULL;
+    theValue = (theValue | theValue << 4)  & 0x10c30c30c30c30c3ULL;
+    theValue = (theValue | theValue << 2)  & 0x1249249249249249ULL;
+    return theValue;
+  }
+
+  //! Octree builder over points sorted along Morton curve.
+  //! Points of each octree cell form a contiguous range of sorted points;
+  //! builder moves node subsample to the front of the range, so that the final order is the pre-order of nodes.
+  struct PtsOctreeBuilder
+  {
+    const std::vector<Graphic3d_Vec3>&          Points;
+    std::vector<std::pair<uint64_t, uint32_t>>& Order;
+    std::vector<PtsNode>                        Nodes;
+    size_t                                      NodeSize;
+
+    PtsOctreeBuilder(const std::vector<Graphic3d_Vec3>& thePoints,
+                     std::vector<std::pair<uint64_t, uint32_t>>& theOrder,
+                     size_t theNodeSize)
+    : Points(thePoints), Order(theOrder), NodeSize(theNodeSize) {}
+
+    //! Build node for range of sorted points within cell at specified depth.
+    //! @return node index
+    uint32_t Build(size_t theBegin, size_t theEnd, int theDepth)
+    {
+      const uint32_t aNodeIndex = uint32_t(Nodes.size());
+      PtsNode aNode;
+      std::memset(&aNode, 0, sizeof(aNode));
+      Graphic3d_Vec3 aBndMin(FLT_MAX), aBndMax(-FLT_MAX);
+      for (size_t aPntIter = theBegin; aPntIter < theEnd; ++aPntIter)
+      {
+        aBndMin = aBndMin.cwiseMin(Points[Order[aPntIter].second]);
+        aBndMax = aBndMax.cwiseMax(Points[Order[aPntIter].second]);
+      }
+      std::memcpy(aNode.BndMin, aBndMin.GetData(), sizeof(aNode.BndMin));
+      std::memcpy(aNode.BndMax, aBndMax.GetData(), sizeof(aNode.BndMax));
+      aNode.FirstPoint = theBegin;
+      aNode.NbPoints = uint32_t(theEnd - theBegin);
+      Nodes.push_back(aNode);
+
+      const size_t aNbPoints = theEnd - theBegin;
+      if (aNbPoints <= NodeSize
+       || theDepth >= THE_PTS_MAX_DEPTH)
+      {
+        return aNodeIndex;
+      }
+
+      // keep points evenly spaced along Morton curve as coarse subsample of the cell,
+      // the rest (still sorted) is passed to children
+      std::vector<std::pair<uint64_t, uint32_t>> aRest;
+      aRest.reserve(aNbPoints - NodeSize);
+      size_t aDstIter = theBegin;
+      for (size_t aPntIter = 0; aPntIter < aNbPoints; ++aPntIter)
+      {
+        const std::pair<uint64_t, uint32_t>& aPnt = Order[theBegin + aPntIter];
+        if ((aPntIter * NodeSize) / aNbPoints != ((aPntIter + 1) * NodeSize) / aNbPoints)
+          Order[aDstIter++] = aPnt;
+        else
+          aRest.push_back(aPnt);
+      }
+      std::copy(aRest.begin(), aRest.end(), Order.begin() + aDstIter);
+      aRest = std::vector<std::pair<uint64_t, uint32_t>>();
+      Nodes[aNodeIndex].NbPoints = uint32_t(aDstIter - theBegin);
+
+      // children cells are defined by the next 3 bits of Morton code
+      const int aShift = 3 * (THE_PTS_MAX_DEPTH - 1 - theDepth);
+      for (size_t aChildBegin = aDstIter; aChildBegin < theEnd;)
+      {
+        const uint64_t anOctant = (Order[aChildBegin].first >> aShift) & 7;
+        size_t aChildEnd = aChildBegin + 1;
+        while (aChildEnd < theEnd
+           && ((Order[aChildEnd].first >> aShift) & 7) == anOctant)
+        {
+          ++aChildEnd;
+        }
+        const uint32_t aChildIndex = Build(aChildBegin, aChildEnd, theDepth + 1);
+        Nodes[aNodeIndex].Children[anOctant] = aChildIndex;
+        aChildBegin = aChildEnd;
+      }
+      return aNodeIndex;
+    }
+  };
+}
+
+// ================================================================
+// Function : WriteFile
+// ================================================================
+bool OcctPointCloud::WriteFile(const TCollection_AsciiString& thePath,
+                               const std::vector<Graphic3d_Vec3>& thePoints,
+                               const std::vector<Graphic3d_Vec4ub>& theColors,
+                               int theNodeSize)
+{
+  const bool hasColors = !theColors.empty();
+  if (thePoints.empty()
+   || thePoints.size() > size_t(UINT_MAX)
+   || (hasColors && theColors.size() != thePoints.size())
+   || theNodeSize <= 0)
+  {
+    Message::SendFail() << "Error: invalid point cloud data";
+    return false;
+  }
+
+  PtsHeader aHeader;
+  std::memcpy(aHeader.Magic, THE_PTS_MAGIC, sizeof(THE_PTS_MAGIC));
+  aHeader.NbPoints = thePoints.size();
+  aHeader.Flags = hasColors ? PtsFlags_HasColors : 0;
+  Graphic3d_Vec3 aBndMin = thePoints[0], aBndMax = thePoints[0];
+  for (const Graphic3d_Vec3& aPnt : thePoints)
+  {
+    aBndMin = aBndMin.cwiseMin(aPnt);
+    aBndMax = aBndMax.cwiseMax(aPnt);
+  }
+  std::memcpy(aHeader.BndMin, aBndMin.GetData(), sizeof(aHeader.BndMin));
+  std::memcpy(aHeader.BndMax, aBndMax.GetData(), sizeof(aHeader.BndMax));
+
+  // sort points along Morton curve within cubic root cell, so that each octree cell is a contiguous range
+  const float aCellSize = std::max((aBndMax - aBndMin).maxComp(), 1.0e-6f);
+  std::vector<std::pair<uint64_t, uint32_t>> anOrder(thePoints.size());
+  for (size_t aPntIter = 0; aPntIter < thePoints.size(); ++aPntIter)
+  {
+    const Graphic3d_Vec3 aDelta = (thePoints[aPntIter] - aBndMin) / aCellSize;
+    const uint64_t aCode = mortonSpread(uint64_t(aDelta.x() * 2097151.0f))
+                        | (mortonSpread(uint64_t(aDelta.y() * 2097151.0f)) << 1)
+                        | (mortonSpread(uint64_t(aDelta.z() * 2097151.0f)) << 2);
+    anOrder[aPntIter] = std::make_pair(aCode, uint32_t(aPntIter));
+  }
+  std::sort(anOrder.begin(), anOrder.end());
+
+  PtsOctreeBuilder aBuilder(thePoints, anOrder, size_t(theNodeSize));
+  aBuilder.Build(0, anOrder.size(), 0);
+  aHeader.NbNodes = uint32_t(aBuilder.Nodes.size());
+
+  std::ofstream aFile;
+  OSD_OpenStream(aFile, thePath.ToCString(), std::ios::out | std::ios::binary);
+  if (!aFile.is_open())
+  {
+    Message::SendFail() << "Error: unable to create file '" << thePath << "'";
+    return false;
+  }
+
+  aFile.write((const char* )&aHeader, sizeof(aHeader));
+  aFile.write((const char* )aBuilder.Nodes.data(), aBuilder.Nodes.size() * sizeof(PtsNode));
+  for (const std::pair<uint64_t, uint32_t>& aPntIter : anOrder)
+  {
+    aFile.write((const char* )thePoints[aPntIter.second].GetData(), sizeof(Graphic3d_Vec3));
+    if (hasColors)
+      aFile.write((const char* )theColors[aPntIter.second].GetData(), sizeof(Graphic3d_Vec4ub));
+  }
+  aFile.flush();
+  if (!aFile.good())
+  {
+    Message::SendFail() << "Error: unable to write file '" << thePath << "'";
+    return false;
+  }
+  return true;
+}
+
+// ================================================================
+// Function : Benchmark
+// ================================================================
+Handle(OcctPointCloud) OcctPointCloud::Benchmark(const Handle(AIS_InteractiveContext)& theCtx,
+                                                 const Handle(V3d_View)& theView,
+                                                 int theNbPoints)
+{
+  const int aNbPoints = theNbPoints > 0 ? theNbPoints : 10000000;
+  const TCollection_AsciiString aPath = "occt-pointcloud-bench.ocpts";
+
+  // synthetic terrain scan
+  OSD_Timer aTimer;
+  aTimer.Start();
+  {
+    std::vector<Graphic3d_Vec3> aPoints(aNbPoints);
+    std::vector<Graphic3d_Vec4ub> aColors(aNbPoints);
+    const int aGridSize = (int )std::sqrt(double(aNbPoints)) + 1;
+    for (int aPntIter = 0; aPntIter < aNbPoints; ++aPntIter)
+    {
+      const float anX = 1000.0f * float(aPntIter % aGridSize) / aGridSize;
+      const float anY = 1000.0f * float(aPntIter / aGridSize) / aGridSize;
+      const float aZ  = 20.0f * std::sin(anX * 0.02f) * std::cos(anY * 0.03f);
+      aPoints[aPntIter] = Graphic3d_Vec3(anX, anY, aZ);
+      aColors[aPntIter] = Graphic3d_Vec4ub(Standard_Byte(127.0f + aZ * 6.0f), 160, Standard_Byte(127.0f - aZ * 6.0f), 255);
+    }
+    if (!WriteFile(aPath, aPoints, aColors))
+      return Handle(OcctPointCloud)();
+  }
+  aTimer.Stop();
+  const double aWriteTime = aTimer.ElapsedTime();
+
+  Handle(OcctPointCloud) aCloud = new OcctPointCloud();
+  if (!aCloud->Open(aPath))
+    return Handle(OcctPointCloud)();
+
+  theCtx->Display(aCloud, 0, 0, false);
+  theView->FitAll(0.01, false);
+
+  aTimer.Reset();
+  aTimer.Start();
+  for (;;)
+  {
+    aCloud->UpdateStreaming(theView);
+    if (!aCloud->IsLoading() || aTimer.ElapsedTime() > 60.0)
+      break;
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  aTimer.Stop();
+  const double aStreamTime = aTimer.ElapsedTime();
+
+  const double aLoadedMiB = double(aCloud->NbLoadedPoints()) * double(aCloud->myPointStride) / (1024.0 * 1024.0);
+  Message::SendInfo() << "OcctPointCloud benchmark, " << aNbPoints << " points (" << aCloud->NbNodes() << " octree nodes)\n"
+                      << "  file writing: " << aWriteTime << " s\n"
+                      << "  streaming of visible nodes: " << (aStreamTime * 1000.0) << " ms, "
+                      << aCloud->NbLoadedPoints() << " points in " << aCloud->NbLoadedNodes() << " nodes within budget " << aCloud->PointBudget()
+                      << " (" << (aStreamTime > 0.0 ? aLoadedMiB / aStreamTime : 0.0) << " MiB/s)";
+  theView->Invalidate();
+  return aCloud;
+}
+
+// ================================================================
+// Function : OcctPointCloud
+// ================================================================
+OcctPointCloud::OcctPointCloud()
+{
+  myDrawer->SetPointAspect(new Prs3d_PointAspect(Aspect_TOM_POINT, Quantity_NOC_WHITE, 1.0));
+  SetDisplayMode(0);
+  SetInfiniteState(false);
+}
+
+// ================================================================
+// Function : ~OcctPointCloud
+// ================================================================
+OcctPointCloud::~OcctPointCloud()
+{
+  StopLoading();
+}
+
+// ================================================================
+// Function : Open
+// ================================================================
+bool OcctPointCloud::Open(const TCollection_AsciiString& thePath)
+{
+  StopLoading();
+  myNodes.Clear();
+  myWanted.Clear();
+  myNbPoints = 0;
+  myNbNodes = 0;
+  myNbLoadedPoints = 0;
+  if (!myFile.Open(thePath, true))
+    return false;
+
+  PtsHeader aHeader;
+  if (myFile.Size() < sizeof(PtsHeader))
+  {
+    Message::SendFail() << "Error: file '" << thePath << "' is not a point cloud";
+    myFile.Close();
+    return false;
+  }
+  std::memcpy(&aHeader, myFile.Data(), sizeof(aHeader));
+  myHasColors    = (aHeader.Flags & PtsFlags_HasColors) != 0;
+  myPointStride  = sizeof(Graphic3d_Vec3) + (myHasColors ? sizeof(Graphic3d_Vec4ub) : 0);
+  myPointsOffset = sizeof(PtsHeader) + size_t(aHeader.NbNodes) * sizeof(PtsNode);
+  // sizes are compared through division to avoid overflow on corrupted header;
+  // nodes are validated on reading, so that opening doesn't depend on file size
+  if (std::memcmp(aHeader.Magic, THE_PTS_MAGIC, sizeof(THE_PTS_MAGIC)) != 0
+   || aHeader.NbNodes == 0
+   || aHeader.NbNodes > uint32_t(INT_MAX)
+   || aHeader.NbNodes > (myFile.Size() - sizeof(PtsHeader)) / sizeof(PtsNode)
+   || aHeader.NbPoints > uint64_t(myFile.Size() - myPointsOffset) / myPointStride)
+  {
+    Message::SendFail() << "Error: file '" << thePath << "' is not a point cloud or truncated";
+    myFile.Close();
+    return false;
+  }
+
+  myNbPoints = aHeader.NbPoints;
+  myNbNodes  = (int )aHeader.NbNodes;
+  myBndMin = Graphic3d_Vec3(aHeader.BndMin[0], aHeader.BndMin[1], aHeader.BndMin[2]);
+  myBndMax = Graphic3d_Vec3(aHeader.BndMax[0], aHeader.BndMax[1], aHeader.BndMax[2]);
+  NodeInfo aRoot;
+  if (!readNode(0, aRoot))
+  {
+    Message::SendFail() << "Error: file '" << thePath << "' has corrupted node table";
+    myNbNodes = 0;
+    myFile.Close();
+    return false;
+  }
+
+  Message::SendInfo() << "Point cloud '" << thePath << "': " << (int64_t )myNbPoints << " points in "
+                      << myNbNodes << " octree nodes";
+  myToStop = false;
+  if (myPool.IsNull()
+   || myPool->NbThreads() != std::max(myNbWorkers, 1))
+  {
+    myPool = new OSD_ThreadPool(std::max(myNbWorkers, 1));
+  }
+  myLoader.SetFunction(&OcctPointCloud::loaderThread);
+  myIsLoaderRunning = myLoader.Run(this);
+  return true;
+}
+
+// ================================================================
+// Function : readNode
+// ================================================================
+bool OcctPointCloud::readNode(int theIndex, NodeInfo& theNode) const
+{
+  if (theIndex < 0 || theIndex >= myNbNodes)
+    return false;
+
+  PtsNode aNodeInfo;
+  std::memcpy(&aNodeInfo, myFile.Data() + sizeof(PtsHeader) + size_t(theIndex) * sizeof(PtsNode), sizeof(aNodeInfo));
+  if (aNodeInfo.FirstPoint > myNbPoints
+   || aNodeInfo.NbPoints > myNbPoints - aNodeInfo.FirstPoint
+   || aNodeInfo.NbPoints > uint32_t(INT_MAX))
+  {
+    return false;
+  }
+
+  theNode.FirstPoint = aNodeInfo.FirstPoint;
+  theNode.NbPoints = (int )aNodeInfo.NbPoints;
+  theNode.BndMin = Graphic3d_Vec3(aNodeInfo.BndMin[0], aNodeInfo.BndMin[1], aNodeInfo.BndMin[2]);
+  theNode.BndMax = Graphic3d_Vec3(aNodeInfo.BndMax[0], aNodeInfo.BndMax[1], aNodeInfo.BndMax[2]);
+  for (int aChildIter = 0; aChildIter < 8; ++aChildIter)
+  {
+    // children follow parent in pre-order, which also excludes cycles in corrupted file
+    const uint32_t aChild = aNodeInfo.Children[aChildIter];
+    theNode.Children[aChildIter] = aChild > uint32_t(theIndex) && aChild < uint32_t(myNbNodes) ? (int )aChild : 0;
+  }
+  return true;
+}
+
+// ================================================================
+// Function : StopLoading
+// ================================================================
+void OcctPointCloud::StopLoading()
+{
+  {
+    std::lock_guard<std::mutex> aLock(myMutex);
+    myToStop = true;
+    myRequests.clear();
+    myResults.clear();
+  }
+  myCondition.notify_all();
+  if (myIsLoaderRunning)
+  {
+    myLoader.Wait();
+    myIsLoaderRunning = false;
+  }
+  myPending.Clear();
+}
+
+// ================================================================
+// Function : loaderThread
+// ================================================================
+Standard_Address OcctPointCloud::loaderThread(Standard_Address theData)
+{
+  static_cast<OcctPointCloud*>(theData)->loaderLoop();
+  return NULL;
+}
+
+// ================================================================
+// Function : loaderLoop
+// ================================================================
+void OcctPointCloud::loaderLoop()
+{
+  for (;;)
+  {
+    std::vector<LoadTask> aBatch;
+    {
+      std::unique_lock<std::mutex> aLock(myMutex);
+      myCondition.wait(aLock, [this]() { return myToStop || !myRequests.empty(); });
+      if (myToStop)
+        return;
+
+      // requests are sorted by priority - take the first ones, one per pool thread
+      const size_t aNbTasks = std::min(myRequests.size(), size_t(myPool->NbThreads()));
+      aBatch.assign(myRequests.begin(), myRequests.begin() + aNbTasks);
+      myRequests.erase(myRequests.begin(), myRequests.begin() + aNbTasks);
+      myNbActiveTasks = (int )aNbTasks;
+    }
+
+    OSD_ThreadPool::Launcher aLauncher(*myPool, (int )aBatch.size());
+    aLauncher.Perform(0, (int )aBatch.size(), [this, &aBatch](int , int theIndex)
+    {
+      aBatch[theIndex].Array = readPoints(aBatch[theIndex].FirstPoint, aBatch[theIndex].NbPoints);
+    });
+
+    std::function<void()> aCallback;
+    {
+      std::lock_guard<std::mutex> aLock(myMutex);
+      myNbActiveTasks = 0;
+      if (myToStop)
+        return;
+
+      myResults.insert(myResults.end(), aBatch.begin(), aBatch.end());
+      aCallback = myLoadedCallback;
+    }
+    if (aCallback)
+      aCallback();
+  }
+}
+
+// ================================================================
+// Function : readPoints
+// ================================================================
+Handle(Graphic3d_ArrayOfPoints) OcctPointCloud::readPoints(uint64_t theFirstPoint, int theNbPoints) const
+{
+  Handle(Graphic3d_ArrayOfPoints) anArray = new Graphic3d_ArrayOfPoints(theNbPoints, myHasColors ? Graphic3d_ArrayFlags_VertexColor : Graphic3d_ArrayFlags_None);
+  const uint8_t* aData = myFile.Data() + myPointsOffset + size_t(theFirstPoint) * myPointStride;
+  for (int aPntIter = 0; aPntIter < theNbPoints; ++aPntIter, aData += myPointStride)
+  {
+    Graphic3d_Vec3 aPnt;
+    std::memcpy(aPnt.ChangeData(), aData, sizeof(aPnt));
+    const int aVertIndex = anArray->AddVertex(aPnt.x(), aPnt.y(), aPnt.z());
+    if (myHasColors)
+    {
+      Graphic3d_Vec4ub aColor;
+      std::memcpy(aColor.ChangeData(), aData + sizeof(Graphic3d_Vec3), sizeof(aColor));
+      anArray->SetVertexColor(aVertIndex, aColor);
+    }
+  }
+  return anArray;
+}
+
+// ================================================================
+// Function : addNodeGroup
+// ================================================================
+void OcctPointCloud::addNodeGroup(Node& theNode)
+{
+  if (myPrs.IsNull() || theNode.Array.IsNull())
+    return;
+
+  theNode.Group = myPrs->NewGroup();
+  theNode.Group->SetGroupPrimitivesAspect(myDrawer->PointAspect()->Aspect());
+  theNode.Group->AddPrimitiveArray(theNode.Array);
+  theNode.Group->SetMinMaxValues(theNode.BndMin.x(), theNode.BndMin.y(), theNode.BndMin.z(),
+                                 theNode.BndMax.x(), theNode.BndMax.y(), theNode.BndMax.z());
+}
+
+// ================================================================
+// Function : Compute
+// ================================================================
+void OcctPointCloud::Compute(const Handle(PrsMgr_PresentationManager)& ,
+                             const Handle(Prs3d_Presentation)& thePrs,
+                             const int theMode)
+{
+  if (theMode != 0 || myNbNodes == 0)
+    return;
+
+  // empty group defines bounding box of the whole cloud, including not loaded nodes
+  myPrs = thePrs;
+  Handle(Graphic3d_Group) aBndGroup = thePrs->NewGroup();
+  aBndGroup->SetMinMaxValues(myBndMin.x(), myBndMin.y(), myBndMin.z(),
+                             myBndMax.x(), myBndMax.y(), myBndMax.z());
+  for (NCollection_DataMap<int, Node>::Iterator aNodeIter(myNodes); aNodeIter.More(); aNodeIter.Next())
+  {
+    addNodeGroup(aNodeIter.ChangeValue());
+  }
+}
+
+// ================================================================
+// Function : ComputeSelection
+// ================================================================
+void OcctPointCloud::ComputeSelection(const Handle(SelectMgr_Selection)& theSel,
+                                      const int theMode)
+{
+  if (theMode != 0 || myNbNodes == 0)
+    return;
+
+  Bnd_Box aBox;
+  aBox.Update(myBndMin.x(), myBndMin.y(), myBndMin.z(), myBndMax.x(), myBndMax.y(), myBndMax.z());
+  Handle(SelectMgr_EntityOwner) anOwner = new SelectMgr_EntityOwner(this);
+  theSel->Add(new Select3D_SensitiveBox(anOwner, aBox));
+}
+
+// ================================================================
+// Function : UpdateStreaming
+// ================================================================
+bool OcctPointCloud::UpdateStreaming(const Handle(V3d_View)& theView)
+{
+  if (myPrs.IsNull() || myNbNodes == 0 || theView->Window().IsNull())
+    return false;
+
+  bool isChanged = false;
+
+  // put loaded nodes into presentation
+  std::vector<LoadTask> aResults;
+  {
+    std::lock_guard<std::mutex> aLock(myMutex);
+    aResults.swap(myResults);
+  }
+  for (const LoadTask& aResult : aResults)
+  {
+    myPending.Remove(aResult.Node);
+    if (!myWanted.Contains(aResult.Node)
+     || myNodes.IsBound(aResult.Node))
+    {
+      continue; // outdated request
+    }
+
+    Node aNode;
+    aNode.BndMin = aResult.BndMin;
+    aNode.BndMax = aResult.BndMax;
+    aNode.Array  = aResult.Array;
+    addNodeGroup(aNode);
+    myNodes.Bind(aResult.Node, aNode);
+    isChanged = true;
+  }
+
+  // traverse octree for the current camera
+  const Handle(Graphic3d_Camera)& aCam = theView->Camera();
+  Graphic3d_Vec2i aWinSize;
+  theView->Window()->Size(aWinSize.x(), aWinSize.y());
+  const gp_Trsf aTrsf = LocalTransformation();
+  Graphic3d_Mat4d aModelMat;
+  aTrsf.GetMat4(aModelMat);
+
+  Graphic3d_CullingTool aCuller;
+  aCuller.SetViewVolume(aCam, aModelMat);
+  aCuller.SetViewportSize(aWinSize.x(), aWinSize.y(), 1.0);
+  Graphic3d_CullingTool::CullingContext aCullCtx;
+  aCuller.SetCullingDistance(aCullCtx, -1.0);
+  aCuller.SetCullingSize(aCullCtx, -1.0);
+
+  // return projected size of node diagonal in pixels or -1 if node is culled
+  auto aProjectSize = [&](const NodeInfo& theNode)
+  {
+    const Graphic3d_Vec3d aMin(theNode.BndMin.x(), theNode.BndMin.y(), theNode.BndMin.z());
+    const Graphic3d_Vec3d aMax(theNode.BndMax.x(), theNode.BndMax.y(), theNode.BndMax.z());
+    if (aCuller.IsCulled(aCullCtx, aMin, aMax))
+      return -1.0;
+
+    gp_Pnt aCenter((aMin.x() + aMax.x()) * 0.5, (aMin.y() + aMax.y()) * 0.5, (aMin.z() + aMax.z()) * 0.5);
+    aCenter.Transform(aTrsf);
+    const double aDiag  = (aMax - aMin).Modulus() * aTrsf.ScaleFactor();
+    const double aDepth = gp_Vec(aCam->Eye(), aCenter).Dot(gp_Vec(aCam->Direction()));
+    const double aViewHeight = aDepth > aCam->ZNear() ? aCam->ViewDimensions(aDepth).Y() : 0.0;
+    return aViewHeight > 0.0 ? aDiag / aViewHeight * aWinSize.y() : double(aWinSize.y());
+  };
+
+  // visit nodes starting from larger ones; node is refined only when loaded and sparser than requested density,
+  // so that traversal stops at the loaded front and visits at most NodeBudget() nodes and their children
+  std::priority_queue<std::pair<double, int>> aQueue;
+  std::vector<LoadTask> aMissing;
+  NCollection_Map<int> aWanted;
+  int64_t aNbWantedPoints = 0;
+  {
+    NodeInfo aRoot;
+    const double aRootSize = readNode(0, aRoot) ? aProjectSize(aRoot) : -1.0;
+    if (aRootSize >= 0.0)
+      aQueue.push(std::make_pair(aRootSize, 0));
+  }
+  while (!aQueue.empty())
+  {
+    const std::pair<double, int> aTop = aQueue.top();
+    aQueue.pop();
+    NodeInfo aNode;
+    if (!readNode(aTop.second, aNode))
+      continue;
+
+    if (aNbWantedPoints + aNode.NbPoints > myPointBudget
+     || aWanted.Extent() >= myNodeBudget)
+    {
+      break;
+    }
+
+    aWanted.Add(aTop.second);
+    aNbWantedPoints += aNode.NbPoints;
+    if (!myNodes.IsBound(aTop.second))
+    {
+      LoadTask aRequest;
+      aRequest.FirstPoint = aNode.FirstPoint;
+      aRequest.NbPoints = aNode.NbPoints;
+      aRequest.Node = aTop.second;
+      aRequest.BndMin = aNode.BndMin;
+      aRequest.BndMax = aNode.BndMax;
+      aMissing.push_back(aRequest);
+      continue;
+    }
+
+    // screen-space error - stop refinement when node own points are dense enough
+    if (double(aNode.NbPoints) >= aTop.first * aTop.first * 0.5 * myPointDensity)
+      continue;
+
+    for (int aChildIter = 0; aChildIter < 8; ++aChildIter)
+    {
+      NodeInfo aChild;
+      if (aNode.Children[aChildIter] == 0
+      || !readNode(aNode.Children[aChildIter], aChild))
+      {
+        continue;
+      }
+
+      const double aChildSize = aProjectSize(aChild);
+      if (aChildSize >= 0.0)
+        aQueue.push(std::make_pair(aChildSize, aNode.Children[aChildIter]));
+    }
+  }
+  myWanted = aWanted;
+
+  // release nodes which are no more needed (including finer nodes of parent which is not loaded anymore)
+  std::vector<int> aRemoved;
+  myNbLoadedPoints = 0;
+  for (NCollection_DataMap<int, Node>::Iterator aNodeIter(myNodes); aNodeIter.More(); aNodeIter.Next())
+  {
+    if (!myWanted.Contains(aNodeIter.Key()))
+      aRemoved.push_back(aNodeIter.Key());
+    else
+      myNbLoadedPoints += aNodeIter.Value().Array->VertexNumber();
+  }
+  for (int aNodeIndex : aRemoved)
+  {
+    Node& aNode = myNodes.ChangeFind(aNodeIndex);
+    if (!aNode.Group.IsNull())
+      aNode.Group->Remove();
+    myNodes.UnBind(aNodeIndex);
+    isChanged = true;
+  }
+
+  // submit new requests in priority order
+  std::lock_guard<std::mutex> aLock(myMutex);
+  for (const LoadTask& aRequest : myRequests)
+  {
+    myPending.Remove(aRequest.Node);
+  }
+  myRequests.clear();
+  for (const LoadTask& aRequest : aMissing)
+  {
+    if (myPending.Add(aRequest.Node))
+      myRequests.push_back(aRequest);
+  }
+  if (!myRequests.empty())
+    myCondition.notify_all();
+
+  if (isChanged)
+  {
+    Message::SendTrace() << "OcctPointCloud: " << myNbLoadedPoints << " points in " << myNodes.Extent() << " nodes loaded, "
+                         << int(myRequests.size()) << " node requests pending";
+  }
+  return isChanged;
+}
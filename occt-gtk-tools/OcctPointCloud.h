@@ -0,0 +1,225 @@
+// Copyright (c) 2026 Kirill Gavrilov
+
+#ifndef _OcctPointCloud_HeaderFile
+#define _OcctPointCloud_HeaderFile
+
+#include "OcctMappedFile.h"
+
+#include <AIS_InteractiveObject.hxx>
+#include <Graphic3d_ArrayOfPoints.hxx>
+#include <Graphic3d_Vec.hxx>
+#include <NCollection_DataMap.hxx>
+#include <NCollection_Map.hxx>
+#include <OSD_Thread.hxx>
+#include <OSD_ThreadPool.hxx>
+#include <V3d_View.hxx>
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+//! Out-of-core point cloud presentation streaming level-of-detail subsets of memory-mapped file.
+//!
+//! The file (see WriteFile() for the format) stores points split into chunks of limited size,
+//! sorted along Morton (Z-order) curve so that each chunk covers a spatially compact region,
+//! and each chunk is stored in progressive (bit-reversed) order so that any prefix of the chunk
+//! is a uniform subsample of it. Level L of a chunk is a prefix of 1/4^L of its points.
+//! The table of chunk bounding boxes is stored in the file header, so that opening doesn't depend on file size.
+//! Chunks form a flat list (not a hierarchy) - UpdateStreaming() tests each chunk box, which is cheap for
+//! thousands of chunks but makes per-frame cost linear to the file size.
+//!
+//! UpdateStreaming() should be called before redrawing the view: it culls chunks by view frustum,
+//! selects levels from projected screen size (PointDensity() points per pixel area)
+//! within PointBudget() starting from larger chunks, and submits loading requests to the loader thread,
+//! which reads batches of requests in parallel using OSD_ThreadPool.
+//! Loaded subsets are added to presentation as separate groups (without recomputing other chunks),
+//! chunks which are no more needed are removed and coarser levels are cut from already loaded ones,
+//! so that GPU and CPU memory are bounded by the point budget (plus levels waiting for finer replacement).
+class OcctPointCloud : public AIS_InteractiveObject
+{
+  DEFINE_STANDARD_RTTI_INLINE(OcctPointCloud, AIS_InteractiveObject)
+public:
+
+  //! Write point cloud file.
+  //! @param[in] thePath    file path
+  //! @param[in] thePoints  point positions
+  //! @param[in] theColors  optional point colors (empty or of the same size as thePoints)
+  //! @param[in] theNodeSize maximum number of points per octree node
+  static bool WriteFile(const TCollection_AsciiString& thePath,
+                        const std::vector<Graphic3d_Vec3>& thePoints,
+                        const std::vector<Graphic3d_Vec4ub>& theColors,
+                        int theNodeSize = 32768);
+
+  //! Benchmark streaming: writes synthetic point cloud of theNbPoints points (terrain-like scan with colors) into file,
+  //! displays it and prints file writing time, time to stream visible levels and loading throughput.
+  //! @return displayed point cloud
+  static Handle(OcctPointCloud) Benchmark(const Handle(AIS_InteractiveContext)& theCtx,
+                                          const Handle(V3d_View)& theView,
+                                          int theNbPoints);
+
+public:
+
+  //! Empty constructor.
+  OcctPointCloud();
+
+  //! Destructor.
+  virtual ~OcctPointCloud();
+
+  //! Open point cloud file.
+  bool Open(const TCollection_AsciiString& thePath);
+
+  //! Stop loading threads; should be called before destroying objects used by LoadedCallback().
+  void StopLoading();
+
+  //! Return total number of points in file.
+  uint64_t NbPoints() const { return myNbPoints; }
+
+  //! Return total number of octree nodes in file.
+  int NbNodes() const { return myNbNodes; }
+
+  //! Return number of loaded (displayed) nodes.
+  int NbLoadedNodes() const { return myNodes.Extent(); }
+
+  //! Return number of loaded points.
+  int64_t NbLoadedPoints() const { return myNbLoadedPoints; }
+
+  //! Return maximum number of points to load (5 million by default).
+  int64_t PointBudget() const { return myPointBudget; }
+
+  //! Set maximum number of points to load.
+  void SetPointBudget(int64_t theNbPoints) { myPointBudget = theNbPoints; }
+
+  //! Return maximum number of nodes to load (2000 by default).
+  int NodeBudget() const { return myNodeBudget; }
+
+  //! Set maximum number of nodes to load.
+  void SetNodeBudget(int theNbNodes) { myNodeBudget = theNbNodes; }
+
+  //! Return requested number of points per pixel of projected node area (0.5 by default);
+  //! node is refined by its children while its own points are sparser.
+  float PointDensity() const { return myPointDensity; }
+
+  //! Set requested number of points per pixel.
+  void SetPointDensity(float theDensity) { myPointDensity = theDensity; }
+
+  //! Return number of threads reading points (2 by default).
+  int NbWorkers() const { return myNbWorkers; }
+
+  //! Set number of threads reading points; should be called before Open().
+  void SetNbWorkers(int theNbWorkers) { myNbWorkers = theNbWorkers; }
+
+  //! Set callback called from loader thread when new data has been loaded.
+  //! The callback should wake up GUI thread to redraw the view (and call UpdateStreaming()).
+  void SetLoadedCallback(const std::function<void()>& theCallback)
+  {
+    std::lock_guard<std::mutex> aLock(myMutex);
+    myLoadedCallback = theCallback;
+  }
+
+  //! Return TRUE if some nodes are being loaded or waiting to be added to presentation.
+  bool IsLoading()
+  {
+    std::lock_guard<std::mutex> aLock(myMutex);
+    return !myRequests.empty() || !myResults.empty() || myNbActiveTasks != 0;
+  }
+
+  //! Update streamed nodes for the view camera; should be called from GUI thread before redrawing the view.
+  //! @return TRUE if presentation has been modified
+  bool UpdateStreaming(const Handle(V3d_View)& theView);
+
+public:
+
+  //! Return TRUE for supported display modes (only 0 is supported).
+  virtual bool AcceptDisplayMode(const int theMode) const override { return theMode == 0; }
+
+protected:
+
+  //! Compute presentation - re-adds already loaded nodes.
+  virtual void Compute(const Handle(PrsMgr_PresentationManager)& thePrsMgr,
+                       const Handle(Prs3d_Presentation)& thePrs,
+                       const int theMode) override;
+
+  //! Compute selection - whole cloud is selected by its bounding box.
+  virtual void ComputeSelection(const Handle(SelectMgr_Selection)& theSel,
+                                const int theMode) override;
+
+protected:
+
+  //! Octree node definition read from file.
+  struct NodeInfo
+  {
+    Graphic3d_Vec3 BndMin, BndMax;  //!< bounding box of node points and its descendants
+    uint64_t       FirstPoint = 0;  //!< index of the first point in file
+    int            NbPoints   = 0;  //!< number of node own points
+    int            Children[8];     //!< child node indices (0 if none)
+  };
+
+  //! Loaded node.
+  struct Node
+  {
+    Graphic3d_Vec3 BndMin, BndMax;         //!< bounding box of node points
+    Handle(Graphic3d_ArrayOfPoints) Array; //!< loaded points
+    Handle(Graphic3d_Group)         Group; //!< presentation group
+  };
+
+  //! Loading request / result.
+  struct LoadTask
+  {
+    uint64_t FirstPoint = 0;  //!< index of the first point in file
+    int      NbPoints   = 0;  //!< number of points to read
+    int      Node       = -1; //!< node index
+    Graphic3d_Vec3 BndMin, BndMax; //!< bounding box of node points
+    Handle(Graphic3d_ArrayOfPoints) Array; //!< loaded points
+  };
+
+  //! Read and validate node definition from mapped file.
+  bool readNode(int theIndex, NodeInfo& theNode) const;
+
+  //! Loader thread function.
+  static Standard_Address loaderThread(Standard_Address theData);
+
+  //! Loader thread loop reading batches of requests in parallel.
+  void loaderLoop();
+
+  //! Read points from mapped file.
+  Handle(Graphic3d_ArrayOfPoints) readPoints(uint64_t theFirstPoint, int theNbPoints) const;
+
+  //! Add loaded node into presentation.
+  void addNodeGroup(Node& theNode);
+
+protected:
+
+  OcctMappedFile          myFile;
+  NCollection_DataMap<int, Node> myNodes;   //!< loaded nodes
+  NCollection_Map<int>    myWanted;         //!< nodes selected by the last UpdateStreaming()
+  NCollection_Map<int>    myPending;        //!< nodes requested from loader and not yet returned
+  Graphic3d_Vec3          myBndMin, myBndMax;
+  Handle(Prs3d_Presentation) myPrs;
+  uint64_t                myNbPoints      = 0;
+  int                     myNbNodes       = 0;
+  size_t                  myPointStride   = 0;
+  size_t                  myPointsOffset  = 0;
+  bool                    myHasColors     = false;
+  int64_t                 myNbLoadedPoints = 0;
+  int64_t                 myPointBudget   = 5000000;
+  int                     myNodeBudget    = 2000;
+  float                   myPointDensity  = 0.5f;
+  int                     myNbWorkers     = 2;
+
+  std::function<void()>   myLoadedCallback;
+  Handle(OSD_ThreadPool)  myPool;      //!< pool reading batches of requests
+  OSD_Thread              myLoader;    //!< thread taking requests from the queue
+  bool                    myIsLoaderRunning = false;
+  std::mutex              myMutex;
+  std::condition_variable myCondition;
+  std::deque<LoadTask>    myRequests;  //!< requests sorted by priority
+  std::vector<LoadTask>   myResults;   //!< loaded nodes to be added to presentation
+  int                     myNbActiveTasks = 0;
+  bool                    myToStop = false;
+
+};
+
+#endif // _OcctPointCloud_HeaderFile
@@ -0,0 +1,374 @@
+// Copyright (c) 2026 Kirill Gavrilov
+
+#include "OcctQualityGovernor.h"
+
+#include "OcctGlTools.h"
+
+#include <Message.hxx>
+#include <OpenGl_Context.hxx>
+#include <Prs3d_ShadingAspect.hxx>
+#include <Standard_Version.hxx>
+
+#include <algorithm>
+
+#ifndef GL_TIME_ELAPSED
+  #define GL_TIME_ELAPSED 0x88BF
+#endif
+#ifndef GL_QUERY_RESULT
+  #define GL_QUERY_RESULT 0x8866
+#endif
+#ifndef GL_QUERY_RESULT_AVAILABLE
+  #define GL_QUERY_RESULT_AVAILABLE 0x8867
+#endif
+
+namespace
+{
+  //! Number of GPU timer queries in flight.
+  static const int THE_NB_QUERIES = 4;
+}
+
+// ================================================================
+// Function : SetEnabled
+// ================================================================
+void OcctQualityGovernor::SetEnabled(const Handle(AIS_InteractiveContext)& theCtx,
+                                     const Handle(V3d_View)& theView,
+                                     bool theToEnable)
+{
+  if (myIsEnabled == theToEnable)
+    return;
+
+  if (!theToEnable)
+  {
+    applyLevel(theCtx, theView, 0);
+    mySteps.clear();
+    myIsEnabled = false;
+    return;
+  }
+
+  myFullParams   = theView->RenderingParams();
+  myHasFullEdges = theCtx->DefaultDrawer()->ShadingAspect()->Aspect()->ToDrawEdges();
+  if (!myHasFullEdges)
+  {
+    AIS_ListOfInteractive anObjects;
+    theCtx->DisplayedObjects(anObjects);
+    for (AIS_ListOfInteractive::Iterator anObjIter(anObjects); anObjIter.More() && !myHasFullEdges; anObjIter.Next())
+    {
+      myHasFullEdges = anObjIter.Value()->Attributes()->ShadingAspect()->Aspect()->ToDrawEdges();
+    }
+  }
+  buildSteps();
+  myLevel = 0;
+  myInteractiveLevel = 0;
+  myNbFramesSinceChange = 0;
+  myLastDegradedFrom = -1;
+  myFrameTime = 0.0;
+  myIdleState = IdleState_Active;
+  myIsEnabled = true;
+
+  Message_Messenger::StreamBuffer aMsg = Message::SendTrace();
+  aMsg << "OcctQualityGovernor: target " << myTargetFps << " fps, degradation steps:";
+  for (const Step& aStep : mySteps)
+  {
+    aMsg << " [" << stepName(aStep) << "]";
+  }
+}
+
+// ================================================================
+// Function : buildSteps
+// ================================================================
+void OcctQualityGovernor::buildSteps()
+{
+  mySteps.clear();
+  for (int aNbSamples = myFullParams.NbMsaaSamples / 2; aNbSamples > 0; aNbSamples /= 2)
+  {
+    const int aValue = aNbSamples > 1 ? aNbSamples : 0;
+    if (aValue < myMinMsaa)
+      break;
+
+    mySteps.push_back(Step{ StepType_Msaa, float(aValue) });
+  }
+#if (OCC_VERSION_HEX >= 0x070600)
+  if (myFullParams.IsShadowEnabled)
+    mySteps.push_back(Step{ StepType_Shadows, 0.0f });
+#endif
+  if (myFullParams.TransparencyMethod != Graphic3d_RTM_BLEND_UNORDERED)
+    mySteps.push_back(Step{ StepType_Transparency, 0.0f });
+  if (myHasFullEdges)
+    mySteps.push_back(Step{ StepType_Edges, 0.0f });
+  for (float aScale = myFullParams.RenderResolutionScale * 0.75f; aScale >= myMinRenderScale - 0.001f; aScale *= 0.75f)
+  {
+    mySteps.push_back(Step{ StepType_RenderScale, aScale });
+  }
+}
+
+// ================================================================
+// Function : applyLevel
+// ================================================================
+void OcctQualityGovernor::applyLevel(const Handle(AIS_InteractiveContext)& theCtx,
+                                     const Handle(V3d_View)& theView,
+                                     int theLevel)
+{
+  // only parameters managed by governor are reset
+  Graphic3d_RenderingParams& aParams = theView->ChangeRenderingParams();
+  aParams.NbMsaaSamples         = myFullParams.NbMsaaSamples;
+  aParams.TransparencyMethod    = myFullParams.TransparencyMethod;
+  aParams.RenderResolutionScale = myFullParams.RenderResolutionScale;
+#if (OCC_VERSION_HEX >= 0x070600)
+  aParams.IsShadowEnabled       = myFullParams.IsShadowEnabled;
+#endif
+  bool toDrawEdges = myHasFullEdges;
+  for (int aStepIter = 0; aStepIter < theLevel && aStepIter < NbLevels(); ++aStepIter)
+  {
+    const Step& aStep = mySteps[aStepIter];
+    switch (aStep.Type)
+    {
+      case StepType_Msaa:         aParams.NbMsaaSamples = int(aStep.Value); break;
+    #if (OCC_VERSION_HEX >= 0x070600)
+      case StepType_Shadows:      aParams.IsShadowEnabled = false; break;
+    #else
+      case StepType_Shadows:      break;
+    #endif
+      case StepType_Transparency: aParams.TransparencyMethod = Graphic3d_RTM_BLEND_UNORDERED; break;
+      case StepType_Edges:        toDrawEdges = false; break;
+      case StepType_RenderScale:  aParams.RenderResolutionScale = aStep.Value; break;
+    }
+  }
+
+  setEdges(theCtx, toDrawEdges);
+
+  myLevel = theLevel;
+  myNbFramesSinceChange = 0;
+  myFrameTime = 0.0;
+  myGpuTime = 0.0;
+  myNbStaleQueries = myNbPendingQueries;
+  theView->Invalidate();
+}
+
+// ================================================================
+// Function : setEdges
+// ================================================================
+void OcctQualityGovernor::setEdges(const Handle(AIS_InteractiveContext)& theCtx,
+                                   bool theToDraw)
+{
+  if (theToDraw)
+  {
+    // groups recomputed in between have been created with drawer aspects and are not touched
+    for (const std::pair<Handle(Graphic3d_Group), Handle(Graphic3d_Aspects)>& anOverride : myEdgeOverrides)
+    {
+      if (!anOverride.first->IsDeleted())
+        anOverride.first->SetGroupPrimitivesAspect(anOverride.second);
+    }
+    myEdgeOverrides.clear();
+    return;
+  }
+  else if (!myEdgeOverrides.empty())
+  {
+    return;
+  }
+
+  // aspects of groups are overridden by copies without edges, so that drawers and not displayed objects are not affected
+  AIS_ListOfInteractive anObjects;
+  theCtx->DisplayedObjects(anObjects);
+  for (AIS_ListOfInteractive::Iterator anObjIter(anObjects); anObjIter.More(); anObjIter.Next())
+  {
+    for (PrsMgr_Presentations::Iterator aPrsIter(anObjIter.Value()->Presentations()); aPrsIter.More(); aPrsIter.Next())
+    {
+      for (Graphic3d_SequenceOfGroup::Iterator aGroupIter(aPrsIter.Value()->Groups()); aGroupIter.More(); aGroupIter.Next())
+      {
+        const Handle(Graphic3d_Group)& aGroup = aGroupIter.Value();
+        const Handle(Graphic3d_Aspects) anAspects = aGroup->Aspects();
+        if (anAspects.IsNull()
+         || !anAspects->ToDrawEdges())
+        {
+          continue;
+        }
+
+        Handle(Graphic3d_Aspects) aNoEdges = new Graphic3d_Aspects(*anAspects);
+        aNoEdges->SetDrawEdges(false);
+        aGroup->SetGroupPrimitivesAspect(aNoEdges);
+        myEdgeOverrides.push_back(std::make_pair(aGroup, anAspects));
+      }
+    }
+  }
+}
+
+// ================================================================
+// Function : readQueries
+// ================================================================
+void OcctQualityGovernor::readQueries(const Handle(V3d_View)& theView)
+{
+  Handle(OpenGl_Context) aGlCtx = OcctGlTools::GetGlContext(theView);
+  if (aGlCtx.IsNull())
+    return;
+
+  if (myQueries.empty())
+  {
+    myHasTimerQueries = aGlCtx->core15fwd != nullptr
+                     && (aGlCtx->IsGlGreaterEqual(3, 3) || aGlCtx->CheckExtension("GL_ARB_timer_query"));
+    if (!myHasTimerQueries)
+      return;
+
+    myQueries.resize(THE_NB_QUERIES, 0);
+    aGlCtx->core15fwd->glGenQueries(THE_NB_QUERIES, myQueries.data());
+    myQueryFirst = 0;
+    myNbPendingQueries = 0;
+    myNbStaleQueries = 0;
+  }
+
+  // results are taken in order while available, so that waiting for GPU never happens
+  while (myNbPendingQueries > 0)
+  {
+    const unsigned int aQuery = myQueries[myQueryFirst];
+    GLuint isAvailable = 0;
+    aGlCtx->core15fwd->glGetQueryObjectuiv(aQuery, GL_QUERY_RESULT_AVAILABLE, &isAvailable);
+    if (isAvailable == 0)
+      break;
+
+    GLuint aNanoSeconds = 0;
+    aGlCtx->core15fwd->glGetQueryObjectuiv(aQuery, GL_QUERY_RESULT, &aNanoSeconds);
+    if (myNbStaleQueries > 0)
+      --myNbStaleQueries;
+    else
+      myGpuTime = double(aNanoSeconds) * 0.000000001;
+
+    myQueryFirst = (myQueryFirst + 1) % THE_NB_QUERIES;
+    --myNbPendingQueries;
+  }
+}
+
+// ================================================================
+// Function : ReleaseGl
+// ================================================================
+void OcctQualityGovernor::ReleaseGl(const Handle(V3d_View)& theView)
+{
+  Handle(OpenGl_Context) aGlCtx = OcctGlTools::GetGlContext(theView);
+  if (!myQueries.empty()
+   && !aGlCtx.IsNull())
+  {
+    if (myIsQueryActive)
+      aGlCtx->core15fwd->glEndQuery(GL_TIME_ELAPSED);
+    aGlCtx->core15fwd->glDeleteQueries((int )myQueries.size(), myQueries.data());
+  }
+  myQueries.clear();
+  myIsQueryActive = false;
+  myNbPendingQueries = 0;
+  myNbStaleQueries = 0;
+  myGpuTime = 0.0;
+}
+
+// ================================================================
+// Function : BeginFrame
+// ================================================================
+void OcctQualityGovernor::BeginFrame(const Handle(AIS_InteractiveContext)& theCtx,
+                                     const Handle(V3d_View)& theView)
+{
+  if (!myIsEnabled)
+    return;
+
+  readQueries(theView);
+  if (myHasTimerQueries
+   && !myIsQueryActive
+   && myNbPendingQueries < THE_NB_QUERIES)
+  {
+    Handle(OpenGl_Context) aGlCtx = OcctGlTools::GetGlContext(theView);
+    aGlCtx->core15fwd->glBeginQuery(GL_TIME_ELAPSED, myQueries[(myQueryFirst + myNbPendingQueries) % THE_NB_QUERIES]);
+    myIsQueryActive = true;
+  }
+
+  if (myIdleState != IdleState_Idle)
+    return;
+
+  // interaction has been resumed after idle state
+  myIdleState = IdleState_Active;
+  if (myInteractiveLevel != myLevel)
+  {
+    Message::SendInfo() << "OcctQualityGovernor: resume interactive level " << myInteractiveLevel << "/" << NbLevels();
+    applyLevel(theCtx, theView, myInteractiveLevel);
+  }
+}
+
+// ================================================================
+// Function : EndFrame
+// ================================================================
+void OcctQualityGovernor::EndFrame(const Handle(AIS_InteractiveContext)& theCtx,
+                                   const Handle(V3d_View)& theView,
+                                   double theFrameTime)
+{
+  if (!myIsEnabled)
+    return;
+
+  if (myIsQueryActive)
+  {
+    OcctGlTools::GetGlContext(theView)->core15fwd->glEndQuery(GL_TIME_ELAPSED);
+    myIsQueryActive = false;
+    ++myNbPendingQueries;
+  }
+
+  if (myIdleState != IdleState_Active)
+  {
+    // full quality frame rendered on idle is not measured
+    myIdleState = IdleState_Idle;
+    return;
+  }
+
+  // GPU time lags behind by a few frames, but still limits frame rate when rendering is GPU-bound
+  const double aFrameTime = std::max(theFrameTime, myGpuTime);
+  myFrameTime = myFrameTime > 0.0 ? myFrameTime * 0.7 + aFrameTime * 0.3 : aFrameTime;
+  if (++myNbFramesSinceChange < 5)
+    return;
+
+  const double aTargetTime = 1.0 / myTargetFps;
+  if (myFrameTime > aTargetTime * 1.15
+   && myLevel < NbLevels())
+  {
+    Message::SendInfo() << "OcctQualityGovernor: frame time " << (myFrameTime * 1000.0) << " ms > " << (aTargetTime * 1000.0)
+                        << " ms, degrade to level " << (myLevel + 1) << "/" << NbLevels() << " [" << stepName(mySteps[myLevel]) << "]";
+    myLastDegradedFrom = myLevel;
+    applyLevel(theCtx, theView, myLevel + 1);
+  }
+  else if (myFrameTime < aTargetTime * 0.6
+        && myLevel > 0
+        && (myLevel - 1 != myLastDegradedFrom || myNbFramesSinceChange >= 60))
+  {
+    // upgrading back into just left level requires longer cooldown
+    Message::SendInfo() << "OcctQualityGovernor: frame time " << (myFrameTime * 1000.0) << " ms < " << (aTargetTime * 600.0)
+                        << " ms, upgrade to level " << (myLevel - 1) << "/" << NbLevels() << " [-" << stepName(mySteps[myLevel - 1]) << "]";
+    applyLevel(theCtx, theView, myLevel - 1);
+  }
+  myInteractiveLevel = myLevel;
+}
+
+// ================================================================
+// Function : RestoreFullQuality
+// ================================================================
+bool OcctQualityGovernor::RestoreFullQuality(const Handle(AIS_InteractiveContext)& theCtx,
+                                             const Handle(V3d_View)& theView)
+{
+  if (!myIsEnabled
+    || myLevel == 0)
+  {
+    return false;
+  }
+
+  Message::SendInfo() << "OcctQualityGovernor: view is idle, restore full quality from level " << myLevel << "/" << NbLevels();
+  myInteractiveLevel = myLevel;
+  applyLevel(theCtx, theView, 0);
+  myIdleState = IdleState_Pending;
+  return true;
+}
+
+// ================================================================
+// Function : stepName
+// ================================================================
+TCollection_AsciiString OcctQualityGovernor::stepName(const Step& theStep)
+{
+  switch (theStep.Type)
+  {
+    case StepType_Msaa:         return TCollection_AsciiString("MSAA ") + int(theStep.Value) + "x";
+    case StepType_Shadows:      return "shadows off";
+    case StepType_Transparency: return "unordered transparency";
+    case StepType_Edges:        return "edges off";
+    case StepType_RenderScale:  return TCollection_AsciiString("render scale ") + double(theStep.Value);
+  }
+  return "";
+}
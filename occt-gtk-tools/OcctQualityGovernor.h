@@ -0,0 +1,175 @@
+// Copyright (c) 2026 Kirill Gavrilov
+
+#ifndef _OcctQualityGovernor_HeaderFile
+#define _OcctQualityGovernor_HeaderFile
+
+#include <AIS_InteractiveContext.hxx>
+#include <Graphic3d_Group.hxx>
+#include <Graphic3d_RenderingParams.hxx>
+#include <V3d_View.hxx>
+
+#include <utility>
+#include <vector>
+
+//! Closed-loop controller adjusting rendering quality of the view to hold target frame rate.
+//!
+//! At the moment of enabling, current rendering parameters are captured as full quality,
+//! and a ladder of degradation steps is built from them within configured range:
+//! halving MSAA samples down to MinMsaaSamples(), disabling shadows,
+//! switching OIT to unordered blending, disabling edges of shaded presentations
+//! and lowering render resolution scale down to MinRenderScale().
+//! Edges are disabled by overriding aspects of presentation groups of displayed objects having edges,
+//! so that drawers (including default one) are not modified and overridden groups are restored as they were.
+//!
+//! Frame time is the maximum of CPU time passed to EndFrame() and GPU time measured by GL_TIME_ELAPSED queries
+//! started by BeginFrame(); query results are read back a few frames later without stalling the pipeline.
+//! Without timer queries (OpenGL ES, OpenGL below 3.3 without GL_ARB_timer_query) only CPU time is measured.
+//! ReleaseGl() should be called before OpenGL context is destroyed.
+//!
+//! EndFrame() smooths measured frame times and moves one step down the ladder when frame time exceeds the target,
+//! or one step up when there is enough headroom; hysteresis and cooldown periods prevent oscillation.
+//! RestoreFullQuality() should be called when the view becomes idle; the reached level is re-applied
+//! when interaction resumes after one full-quality frame. Every adjustment is logged.
+class OcctQualityGovernor
+{
+public:
+
+  //! Empty constructor.
+  OcctQualityGovernor() {}
+
+  //! Return TRUE if governor is enabled.
+  bool IsEnabled() const { return myIsEnabled; }
+
+  //! Enable governor capturing current rendering parameters of the view as full quality,
+  //! or disable governor restoring full quality.
+  void SetEnabled(const Handle(AIS_InteractiveContext)& theCtx,
+                  const Handle(V3d_View)& theView,
+                  bool theToEnable);
+
+  //! Return target frame rate (30 by default).
+  double TargetFps() const { return myTargetFps; }
+
+  //! Set target frame rate.
+  void SetTargetFps(double theFps) { myTargetFps = theFps; }
+
+  //! Return minimal number of MSAA samples (0 by default).
+  int MinMsaaSamples() const { return myMinMsaa; }
+
+  //! Set minimal number of MSAA samples; should be set before enabling governor.
+  void SetMinMsaaSamples(int theNbSamples) { myMinMsaa = theNbSamples; }
+
+  //! Return minimal render resolution scale (0.5 by default).
+  float MinRenderScale() const { return myMinRenderScale; }
+
+  //! Set minimal render resolution scale; should be set before enabling governor.
+  void SetMinRenderScale(float theScale) { myMinRenderScale = theScale; }
+
+  //! Return idle time in seconds to restore full quality (0.5 by default).
+  double IdleTimeout() const { return myIdleTimeout; }
+
+  //! Set idle timeout in seconds.
+  void SetIdleTimeout(double theSeconds) { myIdleTimeout = theSeconds; }
+
+  //! Return current degradation level (0 means full quality).
+  int Level() const { return myLevel; }
+
+  //! Return number of degradation steps.
+  int NbLevels() const { return (int )mySteps.size(); }
+
+  //! Return smoothed frame time in seconds.
+  double FrameTime() const { return myFrameTime; }
+
+  //! Prepare the frame: re-apply interactive level when interaction resumes after idle state,
+  //! and start GPU timer query; should be called with OpenGL context bound.
+  void BeginFrame(const Handle(AIS_InteractiveContext)& theCtx,
+                  const Handle(V3d_View)& theView);
+
+  //! Account rendered frame and adjust quality for the next frames.
+  //! @param[in] theFrameTime CPU frame rendering time in seconds (without waiting for GPU)
+  void EndFrame(const Handle(AIS_InteractiveContext)& theCtx,
+                const Handle(V3d_View)& theView,
+                double theFrameTime);
+
+  //! Restore full quality on idle state.
+  //! @return TRUE if rendering parameters have been changed and view should be redrawn
+  bool RestoreFullQuality(const Handle(AIS_InteractiveContext)& theCtx,
+                          const Handle(V3d_View)& theView);
+
+  //! Release GPU timer queries; should be called with OpenGL context bound.
+  void ReleaseGl(const Handle(V3d_View)& theView);
+
+protected:
+
+  //! Degradation step type.
+  enum StepType
+  {
+    StepType_Msaa,
+    StepType_Shadows,
+    StepType_Transparency,
+    StepType_Edges,
+    StepType_RenderScale
+  };
+
+  //! Degradation step.
+  struct Step
+  {
+    StepType Type;
+    float    Value;
+  };
+
+  //! Idle state.
+  enum IdleState
+  {
+    IdleState_Active,  //!< interactive frames
+    IdleState_Pending, //!< full quality restored, waiting for full-quality frame
+    IdleState_Idle     //!< full-quality frame has been rendered
+  };
+
+protected:
+
+  //! Build degradation ladder from full quality parameters.
+  void buildSteps();
+
+  //! Apply degradation level.
+  void applyLevel(const Handle(AIS_InteractiveContext)& theCtx,
+                  const Handle(V3d_View)& theView,
+                  int theLevel);
+
+  //! Disable or restore edges of displayed objects.
+  void setEdges(const Handle(AIS_InteractiveContext)& theCtx,
+                bool theToDraw);
+
+  //! Read available results of GPU timer queries.
+  void readQueries(const Handle(V3d_View)& theView);
+
+  //! Return step description.
+  static TCollection_AsciiString stepName(const Step& theStep);
+
+protected:
+
+  Graphic3d_RenderingParams myFullParams;             //!< full quality parameters
+  std::vector<Step>         mySteps;                  //!< degradation ladder
+  std::vector<std::pair<Handle(Graphic3d_Group), Handle(Graphic3d_Aspects)>> myEdgeOverrides; //!< groups with disabled edges and their original aspects
+  std::vector<unsigned int> myQueries;                //!< ring of GPU timer queries
+  double    myTargetFps      = 30.0;
+  double    myIdleTimeout    = 0.5;
+  double    myFrameTime      = 0.0;  //!< smoothed frame time
+  double    myGpuTime        = 0.0;  //!< last measured GPU frame time
+  float     myMinRenderScale = 0.5f;
+  int       myMinMsaa        = 0;
+  int       myLevel          = 0;    //!< applied level
+  int       myInteractiveLevel = 0;  //!< level to re-apply after idle state
+  int       myNbFramesSinceChange = 0;
+  int       myLastDegradedFrom = -1; //!< level left due to slow frames (upgrading into it requires longer cooldown)
+  int       myQueryFirst     = 0;    //!< index of the oldest pending query
+  int       myNbPendingQueries = 0;  //!< number of finished queries waiting for results
+  int       myNbStaleQueries = 0;    //!< number of pending queries measuring previous level
+  IdleState myIdleState      = IdleState_Active;
+  bool      myHasFullEdges   = false;
+  bool      myHasTimerQueries = false;
+  bool      myIsQueryActive  = false;
+  bool      myIsEnabled      = false;
+
+};
+
+#endif // _OcctQualityGovernor_HeaderFile
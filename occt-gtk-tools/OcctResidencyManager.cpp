@@ -0,0 +1,380 @@
+// Copyright (c) 2026 Kirill Gavrilov
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+#include "OcctResidencyManager.h"
+
+#include "OcctSceneBoundsIndex.h"
+
+#include "OcctGlTools.h"
+#include "OcctMemoryReport.h"
+
+#include <Message.hxx>
+#include <NCollection_Map.hxx>
+#include <OpenGl_Context.hxx>
+#include <TColStd_ListOfInteger.hxx>
+
+#include <algorithm>
+#include <vector>
+
+// ================================================================
+// Function : OcctResidencyManager
+// ================================================================
+OcctResidencyManager::OcctResidencyManager()
+{
+  myTimer.Start();
+}
+
+// ================================================================
+// Function : EvictedBoundingBox
+// ================================================================
+Bnd_Box OcctResidencyManager::EvictedBoundingBox() const
+{
+  Bnd_Box aBox;
+  for (NCollection_IndexedMap<Handle(AIS_InteractiveObject)>::Iterator anObjIter(myEvicted); anObjIter.More(); anObjIter.Next())
+  {
+    const ObjectState* aState = myStates.Seek(anObjIter.Value());
+    if (aState != NULL && aState->IsOffscreen)
+      aBox.Add(aState->Box);
+  }
+  return aBox;
+}
+
+// ================================================================
+// Function : Update
+// ================================================================
+bool OcctResidencyManager::Update(const Handle(AIS_InteractiveContext)& theCtx,
+                                  const Handle(V3d_View)& theView)
+{
+  if (!IsEnabled() || theView->Window().IsNull())
+    return false;
+
+  const double aTime = myTimer.ElapsedTime();
+
+  Graphic3d_Vec2i aWinSize;
+  theView->Window()->Size(aWinSize.x(), aWinSize.y());
+  Graphic3d_CullingTool aCuller;
+  aCuller.SetViewVolume(theView->Camera());
+  aCuller.SetViewportSize(aWinSize.x(), aWinSize.y(), 1.0);
+  Graphic3d_CullingTool::CullingContext aCullCtx;
+  aCuller.SetCullingDistance(aCullCtx, -1.0);
+  aCuller.SetCullingSize(aCullCtx, -1.0);
+
+  if (myLastRescan < 0.0
+   || aTime - myLastRescan >= myRescanInterval)
+  {
+    rescan(theCtx, aTime);
+    myLastRescan = aTime;
+  }
+
+  // evicted objects are tested every frame, so that objects entering view frustum are restored without delay
+  bool isChanged = false;
+  for (int anEvictIter = myEvicted.Extent(); anEvictIter >= 1; --anEvictIter)
+  {
+    const Handle(AIS_InteractiveObject) anObj = myEvicted.FindKey(anEvictIter);
+    ObjectState* aState = myStates.ChangeSeek(anObj);
+    const PrsMgr_DisplayStatus aStatus = theCtx->DisplayStatus(anObj);
+    if (aState == NULL
+     || aStatus == PrsMgr_DisplayStatus_None)
+    {
+      // removed from context - dropped by the next rescan
+      myEvicted.RemoveFromIndex(anEvictIter);
+      continue;
+    }
+
+    if (aStatus == PrsMgr_DisplayStatus_Displayed)
+    {
+      // displayed back by application - presentation has been recomputed by context
+      aState->IsEvicted = false;
+      aState->IsOffscreen = false;
+      aState->GpuBytes = 0;
+      aState->LastVisible = aTime;
+      myEvicted.RemoveFromIndex(anEvictIter);
+      continue;
+    }
+
+    if (aState->IsOffscreen)
+    {
+      updateEvictedBox(anObj, *aState);
+      if (!aState->Box.IsVoid()
+       && !aCuller.IsCulled(aCullCtx,
+                            Graphic3d_Vec3d(aState->Box.CornerMin().X(), aState->Box.CornerMin().Y(), aState->Box.CornerMin().Z()),
+                            Graphic3d_Vec3d(aState->Box.CornerMax().X(), aState->Box.CornerMax().Y(), aState->Box.CornerMax().Z())))
+      {
+        // object entered view frustum - upload it back
+        restore(theCtx, anObj, *aState, aTime);
+        myEvicted.RemoveFromIndex(anEvictIter);
+        isChanged = true;
+      }
+    }
+  }
+
+  // resident objects are visited in round-robin slices
+  const int aNbStates = myStates.Extent();
+  const int aNbToVisit = std::min(std::max(myNbPerFrame, 1), aNbStates);
+  for (int aVisitIter = 0; aVisitIter < aNbToVisit; ++aVisitIter, ++myNextIndex)
+  {
+    if (myNextIndex > aNbStates)
+      myNextIndex = 1;
+
+    ObjectState& aState = myStates.ChangeFromIndex(myNextIndex);
+    if (!aState.IsEvicted)
+      visit(theCtx, myStates.FindKey(myNextIndex), aState, aCuller, aCullCtx, aTime);
+  }
+
+  Standard_Size aBytesToFree = myBudget != 0 && myResidentBytes > myBudget ? myResidentBytes - myBudget : 0;
+  if (myMinFreeMemory != 0)
+  {
+    Handle(OpenGl_Context) aGlCtx = OcctGlTools::GetGlContext(theView);
+    const Standard_Size aFreeMem = !aGlCtx.IsNull() ? aGlCtx->AvailableMemory() : 0;
+    if (aFreeMem != 0 && aFreeMem < myMinFreeMemory)
+      aBytesToFree = std::max(aBytesToFree, myMinFreeMemory - aFreeMem);
+  }
+  if (aBytesToFree == 0
+   || aTime < myNextEvictTime)
+  {
+    return isChanged;
+  }
+
+  // candidates scan walks all objects, so that it is repeated not often than once per rescan interval
+  // while there is not enough candidates to free requested memory
+  const Standard_Size aFreedBytes = evictCandidates(theCtx, aCuller, aCullCtx, aTime, aBytesToFree);
+  myNextEvictTime = aFreedBytes < aBytesToFree ? aTime + myRescanInterval : 0.0;
+  return isChanged || aFreedBytes != 0;
+}
+
+// ================================================================
+// Function : rescan
+// ================================================================
+void OcctResidencyManager::rescan(const Handle(AIS_InteractiveContext)& theCtx, double theTime)
+{
+  AIS_ListOfInteractive anObjects;
+  theCtx->ObjectsInside(anObjects);
+  NCollection_Map<Handle(AIS_InteractiveObject)> aPresent(anObjects.Size());
+  for (AIS_ListOfInteractive::Iterator anObjIter(anObjects); anObjIter.More(); anObjIter.Next())
+  {
+    const Handle(AIS_InteractiveObject)& anObj = anObjIter.Value();
+    if (!anObj->TransformPersistence().IsNull()
+      || anObj->ZLayer() != Graphic3d_ZLayerId_Default)
+    {
+      continue;
+    }
+
+    aPresent.Add(anObj);
+    if (!myStates.Contains(anObj))
+    {
+      ObjectState aState;
+      aState.LastVisible = theTime;
+      myStates.Add(anObj, aState);
+    }
+  }
+
+  // removed objects are dropped; the last object is moved into the index of removed one, so that iteration goes backwards
+  for (int anIndex = myStates.Extent(); anIndex >= 1; --anIndex)
+  {
+    const Handle(AIS_InteractiveObject)& anObj = myStates.FindKey(anIndex);
+    if (aPresent.Contains(anObj))
+      continue;
+
+    myResidentBytes -= std::min(myResidentBytes, myStates.FindFromIndex(anIndex).GpuBytes);
+    myEvicted.RemoveKey(anObj);
+    myStates.RemoveFromIndex(anIndex);
+  }
+}
+
+// ================================================================
+// Function : visit
+// ================================================================
+void OcctResidencyManager::visit(const Handle(AIS_InteractiveContext)& theCtx,
+                                 const Handle(AIS_InteractiveObject)& theObj,
+                                 ObjectState& theState,
+                                 const Graphic3d_CullingTool& theCuller,
+                                 const Graphic3d_CullingTool::CullingContext& theCullCtx,
+                                 double theTime)
+{
+  if (theCtx->DisplayStatus(theObj) == PrsMgr_DisplayStatus_Displayed)
+  {
+    Bnd_Box aBox;
+    theObj->BoundingBox(aBox);
+    if (!aBox.IsVoid())
+    {
+      theState.Box = aBox;
+      theState.Trsf = theObj->TransformationGeom();
+      if (!theCuller.IsCulled(theCullCtx,
+                              Graphic3d_Vec3d(aBox.CornerMin().X(), aBox.CornerMin().Y(), aBox.CornerMin().Z()),
+                              Graphic3d_Vec3d(aBox.CornerMax().X(), aBox.CornerMax().Y(), aBox.CornerMax().Z())))
+      {
+        theState.LastVisible = theTime;
+      }
+    }
+  }
+
+  // VBOs are allocated on the first draw and reallocated on recomputing presentation (by application or by restore()),
+  // so that memory is measured on every visit and resident total is corrected by the difference
+  const Standard_Size aGpuBytes = OcctMemoryReport::EstimateGpuBytes(theObj);
+  myResidentBytes = myResidentBytes - std::min(myResidentBytes, theState.GpuBytes) + aGpuBytes;
+  theState.GpuBytes = aGpuBytes;
+}
+
+// ================================================================
+// Function : updateEvictedBox
+// ================================================================
+void OcctResidencyManager::updateEvictedBox(const Handle(AIS_InteractiveObject)& theObj,
+                                            ObjectState& theState)
+{
+  const Handle(TopLoc_Datum3D)& aTrsf = theObj->TransformationGeom();
+  if (aTrsf == theState.Trsf)
+    return;
+
+  // presentation is cleared, so that the box is moved by transformation delta instead of being recomputed
+  gp_Trsf aDelta = !aTrsf.IsNull() ? aTrsf->Trsf() : gp_Trsf();
+  if (!theState.Trsf.IsNull())
+    aDelta = aDelta * theState.Trsf->Trsf().Inverted();
+  if (!theState.Box.IsVoid())
+    theState.Box = theState.Box.Transformed(aDelta);
+  theState.Trsf = aTrsf;
+}
+
+// ================================================================
+// Function : evictCandidates
+// ================================================================
+Standard_Size OcctResidencyManager::evictCandidates(const Handle(AIS_InteractiveContext)& theCtx,
+                                                    const Graphic3d_CullingTool& theCuller,
+                                                    const Graphic3d_CullingTool::CullingContext& theCullCtx,
+                                                    double theTime,
+                                                    Standard_Size theBytesToFree)
+{
+  std::vector<std::pair<double, int>> aCandidates;
+  for (int anIndex = 1; anIndex <= myStates.Extent(); ++anIndex)
+  {
+    const ObjectState& aState = myStates.FindFromIndex(anIndex);
+    if (aState.IsEvicted
+     || aState.GpuBytes == 0)
+    {
+      continue;
+    }
+
+    const PrsMgr_DisplayStatus aStatus = theCtx->DisplayStatus(myStates.FindKey(anIndex));
+    if (aStatus == PrsMgr_DisplayStatus_Erased
+     || (aStatus == PrsMgr_DisplayStatus_Displayed && theTime - aState.LastVisible > myOffscreenTimeout))
+    {
+      aCandidates.push_back(std::make_pair(aState.LastVisible, anIndex));
+    }
+  }
+
+  // evict least-recently visible objects first
+  std::sort(aCandidates.begin(), aCandidates.end());
+  Standard_Size aFreedBytes = 0;
+  int aNbEvicted = 0;
+  for (size_t aCandIter = 0; aCandIter < aCandidates.size() && aFreedBytes < theBytesToFree; ++aCandIter)
+  {
+    const Handle(AIS_InteractiveObject) anObj = myStates.FindKey(aCandidates[aCandIter].second);
+    ObjectState& aState = myStates.ChangeFromIndex(aCandidates[aCandIter].second);
+    if (theCtx->DisplayStatus(anObj) == PrsMgr_DisplayStatus_Displayed)
+    {
+      // visibility of displayed candidate might be outdated by one round of slices - check it with the current box
+      visit(theCtx, anObj, aState, theCuller, theCullCtx, theTime);
+      if (theTime - aState.LastVisible <= myOffscreenTimeout)
+        continue;
+    }
+
+    aFreedBytes += aState.GpuBytes;
+    evict(theCtx, anObj, aState);
+    ++aNbEvicted;
+  }
+  myResidentBytes -= std::min(myResidentBytes, aFreedBytes);
+  if (aNbEvicted != 0)
+  {
+    Message::SendTrace() << "OcctResidencyManager: evicted " << aNbEvicted << " objects releasing "
+                         << (aFreedBytes / (1024 * 1024)) << " MiB (resident " << (myResidentBytes / (1024 * 1024)) << " MiB)";
+  }
+  return aFreedBytes;
+}
+
+// ================================================================
+// Function : evict
+// ================================================================
+void OcctResidencyManager::evict(const Handle(AIS_InteractiveContext)& theCtx,
+                                 const Handle(AIS_InteractiveObject)& theObj,
+                                 ObjectState& theState)
+{
+  theState.SelModes.Clear();
+  theCtx->ActivatedModes(theObj, theState.SelModes);
+  theState.DispMode = theObj->HasDisplayMode() ? theObj->DisplayMode() : theCtx->DisplayMode();
+  theState.Trsf = theObj->TransformationGeom();
+  theState.IsOffscreen = theCtx->DisplayStatus(theObj) == PrsMgr_DisplayStatus_Displayed;
+  if (theState.IsOffscreen)
+  {
+    theCtx->Erase(theObj, false);
+    if (myBoundsIndex != NULL
+     && myBoundsIndex->IsEnabled())
+    {
+      myBoundsIndex->Remove(theObj);
+    }
+  }
+
+  NCollection_Sequence<int> aModes;
+  for (PrsMgr_Presentations::Iterator aPrsIter(theObj->Presentations()); aPrsIter.More(); aPrsIter.Next())
+  {
+    aModes.Append(aPrsIter.Value()->Mode());
+  }
+  for (NCollection_Sequence<int>::Iterator aModeIter(aModes); aModeIter.More(); aModeIter.Next())
+  {
+    // removing presentation releases its OpenGL resources
+    theCtx->ClearPrs(theObj, aModeIter.Value(), false);
+  }
+
+  theState.IsEvicted = true;
+  theState.GpuBytes = 0;
+  myEvicted.Add(theObj);
+}
+
+// ================================================================
+// Function : restore
+// ================================================================
+void OcctResidencyManager::restore(const Handle(AIS_InteractiveContext)& theCtx,
+                                   const Handle(AIS_InteractiveObject)& theObj,
+                                   ObjectState& theState,
+                                   double theTime)
+{
+  theCtx->Display(theObj, theState.DispMode, -1, false);
+  if (myBoundsIndex != NULL
+   && myBoundsIndex->IsEnabled())
+  {
+    myBoundsIndex->Update(theObj);
+  }
+  for (TColStd_ListOfInteger::Iterator aModeIter(theState.SelModes); aModeIter.More(); aModeIter.Next())
+  {
+    theCtx->Activate(theObj, aModeIter.Value());
+  }
+  theState.IsEvicted = false;
+  theState.IsOffscreen = false;
+  theState.GpuBytes = 0;
+  theState.LastVisible = theTime;
+}
+
+// ================================================================
+// Function : RestoreAll
+// ================================================================
+void OcctResidencyManager::RestoreAll(const Handle(AIS_InteractiveContext)& theCtx)
+{
+  const double aTime = myTimer.ElapsedTime();
+  for (NCollection_IndexedMap<Handle(AIS_InteractiveObject)>::Iterator anObjIter(myEvicted); anObjIter.More(); anObjIter.Next())
+  {
+    ObjectState* aState = myStates.ChangeSeek(anObjIter.Value());
+    if (aState == NULL)
+      continue;
+
+    if (aState->IsOffscreen
+     && theCtx->DisplayStatus(anObjIter.Value()) == PrsMgr_DisplayStatus_Erased)
+    {
+      restore(theCtx, anObjIter.Value(), *aState, aTime);
+    }
+    aState->IsEvicted = false;
+    aState->IsOffscreen = false;
+    aState->LastVisible = aTime;
+  }
+  myEvicted.Clear();
+}
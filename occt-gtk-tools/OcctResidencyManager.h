@@ -0,0 +1,162 @@
+// Copyright (c) 2026 Kirill Gavrilov
+
+#ifndef _OcctResidencyManager_HeaderFile
+#define _OcctResidencyManager_HeaderFile
+
+#include <AIS_InteractiveContext.hxx>
+#include <Bnd_Box.hxx>
+#include <Graphic3d_CullingTool.hxx>
+#include <NCollection_IndexedDataMap.hxx>
+#include <NCollection_IndexedMap.hxx>
+#include <OSD_Timer.hxx>
+#include <TColStd_ListOfInteger.hxx>
+#include <V3d_View.hxx>
+
+class OcctSceneBoundsIndex;
+
+//! GPU memory residency manager keeping VBOs and textures of presentations under configurable budget.
+//!
+//! When estimated GPU memory of presentations exceeds the budget (or OpenGL driver reports too little free video memory),
+//! the manager releases presentations of least-recently-visible objects among eviction candidates:
+//! - objects erased (hidden) from the context;
+//! - displayed objects staying outside of the view frustum longer than OffscreenTimeout().
+//!
+//! Evicted off-screen objects are erased with presentations cleared (releasing GPU buffers),
+//! and displayed back (recomputing and re-uploading presentation, re-activating all remembered selection modes)
+//! as soon as their remembered bounding box enters the view frustum again; the box follows transformation changes
+//! of evicted object. Evicted hidden objects are recomputed by context on the next Display() call.
+//!
+//! To keep per-frame cost independent from scene size, resident objects are visited in slices of NbObjectsPerFrame()
+//! objects per Update() (re-measuring GPU memory of recomputed presentations and visibility), the list of context objects is refreshed
+//! once per RescanInterval(), and only evicted objects are tested every frame to be restored without delay.
+//!
+//! Objects with transformation persistence or within non-default Z-layers are never evicted.
+class OcctResidencyManager
+{
+public:
+
+  //! Empty constructor.
+  OcctResidencyManager();
+
+  //! Return TRUE if manager is enabled (budget or minimal free memory are defined).
+  bool IsEnabled() const { return myBudget != 0 || myMinFreeMemory != 0; }
+
+  //! Return GPU memory budget in bytes; 0 (default) means no budget.
+  Standard_Size Budget() const { return myBudget; }
+
+  //! Set GPU memory budget in bytes.
+  void SetBudget(Standard_Size theBytes) { myBudget = theBytes; }
+
+  //! Return minimal free video memory in bytes reported by OpenGL driver to keep; 0 (default) means no limit.
+  //! Requires GL_NVX_gpu_memory_info or GL_ATI_meminfo extensions, ignored otherwise.
+  Standard_Size MinFreeMemory() const { return myMinFreeMemory; }
+
+  //! Set minimal free video memory to keep.
+  void SetMinFreeMemory(Standard_Size theBytes) { myMinFreeMemory = theBytes; }
+
+  //! Return time in seconds after which object outside of view frustum becomes eviction candidate (5 seconds by default).
+  double OffscreenTimeout() const { return myOffscreenTimeout; }
+
+  //! Set off-screen timeout.
+  void SetOffscreenTimeout(double theSeconds) { myOffscreenTimeout = theSeconds; }
+
+  //! Return number of resident objects visited by single Update() (2000 by default).
+  int NbObjectsPerFrame() const { return myNbPerFrame; }
+
+  //! Set number of resident objects visited by single Update().
+  void SetNbObjectsPerFrame(int theNbObjects) { myNbPerFrame = theNbObjects; }
+
+  //! Return interval in seconds for refreshing the list of context objects (1 second by default).
+  double RescanInterval() const { return myRescanInterval; }
+
+  //! Set interval for refreshing the list of context objects.
+  void SetRescanInterval(double theSeconds) { myRescanInterval = theSeconds; }
+
+  //! Return estimated GPU memory of resident presentations measured by visited objects.
+  Standard_Size ResidentBytes() const { return myResidentBytes; }
+
+  //! Set bounds index to be updated on evicting and restoring objects (NULL by default).
+  void SetBoundsIndex(OcctSceneBoundsIndex* theIndex) { myBoundsIndex = theIndex; }
+
+  //! Return number of currently evicted objects.
+  int NbEvicted() const { return myEvicted.Extent(); }
+
+  //! Return bounding box of off-screen evicted objects (not displayed thus ignored by V3d_View::FitAll()).
+  Bnd_Box EvictedBoundingBox() const;
+
+  //! Update residency of context objects; should be called before redrawing the view with bound OpenGL context.
+  //! @return TRUE if some objects have been evicted or restored
+  bool Update(const Handle(AIS_InteractiveContext)& theCtx,
+              const Handle(V3d_View)& theView);
+
+  //! Display back all off-screen evicted objects.
+  void RestoreAll(const Handle(AIS_InteractiveContext)& theCtx);
+
+protected:
+
+  //! Residency state of an object.
+  struct ObjectState
+  {
+    Bnd_Box                Box;                  //!< last known bounding box
+    Handle(TopLoc_Datum3D) Trsf;                 //!< object transformation corresponding to the box
+    TColStd_ListOfInteger  SelModes;             //!< selection modes to restore
+    double                 LastVisible = 0.0;    //!< last time object has been within view frustum
+    Standard_Size          GpuBytes    = 0;      //!< estimated GPU memory of resident presentation
+    int                    DispMode    = 0;      //!< display mode to restore
+    bool                   IsEvicted   = false;  //!< presentation has been released
+    bool                   IsOffscreen = false;  //!< object has been erased by manager (not by application)
+  };
+
+  //! Synchronize the list of objects with context: register new objects and drop removed ones.
+  void rescan(const Handle(AIS_InteractiveContext)& theCtx, double theTime);
+
+  //! Measure GPU memory and visibility of resident object.
+  void visit(const Handle(AIS_InteractiveContext)& theCtx,
+             const Handle(AIS_InteractiveObject)& theObj,
+             ObjectState& theState,
+             const Graphic3d_CullingTool& theCuller,
+             const Graphic3d_CullingTool::CullingContext& theCullCtx,
+             double theTime);
+
+  //! Move remembered box of evicted object to the current object transformation.
+  static void updateEvictedBox(const Handle(AIS_InteractiveObject)& theObj,
+                               ObjectState& theState);
+
+  //! Release presentations of the object.
+  void evict(const Handle(AIS_InteractiveContext)& theCtx,
+             const Handle(AIS_InteractiveObject)& theObj,
+             ObjectState& theState);
+
+  //! Display back evicted object with remembered display and selection modes.
+  void restore(const Handle(AIS_InteractiveContext)& theCtx,
+               const Handle(AIS_InteractiveObject)& theObj,
+               ObjectState& theState,
+               double theTime);
+
+  //! Evict least-recently visible candidates to free specified amount of memory.
+  //! @return freed memory
+  Standard_Size evictCandidates(const Handle(AIS_InteractiveContext)& theCtx,
+                                const Graphic3d_CullingTool& theCuller,
+                                const Graphic3d_CullingTool::CullingContext& theCullCtx,
+                                double theTime,
+                                Standard_Size theBytesToFree);
+
+private:
+
+  NCollection_IndexedDataMap<Handle(AIS_InteractiveObject), ObjectState> myStates;
+  NCollection_IndexedMap<Handle(AIS_InteractiveObject)> myEvicted; //!< evicted objects tested every frame
+  OcctSceneBoundsIndex* myBoundsIndex = NULL; //!< optional bounds index of displayed objects
+  OSD_Timer     myTimer;
+  Standard_Size myBudget           = 0;
+  Standard_Size myMinFreeMemory    = 0;
+  Standard_Size myResidentBytes    = 0;
+  double        myOffscreenTimeout = 5.0;
+  double        myRescanInterval   = 1.0;
+  double        myLastRescan       = -1.0;
+  double        myNextEvictTime    = 0.0;  //!< time of the next candidates scan after scan failed to free enough memory
+  int           myNbPerFrame       = 2000;
+  int           myNextIndex        = 1;    //!< index of the next object to visit
+
+};
+
+#endif // _OcctResidencyManager_HeaderFile
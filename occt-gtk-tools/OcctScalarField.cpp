@@ -0,0 +1,371 @@
+// Copyright (c) 2026 Kirill Gavrilov
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+#include "OcctScalarField.h"
+
+#include "OcctGlTools.h"
+#include "OcctMeshTools.h"
+
+#include <Graphic3d_ShaderAttribute.hxx>
+#include <Graphic3d_ShaderObject.hxx>
+#include <Graphic3d_TextureParams.hxx>
+#include <Graphic3d_TextureSet.hxx>
+#include <Image_PixMap.hxx>
+#include <Message.hxx>
+#include <OpenGl_Context.hxx>
+#include <OSD_Timer.hxx>
+#include <Prs3d_Presentation.hxx>
+#include <Select3D_SensitiveTriangulation.hxx>
+#include <SelectMgr_EntityOwner.hxx>
+#include <SelectMgr_Selection.hxx>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace
+{
+  //! Vertex shader passing normalized scalar value to fragment shader.
+  static const char THE_FIELD_VERT_SHADER[] =
+    "THE_ATTRIBUTE float scalarValue;\n"
+    "THE_SHADER_OUT vec3  Normal;\n"
+    "THE_SHADER_OUT vec4  PositionWorld;\n"
+    "THE_SHADER_OUT float ScalarCoord;\n"
+    "void main()\n"
+    "{\n"
+    "  PositionWorld = occModelWorldMatrix * occVertex;\n"
+    "  Normal = (occWorldViewMatrix * occModelWorldMatrix * vec4 (occNormal.xyz, 0.0)).xyz;\n"
+    "  ScalarCoord = scalarValue;\n"
+    "  gl_Position = occProjectionMatrix * occWorldViewMatrix * PositionWorld;\n"
+    "}\n";
+
+  //! Fragment shader looking up color map by interpolated scalar value, with headlight shading;
+  //! clipping planes are applied in the same way as by built-in programs.
+  static const char THE_FIELD_FRAG_SHADER[] =
+    "THE_SHADER_IN vec3  Normal;\n"
+    "THE_SHADER_IN vec4  PositionWorld;\n"
+    "THE_SHADER_IN float ScalarCoord;\n"
+    "void main()\n"
+    "{\n"
+    "#if defined(THE_MAX_CLIP_PLANES) && (THE_MAX_CLIP_PLANES > 0)\n"
+    "  for (int aPlaneIter = 0; aPlaneIter < occClipPlaneCount;)\n"
+    "  {\n"
+    "    vec4 anEquation = occClipPlaneEquations[aPlaneIter];\n"
+    "    if (dot (anEquation.xyz, PositionWorld.xyz / PositionWorld.w) + anEquation.w < 0.0)\n"
+    "    {\n"
+    "      if (occClipPlaneChains[aPlaneIter] == 1)\n"
+    "      {\n"
+    "        discard;\n"
+    "      }\n"
+    "      aPlaneIter += 1;\n"
+    "    }\n"
+    "    else\n"
+    "    {\n"
+    "      aPlaneIter += occClipPlaneChains[aPlaneIter];\n"
+    "    }\n"
+    "  }\n"
+    "#endif\n"
+    "  vec3 aNorm = normalize (gl_FrontFacing ? Normal : -Normal);\n"
+    "  vec4 aColor = occTexture2D (occSampler0, vec2 (ScalarCoord, 0.5));\n"
+    "  float aLight = 0.3 + 0.7 * max (aNorm.z, 0.0);\n"
+    "  occSetFragColor (vec4 (aColor.rgb * aLight, 1.0));\n"
+    "}\n";
+
+  //! Synthetic time step of results on the surface.
+  static void fillWaveField(std::vector<float>& theValues,
+                            const Handle(Poly_Triangulation)& theTris,
+                            double theTime)
+  {
+    for (int aNodeIter = 1; aNodeIter <= theTris->NbNodes(); ++aNodeIter)
+    {
+      const gp_Pnt aPnt = theTris->Node(aNodeIter);
+      theValues[aNodeIter - 1] = float(std::sin(aPnt.X() * 0.02 + theTime) * std::cos(aPnt.Y() * 0.03 - 0.5 * theTime));
+    }
+  }
+}
+
+// ================================================================
+// Function : CreateColorMap
+// ================================================================
+Handle(Graphic3d_Texture2D) OcctScalarField::CreateColorMap(int theNbColors)
+{
+  const int aNbColors = std::max(theNbColors, 2);
+  Handle(Image_PixMap) anImage = new Image_PixMap();
+  if (!anImage->InitZero(Image_Format_RGB, aNbColors, 1))
+    return Handle(Graphic3d_Texture2D)();
+
+  // piecewise linear rainbow through 5 key colors
+  static const float THE_KEYS[5][3] =
+  {
+    { 0.0f, 0.0f, 1.0f }, { 0.0f, 1.0f, 1.0f }, { 0.0f, 1.0f, 0.0f }, { 1.0f, 1.0f, 0.0f }, { 1.0f, 0.0f, 0.0f }
+  };
+  for (int aColorIter = 0; aColorIter < aNbColors; ++aColorIter)
+  {
+    const float aPos = 4.0f * float(aColorIter) / float(aNbColors - 1);
+    const int   aKey = std::min((int )aPos, 3);
+    const float aFrac = aPos - float(aKey);
+    Image_ColorRGB& aColor = anImage->ChangeValue<Image_ColorRGB>(0, aColorIter);
+    aColor.r() = Standard_Byte(255.0f * (THE_KEYS[aKey][0] + (THE_KEYS[aKey + 1][0] - THE_KEYS[aKey][0]) * aFrac) + 0.5f);
+    aColor.g() = Standard_Byte(255.0f * (THE_KEYS[aKey][1] + (THE_KEYS[aKey + 1][1] - THE_KEYS[aKey][1]) * aFrac) + 0.5f);
+    aColor.b() = Standard_Byte(255.0f * (THE_KEYS[aKey][2] + (THE_KEYS[aKey + 1][2] - THE_KEYS[aKey][2]) * aFrac) + 0.5f);
+  }
+
+  Handle(Graphic3d_Texture2D) aTexture = new Graphic3d_Texture2D(anImage);
+  aTexture->GetParams()->SetRepeat(false);
+  aTexture->GetParams()->SetFilter(Graphic3d_TOTF_BILINEAR);
+  aTexture->GetParams()->SetModulate(false);
+  return aTexture;
+}
+
+// ================================================================
+// Function : OcctScalarField
+// ================================================================
+OcctScalarField::OcctScalarField(const Handle(Poly_Triangulation)& theTris)
+: myTris(theTris),
+  myValues(!theTris.IsNull() ? theTris->NbNodes() : 0, 0.0f)
+{
+  Graphic3d_ShaderAttributeList anAttribs;
+  anAttribs.Append(new Graphic3d_ShaderAttribute("scalarValue", Graphic3d_TOA_CUSTOM));
+  myProgram = new Graphic3d_ShaderProgram();
+  myProgram->SetVertexAttributes(anAttribs);
+  myProgram->SetNbClipPlanesMax(Graphic3d_ShaderProgram::THE_MAX_CLIP_PLANES_DEFAULT);
+  myProgram->AttachShader(Graphic3d_ShaderObject::CreateFromSource(Graphic3d_TOS_VERTEX,   THE_FIELD_VERT_SHADER));
+  myProgram->AttachShader(Graphic3d_ShaderObject::CreateFromSource(Graphic3d_TOS_FRAGMENT, THE_FIELD_FRAG_SHADER));
+
+  myColorMap = CreateColorMap();
+  myAspect = new Graphic3d_Aspects();
+  myAspect->SetInteriorStyle(Aspect_IS_SOLID);
+  myAspect->SetShaderProgram(myProgram);
+  myAspect->SetTextureSet(new Graphic3d_TextureSet(myColorMap));
+  myAspect->SetTextureMapOn(true);
+  SetDisplayMode(0);
+  SetInfiniteState(false);
+}
+
+// ================================================================
+// Function : SetValues
+// ================================================================
+bool OcctScalarField::SetValues(const std::vector<float>& theValues)
+{
+  if (theValues.size() != myValues.size())
+  {
+    Message::SendFail() << "Error: " << (int )theValues.size() << " scalar values for " << (int )myValues.size() << " nodes";
+    return false;
+  }
+
+  myValues = theValues;
+  updateScalarAttribute();
+  return true;
+}
+
+// ================================================================
+// Function : SetRange
+// ================================================================
+void OcctScalarField::SetRange(float theMin, float theMax)
+{
+  myRangeMin = theMin;
+  myRangeMax = theMax;
+  updateScalarAttribute();
+}
+
+// ================================================================
+// Function : FitRange
+// ================================================================
+void OcctScalarField::FitRange()
+{
+  if (myValues.empty())
+    return;
+
+  const std::pair<std::vector<float>::const_iterator, std::vector<float>::const_iterator> aMinMax =
+    std::minmax_element(myValues.begin(), myValues.end());
+  SetRange(*aMinMax.first, *aMinMax.second);
+}
+
+// ================================================================
+// Function : SetColorMap
+// ================================================================
+void OcctScalarField::SetColorMap(const Handle(Graphic3d_Texture2D)& theTexture)
+{
+  myColorMap = theTexture;
+  myAspect->SetTextureSet(new Graphic3d_TextureSet(myColorMap));
+  SynchronizeAspects();
+}
+
+// ================================================================
+// Function : updateScalarAttribute
+// ================================================================
+void OcctScalarField::updateScalarAttribute()
+{
+  if (myAttribs.IsNull())
+    return;
+
+  int anAttribIndex = 0;
+  Standard_Size aStride = 0;
+  float* aCoords = reinterpret_cast<float*>(myAttribs->ChangeAttributeData(Graphic3d_TOA_CUSTOM, anAttribIndex, aStride));
+  if (aCoords == nullptr)
+    return;
+
+  // non-interleaved layout keeps values of the attribute within a single contiguous range
+  const float aScale = myRangeMax > myRangeMin ? 1.0f / (myRangeMax - myRangeMin) : 0.0f;
+  const int aNbValues = std::min(myAttribs->NbElements, (int )myValues.size());
+  for (int aValueIter = 0; aValueIter < aNbValues; ++aValueIter)
+  {
+    aCoords[aValueIter] = std::min(std::max((myValues[aValueIter] - myRangeMin) * aScale, 0.0f), 1.0f);
+  }
+  myAttribs->Invalidate(anAttribIndex);
+}
+
+// ================================================================
+// Function : Compute
+// ================================================================
+void OcctScalarField::Compute(const Handle(PrsMgr_PresentationManager)& ,
+                              const Handle(Prs3d_Presentation)& thePrs,
+                              const int theMode)
+{
+  myAttribs.Nullify();
+  if (theMode != 0
+   || myTris.IsNull()
+   || myTris->NbTriangles() < 1)
+  {
+    return;
+  }
+
+  static const Graphic3d_Attribute THE_ATTRIBS[3] =
+  {
+    { Graphic3d_TOA_POS,    Graphic3d_TOD_VEC3 },
+    { Graphic3d_TOA_NORM,   Graphic3d_TOD_VEC3 },
+    { Graphic3d_TOA_CUSTOM, Graphic3d_TOD_FLOAT }
+  };
+
+  const int aNbNodes = myTris->NbNodes();
+  const int aNbTris  = myTris->NbTriangles();
+  Handle(Graphic3d_AttribBuffer) anAttribs = new Graphic3d_AttribBuffer(NCollection_BaseAllocator::CommonBaseAllocator());
+  Handle(Graphic3d_IndexBuffer) anIndices = new Graphic3d_IndexBuffer(NCollection_BaseAllocator::CommonBaseAllocator());
+  anAttribs->SetInterleaved(false);
+  anAttribs->SetMutable(true);
+  if (!anAttribs->Init(aNbNodes, THE_ATTRIBS, 3)
+   || !anIndices->Init<unsigned int>(aNbTris * 3))
+  {
+    Message::SendFail() << "Error: unable to allocate scalar field arrays";
+    return;
+  }
+
+  int anAttribIndex = 0;
+  Standard_Size aStride = 0;
+  Graphic3d_Vec3* aPositions = reinterpret_cast<Graphic3d_Vec3*>(anAttribs->ChangeAttributeData(Graphic3d_TOA_POS,  anAttribIndex, aStride));
+  Graphic3d_Vec3* aNormals   = reinterpret_cast<Graphic3d_Vec3*>(anAttribs->ChangeAttributeData(Graphic3d_TOA_NORM, anAttribIndex, aStride));
+  Graphic3d_Vec3 aMin(FLT_MAX), aMax(-FLT_MAX);
+  for (int aNodeIter = 0; aNodeIter < aNbNodes; ++aNodeIter)
+  {
+    const gp_Pnt aPnt = myTris->Node(aNodeIter + 1);
+    aPositions[aNodeIter] = Graphic3d_Vec3(float(aPnt.X()), float(aPnt.Y()), float(aPnt.Z()));
+    aNormals[aNodeIter] = Graphic3d_Vec3(0.0f);
+    aMin = aMin.cwiseMin(aPositions[aNodeIter]);
+    aMax = aMax.cwiseMax(aPositions[aNodeIter]);
+  }
+
+  // smooth normals weighted by triangle area
+  for (int aTriIter = 1; aTriIter <= aNbTris; ++aTriIter)
+  {
+    int aNodes[3] = { 0, 0, 0 };
+    myTris->Triangle(aTriIter).Get(aNodes[0], aNodes[1], aNodes[2]);
+    const Graphic3d_Vec3 aNorm = Graphic3d_Vec3::Cross(aPositions[aNodes[1] - 1] - aPositions[aNodes[0] - 1],
+                                                       aPositions[aNodes[2] - 1] - aPositions[aNodes[0] - 1]);
+    for (int aNodeIter = 0; aNodeIter < 3; ++aNodeIter)
+    {
+      aNormals[aNodes[aNodeIter] - 1] += aNorm;
+      anIndices->SetIndex((aTriIter - 1) * 3 + aNodeIter, aNodes[aNodeIter] - 1);
+    }
+  }
+  for (int aNodeIter = 0; aNodeIter < aNbNodes; ++aNodeIter)
+  {
+    const float aLen = aNormals[aNodeIter].Modulus();
+    aNormals[aNodeIter] = aLen > 0.0f ? aNormals[aNodeIter] / aLen : Graphic3d_Vec3(0.0f, 0.0f, 1.0f);
+  }
+
+  myAttribs = anAttribs;
+  updateScalarAttribute();
+
+  // buffer is kept in CPU memory (mutable), so that later updates upload only invalidated range
+  Handle(Graphic3d_Group) aGroup = thePrs->NewGroup();
+  aGroup->SetGroupPrimitivesAspect(myAspect);
+  aGroup->AddPrimitiveArray(Graphic3d_TOPA_TRIANGLES, anIndices, anAttribs, Handle(Graphic3d_BoundBuffer)(), false);
+  aGroup->SetMinMaxValues(aMin.x(), aMin.y(), aMin.z(), aMax.x(), aMax.y(), aMax.z());
+}
+
+// ================================================================
+// Function : ComputeSelection
+// ================================================================
+void OcctScalarField::ComputeSelection(const Handle(SelectMgr_Selection)& theSel,
+                                       const int theMode)
+{
+  if (theMode != 0
+   || myTris.IsNull())
+  {
+    return;
+  }
+
+  Handle(SelectMgr_EntityOwner) anOwner = new SelectMgr_EntityOwner(this);
+  theSel->Add(new Select3D_SensitiveTriangulation(anOwner, myTris, TopLoc_Location(), true));
+}
+
+// ================================================================
+// Function : Benchmark
+// ================================================================
+void OcctScalarField::Benchmark(const Handle(AIS_InteractiveContext)& theCtx,
+                                const Handle(V3d_View)& theView,
+                                int theNbTriangles)
+{
+  const int aNbTriangles = theNbTriangles > 0 ? theNbTriangles : 1000000;
+  const int aNbSteps = 100;
+  Handle(OpenGl_Context) aGlCtx = OcctGlTools::GetGlContext(theView);
+
+  // wavy surface tessellated by regular grid
+  Handle(Poly_Triangulation) aTris = OcctMeshTools::WavyGrid(OcctMeshTools::GridSize(aNbTriangles));
+
+  Handle(OcctScalarField) aField = new OcctScalarField(aTris);
+  aField->SetRange(-1.0f, 1.0f);
+  theCtx->Display(aField, 0, -1, false);
+  Handle(Graphic3d_Camera) aCamBack = new Graphic3d_Camera(theView->Camera());
+  theView->FitAll(0.01, false);
+  theView->Invalidate();
+  theView->Redraw();
+  aGlCtx->core11fwd->glFinish();
+
+  Message::SendInfo() << "OcctScalarField benchmark, " << aTris->NbTriangles() << " triangles, "
+                      << aTris->NbNodes() << " nodes, " << aNbSteps << " time steps";
+  static const char* THE_CONFIGS[] = { "Recomputed presentation", "Updated scalar attribute" };
+  std::vector<float> aValues(aTris->NbNodes());
+  for (int aConfIter = 0; aConfIter < 2; ++aConfIter)
+  {
+    OSD_Timer aTimer;
+    for (int aStepIter = 0; aStepIter < aNbSteps; ++aStepIter)
+    {
+      // values of the time step are expected to be provided by solver, so that generating them is not timed
+      fillWaveField(aValues, aTris, 0.1 * aStepIter);
+
+      aTimer.Start();
+      aField->SetValues(aValues);
+      if (aConfIter == 0)
+        theCtx->RecomputePrsOnly(aField, false);
+      theView->Invalidate();
+      theView->Redraw();
+      aGlCtx->core11fwd->glFinish();
+      aTimer.Stop();
+    }
+
+    const double aStepTime = aTimer.ElapsedTime() / aNbSteps;
+    const double anUploadMiB = double(aTris->NbNodes()) * (aConfIter == 0 ? 7 * sizeof(float) : sizeof(float)) / (1024.0 * 1024.0)
+                             + (aConfIter == 0 ? double(aTris->NbTriangles()) * 3 * sizeof(unsigned int) / (1024.0 * 1024.0) : 0.0);
+    Message::SendInfo() << "  " << THE_CONFIGS[aConfIter] << ": " << (aStepTime * 1000.0) << " ms/step ("
+                        << (aStepTime > 0.0 ? 1.0 / aStepTime : 0.0) << " steps per second), uploaded "
+                        << anUploadMiB << " MiB/step";
+  }
+
+  theView->Camera()->Copy(aCamBack);
+  theCtx->Remove(aField, false);
+  theView->Invalidate();
+}
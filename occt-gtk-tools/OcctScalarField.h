@@ -0,0 +1,109 @@
+// Copyright (c) 2026 Kirill Gavrilov
+
+#ifndef _OcctScalarField_HeaderFile
+#define _OcctScalarField_HeaderFile
+
+#include <AIS_InteractiveObject.hxx>
+#include <Graphic3d_AttribBuffer.hxx>
+#include <Graphic3d_IndexBuffer.hxx>
+#include <Graphic3d_ShaderProgram.hxx>
+#include <Graphic3d_Texture2D.hxx>
+#include <Poly_Triangulation.hxx>
+#include <V3d_View.hxx>
+
+#include <vector>
+
+//! Presentation of triangulated mesh colored by per-vertex scalar field (stress, temperature, deviation),
+//! intended for animating simulation results with many time steps.
+//!
+//! Positions, normals and scalar values are stored in a mutable non-interleaved Graphic3d_AttribBuffer,
+//! so that SetValues() rewrites only the block of scalar values and invalidates its range:
+//! OpenGL driver re-uploads this range by glBufferSubData() on the next redraw,
+//! while geometry and presentation are left untouched.
+//! Values are normalized within Range() on CPU, and color is looked up from color map texture
+//! by a custom GLSL program (with simplified headlight shading).
+class OcctScalarField : public AIS_InteractiveObject
+{
+  DEFINE_STANDARD_RTTI_INLINE(OcctScalarField, AIS_InteractiveObject)
+public:
+
+  //! Create color map texture (blue - cyan - green - yellow - red) of specified size.
+  static Handle(Graphic3d_Texture2D) CreateColorMap(int theNbColors = 256);
+
+  //! Benchmark animating scalar field on tessellated surface of theNbTriangles triangles (1000000 by default):
+  //! compares time steps recomputing presentation with time steps updating only the scalar attribute.
+  static void Benchmark(const Handle(AIS_InteractiveContext)& theCtx,
+                        const Handle(V3d_View)& theView,
+                        int theNbTriangles);
+
+public:
+
+  //! Main constructor.
+  //! @param[in] theTris triangulation (nodes are expected to be shared by adjacent triangles)
+  OcctScalarField(const Handle(Poly_Triangulation)& theTris);
+
+  //! Return triangulation.
+  const Handle(Poly_Triangulation)& Triangulation() const { return myTris; }
+
+  //! Return scalar values per node.
+  const std::vector<float>& Values() const { return myValues; }
+
+  //! Set scalar values per node (of the same size as number of triangulation nodes);
+  //! updates only scalar attribute of displayed presentation, the view should be redrawn afterwards.
+  //! @return FALSE if number of values doesn't match number of nodes
+  bool SetValues(const std::vector<float>& theValues);
+
+  //! Return range of values mapped to color map (0..1 by default).
+  void Range(float& theMin, float& theMax) const
+  {
+    theMin = myRangeMin;
+    theMax = myRangeMax;
+  }
+
+  //! Set range of values mapped to color map; values outside of range are clamped.
+  void SetRange(float theMin, float theMax);
+
+  //! Set range of values to the minimum and maximum of current values.
+  void FitRange();
+
+  //! Return color map texture.
+  const Handle(Graphic3d_Texture2D)& ColorMap() const { return myColorMap; }
+
+  //! Set color map texture (1D lookup along U axis); only aspect of displayed presentation is updated.
+  void SetColorMap(const Handle(Graphic3d_Texture2D)& theTexture);
+
+public:
+
+  //! Return TRUE for supported display modes (only 0 is supported).
+  virtual bool AcceptDisplayMode(const int theMode) const override { return theMode == 0; }
+
+protected:
+
+  //! Compute presentation - creates attribute buffer.
+  virtual void Compute(const Handle(PrsMgr_PresentationManager)& thePrsMgr,
+                       const Handle(Prs3d_Presentation)& thePrs,
+                       const int theMode) override;
+
+  //! Compute selection - whole triangulation, detected by triangle interiors.
+  virtual void ComputeSelection(const Handle(SelectMgr_Selection)& theSel,
+                                const int theMode) override;
+
+protected:
+
+  //! Write normalized values into scalar attribute of the buffer and invalidate its range.
+  void updateScalarAttribute();
+
+protected:
+
+  Handle(Poly_Triangulation)      myTris;
+  std::vector<float>              myValues;   //!< scalar values per node
+  float                           myRangeMin = 0.0f;
+  float                           myRangeMax = 1.0f;
+  Handle(Graphic3d_AttribBuffer)  myAttribs;  //!< mutable buffer of displayed presentation
+  Handle(Graphic3d_Aspects)       myAspect;   //!< aspect with color map and program
+  Handle(Graphic3d_Texture2D)     myColorMap; //!< color map texture
+  Handle(Graphic3d_ShaderProgram) myProgram;  //!< program looking up color map
+
+};
+
+#endif // _OcctScalarField_HeaderFile
@@ -0,0 +1,604 @@
+// Copyright (c) 2026 Kirill Gavrilov
+
+#include "OcctSceneBoundsIndex.h"
+
+#include <AIS_Shape.hxx>
+#include <BRepPrimAPI_MakeBox.hxx>
+#include <Graphic3d_CullingTool.hxx>
+#include <Message.hxx>
+#include <NCollection_Map.hxx>
+#include <OSD_Timer.hxx>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace
+{
+  //! Return surface area of the box.
+  static double boxArea(const Graphic3d_Vec3d& theMin,
+                        const Graphic3d_Vec3d& theMax)
+  {
+    const Graphic3d_Vec3d aSize = theMax - theMin;
+    return 2.0 * (aSize.x() * aSize.y() + aSize.y() * aSize.z() + aSize.z() * aSize.x());
+  }
+
+  //! Return TRUE if the first box is within the second one.
+  static bool isBoxInside(const Graphic3d_Vec3d& theMin,
+                          const Graphic3d_Vec3d& theMax,
+                          const Graphic3d_Vec3d& theOuterMin,
+                          const Graphic3d_Vec3d& theOuterMax)
+  {
+    return theMin.x() >= theOuterMin.x() && theMin.y() >= theOuterMin.y() && theMin.z() >= theOuterMin.z()
+        && theMax.x() <= theOuterMax.x() && theMax.y() <= theOuterMax.y() && theMax.z() <= theOuterMax.z();
+  }
+
+  //! Setup view frustum culling for the camera and view size.
+  //! @param[in] theMinSizePx objects smaller than this size in pixels are culled; 0 disables small-object culling
+  static void initCuller(Graphic3d_CullingTool& theCuller,
+                         Graphic3d_CullingTool::CullingContext& theCullCtx,
+                         const Handle(Graphic3d_Camera)& theCamera,
+                         const Handle(V3d_View)& theView,
+                         double theMinSizePx)
+  {
+    Graphic3d_Vec2i aWinSize;
+    theView->Window()->Size(aWinSize.x(), aWinSize.y());
+    theCuller.SetViewVolume(theCamera);
+    theCuller.SetViewportSize(aWinSize.x(), aWinSize.y(), 1.0);
+    theCuller.SetCullingDistance(theCullCtx, -1.0);
+    theCuller.SetCullingSize(theCullCtx, theMinSizePx > 0.0 ? theMinSizePx : -1.0);
+  }
+}
+
+// ================================================================
+// Function : OcctSceneBoundsIndex
+// ================================================================
+OcctSceneBoundsIndex::OcctSceneBoundsIndex()
+{
+  //
+}
+
+// ================================================================
+// Function : BoundingBox
+// ================================================================
+Bnd_Box OcctSceneBoundsIndex::BoundingBox() const
+{
+  Bnd_Box aBox;
+  if (myRoot != -1)
+  {
+    const Node& aRoot = myNodes[myRoot];
+    aBox.Update(aRoot.Min.x(), aRoot.Min.y(), aRoot.Min.z(),
+                aRoot.Max.x(), aRoot.Max.y(), aRoot.Max.z());
+  }
+  return aBox;
+}
+
+// ================================================================
+// Function : isIndexable
+// ================================================================
+bool OcctSceneBoundsIndex::isIndexable(const Handle(AIS_InteractiveObject)& theObj)
+{
+  return theObj->TransformPersistence().IsNull()
+     && !theObj->IsInfinite();
+}
+
+// ================================================================
+// Function : Update
+// ================================================================
+void OcctSceneBoundsIndex::Update(const Handle(AIS_InteractiveObject)& theObj)
+{
+  Bnd_Box aBox;
+  if (isIndexable(theObj))
+    theObj->BoundingBox(aBox);
+
+  if (aBox.IsVoid())
+  {
+    Remove(theObj);
+    return;
+  }
+
+  const gp_Pnt aCornerMin = aBox.CornerMin(), aCornerMax = aBox.CornerMax();
+  const Graphic3d_Vec3d aMin(aCornerMin.X(), aCornerMin.Y(), aCornerMin.Z());
+  const Graphic3d_Vec3d aMax(aCornerMax.X(), aCornerMax.Y(), aCornerMax.Z());
+  if (const int* aLeafPtr = myObjects.Seek(theObj))
+  {
+    const int aLeaf = *aLeafPtr;
+    if (myNodes[aLeaf].Min.IsEqual(aMin)
+     && myNodes[aLeaf].Max.IsEqual(aMax))
+    {
+      return;
+    }
+
+    // re-insert moved object to keep the tree tight
+    removeLeaf(aLeaf);
+    myNodes[aLeaf].Min = aMin;
+    myNodes[aLeaf].Max = aMax;
+    insertLeaf(aLeaf);
+    return;
+  }
+
+  const int aLeaf = allocateNode();
+  Node& aNode = myNodes[aLeaf];
+  aNode.Min = aMin;
+  aNode.Max = aMax;
+  aNode.Object = theObj;
+  myObjects.Bind(theObj, aLeaf);
+  insertLeaf(aLeaf);
+}
+
+// ================================================================
+// Function : Remove
+// ================================================================
+void OcctSceneBoundsIndex::Remove(const Handle(AIS_InteractiveObject)& theObj)
+{
+  const int* aLeafPtr = myObjects.Seek(theObj);
+  if (aLeafPtr == NULL)
+    return;
+
+  const int aLeaf = *aLeafPtr;
+  myObjects.UnBind(theObj);
+  removeLeaf(aLeaf);
+  releaseNode(aLeaf);
+}
+
+// ================================================================
+// Function : Clear
+// ================================================================
+void OcctSceneBoundsIndex::Clear()
+{
+  myNodes.clear();
+  myObjects.Clear();
+  myRoot = -1;
+  myFreeNode = -1;
+  myIsDirty = false;
+}
+
+// ================================================================
+// Function : Synchronize
+// ================================================================
+void OcctSceneBoundsIndex::Synchronize(const Handle(AIS_InteractiveContext)& theCtx)
+{
+  AIS_ListOfInteractive anObjects;
+  theCtx->DisplayedObjects(anObjects);
+  NCollection_Map<Handle(AIS_InteractiveObject)> aDisplayed(anObjects.Size());
+  for (AIS_ListOfInteractive::Iterator anObjIter(anObjects); anObjIter.More(); anObjIter.Next())
+  {
+    aDisplayed.Add(anObjIter.Value());
+    Update(anObjIter.Value());
+  }
+
+  std::vector<Handle(AIS_InteractiveObject)> anErased;
+  for (NCollection_DataMap<Handle(AIS_InteractiveObject), int>::Iterator anObjIter(myObjects); anObjIter.More(); anObjIter.Next())
+  {
+    if (!aDisplayed.Contains(anObjIter.Key()))
+      anErased.push_back(anObjIter.Key());
+  }
+  for (const Handle(AIS_InteractiveObject)& anObj : anErased)
+  {
+    Remove(anObj);
+  }
+  myIsDirty = false;
+}
+
+// ================================================================
+// Function : ZFit
+// ================================================================
+bool OcctSceneBoundsIndex::ZFit(const Handle(V3d_View)& theView) const
+{
+  if (myRoot == -1 || myIsDirty || theView->Window().IsNull())
+    return false;
+
+  // cull by side planes only - depth range of the culling camera covers the whole indexed scene
+  const Handle(Graphic3d_Camera)& aCam = theView->Camera();
+  const Bnd_Box aSceneBox = BoundingBox();
+  Handle(Graphic3d_Camera) aCullCam = new Graphic3d_Camera(aCam);
+  aCullCam->ZFitAll(1.0, aSceneBox, aSceneBox);
+
+  Graphic3d_CullingTool aCuller;
+  Graphic3d_CullingTool::CullingContext aCullCtx;
+  initCuller(aCuller, aCullCtx, aCullCam, theView, 0.0);
+
+  Graphic3d_Vec3d aVisMin(DBL_MAX, DBL_MAX, DBL_MAX), aVisMax(-DBL_MAX, -DBL_MAX, -DBL_MAX);
+  bool hasVisible = false;
+  std::vector<int> aStack;
+  aStack.reserve(64);
+  aStack.push_back(myRoot);
+  while (!aStack.empty())
+  {
+    const Node& aNode = myNodes[aStack.back()];
+    aStack.pop_back();
+    // subtrees within already visible box cannot extend it
+    if ((hasVisible && isBoxInside(aNode.Min, aNode.Max, aVisMin, aVisMax))
+     || aCuller.IsCulled(aCullCtx, aNode.Min, aNode.Max))
+    {
+      continue;
+    }
+
+    if (aNode.IsLeaf())
+    {
+      aVisMin = aVisMin.cwiseMin(aNode.Min);
+      aVisMax = aVisMax.cwiseMax(aNode.Max);
+      hasVisible = true;
+      continue;
+    }
+    aStack.push_back(aNode.Left);
+    aStack.push_back(aNode.Right);
+  }
+  if (!hasVisible)
+    return false;
+
+  Bnd_Box aMinMax;
+  aMinMax.Update(aVisMin.x(), aVisMin.y(), aVisMin.z(), aVisMax.x(), aVisMax.y(), aVisMax.z());
+
+  // objects with transformation persistence are drawn at focus distance
+  // with size in pixels, so that they are bounded by view dimensions
+  Bnd_Box aGraphicBox = aMinMax;
+  const gp_XYZ aViewDims = aCam->ViewDimensions();
+  const double aHalfSize = 0.5 * std::max(aViewDims.X(), aViewDims.Y());
+  const gp_Pnt aCenter = aCam->Center();
+  aGraphicBox.Update(aCenter.X() - aHalfSize, aCenter.Y() - aHalfSize, aCenter.Z() - aHalfSize,
+                     aCenter.X() + aHalfSize, aCenter.Y() + aHalfSize, aCenter.Z() + aHalfSize);
+  aCam->ZFitAll(theView->AutoZFitScaleFactor(), aMinMax, aGraphicBox);
+  return true;
+}
+
+// ================================================================
+// Function : Query
+// ================================================================
+int OcctSceneBoundsIndex::Query(const Handle(V3d_View)& theView,
+                                double theMinSizePx,
+                                NCollection_Vector<Handle(AIS_InteractiveObject)>& theObjects) const
+{
+  if (myRoot == -1 || theView->Window().IsNull())
+    return 0;
+
+  Graphic3d_CullingTool aCuller;
+  Graphic3d_CullingTool::CullingContext aCullCtx;
+  initCuller(aCuller, aCullCtx, theView->Camera(), theView, theMinSizePx);
+
+  int aNbAdded = 0;
+  std::vector<int> aStack;
+  aStack.reserve(64);
+  aStack.push_back(myRoot);
+  while (!aStack.empty())
+  {
+    const Node& aNode = myNodes[aStack.back()];
+    aStack.pop_back();
+    if (aCuller.IsCulled(aCullCtx, aNode.Min, aNode.Max))
+      continue;
+
+    if (aNode.IsLeaf())
+    {
+      theObjects.Append(aNode.Object);
+      ++aNbAdded;
+      continue;
+    }
+    aStack.push_back(aNode.Left);
+    aStack.push_back(aNode.Right);
+  }
+  return aNbAdded;
+}
+
+// ================================================================
+// Function : allocateNode
+// ================================================================
+int OcctSceneBoundsIndex::allocateNode()
+{
+  if (myFreeNode == -1)
+  {
+    myNodes.push_back(Node());
+    return (int )myNodes.size() - 1;
+  }
+
+  const int aNode = myFreeNode;
+  myFreeNode = myNodes[aNode].Parent;
+  myNodes[aNode] = Node();
+  return aNode;
+}
+
+// ================================================================
+// Function : releaseNode
+// ================================================================
+void OcctSceneBoundsIndex::releaseNode(int theNode)
+{
+  myNodes[theNode] = Node();
+  myNodes[theNode].Parent = myFreeNode;
+  myNodes[theNode].Height = -1;
+  myFreeNode = theNode;
+}
+
+// ================================================================
+// Function : insertLeaf
+// ================================================================
+void OcctSceneBoundsIndex::insertLeaf(int theLeaf)
+{
+  if (myRoot == -1)
+  {
+    myRoot = theLeaf;
+    myNodes[theLeaf].Parent = -1;
+    return;
+  }
+
+  // descend to the sibling minimizing surface area of new and enlarged inner nodes
+  const Graphic3d_Vec3d aLeafMin = myNodes[theLeaf].Min, aLeafMax = myNodes[theLeaf].Max;
+  int aSibling = myRoot;
+  while (!myNodes[aSibling].IsLeaf())
+  {
+    const Node& aNode = myNodes[aSibling];
+    const double anArea = boxArea(aNode.Min, aNode.Max);
+    const double aCombinedArea = boxArea(aNode.Min.cwiseMin(aLeafMin), aNode.Max.cwiseMax(aLeafMax));
+
+    // cost of new parent for this node and the leaf, and minimum cost of pushing the leaf further down
+    const double aCost = 2.0 * aCombinedArea;
+    const double anInheritCost = 2.0 * (aCombinedArea - anArea);
+    double aChildCosts[2] = { 0.0, 0.0 };
+    for (int aChildIter = 0; aChildIter < 2; ++aChildIter)
+    {
+      const Node& aChild = myNodes[aChildIter == 0 ? aNode.Left : aNode.Right];
+      const double aChildArea = boxArea(aChild.Min.cwiseMin(aLeafMin), aChild.Max.cwiseMax(aLeafMax));
+      aChildCosts[aChildIter] = aChild.IsLeaf()
+                              ? aChildArea + anInheritCost
+                              : aChildArea - boxArea(aChild.Min, aChild.Max) + anInheritCost;
+    }
+    if (aCost < aChildCosts[0]
+     && aCost < aChildCosts[1])
+    {
+      break;
+    }
+    aSibling = aChildCosts[0] < aChildCosts[1] ? aNode.Left : aNode.Right;
+  }
+
+  const int anOldParent = myNodes[aSibling].Parent;
+  const int aNewParent = allocateNode();
+  myNodes[aNewParent].Parent = anOldParent;
+  myNodes[aNewParent].Left   = aSibling;
+  myNodes[aNewParent].Right  = theLeaf;
+  myNodes[aSibling].Parent = aNewParent;
+  myNodes[theLeaf].Parent  = aNewParent;
+  if (anOldParent == -1)
+    myRoot = aNewParent;
+  else if (myNodes[anOldParent].Left == aSibling)
+    myNodes[anOldParent].Left = aNewParent;
+  else
+    myNodes[anOldParent].Right = aNewParent;
+
+  refitUpwards(aNewParent);
+}
+
+// ================================================================
+// Function : removeLeaf
+// ================================================================
+void OcctSceneBoundsIndex::removeLeaf(int theLeaf)
+{
+  if (theLeaf == myRoot)
+  {
+    myRoot = -1;
+    return;
+  }
+
+  // replace parent by sibling of the leaf
+  const int aParent = myNodes[theLeaf].Parent;
+  const int aGrandParent = myNodes[aParent].Parent;
+  const int aSibling = myNodes[aParent].Left == theLeaf ? myNodes[aParent].Right : myNodes[aParent].Left;
+  releaseNode(aParent);
+  myNodes[theLeaf].Parent = -1;
+  myNodes[aSibling].Parent = aGrandParent;
+  if (aGrandParent == -1)
+  {
+    myRoot = aSibling;
+    return;
+  }
+
+  if (myNodes[aGrandParent].Left == aParent)
+    myNodes[aGrandParent].Left = aSibling;
+  else
+    myNodes[aGrandParent].Right = aSibling;
+  refitUpwards(aGrandParent);
+}
+
+// ================================================================
+// Function : refitUpwards
+// ================================================================
+void OcctSceneBoundsIndex::refitUpwards(int theNode)
+{
+  for (int aNode = theNode; aNode != -1; aNode = myNodes[aNode].Parent)
+  {
+    aNode = balance(aNode);
+    refitNode(aNode);
+  }
+}
+
+// ================================================================
+// Function : refitNode
+// ================================================================
+void OcctSceneBoundsIndex::refitNode(int theNode)
+{
+  Node& aNode = myNodes[theNode];
+  const Node& aLeft  = myNodes[aNode.Left];
+  const Node& aRight = myNodes[aNode.Right];
+  aNode.Min = aLeft.Min.cwiseMin(aRight.Min);
+  aNode.Max = aLeft.Max.cwiseMax(aRight.Max);
+  aNode.Height = 1 + std::max(aLeft.Height, aRight.Height);
+}
+
+// ================================================================
+// Function : balance
+// ================================================================
+int OcctSceneBoundsIndex::balance(int theNode)
+{
+  const int anA = theNode;
+  if (myNodes[anA].IsLeaf()
+   || myNodes[anA].Height < 2)
+  {
+    return anA;
+  }
+
+  const int aB = myNodes[anA].Left;
+  const int aC = myNodes[anA].Right;
+  const int aBalance = myNodes[aC].Height - myNodes[aB].Height;
+  if (aBalance > -2 && aBalance < 2)
+    return anA;
+
+  // lift the higher child (aTop) to the place of A,
+  // A takes the lower grandchild, while the higher grandchild stays under aTop
+  const bool isRightUp = aBalance > 1;
+  const int aTop = isRightUp ? aC : aB;
+  const int aGrand1 = myNodes[aTop].Left, aGrand2 = myNodes[aTop].Right;
+  const int aParent = myNodes[anA].Parent;
+  myNodes[aTop].Left = anA;
+  myNodes[aTop].Parent = aParent;
+  myNodes[anA].Parent = aTop;
+  if (aParent == -1)
+    myRoot = aTop;
+  else if (myNodes[aParent].Left == anA)
+    myNodes[aParent].Left = aTop;
+  else
+    myNodes[aParent].Right = aTop;
+
+  const bool isFirstHigher = myNodes[aGrand1].Height > myNodes[aGrand2].Height;
+  const int aHigher = isFirstHigher ? aGrand1 : aGrand2;
+  const int aLower  = isFirstHigher ? aGrand2 : aGrand1;
+  myNodes[aTop].Right = aHigher;
+  if (isRightUp)
+    myNodes[anA].Right = aLower;
+  else
+    myNodes[anA].Left = aLower;
+  myNodes[aLower].Parent = anA;
+
+  refitNode(anA);
+  refitNode(aTop);
+  return aTop;
+}
+
+// ================================================================
+// Function : Benchmark
+// ================================================================
+void OcctSceneBoundsIndex::Benchmark(const Handle(AIS_InteractiveContext)& theCtx,
+                                     const Handle(V3d_View)& theView,
+                                     int theNbObjects)
+{
+  if (theView->Window().IsNull())
+    return;
+
+  const int aNbObjects = theNbObjects > 0 ? theNbObjects : 100000;
+  const int aNbMoved   = std::max(aNbObjects / 100, 1);
+  const int aNbFrames  = 100;
+  const double aMinSizePx = 4.0;
+
+  // 3D grid of boxes
+  const int aGridSize = std::max((int )std::ceil(std::cbrt(double(aNbObjects))), 1);
+  const TopoDS_Shape aBox = BRepPrimAPI_MakeBox(1.0, 1.0, 1.0).Shape();
+  std::vector<Handle(AIS_Shape)> anObjects(aNbObjects);
+  for (int anObjIter = 0; anObjIter < aNbObjects; ++anObjIter)
+  {
+    gp_Trsf aTrsf;
+    aTrsf.SetTranslation(gp_Vec(3.0 * (anObjIter % aGridSize),
+                                3.0 * ((anObjIter / aGridSize) % aGridSize),
+                                3.0 * (anObjIter / (aGridSize * aGridSize))));
+    anObjects[anObjIter] = new AIS_Shape(aBox);
+    anObjects[anObjIter]->SetLocalTransformation(aTrsf);
+    theCtx->Display(anObjects[anObjIter], AIS_Shaded, -1, false);
+  }
+  Handle(Graphic3d_Camera) aCamBack = new Graphic3d_Camera(theView->Camera());
+  theView->FitAll(0.01, false);
+
+  OcctSceneBoundsIndex anIndex;
+  OSD_Timer aTimer;
+  aTimer.Start();
+  anIndex.Synchronize(theCtx);
+  aTimer.Stop();
+  Message::SendInfo() << "OcctSceneBoundsIndex benchmark, " << anIndex.NbObjects() << " objects, "
+                      << aNbMoved << " moved per frame, " << aNbFrames << " frames of camera orbiting\n"
+                      << "  index build: " << (aTimer.ElapsedTime() * 1000.0) << " ms";
+
+  static const char* THE_CONFIGS[] = { "Walking all objects", "Bounds index" };
+  for (int aConfIter = 0; aConfIter < 2; ++aConfIter)
+  {
+    OSD_Timer aTimerUpdate, aTimerBounds, aTimerZFit, aTimerCull;
+    int64_t aNbVisible = 0;
+    for (int aFrameIter = 0; aFrameIter < aNbFrames; ++aFrameIter)
+    {
+      // move objects (up in the first pass, back in the second) and orbit camera
+      gp_Trsf aStep;
+      aStep.SetTranslation(gp_Vec(0.0, 0.0, aConfIter == 0 ? 1.0 : -1.0));
+      for (int aMoveIter = 0; aMoveIter < aNbMoved; ++aMoveIter)
+      {
+        const Handle(AIS_Shape)& anObj = anObjects[(aFrameIter * aNbMoved + aMoveIter) % aNbObjects];
+        anObj->SetLocalTransformation(aStep * anObj->LocalTransformation());
+      }
+
+      const Handle(Graphic3d_Camera)& aCam = theView->Camera();
+      gp_Trsf aRot;
+      aRot.SetRotation(gp_Ax1(aCam->Center(), aCam->Up()), 2.0 * M_PI / aNbFrames);
+      aCam->Transform(aRot);
+
+      if (aConfIter == 0)
+      {
+        aTimerBounds.Start();
+        const Bnd_Box aSceneBox = theView->View()->MinMaxValues();
+        aTimerBounds.Stop();
+        (void )aSceneBox;
+
+        aTimerZFit.Start();
+        theView->ZFitAll(theView->AutoZFitScaleFactor());
+        aTimerZFit.Stop();
+
+        aTimerCull.Start();
+        Graphic3d_CullingTool aCuller;
+        Graphic3d_CullingTool::CullingContext aCullCtx;
+        initCuller(aCuller, aCullCtx, aCam, theView, aMinSizePx);
+        AIS_ListOfInteractive aDisplayed;
+        theCtx->DisplayedObjects(aDisplayed);
+        for (AIS_ListOfInteractive::Iterator anObjIter(aDisplayed); anObjIter.More(); anObjIter.Next())
+        {
+          Bnd_Box anObjBox;
+          anObjIter.Value()->BoundingBox(anObjBox);
+          if (!anObjBox.IsVoid()
+           && !aCuller.IsCulled(aCullCtx,
+                                Graphic3d_Vec3d(anObjBox.CornerMin().X(), anObjBox.CornerMin().Y(), anObjBox.CornerMin().Z()),
+                                Graphic3d_Vec3d(anObjBox.CornerMax().X(), anObjBox.CornerMax().Y(), anObjBox.CornerMax().Z())))
+          {
+            ++aNbVisible;
+          }
+        }
+        aTimerCull.Stop();
+      }
+      else
+      {
+        aTimerUpdate.Start();
+        for (int aMoveIter = 0; aMoveIter < aNbMoved; ++aMoveIter)
+        {
+          anIndex.Update(anObjects[(aFrameIter * aNbMoved + aMoveIter) % aNbObjects]);
+        }
+        aTimerUpdate.Stop();
+
+        aTimerBounds.Start();
+        const Bnd_Box aSceneBox = anIndex.BoundingBox();
+        aTimerBounds.Stop();
+        (void )aSceneBox;
+
+        aTimerZFit.Start();
+        anIndex.ZFit(theView);
+        aTimerZFit.Stop();
+
+        aTimerCull.Start();
+        NCollection_Vector<Handle(AIS_InteractiveObject)> aVisible;
+        aNbVisible += anIndex.Query(theView, aMinSizePx, aVisible);
+        aTimerCull.Stop();
+      }
+    }
+
+    Message::SendInfo() << "  " << THE_CONFIGS[aConfIter] << " (ms/frame): update " << (aTimerUpdate.ElapsedTime() * 1000.0 / aNbFrames)
+                        << ", scene bounds " << (aTimerBounds.ElapsedTime() * 1000.0 / aNbFrames)
+                        << ", z-range " << (aTimerZFit.ElapsedTime() * 1000.0 / aNbFrames)
+                        << ", frustum and small-object culling " << (aTimerCull.ElapsedTime() * 1000.0 / aNbFrames)
+                        << " (" << (aNbVisible / aNbFrames) << " visible)";
+  }
+
+  theView->Camera()->Copy(aCamBack);
+  for (const Handle(AIS_Shape)& anObj : anObjects)
+  {
+    theCtx->Remove(anObj, false);
+  }
+  theView->Invalidate();
+}
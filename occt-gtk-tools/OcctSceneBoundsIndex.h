@@ -0,0 +1,149 @@
+// Copyright (c) 2026 Kirill Gavrilov
+
+#ifndef _OcctSceneBoundsIndex_HeaderFile
+#define _OcctSceneBoundsIndex_HeaderFile
+
+#include <AIS_InteractiveContext.hxx>
+#include <Bnd_Box.hxx>
+#include <Graphic3d_Vec.hxx>
+#include <NCollection_DataMap.hxx>
+#include <NCollection_Vector.hxx>
+#include <V3d_View.hxx>
+
+#include <vector>
+
+//! Hierarchical index of bounding boxes of displayed objects.
+//!
+//! The index is a dynamic AABB tree: an object is inserted next to the sibling minimizing growth of enclosing boxes,
+//! and the tree is kept balanced by rotations, so that displaying, erasing or moving a single object
+//! costs O(log N) instead of walking the whole scene.
+//! The index serves:
+//! - BoundingBox() of the whole scene for FitAll() without iterating objects;
+//! - ZFit() fitting camera depth range to objects within view frustum;
+//! - Query() collecting objects within view frustum and larger than specified size in pixels.
+//!
+//! Application should keep the index up-to-date by calling Update() on displaying or moving an object
+//! and Remove() on erasing it, or Synchronize() with displayed objects of the context after bulk changes.
+//! Tools changing displayed objects (OcctResidencyManager, OcctOnDemandAssembly, OcctBatchUpdate) update the index
+//! per object when it is passed to them by SetBoundsIndex(). Changes made elsewhere should be reported by MarkDirty():
+//! dirty index is not used by ZFit() until the next Synchronize(), so that viewer falls back to automatic z-fit.
+//! Objects with transformation persistence and infinite objects are not indexed.
+class OcctSceneBoundsIndex
+{
+public:
+
+  //! Benchmark on theNbObjects boxes with 1% of objects moved per frame: compares global passes
+  //! walking all objects (view bounds, z-range and culling) with the same passes served by the index.
+  static void Benchmark(const Handle(AIS_InteractiveContext)& theCtx,
+                        const Handle(V3d_View)& theView,
+                        int theNbObjects);
+
+public:
+
+  //! Empty constructor.
+  OcctSceneBoundsIndex();
+
+  //! Return TRUE if index should be used by the viewer for FitAll and z-range (FALSE by default).
+  bool IsEnabled() const { return myIsEnabled; }
+
+  //! Enable or disable the index.
+  void SetEnabled(bool theToEnable) { myIsEnabled = theToEnable; }
+
+  //! Return TRUE if the index may miss changes of displayed objects and should be synchronized.
+  bool IsDirty() const { return myIsDirty; }
+
+  //! Mark the index outdated after changes of displayed objects not reported by Update() and Remove().
+  void MarkDirty() { myIsDirty = true; }
+
+  //! Return number of indexed objects.
+  int NbObjects() const { return myObjects.Extent(); }
+
+  //! Return TRUE if object is indexed.
+  bool Contains(const Handle(AIS_InteractiveObject)& theObj) const { return myObjects.IsBound(theObj); }
+
+  //! Return bounding box of all indexed objects.
+  Bnd_Box BoundingBox() const;
+
+  //! Add object or update its bounding box after displaying or changing transformation.
+  //! Object should be displayed (have computed presentation); objects with empty bounding box are removed.
+  void Update(const Handle(AIS_InteractiveObject)& theObj);
+
+  //! Remove object after erasing it.
+  void Remove(const Handle(AIS_InteractiveObject)& theObj);
+
+  //! Remove all objects.
+  void Clear();
+
+  //! Reconcile the index with displayed objects of the context: adds new, updates moved and removes erased objects.
+  //! This walks all objects, so that it is intended for bulk changes only.
+  void Synchronize(const Handle(AIS_InteractiveContext)& theCtx);
+
+  //! Fit camera depth range to indexed objects within view frustum,
+  //! to be used instead of V3d_View automatic z-fit walking all objects.
+  //! Objects with transformation persistence (like view cube) are expected around the camera focus point.
+  //! @return FALSE if the index is dirty or no indexed objects are within view frustum
+  //!         and depth range has been left unchanged
+  bool ZFit(const Handle(V3d_View)& theView) const;
+
+  //! Collect indexed objects within view frustum.
+  //! @param[in]  theView      view defining frustum and viewport size
+  //! @param[in]  theMinSizePx objects smaller than this size in pixels are culled; 0 disables small-object culling
+  //! @param[out] theObjects   appended visible objects
+  //! @return number of appended objects
+  int Query(const Handle(V3d_View)& theView,
+            double theMinSizePx,
+            NCollection_Vector<Handle(AIS_InteractiveObject)>& theObjects) const;
+
+protected:
+
+  //! Tree node; leaves refer to objects.
+  struct Node
+  {
+    Graphic3d_Vec3d Min;
+    Graphic3d_Vec3d Max;
+    Handle(AIS_InteractiveObject) Object; //!< indexed object (NULL for inner nodes)
+    int Parent = -1; //!< parent node, or next free node for released ones
+    int Left   = -1; //!< left child (-1 for leaves)
+    int Right  = -1; //!< right child
+    int Height =  0; //!< height of subtree (0 for leaves, -1 for released nodes)
+
+    bool IsLeaf() const { return Left == -1; }
+  };
+
+  //! Allocate node from the pool.
+  int allocateNode();
+
+  //! Return node to the pool.
+  void releaseNode(int theNode);
+
+  //! Insert leaf into the tree.
+  void insertLeaf(int theLeaf);
+
+  //! Detach leaf from the tree (leaf node itself is not released).
+  void removeLeaf(int theLeaf);
+
+  //! Refit boxes and heights of ancestors starting from specified node, re-balancing the tree.
+  void refitUpwards(int theNode);
+
+  //! Rotate unbalanced subtree.
+  //! @return new root of the subtree
+  int balance(int theNode);
+
+  //! Update box and height of inner node from its children.
+  void refitNode(int theNode);
+
+  //! Return TRUE if object can be indexed.
+  static bool isIndexable(const Handle(AIS_InteractiveObject)& theObj);
+
+private:
+
+  std::vector<Node> myNodes;
+  NCollection_DataMap<Handle(AIS_InteractiveObject), int> myObjects; //!< map of objects to leaves
+  int  myRoot = -1;
+  int  myFreeNode = -1;
+  bool myIsEnabled = false;
+  bool myIsDirty = false; //!< index may miss changes of displayed objects
+
+};
+
+#endif // _OcctSceneBoundsIndex_HeaderFile
@@ -0,0 +1,291 @@
+// Copyright (c) 2026 Kirill Gavrilov
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+#include "OcctSectionPlane.h"
+
+#include "OcctGlTools.h"
+
+#include <Bnd_Box.hxx>
+#include <BRep_Tool.hxx>
+#include <BRepBuilderAPI_MakeFace.hxx>
+#include <BRepMesh_IncrementalMesh.hxx>
+#include <BRepPrimAPI_MakeSphere.hxx>
+#include <Graphic3d_SequenceOfHClipPlane.hxx>
+#include <Message.hxx>
+#include <OpenGl_Context.hxx>
+#include <OSD_Timer.hxx>
+#include <Poly_Triangulation.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopoDS.hxx>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// ================================================================
+// Function : OcctSectionPlane
+// ================================================================
+OcctSectionPlane::OcctSectionPlane()
+: myClipPlane(new Graphic3d_ClipPlane()),
+  myEquation(0.0, 0.0, 1.0, 0.0)
+{
+  // cut faces are filled with materials of clipped objects
+  myClipPlane->SetCapping(true);
+  myClipPlane->SetUseObjectMaterial(true);
+}
+
+// ================================================================
+// Function : Plane
+// ================================================================
+gp_Pln OcctSectionPlane::Plane() const
+{
+  gp_Pln aPlane(gp::XOY());
+  if (!myPlanePrs.IsNull())
+    aPlane.Transform(myPlanePrs->LocalTransformation());
+  return aPlane;
+}
+
+// ================================================================
+// Function : SetPlane
+// ================================================================
+void OcctSectionPlane::SetPlane(const gp_Pln& thePlane)
+{
+  if (myPlanePrs.IsNull())
+    return;
+
+  gp_Trsf aTrsf;
+  aTrsf.SetDisplacement(gp::XOY(), thePlane.Position());
+  myPlanePrs->SetLocalTransformation(aTrsf);
+  myManipulator->SetPosition(gp_Ax2(thePlane.Location(), thePlane.Axis().Direction(), thePlane.XAxis().Direction()));
+}
+
+// ================================================================
+// Function : Attach
+// ================================================================
+void OcctSectionPlane::Attach(const Handle(AIS_InteractiveContext)& theCtx,
+                              const Handle(V3d_View)& theView)
+{
+  if (myIsAttached)
+    return;
+
+  const Bnd_Box aSceneBox = theView->View()->MinMaxValues();
+  gp_Pnt aCenter(0.0, 0.0, 0.0);
+  double aHalfSize = 100.0;
+  if (!aSceneBox.IsVoid())
+  {
+    aCenter = (aSceneBox.CornerMin().XYZ() + aSceneBox.CornerMax().XYZ()) * 0.5;
+    aHalfSize = std::max(aSceneBox.CornerMin().Distance(aSceneBox.CornerMax()) * 0.6, 1.0e-3);
+  }
+
+  // normal along world axis closest to horizontal screen direction
+  const Handle(Graphic3d_Camera)& aCam = theView->Camera();
+  const gp_Dir aSide = aCam->Direction().Crossed(aCam->Up());
+  int anAxis = 1;
+  for (int aCoordIter = 2; aCoordIter <= 3; ++aCoordIter)
+  {
+    if (std::abs(aSide.Coord(aCoordIter)) > std::abs(aSide.Coord(anAxis)))
+      anAxis = aCoordIter;
+  }
+  gp_XYZ aNorm(0.0, 0.0, 0.0);
+  aNorm.SetCoord(anAxis, aSide.Coord(anAxis) > 0.0 ? 1.0 : -1.0);
+
+  // plane square and manipulator are not clipped by section plane
+  Handle(Graphic3d_SequenceOfHClipPlane) aNoClipping = new Graphic3d_SequenceOfHClipPlane();
+  aNoClipping->SetOverrideGlobal(true);
+
+  myPlanePrs = new AIS_Shape(BRepBuilderAPI_MakeFace(gp_Pln(gp::XOY()), -aHalfSize, aHalfSize, -aHalfSize, aHalfSize).Shape());
+  myPlanePrs->SetColor(Quantity_NOC_GRAY70);
+  myPlanePrs->SetTransparency(0.8);
+  myPlanePrs->SetClipPlanes(aNoClipping);
+  gp_Trsf aTrsf;
+  aTrsf.SetDisplacement(gp::XOY(), gp_Ax3(aCenter, gp_Dir(aNorm)));
+  myPlanePrs->SetLocalTransformation(aTrsf);
+  theCtx->Display(myPlanePrs, AIS_Shaded, -1, false);
+
+  // only translation along normal and rotation around in-plane axes are meaningful for the plane
+  myManipulator = new AIS_Manipulator();
+  myManipulator->SetPart(AIS_MM_Scaling, false);
+  myManipulator->SetPart(AIS_MM_TranslationPlane, false);
+  myManipulator->SetPart(0, AIS_MM_Translation, false);
+  myManipulator->SetPart(1, AIS_MM_Translation, false);
+  myManipulator->SetPart(2, AIS_MM_Rotation, false);
+  myManipulator->SetModeActivationOnDetection(true);
+  myManipulator->SetClipPlanes(aNoClipping);
+
+  AIS_Manipulator::OptionsForAttach anOptions;
+  anOptions.SetAdjustPosition(true);
+  anOptions.SetAdjustSize(true);
+  anOptions.SetEnableModes(true);
+  myManipulator->Attach(myPlanePrs, anOptions);
+
+  theView->AddClipPlane(myClipPlane);
+  myIsAttached = true;
+  Update();
+}
+
+// ================================================================
+// Function : Detach
+// ================================================================
+void OcctSectionPlane::Detach(const Handle(AIS_InteractiveContext)& theCtx,
+                              const Handle(V3d_View)& theView)
+{
+  if (!myIsAttached)
+    return;
+
+  theView->RemoveClipPlane(myClipPlane);
+  myManipulator->Detach();
+  theCtx->Remove(myManipulator, false);
+  theCtx->Remove(myPlanePrs, false);
+  myManipulator.Nullify();
+  myPlanePrs.Nullify();
+  myIsAttached = false;
+}
+
+// ================================================================
+// Function : Update
+// ================================================================
+bool OcctSectionPlane::Update()
+{
+  if (!myIsAttached)
+    return false;
+
+  const gp_Pln aPlane = Plane();
+  Graphic3d_Vec4d anEquation;
+  aPlane.Coefficients(anEquation.x(), anEquation.y(), anEquation.z(), anEquation.w());
+  if (anEquation == myEquation)
+    return false;
+
+  // only equation uniform is changed - neither presentations nor capping resources are recomputed
+  myEquation = anEquation;
+  myClipPlane->SetEquation(aPlane);
+  ++myNbUpdates;
+  return true;
+}
+
+// ================================================================
+// Function : Benchmark
+// ================================================================
+void OcctSectionPlane::Benchmark(const Handle(AIS_InteractiveContext)& theCtx,
+                                 const Handle(V3d_View)& theView,
+                                 int theNbObjects)
+{
+  const int aNbFrames = 200;
+  Handle(OpenGl_Context) aGlCtx = OcctGlTools::GetGlContext(theView);
+
+  // sweep currently displayed model unless explicit number of spheres is requested;
+  // view cube and other transform-persistent objects are not part of the model
+  int aNbModelObjects = 0;
+  if (theNbObjects <= 0)
+  {
+    AIS_ListOfInteractive aDisplayed;
+    theCtx->DisplayedObjects(aDisplayed);
+    for (const Handle(AIS_InteractiveObject)& anObj : aDisplayed)
+    {
+      if (anObj->TransformPersistence().IsNull())
+        ++aNbModelObjects;
+    }
+  }
+
+  const int aNbObjects = aNbModelObjects > 0 ? 0 : (theNbObjects > 0 ? theNbObjects : 2000);
+  Handle(Graphic3d_Camera) aCamBack = new Graphic3d_Camera(theView->Camera());
+
+  // 3D grid of finely tessellated spheres sharing the same triangulation
+  const TopoDS_Shape aSphere = aNbObjects > 0 ? BRepPrimAPI_MakeSphere(1.0).Shape() : TopoDS_Shape();
+  if (aNbObjects > 0)
+  {
+    BRepMesh_IncrementalMesh aMesher(aSphere, 0.002, false, 0.1);
+  }
+  int aNbSphereTris = 0;
+  for (TopExp_Explorer aFaceIter(aSphere, TopAbs_FACE); aFaceIter.More(); aFaceIter.Next())
+  {
+    TopLoc_Location aLoc;
+    const Handle(Poly_Triangulation)& aTris = BRep_Tool::Triangulation(TopoDS::Face(aFaceIter.Current()), aLoc);
+    if (!aTris.IsNull())
+      aNbSphereTris += aTris->NbTriangles();
+  }
+
+  const int aGridSize = std::max((int )std::ceil(std::cbrt(double(aNbObjects))), 1);
+  std::vector<Handle(AIS_Shape)> anObjects(aNbObjects);
+  for (int anObjIter = 0; anObjIter < aNbObjects; ++anObjIter)
+  {
+    gp_Trsf aTrsf;
+    aTrsf.SetTranslation(gp_Vec(3.0 * (anObjIter % aGridSize),
+                                3.0 * ((anObjIter / aGridSize) % aGridSize),
+                                3.0 * (anObjIter / (aGridSize * aGridSize))));
+    anObjects[anObjIter] = new AIS_Shape(aSphere);
+    anObjects[anObjIter]->SetLocalTransformation(aTrsf);
+    anObjects[anObjIter]->SetColor(Quantity_Color(float(anObjIter % aGridSize) / aGridSize, 0.5f, 0.8f, Quantity_TOC_RGB));
+    theCtx->Display(anObjects[anObjIter], AIS_Shaded, -1, false);
+  }
+
+  if (aNbObjects > 0)
+  {
+    // spheres are seen at an angle, while loaded model is swept from the current camera
+    theView->SetProj(V3d_XposYnegZpos, false);
+    theView->FitAll(0.01, false);
+  }
+  theView->Invalidate();
+  theView->Redraw();
+  aGlCtx->core11fwd->glFinish();
+
+  const Bnd_Box aSceneBox = theView->View()->MinMaxValues();
+  if (aSceneBox.IsVoid())
+  {
+    Message::SendFail() << "Error: OcctSectionPlane benchmark has nothing to cut";
+    theView->Camera()->Copy(aCamBack);
+    return;
+  }
+
+  const gp_Pnt aCenter = (aSceneBox.CornerMin().XYZ() + aSceneBox.CornerMax().XYZ()) * 0.5;
+  if (aNbObjects > 0)
+  {
+    Message::SendInfo() << "OcctSectionPlane benchmark, " << aNbObjects << " spheres, "
+                        << (int64_t(aNbSphereTris) * aNbObjects) << " triangles, "
+                        << aNbFrames << " frames of plane sweep";
+  }
+  else
+  {
+    Message::SendInfo() << "OcctSectionPlane benchmark, " << aNbModelObjects << " displayed objects, "
+                        << aNbFrames << " frames of plane sweep";
+  }
+
+  // plane square and manipulator are displayed and moved in all configurations,
+  // so that timings differ only by clipping and capping
+  static const char* THE_CONFIGS[] = { "No section", "Clipping", "Clipping with capping" };
+  Handle(OcctSectionPlane) aSection = new OcctSectionPlane();
+  aSection->Attach(theCtx, theView);
+  for (int aConfIter = 0; aConfIter < 3; ++aConfIter)
+  {
+    aSection->ClipPlane()->SetOn(aConfIter != 0);
+    aSection->SetCapping(aConfIter == 2);
+
+    OSD_Timer aTimer;
+    for (int aFrameIter = 0; aFrameIter < aNbFrames; ++aFrameIter)
+    {
+      const double aPos = aSceneBox.CornerMin().X()
+                        + (aSceneBox.CornerMax().X() - aSceneBox.CornerMin().X()) * (aFrameIter + 0.5) / aNbFrames;
+      aTimer.Start();
+      aSection->SetPlane(gp_Pln(gp_Pnt(aPos, aCenter.Y(), aCenter.Z()), gp::DX()));
+      aSection->Update();
+      theView->Invalidate();
+      theView->Redraw();
+      aGlCtx->core11fwd->glFinish();
+      aTimer.Stop();
+    }
+
+    const double aFrameTime = aTimer.ElapsedTime() / aNbFrames;
+    Message::SendInfo() << "  " << THE_CONFIGS[aConfIter] << ": " << (aFrameTime * 1000.0) << " ms/frame ("
+                        << (aFrameTime > 0.0 ? 1.0 / aFrameTime : 0.0) << " FPS)";
+  }
+
+  aSection->Detach(theCtx, theView);
+  theView->Camera()->Copy(aCamBack);
+  for (const Handle(AIS_Shape)& anObj : anObjects)
+  {
+    theCtx->Remove(anObj, false);
+  }
+  theView->Invalidate();
+}
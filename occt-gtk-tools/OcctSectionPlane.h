@@ -0,0 +1,94 @@
+// Copyright (c) 2026 Kirill Gavrilov
+
+#ifndef _OcctSectionPlane_HeaderFile
+#define _OcctSectionPlane_HeaderFile
+
+#include <AIS_InteractiveContext.hxx>
+#include <AIS_Manipulator.hxx>
+#include <AIS_Shape.hxx>
+#include <gp_Pln.hxx>
+#include <Graphic3d_ClipPlane.hxx>
+#include <V3d_View.hxx>
+
+//! Section plane cutting displayed objects with capping, dragged by AIS_Manipulator.
+//!
+//! Section is a single view-level Graphic3d_ClipPlane with capping enabled: objects are cut by OpenGL clipping,
+//! and cut faces are filled by stencil-based capping algorithm of OpenGl_View using materials of objects.
+//! Built-in OCCT programs apply view clipping planes; objects with custom shader programs are cut only
+//! when their program implements the same occClipPlaneEquations loop (OcctLodMesh compact chunks
+//! and OcctScalarField do), while objects overriding global clipping planes (like the plane square) are not cut.
+//! Capping fills cut faces correctly only for closed geometry, so that open meshes and point clouds are just clipped.
+//! Moving the plane modifies only plane equation, so that presentations of displayed objects are never recomputed.
+//! The plane is displayed as a translucent square (not affected by clipping) with manipulator allowing
+//! translation along normal and rotation around in-plane axes; Update() converts square transformation
+//! into plane equation and should be called before each redraw.
+//! Sensitive entities of displayed objects are not touched as well - view clipping is applied on picking,
+//! so that detection should be refreshed just once when dragging is finished.
+class OcctSectionPlane : public Standard_Transient
+{
+  DEFINE_STANDARD_RTTI_INLINE(OcctSectionPlane, Standard_Transient)
+public:
+
+  //! Benchmark sweeping plane across the currently displayed model (theNbObjects=0)
+  //! or across generated grid of theNbObjects spheres (2000 when nothing is displayed):
+  //! compares frame time with disabled clipping plane, with clipping only and with capping;
+  //! plane square and manipulator are swept in all cases.
+  static void Benchmark(const Handle(AIS_InteractiveContext)& theCtx,
+                        const Handle(V3d_View)& theView,
+                        int theNbObjects);
+
+public:
+
+  //! Empty constructor.
+  OcctSectionPlane();
+
+  //! Return clipping plane.
+  const Handle(Graphic3d_ClipPlane)& ClipPlane() const { return myClipPlane; }
+
+  //! Return manipulator attached to the plane square (NULL if plane is not attached).
+  const Handle(AIS_Manipulator)& Manipulator() const { return myManipulator; }
+
+  //! Return TRUE if cut faces are capped (TRUE by default).
+  bool IsCapping() const { return myClipPlane->IsCapping(); }
+
+  //! Enable or disable capping.
+  void SetCapping(bool theToEnable) { myClipPlane->SetCapping(theToEnable); }
+
+  //! Return TRUE if plane is attached to the view.
+  bool IsAttached() const { return myIsAttached; }
+
+  //! Return plane in world coordinates defined by transformation of the plane square.
+  gp_Pln Plane() const;
+
+  //! Move plane square and manipulator to specified plane; clipping plane is updated by Update().
+  void SetPlane(const gp_Pln& thePlane);
+
+  //! Add clipping plane to the view and display plane square with manipulator.
+  //! The plane is placed through the center of displayed objects with normal along world axis
+  //! closest to horizontal screen direction, so that cut faces are seen at an angle.
+  void Attach(const Handle(AIS_InteractiveContext)& theCtx,
+              const Handle(V3d_View)& theView);
+
+  //! Remove clipping plane from the view, plane square and manipulator.
+  void Detach(const Handle(AIS_InteractiveContext)& theCtx,
+              const Handle(V3d_View)& theView);
+
+  //! Update equation of clipping plane from transformation of the plane square.
+  //! @return TRUE if plane has been moved
+  bool Update();
+
+  //! Return number of plane equation updates.
+  int NbUpdates() const { return myNbUpdates; }
+
+protected:
+
+  Handle(Graphic3d_ClipPlane) myClipPlane;   //!< view-level clipping plane with capping
+  Handle(AIS_Shape)           myPlanePrs;    //!< translucent plane square moved by manipulator
+  Handle(AIS_Manipulator)     myManipulator; //!< manipulator attached to plane square
+  Graphic3d_Vec4d             myEquation;    //!< equation applied to clipping plane
+  int                         myNbUpdates = 0;
+  bool                        myIsAttached = false;
+
+};
+
+#endif // _OcctSectionPlane_HeaderFile
@@ -0,0 +1,202 @@
+// Copyright (c) 2026 Kirill Gavrilov
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+#include "OcctSoftwareProfile.h"
+
+#include "OcctGlTools.h"
+
+#include <AIS_Shape.hxx>
+#include <BRepPrimAPI_MakeSphere.hxx>
+#include <Message.hxx>
+#include <NCollection_Sequence.hxx>
+#include <OpenGl_Context.hxx>
+#include <OSD_Environment.hxx>
+#include <OSD_Parallel.hxx>
+#include <OSD_Timer.hxx>
+#include <Standard_Version.hxx>
+
+#if defined(__linux__)
+  #include <sched.h>
+#endif
+
+namespace
+{
+  //! Return number of processors available to this process;
+  //! OSD_Parallel::NbLogicalProcessors() counts all online processors ignoring CPU affinity mask.
+  static int nbAvailableProcessors()
+  {
+  #if defined(__linux__)
+    cpu_set_t aCpuSet;
+    CPU_ZERO(&aCpuSet);
+    if (sched_getaffinity(0, sizeof(aCpuSet), &aCpuSet) == 0)
+    {
+      const int aNbCpus = CPU_COUNT(&aCpuSet);
+      if (aNbCpus > 0)
+        return aNbCpus;
+    }
+  #endif
+    return OSD_Parallel::NbLogicalProcessors();
+  }
+}
+
+// ================================================================
+// Function : IsSoftwareRenderer
+// ================================================================
+bool OcctSoftwareProfile::IsSoftwareRenderer(const TCollection_AsciiString& theRenderer)
+{
+  TCollection_AsciiString aRenderer = theRenderer;
+  aRenderer.LowerCase();
+  static const char* THE_SOFT_RENDERERS[] =
+  {
+    "llvmpipe", "softpipe", "swrast", "software rasterizer", "swiftshader", "lavapipe",
+    "gdi generic", "microsoft basic render"
+  };
+  for (const char* aName : THE_SOFT_RENDERERS)
+  {
+    if (aRenderer.Search(aName) != -1)
+      return true;
+  }
+  return false;
+}
+
+// ================================================================
+// Function : GlRenderer
+// ================================================================
+TCollection_AsciiString OcctSoftwareProfile::GlRenderer(const Handle(V3d_View)& theView)
+{
+  Handle(OpenGl_Context) aGlCtx = OcctGlTools::GetGlContext(theView);
+  const char* aRenderer = !aGlCtx.IsNull() ? (const char* )aGlCtx->core11fwd->glGetString(GL_RENDERER) : NULL;
+  return aRenderer != NULL ? TCollection_AsciiString(aRenderer) : TCollection_AsciiString();
+}
+
+// ================================================================
+// Function : SetupMesaEnvironment
+// ================================================================
+void OcctSoftwareProfile::SetupMesaEnvironment(bool theToForce)
+{
+#if !defined(__APPLE__)
+  // llvmpipe counts all online processors, while process might be limited to a subset of them by CPU affinity
+  OSD_Environment aNbThreads("LP_NUM_THREADS");
+  if (aNbThreads.Value().IsEmpty())
+  {
+    aNbThreads.SetValue(TCollection_AsciiString(nbAvailableProcessors()));
+    aNbThreads.Build();
+    Message::SendTrace() << "OcctSoftwareProfile: LP_NUM_THREADS=" << aNbThreads.Value();
+  }
+
+  // offload OpenGL calls to a separate thread, so that rasterization overlaps with scene traversal;
+  // renderer is unknown before context creation, so that it is done only when software rendering is requested
+  const TCollection_AsciiString aSoftware = OSD_Environment("LIBGL_ALWAYS_SOFTWARE").Value();
+  const TCollection_AsciiString aGallium  = OSD_Environment("GALLIUM_DRIVER").Value();
+  const bool isSoftware = theToForce
+                      || (!aSoftware.IsEmpty() && aSoftware != "0")
+                      || aGallium == "llvmpipe"
+                      || aGallium == "softpipe";
+  OSD_Environment aGlThread("mesa_glthread");
+  if (isSoftware
+   && aGlThread.Value().IsEmpty())
+  {
+    aGlThread.SetValue("true");
+    aGlThread.Build();
+    Message::SendTrace() << "OcctSoftwareProfile: mesa_glthread=" << aGlThread.Value();
+  }
+#else
+  (void )theToForce;
+#endif
+}
+
+// ================================================================
+// Function : Apply
+// ================================================================
+void OcctSoftwareProfile::Apply(const Handle(V3d_View)& theView)
+{
+  Graphic3d_RenderingParams& aParams = theView->ChangeRenderingParams();
+  aParams.NbMsaaSamples        = 0;
+  aParams.ToEnableDepthPrepass = false;
+  aParams.TransparencyMethod   = Graphic3d_RTM_BLEND_UNORDERED;
+#if (OCC_VERSION_HEX >= 0x070600)
+  aParams.IsShadowEnabled      = false;
+#endif
+  theView->SetShadingModel(Graphic3d_TOSM_VERTEX);
+  theView->Invalidate();
+}
+
+// ================================================================
+// Function : Benchmark
+// ================================================================
+void OcctSoftwareProfile::Benchmark(const Handle(AIS_InteractiveContext)& theCtx,
+                                    const Handle(V3d_View)& theView,
+                                    int theNbFrames)
+{
+  const int aNbFrames = theNbFrames > 0 ? theNbFrames : 100;
+  Handle(OpenGl_Context) aGlCtx = OcctGlTools::GetGlContext(theView);
+
+  // test scene of finely tessellated spheres, some of them semitransparent
+  NCollection_Sequence<Handle(AIS_Shape)> aShapes;
+  for (int aRowIter = 0; aRowIter < 8; ++aRowIter)
+  {
+    for (int aColIter = 0; aColIter < 8; ++aColIter)
+    {
+      Handle(AIS_Shape) aShape = new AIS_Shape(BRepPrimAPI_MakeSphere(gp_Pnt(25.0 * aColIter, 25.0 * aRowIter, 0.0), 10.0).Shape());
+      aShape->Attributes()->SetDeviationCoefficient(0.0002);
+      if ((aRowIter + aColIter) % 4 == 0)
+        aShape->SetTransparency(0.5);
+
+      theCtx->Display(aShape, AIS_Shaded, -1, false);
+      aShapes.Append(aShape);
+    }
+  }
+
+  const Graphic3d_RenderingParams aParamsBack  = theView->RenderingParams();
+  const Graphic3d_TypeOfShadingModel aShadingBack = theView->ShadingModel();
+  Handle(Graphic3d_Camera) aCamBack = new Graphic3d_Camera(theView->Camera());
+  theView->FitAll(0.01, false);
+
+  Message::SendInfo() << "OcctSoftwareProfile benchmark, renderer '" << GlRenderer(theView) << "', "
+                      << aNbFrames << " frames of camera orbiting";
+  static const char* THE_CONFIGS[] = { "Default settings", "Software profile", "Software profile in motion (render scale 0.5)" };
+  for (int aConfIter = 0; aConfIter < 3; ++aConfIter)
+  {
+    theView->ChangeRenderingParams() = aParamsBack;
+    theView->SetShadingModel(aShadingBack);
+    if (aConfIter >= 1)
+      Apply(theView);
+    if (aConfIter == 2)
+      theView->ChangeRenderingParams().RenderResolutionScale = 0.5f;
+
+    // warm-up frame allocating offscreen buffers and compiling shaders
+    theView->Invalidate();
+    theView->Redraw();
+    aGlCtx->core11fwd->glFinish();
+
+    OSD_Timer aTimer;
+    aTimer.Start();
+    for (int aFrameIter = 0; aFrameIter < aNbFrames; ++aFrameIter)
+    {
+      const Handle(Graphic3d_Camera)& aCam = theView->Camera();
+      gp_Trsf aRot;
+      aRot.SetRotation(gp_Ax1(aCam->Center(), aCam->Up()), 2.0 * M_PI / aNbFrames);
+      aCam->Transform(aRot);
+      theView->Invalidate();
+      theView->Redraw();
+    }
+    aGlCtx->core11fwd->glFinish();
+    aTimer.Stop();
+
+    const double aFrameTime = aTimer.ElapsedTime() / aNbFrames;
+    Message::SendInfo() << THE_CONFIGS[aConfIter] << ": " << (aFrameTime * 1000.0) << " ms/frame ("
+                        << (aFrameTime > 0.0 ? 1.0 / aFrameTime : 0.0) << " fps)";
+  }
+
+  theView->ChangeRenderingParams() = aParamsBack;
+  theView->SetShadingModel(aShadingBack);
+  theView->Camera()->Copy(aCamBack);
+  for (NCollection_Sequence<Handle(AIS_Shape)>::Iterator aShapeIter(aShapes); aShapeIter.More(); aShapeIter.Next())
+  {
+    theCtx->Remove(aShapeIter.Value(), false);
+  }
+  theView->Invalidate();
+}
@@ -0,0 +1,53 @@
+// Copyright (c) 2026 Kirill Gavrilov
+
+#ifndef _OcctSoftwareProfile_HeaderFile
+#define _OcctSoftwareProfile_HeaderFile
+
+#include <AIS_InteractiveContext.hxx>
+#include <V3d_View.hxx>
+
+//! Rendering profile tuned for software OpenGL rasterizers (Mesa llvmpipe/softpipe, SwiftShader, Microsoft GDI),
+//! which are common on virtual machines and remote desktops without GPU.
+//!
+//! Profile disables MSAA, shadows, depth pre-pass and OIT, and switches to per-vertex (Gouraud) shading,
+//! while lower render resolution scale during motion is expected to be handled by OcctQualityGovernor.
+class OcctSoftwareProfile
+{
+public:
+
+  //! Profile activation mode.
+  enum Mode
+  {
+    Mode_Auto, //!< apply profile when software renderer is detected
+    Mode_On,   //!< always apply profile
+    Mode_Off   //!< never apply profile
+  };
+
+public:
+
+  //! Return TRUE if OpenGL renderer string corresponds to a software rasterizer.
+  static bool IsSoftwareRenderer(const TCollection_AsciiString& theRenderer);
+
+  //! Return OpenGL renderer string (GL_RENDERER) of the view.
+  static TCollection_AsciiString GlRenderer(const Handle(V3d_View)& theView);
+
+  //! Setup Mesa environment variables for multithreaded software rasterization;
+  //! should be called before creating OpenGL context:
+  //! - LP_NUM_THREADS is set to the number of processors allowed by CPU affinity of the process (if not defined);
+  //! - mesa_glthread is enabled when software rendering is forced by environment
+  //!   (LIBGL_ALWAYS_SOFTWARE or GALLIUM_DRIVER) or by theToForce flag (if not defined).
+  static void SetupMesaEnvironment(bool theToForce);
+
+  //! Apply profile to the view.
+  static void Apply(const Handle(V3d_View)& theView);
+
+  //! Benchmark redrawing of a test scene during camera orbiting with current (default) settings
+  //! and with software profile (with full and half render resolution).
+  //! @param[in] theNbFrames number of frames per configuration
+  static void Benchmark(const Handle(AIS_InteractiveContext)& theCtx,
+                        const Handle(V3d_View)& theView,
+                        int theNbFrames);
+
+};
+
+#endif // _OcctSoftwareProfile_HeaderFile
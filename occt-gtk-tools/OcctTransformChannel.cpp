@@ -0,0 +1,292 @@
+// Copyright (c) 2026 Kirill Gavrilov
+
+#include "OcctTransformChannel.h"
+
+#include <AIS_Shape.hxx>
+#include <BRepPrimAPI_MakeBox.hxx>
+#include <gp.hxx>
+#include <Message.hxx>
+#include <SelectMgr_SelectionManager.hxx>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace
+{
+  //! Flag of middle buffer published by producer and not yet taken by consumer.
+  static const int THE_PUBLISHED_FLAG = 0x4;
+
+  //! Mask of buffer index.
+  static const int THE_INDEX_MASK = 0x3;
+}
+
+// ================================================================
+// Function : OcctTransformChannel
+// ================================================================
+OcctTransformChannel::OcctTransformChannel()
+: myMiddle(0),
+  myNbPublished(0),
+  myNbApplied(0),
+  myIsFeederFinished(false)
+{
+  //
+}
+
+// ================================================================
+// Function : ~OcctTransformChannel
+// ================================================================
+OcctTransformChannel::~OcctTransformChannel()
+{
+  StopFeeder();
+}
+
+// ================================================================
+// Function : AddObject
+// ================================================================
+int OcctTransformChannel::AddObject(const Handle(AIS_InteractiveObject)& theObj)
+{
+  ObjectState aState;
+  aState.Object = theObj;
+  myObjects.push_back(aState);
+  return (int )myObjects.size() - 1;
+}
+
+// ================================================================
+// Function : Publish
+// ================================================================
+void OcctTransformChannel::Publish()
+{
+  // release filled set and take previous middle buffer (either stale or never taken by consumer)
+  myBack = myMiddle.exchange(myBack | THE_PUBLISHED_FLAG, std::memory_order_acq_rel) & THE_INDEX_MASK;
+  myNbPublished.fetch_add(1, std::memory_order_relaxed);
+}
+
+// ================================================================
+// Function : HasPublishedSet
+// ================================================================
+bool OcctTransformChannel::HasPublishedSet() const
+{
+  return (myMiddle.load(std::memory_order_acquire) & THE_PUBLISHED_FLAG) != 0;
+}
+
+// ================================================================
+// Function : Apply
+// ================================================================
+bool OcctTransformChannel::Apply(const Handle(AIS_InteractiveContext)& theCtx,
+                                 double theTime)
+{
+  if (!HasPublishedSet())
+  {
+    if (myIsMoving
+     && theTime - myLastMotionTime >= mySettleTime)
+    {
+      // motion stopped - update sensitive entities and selection BVH of moved objects
+      myIsMoving = false;
+      for (ObjectState& aState : myObjects)
+      {
+        if (aState.IsMoved
+         && theCtx->IsDisplayed(aState.Object))
+        {
+          theCtx->SelectionManager()->Update(aState.Object, false);
+        }
+        aState.IsMoved = false;
+      }
+    }
+    return false;
+  }
+
+  myFront = myMiddle.exchange(myFront, std::memory_order_acq_rel) & THE_INDEX_MASK;
+  myNbApplied.fetch_add(1, std::memory_order_relaxed);
+  NCollection_Map<Handle(AIS_InteractiveObject)> aMoved;
+  for (const Entry& anEntry : myBuffers[myFront])
+  {
+    if (anEntry.Object < 0
+     || anEntry.Object >= NbObjects())
+    {
+      continue;
+    }
+
+    // only transformation of already computed presentations is changed
+    ObjectState& aState = myObjects[anEntry.Object];
+    aState.Object->SetLocalTransformation(anEntry.Trsf);
+    aState.IsMoved = true;
+    aMoved.Add(aState.Object);
+  }
+  updateHighlightTrsf(theCtx, aMoved);
+  myIsMoving = true;
+  myLastMotionTime = theTime;
+  return true;
+}
+
+// ================================================================
+// Function : updateHighlightTrsf
+// ================================================================
+void OcctTransformChannel::updateHighlightTrsf(const Handle(AIS_InteractiveContext)& theCtx,
+                                               const NCollection_Map<Handle(AIS_InteractiveObject)>& theMoved)
+{
+  if (theMoved.IsEmpty())
+    return;
+
+  // SetLocalTransformation() moves only presentations of the object itself, while highlighting of sub-shape owners
+  // is a standalone presentation - move it in the same way as AIS_InteractiveContext::SetLocation() does
+  const auto anUpdateOwner = [&](const Handle(SelectMgr_EntityOwner)& theOwner)
+  {
+    if (theOwner.IsNull())
+      return;
+
+    Handle(AIS_InteractiveObject) anObj = Handle(AIS_InteractiveObject)::DownCast(theOwner->Selectable());
+    if (anObj.IsNull()
+    || !theMoved.Contains(anObj))
+    {
+      return;
+    }
+
+    const int aHiMode = anObj->HasHilightMode() ? anObj->HilightMode() : 0;
+    theOwner->UpdateHighlightTrsf(theCtx->CurrentViewer(), theCtx->MainPrsMgr(), aHiMode);
+  };
+
+  anUpdateOwner(theCtx->DetectedOwner());
+  for (theCtx->InitSelected(); theCtx->MoreSelected(); theCtx->NextSelected())
+  {
+    anUpdateOwner(theCtx->SelectedOwner());
+  }
+}
+
+// ================================================================
+// Function : StartFeeder
+// ================================================================
+void OcctTransformChannel::StartFeeder(const SimulationStep& theStep,
+                                       double theRate)
+{
+  StopFeeder();
+  myToStopFeeder = false;
+  myIsFeederFinished.store(false, std::memory_order_release);
+  myFeeder = std::thread(&OcctTransformChannel::feederLoop, this, theStep, std::max(theRate, 1.0));
+}
+
+// ================================================================
+// Function : StopFeeder
+// ================================================================
+void OcctTransformChannel::StopFeeder()
+{
+  {
+    std::lock_guard<std::mutex> aLock(myFeederMutex);
+    myToStopFeeder = true;
+  }
+  myFeederCondition.notify_all();
+  if (myFeeder.joinable())
+    myFeeder.join();
+}
+
+// ================================================================
+// Function : feederLoop
+// ================================================================
+void OcctTransformChannel::feederLoop(SimulationStep theStep, double theRate)
+{
+  const std::chrono::steady_clock::time_point aStart = std::chrono::steady_clock::now();
+  const std::chrono::duration<double> aPeriod(1.0 / theRate);
+  for (uint64_t aStepIter = 0;; ++aStepIter)
+  {
+    // steps are scheduled from start time, so that late wake ups don't accumulate drift
+    const std::chrono::steady_clock::time_point aStepTime = aStart
+      + std::chrono::duration_cast<std::chrono::steady_clock::duration>(aPeriod * double(aStepIter));
+    {
+      std::unique_lock<std::mutex> aLock(myFeederMutex);
+      if (myFeederCondition.wait_until(aLock, aStepTime, [this]() { return myToStopFeeder; }))
+        return;
+    }
+
+    const double aTime = std::chrono::duration<double>(aStepTime - aStart).count();
+    if (!theStep(ChangeProducerSet(), aTime))
+    {
+      myIsFeederFinished.store(true, std::memory_order_release);
+      return;
+    }
+
+    Publish();
+  }
+}
+
+// ================================================================
+// Function : Benchmark
+// ================================================================
+Handle(OcctTransformChannel) OcctTransformChannel::Benchmark(const Handle(AIS_InteractiveContext)& theCtx,
+                                                             const Handle(V3d_View)& theView,
+                                                             int theNbObjects)
+{
+  static const int    THE_NB_JOINTS = 6;
+  static const double THE_DURATION  = 5.0;
+  static const double THE_RATE      = 1000.0;
+  const double aLinkLengths[THE_NB_JOINTS] = { 4.0, 10.0, 8.0, 3.0, 2.0, 1.0 };
+
+  const int aNbObjects = theNbObjects > 0 ? theNbObjects : 600;
+  const int aNbArms  = (aNbObjects + THE_NB_JOINTS - 1) / THE_NB_JOINTS;
+  const int aGridSize = std::max((int )std::ceil(std::sqrt(double(aNbArms))), 1);
+
+  // links of the arm are boxes along X axis shared by all arms; joints rotate around Z and Y axes in turn
+  TopoDS_Shape aLinkShapes[THE_NB_JOINTS];
+  for (int aJointIter = 0; aJointIter < THE_NB_JOINTS; ++aJointIter)
+  {
+    const double aWidth = 1.5 - 0.2 * aJointIter;
+    aLinkShapes[aJointIter] = BRepPrimAPI_MakeBox(gp_Pnt(0.0, -0.5 * aWidth, -0.5 * aWidth),
+                                                  gp_Pnt(aLinkLengths[aJointIter], 0.5 * aWidth, 0.5 * aWidth)).Shape();
+  }
+
+  Handle(OcctTransformChannel) aChannel = new OcctTransformChannel();
+  std::vector<gp_Trsf> aBases(aNbArms);
+  for (int anObjIter = 0; anObjIter < aNbObjects; ++anObjIter)
+  {
+    const int anArm = anObjIter / THE_NB_JOINTS;
+    if (anObjIter % THE_NB_JOINTS == 0)
+      aBases[anArm].SetTranslation(gp_Vec(40.0 * (anArm % aGridSize), 40.0 * (anArm / aGridSize), 0.0));
+
+    Handle(AIS_Shape) aLink = new AIS_Shape(aLinkShapes[anObjIter % THE_NB_JOINTS]);
+    aLink->SetColor(anObjIter % THE_NB_JOINTS == 0 ? Quantity_NOC_GRAY50 : Quantity_NOC_ORANGE);
+    aLink->SetLocalTransformation(aBases[anArm]);
+    theCtx->Display(aLink, AIS_Shaded, 0, false);
+    aChannel->AddObject(aLink);
+  }
+  theView->FitAll(0.01, false);
+
+  // simulation computing forward kinematics of all arms; owned by feeder thread
+  OcctTransformChannel* aChannelPtr = aChannel.get();
+  Message::SendInfo() << "OcctTransformChannel benchmark, " << aNbObjects << " objects fed at "
+                      << THE_RATE << " Hz for " << THE_DURATION << " s";
+  aChannel->StartFeeder([aChannelPtr, aBases, aNbObjects, aLinkLengths](TransformSet& theSet, double theTime) -> bool
+  {
+    if (theTime > THE_DURATION)
+    {
+      const uint64_t aNbPublished = aChannelPtr->NbPublished(), aNbApplied = aChannelPtr->NbApplied();
+      Message::SendInfo() << "  published sets: " << (int64_t )aNbPublished << " (" << (aNbPublished / THE_DURATION) << " per second)"
+                          << ", applied by viewer: " << (int64_t )aNbApplied << " (" << (aNbApplied / THE_DURATION) << " per second)"
+                          << ", dropped: " << (int64_t )(aNbPublished - aNbApplied);
+      return false;
+    }
+
+    theSet.resize(aNbObjects);
+    gp_Trsf aTrsf;
+    for (int anObjIter = 0; anObjIter < aNbObjects; ++anObjIter)
+    {
+      const int anArm = anObjIter / THE_NB_JOINTS, aJoint = anObjIter % THE_NB_JOINTS;
+      const double anAngle = 0.8 * std::sin(theTime * (0.7 + 0.3 * aJoint) + 0.1 * anArm);
+      gp_Trsf aJointTrsf;
+      if (aJoint == 0)
+      {
+        aTrsf = aBases[anArm];
+      }
+      else
+      {
+        aJointTrsf.SetTranslation(gp_Vec(aLinkLengths[aJoint - 1], 0.0, 0.0));
+        aTrsf.Multiply(aJointTrsf);
+      }
+      aJointTrsf.SetRotation(gp_Ax1(gp::Origin(), aJoint % 2 == 0 ? gp::DZ() : gp::DY()), anAngle);
+      aTrsf.Multiply(aJointTrsf);
+
+      theSet[anObjIter].Object = anObjIter;
+      theSet[anObjIter].Trsf = aTrsf;
+    }
+    return true;
+  }, THE_RATE);
+  return aChannel;
+}
@@ -0,0 +1,175 @@
+// Copyright (c) 2026 Kirill Gavrilov
+
+#ifndef _OcctTransformChannel_HeaderFile
+#define _OcctTransformChannel_HeaderFile
+
+#include <AIS_InteractiveContext.hxx>
+#include <NCollection_Map.hxx>
+#include <V3d_View.hxx>
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//! Lock-free single-producer/single-consumer channel of object transformation sets,
+//! for driving models (robots, machines) by simulation running on another thread at high rate.
+//!
+//! The channel is a triple buffer: producer fills its own set (ChangeProducerSet()) and publishes it by atomic swap
+//! with the middle buffer, and consumer takes the middle buffer only when it has been published since the last frame.
+//! Neither side ever waits for another, and consumer picks up only the latest published set
+//! (intermediate sets published between two frames are dropped), so that each set should carry complete transformations
+//! of all moving objects rather than increments.
+//!
+//! Apply() should be called by GUI thread once per frame (from frame clock tick):
+//! it applies transformations via PrsMgr_PresentableObject::SetLocalTransformation() without recomputing presentations
+//! and without updating selection (highlighting presentations of detected and selected owners are moved as well);
+//! sensitive entities and selection BVH of moved objects are updated only after motion stops
+//! (no new sets within SettleTime()). While objects are moving, picking relies on outdated selection data,
+//! so that moving objects might be missed or detected inaccurately.
+class OcctTransformChannel : public Standard_Transient
+{
+  DEFINE_STANDARD_RTTI_INLINE(OcctTransformChannel, Standard_Transient)
+public:
+
+  //! Transformation of the object.
+  struct Entry
+  {
+    int     Object = -1; //!< object index within channel
+    gp_Trsf Trsf;        //!< local transformation
+  };
+
+  //! Set of object transformations.
+  typedef std::vector<Entry> TransformSet;
+
+  //! Simulation step called by feeder thread: fills transformation set for specified time in seconds.
+  //! @return FALSE to stop feeding
+  typedef std::function<bool(TransformSet& theSet, double theTime)> SimulationStep;
+
+  //! Benchmark: displays theNbObjects links of 6-axis robot arms (600 by default), starts simulation feeding
+  //! joint transformations at 1 kHz for 5 seconds and prints the number of published and applied sets.
+  //! @return channel to be attached to the viewer
+  static Handle(OcctTransformChannel) Benchmark(const Handle(AIS_InteractiveContext)& theCtx,
+                                                const Handle(V3d_View)& theView,
+                                                int theNbObjects);
+
+public:
+
+  //! Empty constructor.
+  OcctTransformChannel();
+
+  //! Destructor, stops feeder thread.
+  virtual ~OcctTransformChannel();
+
+  //! Register object driven by the channel; should be called by GUI thread.
+  //! @return object index to be referred by Entry::Object
+  int AddObject(const Handle(AIS_InteractiveObject)& theObj);
+
+  //! Return number of registered objects.
+  int NbObjects() const { return (int )myObjects.size(); }
+
+  //! Return registered object or NULL for out of range index.
+  Handle(AIS_InteractiveObject) Object(int theIndex) const
+  {
+    return theIndex >= 0 && theIndex < NbObjects() ? myObjects[theIndex].Object : Handle(AIS_InteractiveObject)();
+  }
+
+  //! Return time in seconds without new sets after which motion is considered stopped (0.2 by default).
+  double SettleTime() const { return mySettleTime; }
+
+  //! Set time in seconds without new sets after which selection of moved objects is updated.
+  void SetSettleTime(double theTime) { mySettleTime = theTime; }
+
+public: //! @name producer interface
+
+  //! Return set to be filled by producer thread before Publish().
+  TransformSet& ChangeProducerSet() { return myBuffers[myBack]; }
+
+  //! Publish set filled by producer thread; never blocks.
+  void Publish();
+
+  //! Copy set into producer buffer and publish it.
+  void Push(const TransformSet& theSet)
+  {
+    ChangeProducerSet() = theSet;
+    Publish();
+  }
+
+  //! Start feeder thread calling simulation step at specified rate and publishing filled sets.
+  //! @param[in] theStep  simulation step
+  //! @param[in] theRate  number of steps per second
+  void StartFeeder(const SimulationStep& theStep,
+                   double theRate = 1000.0);
+
+  //! Stop feeder thread.
+  void StopFeeder();
+
+  //! Return number of published sets.
+  uint64_t NbPublished() const { return myNbPublished.load(std::memory_order_relaxed); }
+
+  //! Return TRUE if simulation step of feeder thread has returned FALSE, so that no more sets will be published.
+  bool IsFeederFinished() const { return myIsFeederFinished.load(std::memory_order_acquire); }
+
+public: //! @name consumer interface
+
+  //! Apply the latest published set (if any) to registered objects and update selection of objects after motion stops;
+  //! should be called by GUI thread once per frame.
+  //! @param[in] theCtx   interactive context displaying objects
+  //! @param[in] theTime  frame time in seconds
+  //! @return TRUE if new transformations have been applied and view should be redrawn
+  bool Apply(const Handle(AIS_InteractiveContext)& theCtx,
+             double theTime);
+
+  //! Return TRUE if a set has been published and not yet applied by Apply().
+  bool HasPublishedSet() const;
+
+  //! Return the last set applied by Apply().
+  const TransformSet& CurrentSet() const { return myBuffers[myFront]; }
+
+  //! Return TRUE if objects are moving (selection is not up-to-date).
+  bool IsMoving() const { return myIsMoving; }
+
+  //! Return number of sets applied by consumer.
+  uint64_t NbApplied() const { return myNbApplied.load(std::memory_order_relaxed); }
+
+protected:
+
+  //! Registered object.
+  struct ObjectState
+  {
+    Handle(AIS_InteractiveObject) Object;
+    bool IsMoved = false; //!< object has been moved since the last selection update
+  };
+
+  //! Feeder thread loop.
+  void feederLoop(SimulationStep theStep, double theRate);
+
+  //! Move highlighting presentations of detected and selected owners of moved objects.
+  void updateHighlightTrsf(const Handle(AIS_InteractiveContext)& theCtx,
+                           const NCollection_Map<Handle(AIS_InteractiveObject)>& theMoved);
+
+protected:
+
+  TransformSet             myBuffers[3];        //!< triple buffer
+  std::atomic<int>         myMiddle;            //!< index of middle buffer with published flag
+  int                      myBack  = 1;         //!< index of buffer owned by producer
+  int                      myFront = 2;         //!< index of buffer owned by consumer
+  std::atomic<uint64_t>    myNbPublished;
+  std::atomic<uint64_t>    myNbApplied;
+  std::atomic<bool>        myIsFeederFinished;  //!< simulation has been finished by feeder thread
+
+  std::vector<ObjectState> myObjects;           //!< registered objects
+  double                   mySettleTime = 0.2;
+  double                   myLastMotionTime = 0.0;
+  bool                     myIsMoving = false;
+
+  std::thread              myFeeder;
+  std::mutex               myFeederMutex;
+  std::condition_variable  myFeederCondition;   //!< wakes up feeder on stopping
+  bool                     myToStopFeeder = false;
+
+};
+
+#endif // _OcctTransformChannel_HeaderFile
@@ -0,0 +1,259 @@
+// Copyright (c) 2026 Kirill Gavrilov
+
+#include "OcctGtkAssemblyTree.h"
+
+// ================================================================
+// Function : OcctGtkAssemblyTree
+// ================================================================
+OcctGtkAssemblyTree::OcctGtkAssemblyTree()
+{
+  set_policy(Gtk::POLICY_AUTOMATIC, Gtk::POLICY_AUTOMATIC);
+  set_size_request(200, -1);
+
+  myStore = Gtk::TreeStore::create(myColumns);
+  myTreeView.set_model(myStore);
+  myTreeView.set_headers_visible(false);
+  myTreeView.get_selection()->set_mode(Gtk::SELECTION_MULTIPLE);
+  myTreeView.get_selection()->signal_changed().connect(sigc::mem_fun(*this, &OcctGtkAssemblyTree::onSelectionChanged));
+  myTreeView.signal_test_expand_row().connect(sigc::mem_fun(*this, &OcctGtkAssemblyTree::onTestExpandRow), false);
+
+  // fixed sizing of all columns allows fixed height mode, which avoids measuring all rows
+  Gtk::CellRendererToggle* aToggle = Gtk::manage(new Gtk::CellRendererToggle());
+  aToggle->signal_toggled().connect(sigc::mem_fun(*this, &OcctGtkAssemblyTree::onVisibilityToggled));
+  Gtk::TreeViewColumn* aColumn = Gtk::manage(new Gtk::TreeViewColumn());
+  aColumn->pack_start(*aToggle, false);
+  aColumn->add_attribute(aToggle->property_active(), myColumns.Visible);
+  aColumn->pack_start(myColumns.Name);
+  aColumn->set_sizing(Gtk::TREE_VIEW_COLUMN_FIXED);
+  aColumn->set_fixed_width(400);
+  myTreeView.append_column(*aColumn);
+  myTreeView.set_expander_column(*aColumn);
+  myTreeView.set_fixed_height_mode(true);
+
+  add(myTreeView);
+  myTreeView.show();
+}
+
+// ================================================================
+// Function : ~OcctGtkAssemblyTree
+// ================================================================
+OcctGtkAssemblyTree::~OcctGtkAssemblyTree()
+{
+  mySelectionIdleConn.disconnect();
+}
+
+// ================================================================
+// Function : SetDocument
+// ================================================================
+void OcctGtkAssemblyTree::SetDocument(const Handle(TDocStd_Document)& theDoc)
+{
+  mySelectionIdleConn.disconnect();
+  myIsSyncing = true;
+  myStore->clear();
+  myRows.clear();
+  myTree.Init(theDoc);
+  if (!myContext.IsNull())
+  {
+    myTree.BindObjects(myContext);
+    myTree.SyncVisibility(myContext);
+  }
+
+  for (int aRoot : myTree.Roots())
+  {
+    appendRow(myStore->append(), aRoot);
+  }
+  myIsSyncing = false;
+}
+
+// ================================================================
+// Function : appendRow
+// ================================================================
+void OcctGtkAssemblyTree::appendRow(const Gtk::TreeModel::iterator& theIter,
+                                    int theNode)
+{
+  if ((int )myRows.size() <= theNode)
+    myRows.resize(theNode + 1);
+  myRows[theNode] = theIter;
+
+  const OcctAssemblyTree::Node& aNode = myTree.GetNode(theNode);
+  Gtk::TreeModel::Row aRow = *theIter;
+  aRow[myColumns.Node] = theNode;
+  aRow[myColumns.Name] = aNode.Name.ToCString();
+  aRow[myColumns.Visible] = !aNode.IsHidden;
+  if (aNode.IsAssembly)
+  {
+    // placeholder child to show expander
+    Gtk::TreeModel::Row aChild = *myStore->append(aRow.children());
+    aChild[myColumns.Node] = -1;
+  }
+}
+
+// ================================================================
+// Function : onTestExpandRow
+// ================================================================
+bool OcctGtkAssemblyTree::onTestExpandRow(const Gtk::TreeModel::iterator& theIter,
+                                          const Gtk::TreeModel::Path& )
+{
+  Gtk::TreeModel::Row aRow = *theIter;
+  Gtk::TreeModel::Children aChildren = aRow.children();
+  if (aChildren.empty()
+   || int((*aChildren.begin())[myColumns.Node]) != -1)
+  {
+    return false;
+  }
+
+  const bool wasSyncing = myIsSyncing;
+  myIsSyncing = true;
+  myStore->erase(aChildren.begin());
+  const int aNode = aRow[myColumns.Node];
+  for (int aChild : myTree.Children(aNode))
+  {
+    appendRow(myStore->append(aRow.children()), aChild);
+  }
+  myIsSyncing = wasSyncing;
+  return false; // allow expanding
+}
+
+// ================================================================
+// Function : onSelectionChanged
+// ================================================================
+void OcctGtkAssemblyTree::onSelectionChanged()
+{
+  if (myIsSyncing
+   || mySelectionIdleConn.connected())
+  {
+    return;
+  }
+
+  // range selection emits several events - apply them at once
+  mySelectionIdleConn = Glib::signal_idle().connect(sigc::mem_fun(*this, &OcctGtkAssemblyTree::applySelection));
+}
+
+// ================================================================
+// Function : applySelection
+// ================================================================
+bool OcctGtkAssemblyTree::applySelection()
+{
+  if (myContext.IsNull())
+    return false;
+
+  std::vector<int> aNodes;
+  const std::vector<Gtk::TreeModel::Path> aPaths = myTreeView.get_selection()->get_selected_rows();
+  for (const Gtk::TreeModel::Path& aPath : aPaths)
+  {
+    const int aNode = (*myStore->get_iter(aPath))[myColumns.Node];
+    if (aNode != -1)
+      aNodes.push_back(aNode);
+  }
+
+  myTree.SelectNodes(myContext, aNodes);
+  mySignalViewChanged.emit();
+  return false;
+}
+
+// ================================================================
+// Function : onVisibilityToggled
+// ================================================================
+void OcctGtkAssemblyTree::onVisibilityToggled(const Glib::ustring& thePath)
+{
+  Gtk::TreeModel::iterator anIter = myStore->get_iter(thePath);
+  if (myContext.IsNull()
+  || !anIter)
+  {
+    return;
+  }
+
+  const int aNode = (*anIter)[myColumns.Node];
+  if (aNode == -1)
+    return;
+
+  const bool toShow = myTree.GetNode(aNode).IsHidden;
+  myTree.SetNodeVisible(myContext, aNode, toShow);
+  updateChecks(myStore->children());
+  mySignalViewChanged.emit();
+}
+
+// ================================================================
+// Function : findRow
+// ================================================================
+Gtk::TreeModel::iterator OcctGtkAssemblyTree::findRow(int theNode)
+{
+  // rows are looked up by node, so that only ancestors have to be expanded
+  const std::vector<int> aPath = myTree.NodePath(theNode);
+  for (size_t aLevel = 0; aLevel < aPath.size(); ++aLevel)
+  {
+    if (aPath[aLevel] >= (int )myRows.size()
+    || !myRows[aPath[aLevel]])
+    {
+      return Gtk::TreeModel::iterator();
+    }
+
+    if (aLevel + 1 < aPath.size())
+    {
+      // expanding fills children of the row within onTestExpandRow()
+      myTreeView.expand_row(myStore->get_path(myRows[aPath[aLevel]]), false);
+    }
+  }
+  return myRows[theNode];
+}
+
+// ================================================================
+// Function : SyncSelection
+// ================================================================
+void OcctGtkAssemblyTree::SyncSelection()
+{
+  if (myContext.IsNull()
+   || myTree.Roots().empty())
+  {
+    return;
+  }
+
+  mySelectionIdleConn.disconnect();
+  const std::vector<int> aNodes = myTree.SelectedNodes(myContext);
+  myIsSyncing = true;
+  myTreeView.get_selection()->unselect_all();
+  bool isFirst = true;
+  for (int aNode : aNodes)
+  {
+    Gtk::TreeModel::iterator aRow = findRow(aNode);
+    if (!aRow)
+      continue;
+
+    myTreeView.get_selection()->select(aRow);
+    if (isFirst)
+    {
+      isFirst = false;
+      myTreeView.scroll_to_row(myStore->get_path(aRow));
+    }
+  }
+  myIsSyncing = false;
+}
+
+// ================================================================
+// Function : SyncVisibility
+// ================================================================
+void OcctGtkAssemblyTree::SyncVisibility()
+{
+  if (myContext.IsNull())
+    return;
+
+  myTree.SyncVisibility(myContext);
+  updateChecks(myStore->children());
+}
+
+// ================================================================
+// Function : updateChecks
+// ================================================================
+void OcctGtkAssemblyTree::updateChecks(const Gtk::TreeModel::Children& theRows)
+{
+  for (Gtk::TreeModel::iterator aRowIter = theRows.begin(); aRowIter != theRows.end(); ++aRowIter)
+  {
+    Gtk::TreeModel::Row aRow = *aRowIter;
+    const int aNode = aRow[myColumns.Node];
+    if (aNode == -1)
+      continue;
+
+    aRow[myColumns.Visible] = !myTree.GetNode(aNode).IsHidden;
+    updateChecks(aRow.children());
+  }
+}
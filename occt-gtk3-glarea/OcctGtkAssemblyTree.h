@@ -0,0 +1,96 @@
+// Copyright (c) 2026 Kirill Gavrilov
+
+#ifndef _OcctGtkAssemblyTree_HeaderFile
+#define _OcctGtkAssemblyTree_HeaderFile
+
+#include <gtkmm.h>
+
+#include "../occt-gtk-tools/OcctAssemblyTree.h"
+
+//! Assembly tree panel showing XCAF product structure.
+//!
+//! GTK3 has no Gtk::ListView, so that Gtk::TreeView in fixed height mode is used instead (rendering only visible rows),
+//! with children added to Gtk::TreeStore only on expanding rows (assembly rows have a placeholder child until then),
+//! so that the panel doesn't depend on the total number of nodes in assembly.
+//! Row selection selects objects of nodes within AIS_InteractiveContext and vice versa (see SyncSelection()),
+//! and check boxes show or hide objects of nodes.
+//! Rapid row selection changes are applied to the context at once from idle callback,
+//! followed by a single SignalViewChanged() to redraw the viewer.
+class OcctGtkAssemblyTree : public Gtk::ScrolledWindow
+{
+public:
+
+  //! Main constructor.
+  OcctGtkAssemblyTree();
+
+  //! Destructor.
+  virtual ~OcctGtkAssemblyTree();
+
+  //! Set interactive context displaying objects of the document.
+  void SetContext(const Handle(AIS_InteractiveContext)& theCtx) { myContext = theCtx; }
+
+  //! Show product structure of the document (NULL to clear the tree).
+  void SetDocument(const Handle(TDocStd_Document)& theDoc);
+
+  //! Select rows of objects selected within context, expanding their ancestors.
+  void SyncSelection();
+
+  //! Update check boxes from display status of objects.
+  void SyncVisibility();
+
+  //! Return assembly tree of the document.
+  OcctAssemblyTree& Tree() { return myTree; }
+
+  //! Signal emitted after context has been modified by the tree (selection or visibility), so that viewer should be redrawn.
+  sigc::signal<void>& SignalViewChanged() { return mySignalViewChanged; }
+
+protected:
+
+  //! Tree store columns.
+  struct Columns : public Gtk::TreeModelColumnRecord
+  {
+    Gtk::TreeModelColumn<int>           Node;    //!< tree node, -1 for placeholder child of not expanded row
+    Gtk::TreeModelColumn<Glib::ustring> Name;
+    Gtk::TreeModelColumn<bool>          Visible;
+
+    Columns() { add(Node); add(Name); add(Visible); }
+  };
+
+  //! Fill appended row of the node.
+  void appendRow(const Gtk::TreeModel::iterator& theIter,
+                 int theNode);
+
+  //! Fill children of the row on expanding.
+  bool onTestExpandRow(const Gtk::TreeModel::iterator& theIter,
+                       const Gtk::TreeModel::Path& thePath);
+
+  //! Row selection changed event - schedule applying selection to context.
+  void onSelectionChanged();
+
+  //! Apply row selection to context.
+  bool applySelection();
+
+  //! Check box toggled event.
+  void onVisibilityToggled(const Glib::ustring& thePath);
+
+  //! Find row of the node, expanding its ancestors.
+  Gtk::TreeModel::iterator findRow(int theNode);
+
+  //! Update check boxes of filled rows.
+  void updateChecks(const Gtk::TreeModel::Children& theRows);
+
+protected:
+
+  OcctAssemblyTree               myTree;
+  Handle(AIS_InteractiveContext) myContext;
+  Columns                        myColumns;
+  Glib::RefPtr<Gtk::TreeStore>   myStore;
+  Gtk::TreeView                  myTreeView;
+  std::vector<Gtk::TreeModel::iterator> myRows; //!< filled rows indexed by node (Gtk::TreeStore iterators persist)
+  sigc::signal<void>             mySignalViewChanged;
+  sigc::connection               mySelectionIdleConn; //!< pending application of row selection
+  bool                           myIsSyncing = false; //!< flag to ignore events caused by synchronization
+
+};
+
+#endif // _OcctGtkAssemblyTree_HeaderFile
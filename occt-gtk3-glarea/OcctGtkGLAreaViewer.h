@@ -15,9 +15,30 @@
 #include <V3d_Viewer.hxx>
 #include <V3d_View.hxx>
 
+#include "../occt-gtk-tools/OcctBatchUpdate.h"
+#include "../occt-gtk-tools/OcctCommandQueue.h"
+#include "../occt-gtk-tools/OcctFrameTimeline.h"
+#include "../occt-gtk-tools/OcctHiddenLines.h"
+#include "../occt-gtk-tools/OcctIdleScheduler.h"
+#include "../occt-gtk-tools/OcctInputPredictor.h"
+#include "../occt-gtk-tools/OcctLiveResize.h"
+#include "../occt-gtk-tools/OcctParallelSelector.h"
+#include "../occt-gtk-tools/OcctQualityGovernor.h"
+#include "../occt-gtk-tools/OcctResidencyManager.h"
+#include "../occt-gtk-tools/OcctSceneBoundsIndex.h"
+#include "../occt-gtk-tools/OcctSectionPlane.h"
+#include "../occt-gtk-tools/OcctSoftwareProfile.h"
+#include "../occt-gtk-tools/OcctTransformChannel.h"
+
 //! GTK GLArea widget with embedded OCCT Viewer.
 class OcctGtkGLAreaViewer : public Gtk::GLArea, public AIS_ViewController
 {
+public:
+
+  //! Activation mode of software rasterizer rendering profile (OcctSoftwareProfile::Mode_Auto by default).
+  //! Should be set before initialization.
+  static OcctSoftwareProfile::Mode& SoftwareProfileMode();
+
 public:
 
   //! Main constructor.
@@ -38,6 +59,112 @@ public:
   //! Return GL info.
   const TCollection_AsciiString& GetGlInfo() const { return myGlInfo; }
 
+  //! Return parallel rubber-band/polyline selection engine.
+  OcctParallelSelector& ParallelSelector() { return myParallelSelector; }
+
+  //! Return animation timeline driven by frame clock.
+  OcctFrameTimeline& FrameTimeline() { return myFrameTimeline; }
+
+  //! Return pointer position predictor for dragging gestures (disabled by default).
+  OcctInputPredictor& InputPredictor() { return myInputPredictor; }
+
+  //! Return live resize helper stretching the last frame while window size is changing.
+  OcctLiveResize& LiveResize() { return myLiveResize; }
+
+  //! Return rendering quality governor holding target frame rate (disabled by default).
+  OcctQualityGovernor& QualityGovernor() { return myQualityGovernor; }
+
+  //! Return GPU memory residency manager (disabled by default).
+  OcctResidencyManager& ResidencyManager() { return myResidencyManager; }
+
+  //! Return index of displayed objects bounds serving FitAll and z-range (disabled by default).
+  OcctSceneBoundsIndex& BoundsIndex() { return myBoundsIndex; }
+
+  //! Return batch of display, erase, colour, transparency and location changes to be applied by ApplyBatch().
+  OcctBatchUpdate& Batch() { return myBatch; }
+
+  //! Apply changes collected by Batch() in one pass and request a single redraw;
+  //! selection of displayed objects is activated afterwards from idle callback.
+  void ApplyBatch();
+
+  //! Return queue of scene commands posted by worker threads;
+  //! commands are executed within frame clock update phase (before painting) within per-frame budget.
+  OcctCommandQueue& CommandQueue() { return myCommandQueue; }
+
+  //! Return scheduler of low-priority work executed while the view is idle;
+  //! scheduler is paused on user input and resumed once input settles.
+  OcctIdleScheduler& IdleScheduler() { return myIdleScheduler; }
+
+  //! Return TRUE if hidden line removal mode is enabled.
+  bool IsHiddenLineMode() const { return !myHiddenLines.IsNull(); }
+
+  //! Enable or disable hidden line removal mode (toggled by 'H' key).
+  //! Displayed shapes are taken at the moment of enabling; the view is switched to orthographic projection,
+  //! and hidden lines for a new view direction are computed by idle scheduler jobs while shaded objects are displayed.
+  void SetHiddenLineMode(bool theToEnable);
+
+  //! Return hidden line removal of displayed shapes, or NULL if mode is disabled.
+  const Handle(OcctHiddenLines)& HiddenLines() const { return myHiddenLines; }
+
+  //! Return TRUE if section plane is enabled.
+  bool IsSectionMode() const { return !mySectionPlane.IsNull(); }
+
+  //! Enable or disable section plane with capping dragged by manipulator (toggled by 'C' key).
+  //! Dragging only changes clipping plane equation; detection is refreshed once dragging is finished.
+  void SetSectionMode(bool theToEnable);
+
+  //! Return section plane, or NULL if mode is disabled.
+  const Handle(OcctSectionPlane)& SectionPlane() const { return mySectionPlane; }
+
+  //! Return channel of object transformations streamed from another thread.
+  const Handle(OcctTransformChannel)& TransformChannel() const { return myTransformChannel; }
+
+  //! Set channel of object transformations (NULL to detach).
+  //! The latest published set is applied at each frame clock tick while channel is attached;
+  //! ticking stops once nothing has been published within OcctTransformChannel::SettleTime() and motion has settled,
+  //! and resumes when a new set is published.
+  void SetTransformChannel(const Handle(OcctTransformChannel)& theChannel);
+
+  //! Signal emitted within frame clock update phase (with bound OpenGL context) before flushing input events.
+  sigc::signal<void>& SignalBeforeRedraw() { return mySignalBeforeRedraw; }
+
+  //! Signal emitted from rendering callback (with bound OpenGL context) after redrawing the viewer.
+  sigc::signal<void>& SignalViewRendered() { return mySignalViewRendered; }
+
+  //! Signal emitted when selection in the viewer has been changed by user input.
+  sigc::signal<void>& SignalSelectionChanged() { return mySignalSelectionChanged; }
+
+public: //! @name input events pausing idle work
+
+  //! Pause idle work and update mouse buttons.
+  virtual bool UpdateMouseButtons(const Graphic3d_Vec2i& thePoint,
+                                  Aspect_VKeyMouse theButtons,
+                                  Aspect_VKeyFlags theModifiers,
+                                  bool theIsEmulated) override;
+
+  //! Pause idle work and update mouse position.
+  virtual bool UpdateMousePosition(const Graphic3d_Vec2i& thePoint,
+                                   Aspect_VKeyMouse theButtons,
+                                   Aspect_VKeyFlags theModifiers,
+                                   bool theIsEmulated) override;
+
+  //! Pause idle work and update mouse scroll.
+  virtual bool UpdateMouseScroll(const Aspect_ScrollDelta& theDelta) override;
+
+  //! Pause idle work and add touch point.
+  virtual void AddTouchPoint(Standard_Size theId,
+                             const Graphic3d_Vec2d& thePnt,
+                             Standard_Boolean theClearBefore = false) override;
+
+  //! Pause idle work and update touch point.
+  virtual void UpdateTouchPoint(Standard_Size theId,
+                                const Graphic3d_Vec2d& thePnt) override;
+
+  //! Pause idle work and press key.
+  virtual void KeyDown(Aspect_VKey theKey,
+                       double theTime,
+                       double thePressure = 1.0) override;
+
 protected:
 
   //! Handle multi-touch event.
@@ -60,6 +187,22 @@ protected:
   //! Redraw viewer content.
   bool onGlAreaRender(const Glib::RefPtr<Gdk::GLContext>& theGlCtx);
 
+  //! Store the last rendered frame for stretching on the first size allocation of interactive resize.
+  void onSizeAllocate(Gtk::Allocation& theAlloc);
+
+  //! Connect frame clock signals, so that the scene is updated within frame clock update phase.
+  void connectFrameClock();
+
+  //! Start frame clock tick callback applying sets published into transformation channel.
+  void startTransformTicks();
+
+  //! Execute posted commands, flush pending input events and update the scene before painting;
+  //! called within frame clock update phase after tick callbacks advancing animations.
+  void onFrameClockUpdate();
+
+  //! Redraw the view updated by onFrameClockUpdate().
+  void redrawView();
+
 protected:
 
   //! Setup input callbacks.
@@ -71,10 +214,52 @@ protected:
   //! Initialize pixel scale ratio.
   void initPixelScaleRatio();
 
-  //! Handle view redraw.
+  //! Pass new pointer position to input predictor.
+  //! @param[in] theTouchId touch point id or -1 for mouse pointer
+  void updateInputPredictor(Standard_Size theTouchId);
+
+  //! Apply predicted pointer position before flushing view events.
+  void applyInputPrediction();
+
+  //! Put back real pointer position after flushing view events with predicted one,
+  //! and redraw the view when prediction expires, so that overshoot is not kept after pointer stops.
+  void restoreInputPosition();
+
+  //! Apply software rasterizer profile according to SoftwareProfileMode() and detected OpenGL renderer.
+  void applySoftwareProfile();
+
+  //! Pause idle work on user input and schedule its resuming after IdleScheduler().IdleDelay().
+  void onViewerInput();
+
+  //! Schedule idle callback executing idle steps, if scheduler is not paused.
+  void scheduleIdleSteps();
+
+  //! Mark bounds index dirty (automatic z-fit is used meanwhile) and synchronize it once on idle.
+  void invalidateBoundsIndex();
+
+  //! Display cached hidden lines for the current view direction, or display shaded objects
+  //! and post computation of hidden lines once camera animation is stopped.
+  //! @return TRUE if displayed presentations have been changed
+  bool updateHiddenLines();
+
+  //! Apply section plane moved by manipulator to clipping plane,
+  //! and refresh detection under mouse cursor once dragging is finished.
+  void updateSectionPlane(const Handle(AIS_InteractiveContext)& theCtx,
+                          const Handle(V3d_View)& theView);
+
+  //! Update animations and presentations depending on camera;
+  //! unlike base implementation, the view is not redrawn here but within rendering callback.
   virtual void handleViewRedraw(const Handle(AIS_InteractiveContext)& theCtx,
                                 const Handle(V3d_View)& theView) override;
 
+  //! Handle rubber-band and polyline selection using parallel selection engine.
+  virtual void handleSelectionPoly(const Handle(AIS_InteractiveContext)& theCtx,
+                                   const Handle(V3d_View)& theView) override;
+
+  //! Emit SignalSelectionChanged().
+  virtual void OnSelectionChanged(const Handle(AIS_InteractiveContext)& theCtx,
+                                  const Handle(V3d_View)& theView) override;
+
 protected:
 
   Handle(V3d_Viewer)             myViewer;
@@ -83,6 +268,45 @@ protected:
   Handle(AIS_ViewCube)           myViewCube;  //!< view cube object
   float                          myDevicePixelRatio = 1.0f; //!< device pixel ratio for handling high DPI displays
   TCollection_AsciiString        myGlInfo;
+  OcctParallelSelector           myParallelSelector; //!< parallel area selection engine
+  OcctResidencyManager           myResidencyManager; //!< GPU memory residency manager
+  OcctSceneBoundsIndex           myBoundsIndex;      //!< index of displayed objects bounds
+  OcctBatchUpdate                myBatch;            //!< batch of object changes
+  sigc::connection               myBoundsSyncConn;   //!< idle callback synchronizing dirty bounds index
+  sigc::connection               myBatchSelectionConn; //!< idle callback activating selection of batch-displayed objects
+  OcctCommandQueue               myCommandQueue;     //!< scene commands posted by worker threads
+  Glib::Dispatcher               myCommandDispatcher; //!< redraw request on posting commands
+  OcctIdleScheduler              myIdleScheduler;    //!< low-priority work executed while view is idle
+  Glib::Dispatcher               myIdleDispatcher;   //!< idle steps request on posting steps
+  sigc::connection               myIdleStepsConn;    //!< idle callback executing idle steps
+  sigc::connection               myIdleResumeConn;   //!< timer resuming idle work after input settles
+  Handle(OcctHiddenLines)        myHiddenLines;      //!< hidden line removal of displayed shapes
+  gp_Dir                         myHiddenLinesDir;   //!< view direction of posted hidden lines computation
+  int                            myHiddenLinesTask = 0; //!< idle scheduler job computing hidden lines
+  Graphic3d_Camera::Projection   myHiddenLinesProj = Graphic3d_Camera::Projection_Orthographic; //!< projection before enabling hidden lines
+  Handle(OcctSectionPlane)       mySectionPlane;     //!< section plane with capping
+  bool                           myIsSectionDragged = false; //!< section plane manipulator is being dragged
+  Handle(OcctTransformChannel)   myTransformChannel; //!< streamed object transformations
+  guint                          myTransformCallback = 0; //!< tick callback applying streamed transformations
+  sigc::connection               myTransformPollConn; //!< timer resuming transformation ticks on newly published set
+  OcctFrameTimeline              myFrameTimeline;    //!< animation timeline driven by frame clock
+  OcctInputPredictor             myInputPredictor;   //!< pointer position predictor
+  Standard_Size                  myPredictedTouch = Standard_Size(-1); //!< touch point id fed to predictor or -1 for mouse
+  Graphic3d_Vec2d                myRealPointerPos;   //!< last real position of predicted pointer
+  bool                           myIsPredictionApplied = false; //!< flag indicating that controller holds predicted position
+  sigc::connection               myPredictionExpiryConn; //!< timer redrawing view with real pointer position
+  OcctLiveResize                 myLiveResize;       //!< live resize helper
+  sigc::connection               myResizeSettleConn; //!< timer redrawing view after resize settles
+  OcctQualityGovernor            myQualityGovernor;  //!< rendering quality governor
+  sigc::connection               myQualityIdleConn;  //!< timer restoring full quality on idle
+  gint64                         myQualityLastFrame = 0; //!< time of the last frame measured by quality governor
+  sigc::connection               myFrameBeforePaintConn; //!< frame clock before-paint handler requesting update phase
+  sigc::connection               myFrameUpdateConn;  //!< frame clock update phase handler updating the scene
+  gint64                         myFrameUpdateTime = 0; //!< time of the last scene update
+  sigc::signal<void>             mySignalViewRendered;
+  sigc::signal<void>             mySignalBeforeRedraw;
+  sigc::signal<void>             mySignalSelectionChanged;
+  guint                          myAnimationCallback = 0;
 
 };
 
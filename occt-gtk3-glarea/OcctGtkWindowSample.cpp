@@ -2,18 +2,144 @@
 
 #include "OcctGtkWindowSample.h"
 
+#include "../occt-gtk-tools/OcctInstancedDisplay.h"
+#include "../occt-gtk-tools/OcctMemoryReport.h"
+#include "../occt-gtk-tools/OcctScalarField.h"
+#include "../occt-gtk-tools/OcctSectionPlane.h"
+
 #include <AIS_Shape.hxx>
 #include <BRepPrimAPI_MakeBox.hxx>
 #include <Message.hxx>
+#include <Select3D_SensitiveEntity.hxx>
+#include <SelectMgr_ViewerSelector.hxx>
 #include <Standard_Version.hxx>
 
+// ================================================================
+// Function : BenchmarkName
+// ================================================================
+TCollection_AsciiString& OcctGtkWindowSample::BenchmarkName()
+{
+  static TCollection_AsciiString aBenchName;
+  return aBenchName;
+}
+
+// ================================================================
+// Function : BenchmarkSize
+// ================================================================
+int& OcctGtkWindowSample::BenchmarkSize()
+{
+  static int aBenchSize = 0;
+  return aBenchSize;
+}
+
+// ================================================================
+// Function : GpuBudgetMiB
+// ================================================================
+int& OcctGtkWindowSample::GpuBudgetMiB()
+{
+  static int aBudgetMiB = 0;
+  return aBudgetMiB;
+}
+
+// ================================================================
+// Function : TargetFps
+// ================================================================
+int& OcctGtkWindowSample::TargetFps()
+{
+  static int aTargetFps = 0;
+  return aTargetFps;
+}
+
+// ================================================================
+// Function : ToPredictInput
+// ================================================================
+bool& OcctGtkWindowSample::ToPredictInput()
+{
+  static bool toPredict = false;
+  return toPredict;
+}
+
+// ================================================================
+// Function : LatencyTracePath
+// ================================================================
+TCollection_AsciiString& OcctGtkWindowSample::LatencyTracePath()
+{
+  static TCollection_AsciiString aTracePath;
+  return aTracePath;
+}
+
+// ================================================================
+// Function : ImportPath
+// ================================================================
+TCollection_AsciiString& OcctGtkWindowSample::ImportPath()
+{
+  static TCollection_AsciiString anImportPath;
+  return anImportPath;
+}
+
+// ================================================================
+// Function : ToUseCompactVertices
+// ================================================================
+bool& OcctGtkWindowSample::ToUseCompactVertices()
+{
+  static bool toUseCompact = false;
+  return toUseCompact;
+}
+
+// ================================================================
+// Function : ToLoadPartsOnDemand
+// ================================================================
+bool& OcctGtkWindowSample::ToLoadPartsOnDemand()
+{
+  static bool toLoadOnDemand = false;
+  return toLoadOnDemand;
+}
+
+// ================================================================
+// Function : ToHealShapes
+// ================================================================
+bool& OcctGtkWindowSample::ToHealShapes()
+{
+  static bool toHeal = false;
+  return toHeal;
+}
+
+// ================================================================
+// Function : PointCloudPath
+// ================================================================
+TCollection_AsciiString& OcctGtkWindowSample::PointCloudPath()
+{
+  static TCollection_AsciiString aCloudPath;
+  return aCloudPath;
+}
+
+// ================================================================
+// Function : MemoryReportPath
+// ================================================================
+TCollection_AsciiString& OcctGtkWindowSample::MemoryReportPath()
+{
+  static TCollection_AsciiString aReportPath;
+  return aReportPath;
+}
+
+// ================================================================
+// Function : ToUseBoundsIndex
+// ================================================================
+bool& OcctGtkWindowSample::ToUseBoundsIndex()
+{
+  static bool toUseIndex = false;
+  return toUseIndex;
+}
+
 // ================================================================
 // Function : OcctGtkWindowSample
 // ================================================================
 OcctGtkWindowSample::OcctGtkWindowSample()
 : myVBox(Gtk::Orientation::ORIENTATION_VERTICAL),
+  myPaned(Gtk::Orientation::ORIENTATION_HORIZONTAL),
   myAboutButton("About"),
-  myQuitButton("Quit")
+  myQuitButton("Quit"),
+  myImportCancelButton("Cancel")
 {
   set_title("OCCT Gtk3::GLArea Viewer sample");
   set_default_size(720, 480);
@@ -24,7 +150,14 @@ OcctGtkWindowSample::OcctGtkWindowSample()
   myViewer.set_hexpand(true);
   myViewer.set_vexpand(true);
   myViewer.set_size_request(100, 200);
-  myVBox.add(myViewer);
+
+  // assembly tree is shown only for imported STEP and glTF models
+  myAssemblyTree.set_no_show_all(true);
+  myAssemblyTree.SetContext(myViewer.Context());
+  myPaned.pack1(myAssemblyTree, false, true);
+  myPaned.pack2(myViewer, true, false);
+  myPaned.set_vexpand(true);
+  myVBox.add(myPaned);
   myVBox.add(myControls);
   myControls.set_hexpand(true);
   {
@@ -45,6 +178,16 @@ OcctGtkWindowSample::OcctGtkWindowSample()
     aSliderBox->show();
     myControls.add(*aSliderBox);
 
+    // import progress is shown only while import is running
+    myImportProgress.set_show_text(true);
+    myImportProgress.set_valign(Gtk::ALIGN_CENTER);
+    myImportProgress.set_size_request(150);
+    myImportCancelButton.signal_clicked().connect(sigc::mem_fun(*this, &OcctGtkWindowSample::onImportCancelClicked));
+    myImportProgress.set_no_show_all(true);
+    myImportCancelButton.set_no_show_all(true);
+    myControls.add(myImportProgress);
+    myControls.add(myImportCancelButton);
+
     myAboutButton.set_size_request(70);
     myAboutButton.signal_clicked().connect(sigc::mem_fun(*this, &OcctGtkWindowSample::onAboutClicked));
     myControls.add(myAboutButton);
@@ -60,6 +203,98 @@ OcctGtkWindowSample::OcctGtkWindowSample()
     Handle(AIS_Shape) aShape = new AIS_Shape(aBox);
     myViewer.Context()->Display(aShape, AIS_Shaded, 0, false);
   }
+
+  // stream point cloud nodes before redrawing the view
+  myPointCloudDispatcher.connect([this]() { myViewer.queue_draw(); });
+  myViewer.SignalBeforeRedraw().connect([this]()
+  {
+    // streamed data extends bounding boxes of objects
+    if (!myPointCloud.IsNull()
+     && myPointCloud->UpdateStreaming(myViewer.View())
+     && myViewer.BoundsIndex().IsEnabled())
+    {
+      myViewer.BoundsIndex().Update(myPointCloud);
+    }
+    if (!myMeshStream.IsNull()
+     && myMeshStream->UpdateStreaming())
+    {
+      if (myViewer.BoundsIndex().IsEnabled())
+        myViewer.BoundsIndex().Update(myMeshStream);
+      if (!myMeshStream->IsLoading())
+        myViewer.View()->FitAll(0.01, false);
+    }
+
+    // switch levels of detail of triangulation-only meshes, limited number of chunks per frame
+    bool toSwitchMore = false;
+    for (const Handle(OcctLodMesh)& aMesh : myLodMeshes)
+    {
+      toSwitchMore = aMesh->UpdateLevels(myViewer.View()) || toSwitchMore;
+    }
+    if (toSwitchMore)
+      myPointCloudDispatcher.emit();
+
+    // load parts becoming visible, limited number of displayed parts per frame
+    if (!myAssembly.IsNull()
+     && myAssembly->Update(myViewer.Context(), myViewer.View()))
+    {
+      myPointCloudDispatcher.emit();
+    }
+  });
+
+  // keep selection and visibility of assembly tree in sync with the viewer
+  myViewer.SignalSelectionChanged().connect([this]() { myAssemblyTree.SyncSelection(); });
+  myAssemblyTree.SignalViewChanged().connect([this]()
+  {
+    updateBoundsIndex();
+    myViewer.View()->Invalidate();
+    myViewer.queue_draw();
+  });
+
+  // import model on background thread
+  myImportDispatcher.connect(sigc::mem_fun(*this, &OcctGtkWindowSample::onImportProgress));
+  if (!ImportPath().IsEmpty())
+  {
+    importModel(ImportPath());
+  }
+
+  if (!PointCloudPath().IsEmpty())
+  {
+    openPointCloud(PointCloudPath());
+  }
+
+  if (GpuBudgetMiB() > 0)
+  {
+    myViewer.ResidencyManager().SetBudget(Standard_Size(GpuBudgetMiB()) * 1024 * 1024);
+  }
+
+  if (ToUseBoundsIndex())
+  {
+    myViewer.BoundsIndex().SetEnabled(true);
+    updateBoundsIndex();
+  }
+
+  if (TargetFps() > 0)
+  {
+    myViewer.QualityGovernor().SetTargetFps(TargetFps());
+    myViewer.QualityGovernor().SetEnabled(myViewer.Context(), myViewer.View(), true);
+  }
+
+  myViewer.InputPredictor().SetEnabled(ToPredictInput());
+  if (!LatencyTracePath().IsEmpty())
+  {
+    myViewer.InputPredictor().OpenTrace(LatencyTracePath());
+  }
+
+  if (!BenchmarkName().IsEmpty())
+  {
+    // benchmarks are started from rendering callback to have OpenGL context bound
+    myBenchmarkConn = myViewer.SignalViewRendered().connect(sigc::mem_fun(*this, &OcctGtkWindowSample::runBenchmark));
+  }
+  if (!MemoryReportPath().IsEmpty())
+  {
+    // GL resources are still alive on hiding the window, unlike in destructor
+    signal_hide().connect(sigc::mem_fun(*this, &OcctGtkWindowSample::onWindowHide));
+  }
 }
 
 // ================================================================
@@ -67,7 +302,19 @@ OcctGtkWindowSample::OcctGtkWindowSample()
 // ================================================================
 OcctGtkWindowSample::~OcctGtkWindowSample()
 {
-  //
+  // stop import and loading threads using dispatchers
+  if (!myImporter.IsNull())
+    myImporter->Cancel();
+  myImporter.Nullify();
+
+  if (!myPointCloud.IsNull())
+    myPointCloud->StopLoading();
+  if (!myMeshStream.IsNull())
+    myMeshStream->StopLoading();
+  if (!myAssembly.IsNull())
+    myAssembly->StopLoading();
+  if (!myViewer.TransformChannel().IsNull())
+    myViewer.TransformChannel()->StopFeeder();
 }
 
 // ================================================================
@@ -83,6 +330,16 @@ void OcctGtkWindowSample::onAboutClicked()
 
   TCollection_AsciiString aGlInfo = TCollection_AsciiString() + "OpenGL info\n" + myViewer.GetGlInfo();
 
+  OcctMemoryReport aMemReport;
+  aMemReport.Perform(myViewer.Context());
+  aGlInfo += TCollection_AsciiString() + "\n\nMemory usage (estimated)\n" + aMemReport.FormatTotals();
+
+  const OcctFrameTimeline& aTimeline = myViewer.FrameTimeline();
+  aGlInfo += TCollection_AsciiString() + "\n\nAnimated frames: " + int(aTimeline.NbFrames())
+           + " (missed vblanks: " + int(aTimeline.NbMissedVBlanks()) + ")";
+  aGlInfo += TCollection_AsciiString() + "\n\nScene commands\n" + myViewer.CommandQueue().FormatMetrics();
+  aGlInfo += TCollection_AsciiString() + "\n\nIdle work\n" + myViewer.IdleScheduler().FormatMetrics();
+
   Gtk::MessageDialog aMsg(anAbout.str().c_str(), false, Gtk::MESSAGE_INFO);
   aMsg.set_title("About Sample");
   aMsg.set_secondary_text(aGlInfo.ToCString());
@@ -100,3 +357,326 @@ void OcctGtkWindowSample::onValueChanged(const Glib::RefPtr<Gtk::Adjustment>& th
   myViewer.View()->Invalidate();
   myViewer.queue_draw();
 }
+
+// ================================================================
+// Function : runBenchmark
+// ================================================================
+void OcctGtkWindowSample::runBenchmark()
+{
+  if (!myImporter.IsNull())
+  {
+    // wait until model passed by --import is displayed, so that benchmark may use it
+    return;
+  }
+  myBenchmarkConn.disconnect();
+
+  const TCollection_AsciiString aBenchName = BenchmarkName();
+  if (aBenchName == "select")
+  {
+    OcctParallelSelector::Benchmark(myViewer.Context(), myViewer.View(), BenchmarkSize());
+  }
+  else if (aBenchName == "instancing")
+  {
+    OcctInstancedDisplay::Benchmark(myViewer.Context(), myViewer.View(), BenchmarkSize());
+  }
+  else if (aBenchName == "pointcloud")
+  {
+    setPointCloud(OcctPointCloud::Benchmark(myViewer.Context(), myViewer.View(), BenchmarkSize()));
+  }
+  else if (aBenchName == "swprofile")
+  {
+    OcctSoftwareProfile::Benchmark(myViewer.Context(), myViewer.View(), BenchmarkSize());
+  }
+  else if (aBenchName == "meshstream")
+  {
+    setMeshStream(OcctMeshStream::Benchmark(myViewer.Context(), myViewer.View(), BenchmarkSize()));
+  }
+  else if (aBenchName == "compact")
+  {
+    OcctLodMesh::Benchmark(myViewer.Context(), myViewer.View(), BenchmarkSize());
+  }
+  else if (aBenchName == "bounds")
+  {
+    OcctSceneBoundsIndex::Benchmark(myViewer.Context(), myViewer.View(), BenchmarkSize());
+  }
+  else if (aBenchName == "batch")
+  {
+    OcctBatchUpdate::Benchmark(myViewer.Context(), myViewer.View(), BenchmarkSize());
+  }
+  else if (aBenchName == "scalarfield")
+  {
+    OcctScalarField::Benchmark(myViewer.Context(), myViewer.View(), BenchmarkSize());
+  }
+  else if (aBenchName == "kinematics")
+  {
+    myViewer.SetTransformChannel(OcctTransformChannel::Benchmark(myViewer.Context(), myViewer.View(), BenchmarkSize()));
+  }
+  else if (aBenchName == "section")
+  {
+    OcctSectionPlane::Benchmark(myViewer.Context(), myViewer.View(), BenchmarkSize());
+  }
+  else
+  {
+    Message::SendFail() << "Unknown benchmark '" << aBenchName << "'";
+  }
+  updateBoundsIndex();
+  myViewer.queue_draw();
+}
+
+// ================================================================
+// Function : onWindowHide
+// ================================================================
+void OcctGtkWindowSample::onWindowHide()
+{
+  OcctMemoryReport aMemReport;
+  aMemReport.Perform(myViewer.Context());
+  aMemReport.ExportJson(MemoryReportPath());
+}
+
+// ================================================================
+// Function : openPointCloud
+// ================================================================
+void OcctGtkWindowSample::openPointCloud(const TCollection_AsciiString& thePath)
+{
+  Handle(OcctPointCloud) aCloud = new OcctPointCloud();
+  if (!aCloud->Open(thePath))
+    return;
+
+  myViewer.Context()->Display(aCloud, 0, 0, false);
+  myViewer.View()->FitAll(0.01, false);
+  setPointCloud(aCloud);
+}
+
+// ================================================================
+// Function : setPointCloud
+// ================================================================
+void OcctGtkWindowSample::setPointCloud(const Handle(OcctPointCloud)& theCloud)
+{
+  if (!myPointCloud.IsNull())
+  {
+    myPointCloud->StopLoading();
+    myViewer.Context()->Remove(myPointCloud, false);
+  }
+
+  myPointCloud = theCloud;
+  if (!myPointCloud.IsNull())
+  {
+    myPointCloud->SetLoadedCallback([this]() { myPointCloudDispatcher.emit(); });
+  }
+  updateBoundsIndex();
+  myViewer.queue_draw();
+}
+
+// ================================================================
+// Function : setMeshStream
+// ================================================================
+void OcctGtkWindowSample::setMeshStream(const Handle(OcctMeshStream)& theMesh)
+{
+  if (!myMeshStream.IsNull())
+  {
+    myMeshStream->StopLoading();
+    myViewer.Context()->Remove(myMeshStream, false);
+  }
+
+  myMeshStream = theMesh;
+  if (!myMeshStream.IsNull())
+  {
+    myMeshStream->SetLoadedCallback([this]() { myPointCloudDispatcher.emit(); });
+  }
+  updateLodMeshes();
+  updateBoundsIndex();
+  myViewer.queue_draw();
+}
+
+// ================================================================
+// Function : updateLodMeshes
+// ================================================================
+void OcctGtkWindowSample::updateLodMeshes()
+{
+  myLodMeshes.clear();
+  AIS_ListOfInteractive anObjects;
+  myViewer.Context()->DisplayedObjects(anObjects);
+  for (AIS_ListOfInteractive::Iterator anObjIter(anObjects); anObjIter.More(); anObjIter.Next())
+  {
+    if (Handle(OcctLodMesh) aMesh = Handle(OcctLodMesh)::DownCast(anObjIter.Value()))
+    {
+      aMesh->SetCompactVertices(ToUseCompactVertices());
+      myLodMeshes.push_back(aMesh);
+    }
+  }
+}
+
+// ================================================================
+// Function : updateBoundsIndex
+// ================================================================
+void OcctGtkWindowSample::updateBoundsIndex()
+{
+  if (myViewer.BoundsIndex().IsEnabled())
+    myViewer.BoundsIndex().Synchronize(myViewer.Context());
+}
+
+// ================================================================
+// Function : prebuildSelection
+// ================================================================
+void OcctGtkWindowSample::prebuildSelection()
+{
+  OcctIdleScheduler& aScheduler = myViewer.IdleScheduler();
+  aScheduler.Cancel(myPrebuildTask);
+
+  //! Objects waiting for prebuild and sensitive entities of the current object.
+  struct PrebuildState
+  {
+    AIS_ListOfInteractive Objects;
+    Handle(AIS_InteractiveObject) Object;
+    std::vector<Handle(Select3D_SensitiveEntity)> Entities;
+    size_t NbBuilt = 0;
+  };
+
+  Handle(AIS_InteractiveContext) aCtx = myViewer.Context();
+  std::shared_ptr<PrebuildState> aState = std::make_shared<PrebuildState>();
+  aCtx->DisplayedObjects(aState->Objects);
+  myPrebuildTask = aScheduler.PostIdle("Selection BVH", OcctIdleScheduler::Priority_Low, [aCtx, aState]() -> bool
+  {
+    // one sensitive entity per step, so that objects with many or large entities don't exceed slice budget
+    if (aState->NbBuilt < aState->Entities.size())
+    {
+      aState->Entities[aState->NbBuilt++]->BVH();
+      return true;
+    }
+
+    if (!aState->Object.IsNull())
+    {
+      // BVH of object entities after BVH of all its entities
+      if (aCtx->IsDisplayed(aState->Object))
+        aCtx->MainSelector()->RebuildSensitivesTree(aState->Object, true);
+      aState->Object.Nullify();
+      aState->Entities.clear();
+      aState->NbBuilt = 0;
+      return !aState->Objects.IsEmpty();
+    }
+
+    if (aState->Objects.IsEmpty())
+      return false;
+
+    // collect entities of the next object
+    Handle(AIS_InteractiveObject) anObj = aState->Objects.First();
+    aState->Objects.RemoveFirst();
+    if (!aCtx->IsDisplayed(anObj))
+      return !aState->Objects.IsEmpty();
+
+    for (SelectMgr_SequenceOfSelection::Iterator aSelIter(anObj->Selections()); aSelIter.More(); aSelIter.Next())
+    {
+      const Handle(SelectMgr_Selection)& aSel = aSelIter.Value();
+      if (aSel->GetSelectionState() != SelectMgr_SOS_Activated)
+        continue;
+
+      for (NCollection_Vector<Handle(SelectMgr_SensitiveEntity)>::Iterator anEntIter(aSel->Entities()); anEntIter.More(); anEntIter.Next())
+        aState->Entities.push_back(anEntIter.Value()->BaseSensitive());
+    }
+    aState->Object = anObj;
+    return true;
+  });
+}
+
+// ================================================================
+// Function : importModel
+// ================================================================
+void OcctGtkWindowSample::importModel(const TCollection_AsciiString& thePath)
+{
+  if (!myImporter.IsNull())
+  {
+    myImporter->Cancel();
+    myImporter.Nullify();
+  }
+
+  if (OcctMeshStream::IsSupportedFormat(thePath))
+  {
+    // callback is set before starting worker threads, so that the first loaded chunks wake up GUI thread
+    Handle(OcctMeshStream) aMesh = new OcctMeshStream();
+    aMesh->SetLoadedCallback([this]() { myPointCloudDispatcher.emit(); });
+    if (aMesh->Open(thePath))
+    {
+      myViewer.Context()->Display(aMesh, 0, 0, false);
+      setMeshStream(aMesh);
+    }
+    return;
+  }
+
+  Handle(OcctModelImporter) anImporter = new OcctModelImporter();
+  anImporter->SetProgressCallback([this]() { myImportDispatcher.emit(); });
+  anImporter->SetLoadPartsOnDemand(ToLoadPartsOnDemand());
+  anImporter->SetHealShapes(ToHealShapes());
+  if (!anImporter->Start(thePath))
+  {
+    Message::SendFail() << "Unable to import '" << thePath << "': " << anImporter->Error();
+    return;
+  }
+
+  myImporter = anImporter;
+  myImportProgress.set_fraction(0.0);
+  myImportProgress.set_text(OcctModelImporter::StageName(OcctModelImporter::Stage_Parse));
+  myImportProgress.show();
+  myImportCancelButton.show();
+}
+
+// ================================================================
+// Function : onImportProgress
+// ================================================================
+void OcctGtkWindowSample::onImportProgress()
+{
+  if (myImporter.IsNull())
+    return;
+
+  if (!myImporter->IsDone())
+  {
+    myImportProgress.set_fraction(myImporter->Progress());
+    myImportProgress.set_text(OcctModelImporter::StageName(myImporter->CurrentStage()));
+    return;
+  }
+
+  Handle(OcctModelImporter) anImporter = myImporter;
+  myImporter.Nullify();
+  myImportProgress.hide();
+  myImportCancelButton.hide();
+  if (!anImporter->Wait())
+  {
+    Message::SendFail() << "Import of '" << anImporter->Path() << "' failed: " << anImporter->Error();
+    return;
+  }
+
+  if (!anImporter->OnDemandAssembly().IsNull())
+  {
+    if (!myAssembly.IsNull())
+    {
+      myAssembly->RemoveParts(myViewer.Context());
+      myViewer.Context()->Remove(myAssembly, false);
+    }
+    myAssembly = anImporter->OnDemandAssembly();
+    myAssembly->SetBoundsIndex(&myViewer.BoundsIndex());
+    myAssembly->SetAssemblyTree(&myAssemblyTree.Tree());
+    myAssembly->SetLoadedCallback([this]() { myPointCloudDispatcher.emit(); });
+  }
+
+  const int aNbObjects = anImporter->Display(myViewer.Context());
+  myAssemblyTree.SetDocument(anImporter->Document());
+  myAssemblyTree.show();
+  updateLodMeshes();
+  updateBoundsIndex();
+  prebuildSelection();
+  myViewer.View()->FitAll(0.01, false);
+  myViewer.View()->Invalidate();
+  myViewer.queue_draw();
+  Message::SendInfo() << "Imported " << aNbObjects << " objects from '" << anImporter->Path() << "'\n"
+                      << "  " << anImporter->FormatTimings();
+  if (!anImporter->HealReports().empty())
+    Message::SendInfo() << anImporter->FormatHealReport();
+}
+
+// ================================================================
+// Function : onImportCancelClicked
+// ================================================================
+void OcctGtkWindowSample::onImportCancelClicked()
+{
+  if (!myImporter.IsNull())
+    myImporter->Cancel();
+}
@@ -3,11 +3,58 @@
 #ifndef _OcctGtkWindowSample_HeaderFile
 #define _OcctGtkWindowSample_HeaderFile
 
+#include "OcctGtkAssemblyTree.h"
 #include "OcctGtkGLAreaViewer.h"
 
+#include "../occt-gtk-tools/OcctMeshStream.h"
+#include "../occt-gtk-tools/OcctModelImporter.h"
+#include "../occt-gtk-tools/OcctPointCloud.h"
+
 //! GTK window widget with embedded OCCT Viewer.
 class OcctGtkWindowSample : public Gtk::Window
 {
+public:
+
+  //! Name of the benchmark to run after the first frame (empty by default).
+  //! Should be set before window creation.
+  static TCollection_AsciiString& BenchmarkName();
+
+  //! Benchmark size parameter, like the maximum number of objects (0 means benchmark default).
+  static int& BenchmarkSize();
+
+  //! GPU memory budget in MiB for OcctResidencyManager (0 by default, meaning no budget).
+  static int& GpuBudgetMiB();
+
+  //! Extrapolate dragged pointer to expected frame presentation time (FALSE by default).
+  static bool& ToPredictInput();
+
+  //! Path to CSV file for tracing input latency and prediction errors (empty by default).
+  static TCollection_AsciiString& LatencyTracePath();
+
+  //! Target frame rate for rendering quality governor (0 by default, meaning no governor).
+  static int& TargetFps();
+
+  //! Path to STEP, glTF, STL or PLY file to import (empty by default).
+  static TCollection_AsciiString& ImportPath();
+
+  //! Upload triangle-only meshes in compact vertex layout (FALSE by default).
+  static bool& ToUseCompactVertices();
+
+  //! Load parts of imported STEP and glTF assemblies on demand (FALSE by default).
+  static bool& ToLoadPartsOnDemand();
+
+  //! Heal shapes of imported STEP files in parallel after transfer (FALSE by default).
+  static bool& ToHealShapes();
+
+  //! Path to point cloud file to open (empty by default).
+  static TCollection_AsciiString& PointCloudPath();
+
+  //! Path to JSON file for writing memory report on window hiding (empty by default).
+  static TCollection_AsciiString& MemoryReportPath();
+
+  //! Use OcctSceneBoundsIndex for FitAll and z-range of the viewer (FALSE by default).
+  static bool& ToUseBoundsIndex();
+
 public:
 
   //! Main constructor.
@@ -24,14 +71,62 @@ protected:
   //! Value changed event.
   void onValueChanged(const Glib::RefPtr<Gtk::Adjustment>& theAdj);
 
+  //! Run benchmark specified by BenchmarkName() from rendering callback once model import is finished.
+  void runBenchmark();
+
+  //! Window hide event - write memory report if requested.
+  void onWindowHide();
+
+  //! Start importing STEP or glTF file on background thread, or streaming STL or PLY mesh.
+  void importModel(const TCollection_AsciiString& thePath);
+
+  //! Update import progress bar or display imported model when import is finished.
+  void onImportProgress();
+
+  //! Cancel button clicked event.
+  void onImportCancelClicked();
+
+  //! Replace streamed mesh (removing previous one) and assign loading callback.
+  void setMeshStream(const Handle(OcctMeshStream)& theMesh);
+
+  //! Collect displayed meshes with levels of detail.
+  void updateLodMeshes();
+
+  //! Synchronize bounds index of the viewer (if enabled) with displayed objects after bulk changes.
+  void updateBoundsIndex();
+
+  //! Build selection BVH of displayed objects from idle steps (one sensitive entity per step), so that the first picking doesn't stall.
+  void prebuildSelection();
+
+  //! Open and display point cloud file.
+  void openPointCloud(const TCollection_AsciiString& thePath);
+
+  //! Replace streamed point cloud (removing previous one) and assign loading callback.
+  void setPointCloud(const Handle(OcctPointCloud)& theCloud);
+
 protected:
 
   Gtk::Box    myVBox;
   Gtk::Box    myControls;
+  Gtk::Paned  myPaned;
   Gtk::Button myAboutButton;
   Gtk::Button myQuitButton;
+  Gtk::ProgressBar myImportProgress;
+  Gtk::Button myImportCancelButton;
 
+  OcctGtkAssemblyTree myAssemblyTree; //!< product structure of imported model
   OcctGtkGLAreaViewer myViewer;
+  sigc::connection    myBenchmarkConn;
+
+  Handle(OcctPointCloud) myPointCloud;           //!< streamed point cloud
+  Glib::Dispatcher       myPointCloudDispatcher; //!< redraw request from point cloud and mesh loading threads
+  Handle(OcctMeshStream) myMeshStream;           //!< streamed STL/PLY mesh
+  std::vector<Handle(OcctLodMesh)> myLodMeshes;  //!< displayed meshes with levels of detail
+
+  Handle(OcctOnDemandAssembly) myAssembly;       //!< imported assembly with parts loaded on demand
+  Handle(OcctModelImporter) myImporter;           //!< running model import
+  Glib::Dispatcher          myImportDispatcher;   //!< progress notifications from import thread
+  int                       myPrebuildTask = 0;   //!< idle task building selection BVH
 
 };
 
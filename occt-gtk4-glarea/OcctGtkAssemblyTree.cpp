@@ -0,0 +1,304 @@
+// Copyright (c) 2026 Kirill Gavrilov
+
+#include "OcctGtkAssemblyTree.h"
+
+//! Item of list model referring to the tree node.
+class OcctGtkAssemblyTree::Item : public Glib::Object
+{
+public:
+  static Glib::RefPtr<Item> create(int theNode) { return Glib::make_refptr_for_instance<Item>(new Item(theNode)); }
+
+  int               Node  = -1;
+  Gtk::CheckButton* Check = nullptr; //!< check button of bound row
+protected:
+  Item(int theNode) : Node(theNode) {}
+};
+
+// ================================================================
+// Function : OcctGtkAssemblyTree
+// ================================================================
+OcctGtkAssemblyTree::OcctGtkAssemblyTree()
+{
+  set_policy(Gtk::PolicyType::AUTOMATIC, Gtk::PolicyType::AUTOMATIC);
+  set_size_request(200, -1);
+
+  Glib::RefPtr<Gtk::SignalListItemFactory> aFactory = Gtk::SignalListItemFactory::create();
+  aFactory->signal_setup().connect(sigc::mem_fun(*this, &OcctGtkAssemblyTree::onSetupRow));
+  aFactory->signal_bind().connect(sigc::mem_fun(*this, &OcctGtkAssemblyTree::onBindRow));
+  aFactory->signal_unbind().connect(sigc::mem_fun(*this, &OcctGtkAssemblyTree::onUnbindRow));
+  myListView.set_factory(aFactory);
+  set_child(myListView);
+  SetDocument(Handle(TDocStd_Document)());
+}
+
+// ================================================================
+// Function : ~OcctGtkAssemblyTree
+// ================================================================
+OcctGtkAssemblyTree::~OcctGtkAssemblyTree()
+{
+  mySelectionIdleConn.disconnect();
+}
+
+// ================================================================
+// Function : SetDocument
+// ================================================================
+void OcctGtkAssemblyTree::SetDocument(const Handle(TDocStd_Document)& theDoc)
+{
+  mySelectionIdleConn.disconnect();
+  myTree.Init(theDoc);
+  if (!myContext.IsNull())
+  {
+    myTree.BindObjects(myContext);
+    myTree.SyncVisibility(myContext);
+  }
+
+  Glib::RefPtr<Gio::ListStore<Item>> aRoots = Gio::ListStore<Item>::create();
+  for (int aRoot : myTree.Roots())
+  {
+    aRoots->append(Item::create(aRoot));
+  }
+
+  // children are requested only on expanding rows
+  myTreeModel = Gtk::TreeListModel::create(aRoots, sigc::mem_fun(*this, &OcctGtkAssemblyTree::createChildModel), false, false);
+  mySelection = Gtk::MultiSelection::create(myTreeModel);
+  mySelection->signal_selection_changed().connect(sigc::mem_fun(*this, &OcctGtkAssemblyTree::onSelectionChanged));
+  myListView.set_model(mySelection);
+}
+
+// ================================================================
+// Function : createChildModel
+// ================================================================
+Glib::RefPtr<Gio::ListModel> OcctGtkAssemblyTree::createChildModel(const Glib::RefPtr<Glib::ObjectBase>& theItem)
+{
+  Glib::RefPtr<Item> anItem = std::dynamic_pointer_cast<Item>(theItem);
+  if (!anItem
+   || !myTree.GetNode(anItem->Node).IsAssembly)
+  {
+    return Glib::RefPtr<Gio::ListModel>();
+  }
+
+  Glib::RefPtr<Gio::ListStore<Item>> aChildren = Gio::ListStore<Item>::create();
+  for (int aChild : myTree.Children(anItem->Node))
+  {
+    aChildren->append(Item::create(aChild));
+  }
+  return aChildren;
+}
+
+// ================================================================
+// Function : onSetupRow
+// ================================================================
+void OcctGtkAssemblyTree::onSetupRow(const Glib::RefPtr<Gtk::ListItem>& theListItem)
+{
+  Gtk::TreeExpander* anExpander = Gtk::manage(new Gtk::TreeExpander());
+  Gtk::Box* aBox = Gtk::manage(new Gtk::Box(Gtk::Orientation::HORIZONTAL, 4));
+  Gtk::CheckButton* aCheck = Gtk::manage(new Gtk::CheckButton());
+  Gtk::Label* aLabel = Gtk::manage(new Gtk::Label());
+  aLabel->set_halign(Gtk::Align::START);
+  aLabel->set_ellipsize(Pango::EllipsizeMode::END);
+  aBox->append(*aCheck);
+  aBox->append(*aLabel);
+  anExpander->set_child(*aBox);
+  theListItem->set_child(*anExpander);
+
+  // list item outlives its child widgets, so that raw pointer is safe here
+  Gtk::ListItem* aListItem = theListItem.get();
+  aCheck->signal_toggled().connect([this, aListItem]() { onVisibilityToggled(aListItem); });
+}
+
+// ================================================================
+// Function : onBindRow
+// ================================================================
+void OcctGtkAssemblyTree::onBindRow(const Glib::RefPtr<Gtk::ListItem>& theListItem)
+{
+  Glib::RefPtr<Gtk::TreeListRow> aRow = std::dynamic_pointer_cast<Gtk::TreeListRow>(theListItem->get_item());
+  Gtk::TreeExpander* anExpander = dynamic_cast<Gtk::TreeExpander*>(theListItem->get_child());
+  if (!aRow || anExpander == nullptr)
+    return;
+
+  Glib::RefPtr<Item> anItem = std::dynamic_pointer_cast<Item>(aRow->get_item());
+  Gtk::CheckButton* aCheck = dynamic_cast<Gtk::CheckButton*>(anExpander->get_child()->get_first_child());
+  Gtk::Label* aLabel = dynamic_cast<Gtk::Label*>(aCheck->get_next_sibling());
+  anExpander->set_list_row(aRow);
+  const OcctAssemblyTree::Node& aNode = myTree.GetNode(anItem->Node);
+  aLabel->set_text(aNode.Name.ToCString());
+
+  const bool wasSyncing = myIsSyncing;
+  myIsSyncing = true;
+  aCheck->set_active(!aNode.IsHidden);
+  myIsSyncing = wasSyncing;
+  anItem->Check = aCheck;
+}
+
+// ================================================================
+// Function : onUnbindRow
+// ================================================================
+void OcctGtkAssemblyTree::onUnbindRow(const Glib::RefPtr<Gtk::ListItem>& theListItem)
+{
+  Glib::RefPtr<Gtk::TreeListRow> aRow = std::dynamic_pointer_cast<Gtk::TreeListRow>(theListItem->get_item());
+  if (!aRow)
+    return;
+
+  if (Glib::RefPtr<Item> anItem = std::dynamic_pointer_cast<Item>(aRow->get_item()))
+    anItem->Check = nullptr;
+}
+
+// ================================================================
+// Function : rowItem
+// ================================================================
+Glib::RefPtr<OcctGtkAssemblyTree::Item> OcctGtkAssemblyTree::rowItem(guint thePosition) const
+{
+  Glib::RefPtr<Gtk::TreeListRow> aRow = myTreeModel->get_row(thePosition);
+  return aRow ? std::dynamic_pointer_cast<Item>(aRow->get_item()) : Glib::RefPtr<Item>();
+}
+
+// ================================================================
+// Function : onSelectionChanged
+// ================================================================
+void OcctGtkAssemblyTree::onSelectionChanged(guint , guint )
+{
+  if (myIsSyncing
+   || mySelectionIdleConn.connected())
+  {
+    return;
+  }
+
+  // range selection emits several events - apply them at once
+  mySelectionIdleConn = Glib::signal_idle().connect(sigc::mem_fun(*this, &OcctGtkAssemblyTree::applySelection));
+}
+
+// ================================================================
+// Function : applySelection
+// ================================================================
+bool OcctGtkAssemblyTree::applySelection()
+{
+  if (myContext.IsNull())
+    return false;
+
+  std::vector<int> aNodes;
+  Glib::RefPtr<const Gtk::Bitset> aSelected = mySelection->get_selection();
+  for (guint64 aSelIter = 0; aSelIter < aSelected->get_size(); ++aSelIter)
+  {
+    if (Glib::RefPtr<Item> anItem = rowItem(aSelected->get_nth((guint )aSelIter)))
+      aNodes.push_back(anItem->Node);
+  }
+
+  myTree.SelectNodes(myContext, aNodes);
+  mySignalViewChanged.emit();
+  return false;
+}
+
+// ================================================================
+// Function : onVisibilityToggled
+// ================================================================
+void OcctGtkAssemblyTree::onVisibilityToggled(Gtk::ListItem* theListItem)
+{
+  if (myIsSyncing
+   || myContext.IsNull())
+  {
+    return;
+  }
+
+  Glib::RefPtr<Gtk::TreeListRow> aRow = std::dynamic_pointer_cast<Gtk::TreeListRow>(theListItem->get_item());
+  Glib::RefPtr<Item> anItem = aRow ? std::dynamic_pointer_cast<Item>(aRow->get_item()) : Glib::RefPtr<Item>();
+  if (!anItem
+   || anItem->Check == nullptr)
+  {
+    return;
+  }
+
+  const bool toShow = anItem->Check->get_active();
+  if (myTree.GetNode(anItem->Node).IsHidden != toShow)
+    return;
+
+  myTree.SetNodeVisible(myContext, anItem->Node, toShow);
+  updateChecks();
+  mySignalViewChanged.emit();
+}
+
+// ================================================================
+// Function : findRow
+// ================================================================
+int OcctGtkAssemblyTree::findRow(int theNode)
+{
+  // rows are looked up by node index within children of the parent, so that only ancestors have to be expanded
+  const std::vector<int> aPath = myTree.NodePath(theNode);
+  Glib::RefPtr<Gtk::TreeListRow> aRow;
+  for (size_t aLevel = 0; aLevel < aPath.size(); ++aLevel)
+  {
+    const guint anIndex = (guint )myTree.GetNode(aPath[aLevel]).Index;
+    if (aLevel == 0)
+    {
+      aRow = myTreeModel->get_child_row(anIndex);
+    }
+    else
+    {
+      aRow->set_expanded(true);
+      aRow = aRow->get_child_row(anIndex);
+    }
+    if (!aRow)
+      return -1;
+  }
+  return aRow ? (int )aRow->get_position() : -1;
+}
+
+// ================================================================
+// Function : SyncSelection
+// ================================================================
+void OcctGtkAssemblyTree::SyncSelection()
+{
+  if (myContext.IsNull()
+   || myTree.Roots().empty())
+  {
+    return;
+  }
+
+  mySelectionIdleConn.disconnect();
+  const std::vector<int> aNodes = myTree.SelectedNodes(myContext);
+  myIsSyncing = true;
+  mySelection->unselect_all();
+  int aFirstRow = -1;
+  for (int aNode : aNodes)
+  {
+    const int aRow = findRow(aNode);
+    if (aRow == -1)
+      continue;
+
+    mySelection->select_item(aRow, false);
+    if (aFirstRow == -1)
+      aFirstRow = aRow;
+  }
+  myIsSyncing = false;
+  if (aFirstRow != -1)
+  {
+    myListView.activate_action("list.scroll-to-item", Glib::Variant<guint32>::create(aFirstRow));
+  }
+}
+
+// ================================================================
+// Function : SyncVisibility
+// ================================================================
+void OcctGtkAssemblyTree::SyncVisibility()
+{
+  if (myContext.IsNull())
+    return;
+
+  myTree.SyncVisibility(myContext);
+  updateChecks();
+}
+
+// ================================================================
+// Function : updateChecks
+// ================================================================
+void OcctGtkAssemblyTree::updateChecks()
+{
+  myIsSyncing = true;
+  const guint aNbRows = myTreeModel->get_n_items();
+  for (guint aRowIter = 0; aRowIter < aNbRows; ++aRowIter)
+  {
+    Glib::RefPtr<Item> anItem = rowItem(aRowIter);
+    if (anItem && anItem->Check != nullptr)
+      anItem->Check->set_active(!myTree.GetNode(anItem->Node).IsHidden);
+  }
+  myIsSyncing = false;
+}
@@ -0,0 +1,100 @@
+// Copyright (c) 2026 Kirill Gavrilov
+
+#ifndef _OcctGtkAssemblyTree_HeaderFile
+#define _OcctGtkAssemblyTree_HeaderFile
+
+// workaround macros clash with Gtk::Collation::UNICODE (UNICODE is a standard macros used by WinAPI)
+#ifdef UNICODE
+#undef UNICODE
+#endif
+#include <gtkmm.h>
+
+#include "../occt-gtk-tools/OcctAssemblyTree.h"
+
+//! Assembly tree panel showing XCAF product structure.
+//!
+//! Gtk::ListView creates row widgets only for visible rows (recycling them on scrolling),
+//! and Gtk::TreeListModel requests child models only for expanded nodes,
+//! so that the panel doesn't depend on the total number of nodes in assembly.
+//! Row selection selects objects of nodes within AIS_InteractiveContext and vice versa (see SyncSelection()),
+//! and check buttons show or hide objects of nodes.
+//! Rapid row selection changes are applied to the context at once from idle callback,
+//! followed by a single SignalViewChanged() to redraw the viewer.
+class OcctGtkAssemblyTree : public Gtk::ScrolledWindow
+{
+public:
+
+  //! Main constructor.
+  OcctGtkAssemblyTree();
+
+  //! Destructor.
+  virtual ~OcctGtkAssemblyTree();
+
+  //! Set interactive context displaying objects of the document.
+  void SetContext(const Handle(AIS_InteractiveContext)& theCtx) { myContext = theCtx; }
+
+  //! Show product structure of the document (NULL to clear the tree).
+  void SetDocument(const Handle(TDocStd_Document)& theDoc);
+
+  //! Select rows of objects selected within context, expanding their ancestors.
+  void SyncSelection();
+
+  //! Update check buttons from display status of objects.
+  void SyncVisibility();
+
+  //! Return assembly tree of the document.
+  OcctAssemblyTree& Tree() { return myTree; }
+
+  //! Signal emitted after context has been modified by the tree (selection or visibility), so that viewer should be redrawn.
+  sigc::signal<void()>& SignalViewChanged() { return mySignalViewChanged; }
+
+protected:
+
+  //! Item of list model referring to the tree node.
+  class Item;
+
+  //! Create model of node children for expanded row, or NULL for leaf.
+  Glib::RefPtr<Gio::ListModel> createChildModel(const Glib::RefPtr<Glib::ObjectBase>& theItem);
+
+  //! Create row widgets.
+  void onSetupRow(const Glib::RefPtr<Gtk::ListItem>& theListItem);
+
+  //! Bind row widgets to the item.
+  void onBindRow(const Glib::RefPtr<Gtk::ListItem>& theListItem);
+
+  //! Unbind row widgets.
+  void onUnbindRow(const Glib::RefPtr<Gtk::ListItem>& theListItem);
+
+  //! Row selection changed event - schedule applying selection to context.
+  void onSelectionChanged(guint thePosition, guint theNbItems);
+
+  //! Apply row selection to context.
+  bool applySelection();
+
+  //! Check button toggled event.
+  void onVisibilityToggled(Gtk::ListItem* theListItem);
+
+  //! Return item of the row.
+  Glib::RefPtr<Item> rowItem(guint thePosition) const;
+
+  //! Find row of the node, expanding its ancestors.
+  //! @return row position or -1 if not found
+  int findRow(int theNode);
+
+  //! Update check buttons of bound rows.
+  void updateChecks();
+
+protected:
+
+  OcctAssemblyTree                  myTree;
+  Handle(AIS_InteractiveContext)    myContext;
+  Gtk::ListView                     myListView;
+  Glib::RefPtr<Gtk::TreeListModel>  myTreeModel;
+  Glib::RefPtr<Gtk::MultiSelection> mySelection;
+  sigc::signal<void()>              mySignalViewChanged;
+  sigc::connection                  mySelectionIdleConn; //!< pending application of row selection
+  bool                              myIsSyncing = false; //!< flag to ignore events caused by synchronization
+
+};
+
+#endif // _OcctGtkAssemblyTree_HeaderFile
@@ -9,6 +9,9 @@
 #include <OpenGl_Context.hxx>
 #include <OpenGl_GraphicDriver.hxx>
 #include <OpenGl_FrameBuffer.hxx>
+#include <Standard_Version.hxx>
+
+#include <algorithm>
 
 #ifdef _WIN32
   //
@@ -27,6 +30,15 @@ bool& OcctGtkGLAreaViewer::ToUseModernInput()
   return toUseModern;
 }
 
+// ================================================================
+// Function : SoftwareProfileMode
+// ================================================================
+OcctSoftwareProfile::Mode& OcctGtkGLAreaViewer::SoftwareProfileMode()
+{
+  static OcctSoftwareProfile::Mode aMode = OcctSoftwareProfile::Mode_Auto;
+  return aMode;
+}
+
 // ================================================================
 // Function : OcctGtkGLAreaViewer
 // ================================================================
@@ -61,11 +73,21 @@ OcctGtkGLAreaViewer::OcctGtkGLAreaViewer(bool theUseModernInput)
   // create AIS context
   myContext = new AIS_InteractiveContext(myViewer);
 
+  // tools changing displayed objects update bounds index per object
+  myResidencyManager.SetBoundsIndex(&myBoundsIndex);
+  myBatch.SetBoundsIndex(&myBoundsIndex);
+
   myViewCube = new AIS_ViewCube();
   myViewCube->SetViewAnimation(myViewAnimation);
   myViewCube->SetFixedAnimationLoop(false);
   myViewCube->SetAutoStartAnimation(true);
 
+  // drive camera and objects animations by frame clock
+  myFrameTimeline.AddAnimation(myViewAnimation);
+#if (OCC_VERSION_HEX >= 0x070600)
+  myFrameTimeline.AddAnimation(ObjectsAnimation());
+#endif
+
   // note - window will be created later within onGlAreaRealized() callback!
   myView = myViewer->CreateView();
   myView->SetImmediateUpdate(false);
@@ -88,6 +110,15 @@ OcctGtkGLAreaViewer::OcctGtkGLAreaViewer(bool theUseModernInput)
   signal_unrealize().connect(sigc::mem_fun(*this, &OcctGtkGLAreaViewer::onGlAreaReleased), false);
   signal_render()   .connect(sigc::mem_fun(*this, &OcctGtkGLAreaViewer::onGlAreaRender), false);
 
+  // wake up GUI thread to execute commands posted by worker threads
+  myCommandDispatcher.connect([this]() { queue_draw(); });
+  myCommandQueue.SetPostedCallback([this]() { myCommandDispatcher.emit(); });
+  myCommandQueue.SetBoundsIndex(&myBoundsIndex);
+
+  // execute idle steps posted by GUI thread or by finished background jobs
+  myIdleDispatcher.connect([this]() { scheduleIdleSteps(); });
+  myIdleScheduler.SetWakeCallback([this]() { myIdleDispatcher.emit(); });
+
   if (theUseModernInput)
   {
     addModernEventControllers();
@@ -116,6 +147,7 @@ void OcctGtkGLAreaViewer::addModernEventControllers()
   {
     if (OcctGtkTools::gtkHandleMotionEvent(*this, myView, Graphic3d_Vec2d(theX, theY), myKeyModifiers))
       queue_draw();
+    updateInputPredictor(Standard_Size(-1));
   }, false);
   add_controller(anEventCtrlMotion);
 
@@ -146,12 +178,14 @@ void OcctGtkGLAreaViewer::addModernEventControllers()
     if (OcctGtkTools::gtkHandleButtonEvent(*this, myView, Graphic3d_Vec2d(theX, theY),
                                            aClickPtr->get_current_button(), myKeyModifiers, true))
       queue_draw();
+    updateInputPredictor(Standard_Size(-1));
   }, false);
   anEventCtrlClick->signal_released().connect([this, aClickPtr](int , double theX, double theY)
   {
     if (OcctGtkTools::gtkHandleButtonEvent(*this, myView, Graphic3d_Vec2d(theX, theY),
                                            aClickPtr->get_current_button(), myKeyModifiers, false))
       queue_draw();
+    updateInputPredictor(Standard_Size(-1));
   }, false);
   anEventCtrlClick->signal_cancel().connect([this, aClickPtr](Gdk::EventSequence* )
   {
@@ -159,6 +193,7 @@ void OcctGtkGLAreaViewer::addModernEventControllers()
     const Aspect_VKeyMouse aButton = OcctGtkTools::gtkMouseButton2VKey(aClickPtr->get_current_button());
     if (AIS_ViewController::ReleaseMouseButton(AIS_ViewController::LastMousePosition(), aButton, myKeyModifiers, false))
       queue_draw();
+    updateInputPredictor(Standard_Size(-1));
   }, false);
   add_controller(anEventCtrlClick);
 
@@ -192,7 +227,19 @@ void OcctGtkGLAreaViewer::addModernEventControllers()
 // ================================================================
 OcctGtkGLAreaViewer::~OcctGtkGLAreaViewer()
 {
-  //
+  myFrameBeforePaintConn.disconnect();
+  myFrameUpdateConn.disconnect();
+  myResizeSettleConn.disconnect();
+  myQualityIdleConn.disconnect();
+  myPredictionExpiryConn.disconnect();
+  myBatchSelectionConn.disconnect();
+  myBoundsSyncConn.disconnect();
+  myCommandQueue.SetPostedCallback(std::function<void()>());
+  myIdleStepsConn.disconnect();
+  myIdleResumeConn.disconnect();
+  myTransformPollConn.disconnect();
+  myIdleScheduler.SetWakeCallback(std::function<void()>());
+  myIdleScheduler.Stop();
 }
 
 // ================================================================
@@ -214,6 +261,7 @@ bool OcctGtkGLAreaViewer::onRawEvent(const Glib::RefPtr<const Gdk::Event>& theEv
       const Aspect_VKeyFlags aFlags = OcctGtkTools::gtkModifiers2VKeys(theEvent->get_modifier_state());
       if (OcctGtkTools::gtkHandleMotionEvent(*this, myView, aPos, aFlags))
         queue_draw();
+      updateInputPredictor(Standard_Size(-1));
 
       return true;
     }
@@ -232,6 +280,7 @@ bool OcctGtkGLAreaViewer::onRawEvent(const Glib::RefPtr<const Gdk::Event>& theEv
                                              aPos, theEvent->get_button(), aFlags,
                                              theEvent->get_event_type() == Gdk::Event::Type::BUTTON_PRESS))
         queue_draw();
+      updateInputPredictor(Standard_Size(-1));
 
       return true;
     }
@@ -245,7 +294,7 @@ bool OcctGtkGLAreaViewer::onRawEvent(const Glib::RefPtr<const Gdk::Event>& theEv
       Graphic3d_Vec2d aPos;
       theEvent->get_position(aPos.x(), aPos.y());
       const Graphic3d_Vec2i aPnt2i(myView->Window()->ConvertPointToBacking(aPos) + Graphic3d_Vec2d(0.5));
-      if (AIS_ViewController::UpdateMouseScroll(Aspect_ScrollDelta(aPnt2i, -aDelta.y())))
+      if (UpdateMouseScroll(Aspect_ScrollDelta(aPnt2i, -aDelta.y())))
         queue_draw();
 
       return true;
@@ -265,13 +314,13 @@ bool OcctGtkGLAreaViewer::onRawEvent(const Glib::RefPtr<const Gdk::Event>& theEv
       if (theEvent->get_event_type() == Gdk::Event::Type::TOUCH_BEGIN)
       {
         hasUpdates = true;
-        AIS_ViewController::AddTouchPoint(aTouchId, aNewPos2d);
+        AddTouchPoint(aTouchId, aNewPos2d);
       }
       else if (theEvent->get_event_type() == Gdk::Event::Type::TOUCH_UPDATE
             && AIS_ViewController::TouchPoints().Contains(aTouchId))
       {
         hasUpdates = true;
-        AIS_ViewController::UpdateTouchPoint(aTouchId, aNewPos2d);
+        UpdateTouchPoint(aTouchId, aNewPos2d);
       }
       else if ((theEvent->get_event_type() == Gdk::Event::Type::TOUCH_END
              || theEvent->get_event_type() == Gdk::Event::Type::TOUCH_CANCEL)
@@ -284,6 +333,7 @@ bool OcctGtkGLAreaViewer::onRawEvent(const Glib::RefPtr<const Gdk::Event>& theEv
         return false;
       }
 
+      updateInputPredictor(aTouchId);
       if (hasUpdates)
         queue_draw();
 
@@ -314,7 +364,7 @@ bool OcctGtkGLAreaViewer::onKey(guint theKeyVal, guint theKeyCode, Gdk::Modifier
 
   const double aTimeStamp = AIS_ViewController::EventTime();
   if (theIsPressed)
-    AIS_ViewController::KeyDown(aVKey, aTimeStamp);
+    KeyDown(aVKey, aTimeStamp);
   else
     AIS_ViewController::KeyUp(aVKey, aTimeStamp);
 
@@ -365,10 +415,38 @@ void OcctGtkGLAreaViewer::processKeyPress(Aspect_VKey theKey)
     }
     case Aspect_VKey_F:
     {
-      myView->FitAll(0.01, false);
+      // include objects evicted by residency manager, which are not displayed;
+      // take scene bounds from bounds index when enabled instead of walking all objects
+      Bnd_Box anEvictedBox = myResidencyManager.EvictedBoundingBox();
+      if (myBoundsIndex.IsEnabled()
+      && !myBoundsIndex.IsDirty()
+       && myBoundsIndex.NbObjects() > 0)
+      {
+        anEvictedBox.Add(myBoundsIndex.BoundingBox());
+        myView->FitAll(anEvictedBox, 0.01, false);
+      }
+      else if (!anEvictedBox.IsVoid())
+      {
+        anEvictedBox.Add(myView->View()->MinMaxValues());
+        myView->FitAll(anEvictedBox, 0.01, false);
+      }
+      else
+      {
+        myView->FitAll(0.01, false);
+      }
       queue_draw();
       break;
     }
+    case Aspect_VKey_H:
+    {
+      SetHiddenLineMode(!IsHiddenLineMode());
+      break;
+    }
+    case Aspect_VKey_C:
+    {
+      SetSectionMode(!IsSectionMode());
+      break;
+    }
   }
 }
 
@@ -378,14 +456,50 @@ void OcctGtkGLAreaViewer::processKeyPress(Aspect_VKey theKey)
 void OcctGtkGLAreaViewer::handleViewRedraw(const Handle(AIS_InteractiveContext)& theCtx,
                                            const Handle(V3d_View)& theView)
 {
-  AIS_ViewController::handleViewRedraw(theCtx, theView);
+  // manipulator is dragged within dynamic highlighting preceding redraw, so that plane is moved within the same frame
+  if (!mySectionPlane.IsNull())
+    updateSectionPlane(theCtx, theView);
+
+  // update animations in the same way as AIS_ViewController::handleViewRedraw(),
+  // while the view itself is redrawn by rendering callback
+  myUpdateStartPointRot  = false;
+  myUpdateStartPointZRot = false;
+  myUpdateStartPointPan  = false;
+  myToAskNextFrame = myIsContinuousRedraw;
+  if (!myViewAnimation->IsStopped())
+  {
+    myViewAnimation->UpdateTimer();
+    ResetPreviousMoveTo();
+    myToAskNextFrame = true;
+  }
+#if (OCC_VERSION_HEX >= 0x070600)
+  if (!ObjectsAnimation()->IsStopped())
+  {
+    ObjectsAnimation()->UpdateTimer();
+    ResetPreviousMoveTo();
+    myToAskNextFrame = true;
+  }
+#endif
+
+  // camera is updated by handled events, so that changed presentations are shown by this frame
+  if (!myHiddenLines.IsNull()
+    && updateHiddenLines())
+  {
+    theView->Invalidate();
+    queue_draw();
+  }
   if (myToAskNextFrame != (myAnimationCallback != 0))
   {
     if (myToAskNextFrame)
     {
-      // start animation
-      myAnimationCallback = add_tick_callback([this](const Glib::RefPtr<Gdk::FrameClock>&) -> bool
+      // start animation - tick callbacks are called within frame clock update phase,
+      // so that animations are updated to predicted presentation time before painting
+      myAnimationCallback = add_tick_callback([this](const Glib::RefPtr<Gdk::FrameClock>& theClock) -> bool
       {
+        gint64 aRefreshInterval = 0, aPresentTime = 0;
+        const gint64 aFrameTime = theClock->get_frame_time();
+        theClock->get_refresh_info(aFrameTime, aRefreshInterval, aPresentTime);
+        myFrameTimeline.Advance(aFrameTime, aPresentTime, aRefreshInterval);
         queue_draw();
         return true;
       });
@@ -395,8 +509,552 @@ void OcctGtkGLAreaViewer::handleViewRedraw(const Handle(AIS_InteractiveContext)&
       // stop animation
       remove_tick_callback(myAnimationCallback);
       myAnimationCallback = 0;
+      myFrameTimeline.Stop();
+      scheduleIdleSteps();
+    }
+  }
+}
+
+// ================================================================
+// Function : updateInputPredictor
+// ================================================================
+void OcctGtkGLAreaViewer::updateInputPredictor(Standard_Size theTouchId)
+{
+  if (!myInputPredictor.IsActive())
+    return;
+
+  // only mouse dragging or single touch are predicted
+  bool isDragging = false;
+  Graphic3d_Vec2d aPnt;
+  if (theTouchId == Standard_Size(-1))
+  {
+    isDragging = AIS_ViewController::PressedMouseButtons() != Aspect_VKeyMouse_NONE
+              && AIS_ViewController::TouchPoints().IsEmpty();
+    aPnt = Graphic3d_Vec2d(AIS_ViewController::LastMousePosition());
+  }
+  else if (AIS_ViewController::TouchPoints().Extent() == 1
+        && AIS_ViewController::TouchPoints().Contains(theTouchId))
+  {
+    isDragging = true;
+    aPnt = AIS_ViewController::TouchPoints().FindFromKey(theTouchId).To;
+  }
+
+  if (!isDragging || theTouchId != myPredictedTouch)
+  {
+    myInputPredictor.Reset();
+    myPredictedTouch = theTouchId;
+  }
+  if (isDragging)
+  {
+    myRealPointerPos = aPnt;
+    myInputPredictor.AddSample(double(g_get_monotonic_time()) * 0.000001, aPnt);
+  }
+}
+
+// ================================================================
+// Function : applyInputPrediction
+// ================================================================
+void OcctGtkGLAreaViewer::applyInputPrediction()
+{
+  if (!myInputPredictor.IsActive())
+    return;
+
+  // frame will be presented not earlier than rendering is done
+  const double aNow = double(g_get_monotonic_time()) * 0.000001;
+  double aTargetTime = aNow + myInputPredictor.FrameDuration();
+  if (Glib::RefPtr<Gdk::FrameClock> aClock = get_frame_clock())
+  {
+    gint64 aRefreshInterval = 0, aPresentTime = 0;
+    aClock->get_refresh_info(aClock->get_frame_time(), aRefreshInterval, aPresentTime);
+    if (aPresentTime != 0)
+      aTargetTime = std::max(aTargetTime, double(aPresentTime) * 0.000001);
+  }
+
+  Graphic3d_Vec2d aPnt;
+  if (!myInputPredictor.Predict(aNow, aTargetTime, aPnt))
+    return;
+
+  // controller maps pointer to camera relative to gesture start,
+  // so that predicted position is corrected by the next real event
+  if (myPredictedTouch == Standard_Size(-1))
+  {
+    if (myMouseActiveGesture == AIS_MouseGesture_RotateOrbit
+     || myMouseActiveGesture == AIS_MouseGesture_RotateView
+     || myMouseActiveGesture == AIS_MouseGesture_Pan)
+    {
+      AIS_ViewController::UpdateMousePosition(Graphic3d_Vec2i(aPnt + Graphic3d_Vec2d(0.5)),
+                                              AIS_ViewController::PressedMouseButtons(),
+                                              AIS_ViewController::LastMouseFlags(), false);
+      myIsPredictionApplied = true;
     }
   }
+  else if (AIS_ViewController::TouchPoints().Contains(myPredictedTouch))
+  {
+    AIS_ViewController::UpdateTouchPoint(myPredictedTouch, aPnt);
+    myIsPredictionApplied = true;
+  }
+}
+
+// ================================================================
+// Function : restoreInputPosition
+// ================================================================
+void OcctGtkGLAreaViewer::restoreInputPosition()
+{
+  if (!myIsPredictionApplied)
+    return;
+
+  // predicted position affects only the rendered frame - controller keeps the real one,
+  // so that the next frame moves camera back unless prediction is applied again
+  myIsPredictionApplied = false;
+  if (myPredictedTouch == Standard_Size(-1))
+  {
+    AIS_ViewController::UpdateMousePosition(Graphic3d_Vec2i(myRealPointerPos + Graphic3d_Vec2d(0.5)),
+                                            AIS_ViewController::PressedMouseButtons(),
+                                            AIS_ViewController::LastMouseFlags(), false);
+  }
+  else if (AIS_ViewController::TouchPoints().Contains(myPredictedTouch))
+  {
+    AIS_ViewController::UpdateTouchPoint(myPredictedTouch, myRealPointerPos);
+  }
+
+  // no events come after pointer stops - redraw the view with real position once prediction expires
+  if (!myPredictionExpiryConn.connected())
+  {
+    myPredictionExpiryConn = Glib::signal_timeout().connect([this]() -> bool
+    {
+      queue_draw();
+      return false;
+    }, (unsigned int )(myInputPredictor.FitWindow() * 1000.0) + 1);
+  }
+}
+
+// ================================================================
+// Function : applySoftwareProfile
+// ================================================================
+void OcctGtkGLAreaViewer::applySoftwareProfile()
+{
+  const TCollection_AsciiString aRenderer = OcctSoftwareProfile::GlRenderer(myView);
+  const bool isSoftware = OcctSoftwareProfile::IsSoftwareRenderer(aRenderer);
+  if (SoftwareProfileMode() == OcctSoftwareProfile::Mode_Off
+   || (SoftwareProfileMode() == OcctSoftwareProfile::Mode_Auto && !isSoftware))
+  {
+    return;
+  }
+
+  Message::SendInfo() << "Software rasterizer profile is applied (GL_RENDERER: " << aRenderer << ")";
+
+  // governor captures full quality parameters on enabling, so that it is re-enabled with profile applied;
+  // lower render resolution scale during motion is left to the governor
+  const bool hasGovernor = myQualityGovernor.IsEnabled();
+  myQualityGovernor.SetEnabled(myContext, myView, false);
+  if (!hasGovernor)
+    myQualityGovernor.SetTargetFps(20.0);
+
+  OcctSoftwareProfile::Apply(myView);
+  myQualityGovernor.SetEnabled(myContext, myView, true);
+}
+
+// ================================================================
+// Function : handleSelectionPoly
+// ================================================================
+void OcctGtkGLAreaViewer::handleSelectionPoly(const Handle(AIS_InteractiveContext)& theCtx,
+                                              const Handle(V3d_View)& theView)
+{
+  if (!myParallelSelector.IsEnabled()
+   || !myGL.Selection.ToApplyTool
+   || myGL.Selection.Points.Size() < 2
+   || (myGL.Selection.Tool != AIS_ViewSelectionTool_RubberBand
+    && myGL.Selection.Tool != AIS_ViewSelectionTool_Polygon))
+  {
+    AIS_ViewController::handleSelectionPoly(theCtx, theView);
+    return;
+  }
+
+#if (OCC_VERSION_HEX >= 0x070600)
+  // same logic as AIS_ViewController::handleSelectionPoly(), but using parallel selection engine
+  myGL.Selection.ToApplyTool = false;
+  if (!theCtx->IsDisplayed(myRubberBand))
+    return;
+
+  theCtx->Remove(myRubberBand, false);
+  myRubberBand->ClearPoints();
+  if (myGL.Selection.Tool == AIS_ViewSelectionTool_RubberBand)
+  {
+    const Graphic3d_Vec2i aPnt1 = myGL.Selection.Points.First();
+    const Graphic3d_Vec2i aPnt2 = myGL.Selection.Points.Last();
+    // overlap detection is allowed when rectangle is dragged upwards (AIS_ViewController convention)
+    const bool toAllowOverlap = aPnt1.y() != Min(aPnt1.y(), aPnt2.y());
+    myParallelSelector.SelectRectangle(theCtx,
+                                       Graphic3d_Vec2i(Min(aPnt1.x(), aPnt2.x()), Min(aPnt1.y(), aPnt2.y())),
+                                       Graphic3d_Vec2i(Max(aPnt1.x(), aPnt2.x()), Max(aPnt1.y(), aPnt2.y())),
+                                       theView, myGL.Selection.Scheme, toAllowOverlap);
+  }
+  else
+  {
+    TColgp_Array1OfPnt2d aPolyline(1, myGL.Selection.Points.Size());
+    int aPntIndex = 1;
+    for (NCollection_Sequence<Graphic3d_Vec2i>::Iterator aPntIter(myGL.Selection.Points); aPntIter.More(); aPntIter.Next())
+      aPolyline.SetValue(aPntIndex++, gp_Pnt2d(aPntIter.Value().x(), aPntIter.Value().y()));
+
+    myParallelSelector.SelectPolygon(theCtx, aPolyline, theView, myGL.Selection.Scheme);
+  }
+  OnSelectionChanged(theCtx, theView);
+#endif
+}
+
+// ================================================================
+// Function : OnSelectionChanged
+// ================================================================
+void OcctGtkGLAreaViewer::OnSelectionChanged(const Handle(AIS_InteractiveContext)& ,
+                                             const Handle(V3d_View)& )
+{
+  mySignalSelectionChanged.emit();
+}
+
+// ================================================================
+// Function : ApplyBatch
+// ================================================================
+void OcctGtkGLAreaViewer::ApplyBatch()
+{
+  if (myBatch.IsEmpty())
+    return;
+
+  myBatch.Apply(myContext);
+
+  if (myBatch.HasPendingSelection()
+  && !myBatchSelectionConn.connected())
+  {
+    // activate selection in short slices to keep UI responsive
+    myBatchSelectionConn = Glib::signal_idle().connect([this]() -> bool
+    {
+      return myBatch.ActivatePendingSelection(myContext, 0.01);
+    });
+  }
+  myView->Invalidate();
+  queue_draw();
+}
+
+// ================================================================
+// Function : onViewerInput
+// ================================================================
+void OcctGtkGLAreaViewer::onViewerInput()
+{
+  myIdleScheduler.Pause();
+  myIdleStepsConn.disconnect();
+  myIdleResumeConn.disconnect();
+  myIdleResumeConn = Glib::signal_timeout().connect([this]() -> bool
+  {
+    myIdleScheduler.Resume();
+    scheduleIdleSteps();
+    return false;
+  }, (unsigned int )(myIdleScheduler.IdleDelay() * 1000.0));
+}
+
+// ================================================================
+// Function : scheduleIdleSteps
+// ================================================================
+void OcctGtkGLAreaViewer::scheduleIdleSteps()
+{
+  if (myIdleStepsConn.connected()
+   || myIdleScheduler.IsPaused()
+   || !myIdleScheduler.HasIdleSteps())
+  {
+    return;
+  }
+
+  // default idle priority is lower than input and redraw, so that slices are executed only when main loop has nothing else to do;
+  // while view is animated, steps are executed by rendering callback within spare frame time instead
+  myIdleStepsConn = Glib::signal_idle().connect([this]() -> bool
+  {
+    return myAnimationCallback == 0
+        && myIdleScheduler.RunIdleSteps(myIdleScheduler.SliceBudget());
+  });
+}
+
+// ================================================================
+// Function : SetHiddenLineMode
+// ================================================================
+void OcctGtkGLAreaViewer::SetHiddenLineMode(bool theToEnable)
+{
+  if (theToEnable == IsHiddenLineMode())
+    return;
+
+  myIdleScheduler.Cancel(myHiddenLinesTask);
+  myHiddenLinesTask = 0;
+  if (theToEnable)
+  {
+    // hidden lines are computed for orthographic projection
+    myHiddenLines = new OcctHiddenLines();
+    myHiddenLines->Attach(myContext);
+    myHiddenLinesProj = myView->Camera()->ProjectionType();
+    myView->Camera()->SetProjectionType(Graphic3d_Camera::Projection_Orthographic);
+  }
+  else
+  {
+    myHiddenLines->Detach(myContext, myView);
+    myHiddenLines.Nullify();
+    myView->Camera()->SetProjectionType(myHiddenLinesProj);
+  }
+  if (myBoundsIndex.IsEnabled())
+    myBoundsIndex.Synchronize(myContext);
+
+  myView->Invalidate();
+  queue_draw();
+}
+
+// ================================================================
+// Function : invalidateBoundsIndex
+// ================================================================
+void OcctGtkGLAreaViewer::invalidateBoundsIndex()
+{
+  if (!myBoundsIndex.IsEnabled())
+    return;
+
+  myBoundsIndex.MarkDirty();
+  if (myBoundsSyncConn.connected())
+    return;
+
+  // walking all objects is deferred out of the frame
+  myBoundsSyncConn = Glib::signal_idle().connect([this]() -> bool
+  {
+    if (myBoundsIndex.IsEnabled())
+      myBoundsIndex.Synchronize(myContext);
+
+    queue_draw();
+    return false;
+  });
+}
+
+// ================================================================
+// Function : updateHiddenLines
+// ================================================================
+bool OcctGtkGLAreaViewer::updateHiddenLines()
+{
+  const gp_Dir aViewDir = myView->Camera()->Direction();
+  if (myHiddenLines->IsShown(aViewDir))
+    return false;
+
+  OcctHiddenLines::Result aResult;
+  if (myHiddenLines->FindCached(aViewDir, aResult))
+  {
+    myIdleScheduler.Cancel(myHiddenLinesTask);
+    myHiddenLinesTask = 0;
+    myHiddenLines->Show(myContext, myView, aResult, aViewDir);
+    invalidateBoundsIndex();
+    return true;
+  }
+
+  // keep shaded view while computing
+  bool isChanged = myHiddenLines->ShowShaded(myContext, myView);
+  if (isChanged)
+    invalidateBoundsIndex();
+  if (!myViewAnimation->IsStopped()
+   || myHiddenLines->NbShapes() == 0
+   || (myHiddenLinesTask != 0 && myHiddenLinesDir.IsEqual(aViewDir, 1.0e-4)))
+  {
+    return isChanged;
+  }
+
+  // previous computation is cancelled between groups of shapes; result is picked from cache by the next redraw
+  myIdleScheduler.Cancel(myHiddenLinesTask);
+  myHiddenLinesDir = aViewDir;
+  Handle(OcctHiddenLines) aHiddenLines = myHiddenLines;
+  myHiddenLinesTask = myIdleScheduler.PostJob("Hidden lines", OcctIdleScheduler::Priority_Normal,
+                                              [aHiddenLines, aViewDir](OcctIdleScheduler::JobContext& theJobCtx)
+  {
+    OcctHiddenLines::Result aJobResult;
+    if (aHiddenLines->Perform(aViewDir, [&theJobCtx]() { return !theJobCtx.Yield(); }, aJobResult))
+      Message::SendInfo() << aHiddenLines->FormatStatistics();
+  },
+  [this]() -> bool
+  {
+    myHiddenLinesTask = 0;
+    myView->Invalidate();
+    queue_draw();
+    return false;
+  });
+  return isChanged;
+}
+
+// ================================================================
+// Function : SetSectionMode
+// ================================================================
+void OcctGtkGLAreaViewer::SetSectionMode(bool theToEnable)
+{
+  if (theToEnable == IsSectionMode())
+    return;
+
+  if (theToEnable)
+  {
+    mySectionPlane = new OcctSectionPlane();
+    mySectionPlane->Attach(myContext, myView);
+  }
+  else
+  {
+    mySectionPlane->Detach(myContext, myView);
+    mySectionPlane.Nullify();
+  }
+  myIsSectionDragged = false;
+  if (myBoundsIndex.IsEnabled())
+    myBoundsIndex.Synchronize(myContext);
+
+  myView->Invalidate();
+  queue_draw();
+}
+
+// ================================================================
+// Function : updateSectionPlane
+// ================================================================
+void OcctGtkGLAreaViewer::updateSectionPlane(const Handle(AIS_InteractiveContext)& theCtx,
+                                             const Handle(V3d_View)& theView)
+{
+  if (mySectionPlane->Update())
+    theView->Invalidate();
+
+  // picking respects view clipping, so that sensitive entities of clipped objects are not updated while dragging;
+  // detection under cursor is refreshed once instead of following each intermediate plane position
+  const bool isDragged = !myDragObject.IsNull()
+                      && myDragObject == mySectionPlane->Manipulator();
+  if (myIsSectionDragged
+   && !isDragged)
+  {
+    const Graphic3d_Vec2i aPnt = AIS_ViewController::LastMousePosition();
+    theCtx->MoveTo(aPnt.x(), aPnt.y(), theView, false);
+  }
+  myIsSectionDragged = isDragged;
+}
+
+// ================================================================
+// Function : UpdateMouseButtons
+// ================================================================
+bool OcctGtkGLAreaViewer::UpdateMouseButtons(const Graphic3d_Vec2i& thePoint,
+                                             Aspect_VKeyMouse theButtons,
+                                             Aspect_VKeyFlags theModifiers,
+                                             bool theIsEmulated)
+{
+  onViewerInput();
+  return AIS_ViewController::UpdateMouseButtons(thePoint, theButtons, theModifiers, theIsEmulated);
+}
+
+// ================================================================
+// Function : UpdateMousePosition
+// ================================================================
+bool OcctGtkGLAreaViewer::UpdateMousePosition(const Graphic3d_Vec2i& thePoint,
+                                              Aspect_VKeyMouse theButtons,
+                                              Aspect_VKeyFlags theModifiers,
+                                              bool theIsEmulated)
+{
+  onViewerInput();
+  return AIS_ViewController::UpdateMousePosition(thePoint, theButtons, theModifiers, theIsEmulated);
+}
+
+// ================================================================
+// Function : UpdateMouseScroll
+// ================================================================
+bool OcctGtkGLAreaViewer::UpdateMouseScroll(const Aspect_ScrollDelta& theDelta)
+{
+  onViewerInput();
+  return AIS_ViewController::UpdateMouseScroll(theDelta);
+}
+
+// ================================================================
+// Function : AddTouchPoint
+// ================================================================
+void OcctGtkGLAreaViewer::AddTouchPoint(Standard_Size theId,
+                                        const Graphic3d_Vec2d& thePnt,
+                                        Standard_Boolean theClearBefore)
+{
+  onViewerInput();
+  AIS_ViewController::AddTouchPoint(theId, thePnt, theClearBefore);
+}
+
+// ================================================================
+// Function : UpdateTouchPoint
+// ================================================================
+void OcctGtkGLAreaViewer::UpdateTouchPoint(Standard_Size theId,
+                                           const Graphic3d_Vec2d& thePnt)
+{
+  onViewerInput();
+  AIS_ViewController::UpdateTouchPoint(theId, thePnt);
+}
+
+// ================================================================
+// Function : KeyDown
+// ================================================================
+void OcctGtkGLAreaViewer::KeyDown(Aspect_VKey theKey,
+                                  double theTime,
+                                  double thePressure)
+{
+  onViewerInput();
+  AIS_ViewController::KeyDown(theKey, theTime, thePressure);
+}
+
+// ================================================================
+// Function : SetTransformChannel
+// ================================================================
+void OcctGtkGLAreaViewer::SetTransformChannel(const Handle(OcctTransformChannel)& theChannel)
+{
+  if (myTransformCallback != 0)
+  {
+    remove_tick_callback(myTransformCallback);
+    myTransformCallback = 0;
+  }
+
+  myTransformPollConn.disconnect();
+
+  myTransformChannel = theChannel;
+  if (myTransformChannel.IsNull())
+    return;
+
+  startTransformTicks();
+}
+
+// ================================================================
+// Function : startTransformTicks
+// ================================================================
+void OcctGtkGLAreaViewer::startTransformTicks()
+{
+  myTransformPollConn.disconnect();
+
+  // pick up the latest transformations once per frame, regardless of the producer rate
+  myTransformCallback = add_tick_callback([this](const Glib::RefPtr<Gdk::FrameClock>& theClock) -> bool
+  {
+    const double aFrameTime = double(theClock->get_frame_time()) * 0.000001;
+    if (!myTransformChannel->Apply(myContext, aFrameTime))
+    {
+      if (myTransformChannel->IsMoving())
+        return true;
+
+      // nothing has been published within settle time and selection has been updated - stop ticking every frame
+      // and check for newly published sets at low rate (feeder thread or Push() might resume motion later)
+      myTransformCallback = 0;
+      myTransformPollConn = Glib::signal_timeout().connect([this]() -> bool
+      {
+        if (myTransformChannel.IsNull()
+        || !myTransformChannel->HasPublishedSet())
+        {
+          return !myTransformChannel.IsNull();
+        }
+
+        startTransformTicks();
+        return false;
+      }, 50);
+      return false;
+    }
+
+    if (myBoundsIndex.IsEnabled())
+    {
+      for (const OcctTransformChannel::Entry& anEntry : myTransformChannel->CurrentSet())
+      {
+        Handle(AIS_InteractiveObject) anObj = myTransformChannel->Object(anEntry.Object);
+        if (!anObj.IsNull())
+          myBoundsIndex.Update(anObj);
+      }
+    }
+    myView->Invalidate();
+    queue_draw();
+    return true;
+  });
 }
 
 // ================================================================
@@ -500,11 +1158,13 @@ void OcctGtkGLAreaViewer::onGlAreaRealized()
       aMsg->show();
     }
     make_current();
+    connectFrameClock();
 
     dumpGlInfo(true, false);
     if (isFirstInit)
     {
       myContext->Display(myViewCube, 0, 0, false);
+      applySoftwareProfile();
     }
   }
   catch (const Gdk::GLError& theGlErr)
@@ -533,6 +1193,10 @@ void OcctGtkGLAreaViewer::onGlAreaReleased()
     Handle(Aspect_DisplayConnection) aDisp;
     if (!myView.IsNull())
     {
+      myFrameBeforePaintConn.disconnect();
+      myFrameUpdateConn.disconnect();
+      myLiveResize.Release(myView);
+      myQualityGovernor.ReleaseGl(myView);
       aDisp = myViewer->Driver()->GetDisplayConnection();
       myView->Remove();
       myView.Nullify();
@@ -549,6 +1213,123 @@ void OcctGtkGLAreaViewer::onGlAreaReleased()
   }
 }
 
+// ================================================================
+// Function : size_allocate_vfunc
+// ================================================================
+void OcctGtkGLAreaViewer::size_allocate_vfunc(int theWidth, int theHeight, int theBaseline)
+{
+  // Gtk::GLArea reallocates its buffers only before rendering the next frame,
+  // so that they still keep the last frame at the start of resize
+  if (!myView.IsNull()
+   && !myView->Window().IsNull())
+  {
+    Graphic3d_Vec2i aViewSize;
+    myView->Window()->Size(aViewSize.x(), aViewSize.y());
+    const Graphic3d_Vec2i aNewSize = Graphic3d_Vec2i(Graphic3d_Vec2d(theWidth, theHeight) * myDevicePixelRatio + Graphic3d_Vec2d(0.5));
+    if (aNewSize != aViewSize)
+    {
+      make_current();
+      myLiveResize.BeginResize(myView);
+    }
+  }
+  Gtk::GLArea::size_allocate_vfunc(theWidth, theHeight, theBaseline);
+}
+
+// ================================================================
+// Function : connectFrameClock
+// ================================================================
+void OcctGtkGLAreaViewer::connectFrameClock()
+{
+  myFrameBeforePaintConn.disconnect();
+  myFrameUpdateConn.disconnect();
+  Glib::RefPtr<Gdk::FrameClock> aClock = get_frame_clock();
+  if (!aClock)
+    return;
+
+  // update phase is emitted only when requested or while tick callbacks are running,
+  // while before-paint is emitted by every frame (including frames requested by queue_draw())
+  myFrameBeforePaintConn = aClock->signal_before_paint().connect([this]()
+  {
+    if (Glib::RefPtr<Gdk::FrameClock> aFrameClock = get_frame_clock())
+      aFrameClock->request_phase(Gdk::FrameClock::Phase::UPDATE);
+  });
+  // connected after default handler, so that tick callbacks advancing animations are called first
+  myFrameUpdateConn = aClock->signal_update().connect(sigc::mem_fun(*this, &OcctGtkGLAreaViewer::onFrameClockUpdate), true);
+}
+
+// ================================================================
+// Function : onFrameClockUpdate
+// ================================================================
+void OcctGtkGLAreaViewer::onFrameClockUpdate()
+{
+  if (myView.IsNull()
+   || myView->Window().IsNull())
+  {
+    return;
+  }
+
+  // scene changes may release OpenGL resources
+  make_current();
+  myFrameUpdateTime = g_get_monotonic_time();
+
+  // execute scene commands posted by worker threads within per-frame budget,
+  // and request the next frame for commands left out of budget
+  if (myCommandQueue.Drain(myContext, myView) > 0)
+  {
+    // bounds are updated per command; arbitrary commands leave the index dirty for synchronization out of frame
+    if (myBoundsIndex.IsDirty())
+      invalidateBoundsIndex();
+    if (!myCommandQueue.IsEmpty())
+      myCommandDispatcher.emit();
+  }
+
+  // release GPU memory of hidden and long off-screen objects or upload back objects entering view frustum
+  myResidencyManager.Update(myContext, myView);
+  mySignalBeforeRedraw.emit();
+
+  // flush pending input events with dragged pointer extrapolated to expected presentation time of this frame
+  applyInputPrediction();
+  AIS_ViewController::FlushViewEvents(myContext, myView, true);
+  restoreInputPosition();
+  if (myView->IsInvalidated()
+   || myView->IsInvalidatedImmediate()
+   || myToAskNextFrame)
+  {
+    queue_draw();
+  }
+}
+
+// ================================================================
+// Function : redrawView
+// ================================================================
+void OcctGtkGLAreaViewer::redrawView()
+{
+  // fit depth range to objects within view frustum using bounds index instead of automatic z-fit;
+  // automatic z-fit is kept while camera animation is running (as well as while the index is dirty)
+  const bool wasAutoZFit = myView->AutoZFitMode();
+  const bool toFitByIndex = myBoundsIndex.IsEnabled()
+                         && myViewAnimation->IsStopped()
+                         && myBoundsIndex.ZFit(myView);
+  if (toFitByIndex)
+    myView->SetAutoZFitMode(false, myView->AutoZFitScaleFactor());
+
+  if (myView->IsInvalidated()
+   || myToAskNextFrame)
+  {
+    if (myView->ComputedMode())
+      myView->Update();
+    else
+      myView->Redraw();
+  }
+  else if (myView->IsInvalidatedImmediate())
+  {
+    myView->RedrawImmediate();
+  }
+
+  if (toFitByIndex)
+    myView->SetAutoZFitMode(wasAutoZFit, myView->AutoZFitScaleFactor());
+}
+
 // ================================================================
 // Function : onGlAreaRender
 // ================================================================
@@ -571,7 +1352,7 @@ bool OcctGtkGLAreaViewer::onGlAreaRender(const Glib::RefPtr<Gdk::GLContext>& the
     throw_if_error();
 
     // wrap FBO created by Gtk::GLArea
-    if (!OcctGlTools::InitializeGlFbo(myView))
+    if (!OcctGlTools::InitializeGlFbo(myView, false))
     {
       Gtk::MessageDialog* aMsg = new Gtk::MessageDialog("Default FBO wrapper creation failed", false, Gtk::MessageType::ERROR);
       aMsg->set_title("Critical error: 3D Viewer initialization failure");
@@ -580,6 +1361,19 @@ bool OcctGtkGLAreaViewer::onGlAreaRender(const Glib::RefPtr<Gdk::GLContext>& the
       return false;
     }
 
+    // stretch the last frame while window is being resized,
+    // and resize view (reallocating its offscreen buffers) only after size settles
+    if (myLiveResize.Update(myView))
+    {
+      myResizeSettleConn.disconnect();
+      myResizeSettleConn = Glib::signal_timeout().connect([this]() -> bool
+      {
+        queue_draw();
+        return false;
+      }, (unsigned int )(myLiveResize.SettleTimeout() * 1000.0) + 1);
+      return true;
+    }
+
     // calculate pixel ratio between OpenGL FBO viewport dimension and Gtk::GLArea logical size
     const Graphic3d_Vec2i aLogicalSize(get_width(), get_height());
     Graphic3d_Vec2i aViewSize; myView->Window()->Size(aViewSize.x(), aViewSize.y());
@@ -594,9 +1388,40 @@ bool OcctGtkGLAreaViewer::onGlAreaRender(const Glib::RefPtr<Gdk::GLContext>& the
       dumpGlInfo(true, false);
     }
 
-    // flush pending input events and redraw the viewer
+    // scene has been updated within frame clock update phase - just redraw the view
+    const gint64 aRenderStart = g_get_monotonic_time();
+    myQualityGovernor.BeginFrame(myContext, myView);
     myView->InvalidateImmediate();
-    AIS_ViewController::FlushViewEvents(myContext, myView, true);
+    redrawView();
+    if (myFrameUpdateTime != 0)
+      myInputPredictor.AddFrameDuration(double(g_get_monotonic_time() - myFrameUpdateTime) * 0.000001);
+    if (myQualityGovernor.IsEnabled())
+    {
+      // GPU time is taken from timer queries by governor, and full quality is restored when view becomes idle;
+      // single timer is kept while frames are coming
+      myQualityLastFrame = g_get_monotonic_time();
+      myQualityGovernor.EndFrame(myContext, myView, double(myQualityLastFrame - aRenderStart) * 0.000001);
+      if (!myQualityIdleConn.connected())
+      {
+        myQualityIdleConn = Glib::signal_timeout().connect([this]() -> bool
+        {
+          if (double(g_get_monotonic_time() - myQualityLastFrame) * 0.000001 < myQualityGovernor.IdleTimeout())
+            return true;
+
+          if (myQualityGovernor.RestoreFullQuality(myContext, myView))
+            queue_draw();
+          return false;
+        }, std::max((unsigned int )(myQualityGovernor.IdleTimeout() * 250.0), 1u));
+      }
+    }
+    if (myAnimationCallback != 0)
+    {
+      // share the rest of animated frame with idle steps, as idle callback is not called while view is animated
+      const double aSpareTime = myIdleScheduler.FrameBudget() - double(g_get_monotonic_time() - aRenderStart) * 0.000001;
+      if (aSpareTime > 0.0)
+        myIdleScheduler.RunIdleSteps(aSpareTime);
+    }
+    mySignalViewRendered.emit();
     if (isFirstInit)
       dumpGlInfo(true, true);
 
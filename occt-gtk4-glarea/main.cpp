@@ -11,16 +11,19 @@
 
 #include <gtkmm.h>
 
+#include <cctype>
+#include <cstdlib>
+
 int main(int theNbArgs, char* theArgVec[])
 {
-  // remove parsed argument as Gtk::Application will complain on unknown arguments
-  auto removeArgument = [&theNbArgs, &theArgVec](int& theArgIter)
+  // remove parsed arguments as Gtk::Application will complain on unknown arguments
+  auto removeArgument = [&theNbArgs, &theArgVec](int& theArgIter, int theNbToRemove)
   {
-    if (theArgIter + 1 < theNbArgs)
-      theArgVec[theArgIter] = theArgVec[theArgIter + 1];
+    for (int anArgIter = theArgIter; anArgIter + theNbToRemove < theNbArgs; ++anArgIter)
+      theArgVec[anArgIter] = theArgVec[anArgIter + theNbToRemove];
 
     --theArgIter;
-    --theNbArgs;
+    theNbArgs -= theNbToRemove;
   };
 
   // handle application-specific arguments
@@ -30,19 +33,120 @@ int main(int theNbArgs, char* theArgVec[])
      || std::strcmp(theArgVec[anArgIter], "--verbose") == 0)
     {
       // enable verbose messages from OCCT algorithms
-      removeArgument(anArgIter);
+      removeArgument(anArgIter, 1);
       Message::DefaultMessenger()->Printers().First()->SetTraceLevel(Message_Trace);
     }
+    else if (std::strcmp(theArgVec[anArgIter], "--bench") == 0
+          && anArgIter + 1 < theNbArgs)
+    {
+      // run benchmark after the first frame: --bench NAME [SIZE]
+      int aNbToRemove = 2;
+      OcctGtkWindowSample::BenchmarkName() = theArgVec[anArgIter + 1];
+      if (anArgIter + 2 < theNbArgs
+       && std::isdigit((unsigned char )theArgVec[anArgIter + 2][0]))
+      {
+        OcctGtkWindowSample::BenchmarkSize() = std::atoi(theArgVec[anArgIter + 2]);
+        aNbToRemove = 3;
+      }
+      removeArgument(anArgIter, aNbToRemove);
+    }
+    else if (std::strcmp(theArgVec[anArgIter], "--gpubudget") == 0
+          && anArgIter + 1 < theNbArgs)
+    {
+      // GPU memory budget in MiB for evicting hidden and off-screen objects
+      OcctGtkWindowSample::GpuBudgetMiB() = std::atoi(theArgVec[anArgIter + 1]);
+      removeArgument(anArgIter, 2);
+    }
+    else if (std::strcmp(theArgVec[anArgIter], "--fps") == 0
+          && anArgIter + 1 < theNbArgs)
+    {
+      // adjust rendering quality to hold target frame rate
+      OcctGtkWindowSample::TargetFps() = std::atoi(theArgVec[anArgIter + 1]);
+      removeArgument(anArgIter, 2);
+    }
+    else if (std::strcmp(theArgVec[anArgIter], "--swprofile") == 0
+          && anArgIter + 1 < theNbArgs)
+    {
+      // software rasterizer rendering profile: --swprofile auto|on|off
+      const TCollection_AsciiString aMode(theArgVec[anArgIter + 1]);
+      if (aMode == "on")
+        OcctGtkGLAreaViewer::SoftwareProfileMode() = OcctSoftwareProfile::Mode_On;
+      else if (aMode == "off")
+        OcctGtkGLAreaViewer::SoftwareProfileMode() = OcctSoftwareProfile::Mode_Off;
+      else if (aMode == "auto")
+        OcctGtkGLAreaViewer::SoftwareProfileMode() = OcctSoftwareProfile::Mode_Auto;
+      else
+        Message::SendFail() << "Error: unknown --swprofile value '" << aMode << "', expected auto|on|off";
+      removeArgument(anArgIter, 2);
+    }
+    else if (std::strcmp(theArgVec[anArgIter], "--predict") == 0)
+    {
+      // extrapolate dragged pointer to hide rendering latency
+      OcctGtkWindowSample::ToPredictInput() = true;
+      removeArgument(anArgIter, 1);
+    }
+    else if (std::strcmp(theArgVec[anArgIter], "--latencytrace") == 0
+          && anArgIter + 1 < theNbArgs)
+    {
+      // write input latency and prediction errors into CSV file
+      OcctGtkWindowSample::LatencyTracePath() = theArgVec[anArgIter + 1];
+      removeArgument(anArgIter, 2);
+    }
+    else if (std::strcmp(theArgVec[anArgIter], "--import") == 0
+          && anArgIter + 1 < theNbArgs)
+    {
+      // import STEP or glTF file on background thread, or stream STL or PLY mesh
+      OcctGtkWindowSample::ImportPath() = theArgVec[anArgIter + 1];
+      removeArgument(anArgIter, 2);
+    }
+    else if (std::strcmp(theArgVec[anArgIter], "--compact") == 0)
+    {
+      // upload imported triangle-only meshes in compact vertex layout
+      OcctGtkWindowSample::ToUseCompactVertices() = true;
+      removeArgument(anArgIter, 1);
+    }
+    else if (std::strcmp(theArgVec[anArgIter], "--ondemand") == 0)
+    {
+      // show proxy boxes of imported assembly parts and load parts becoming visible
+      OcctGtkWindowSample::ToLoadPartsOnDemand() = true;
+      removeArgument(anArgIter, 1);
+    }
+    else if (std::strcmp(theArgVec[anArgIter], "--heal") == 0)
+    {
+      // heal imported STEP shapes in parallel and print per-part report of fixes
+      OcctGtkWindowSample::ToHealShapes() = true;
+      removeArgument(anArgIter, 1);
+    }
+    else if (std::strcmp(theArgVec[anArgIter], "--pointcloud") == 0
+          && anArgIter + 1 < theNbArgs)
+    {
+      // open point cloud file written by OcctPointCloud::WriteFile()
+      OcctGtkWindowSample::PointCloudPath() = theArgVec[anArgIter + 1];
+      removeArgument(anArgIter, 2);
+    }
+    else if (std::strcmp(theArgVec[anArgIter], "--memreport") == 0
+          && anArgIter + 1 < theNbArgs)
+    {
+      // write memory report into JSON file on closing the window
+      OcctGtkWindowSample::MemoryReportPath() = theArgVec[anArgIter + 1];
+      removeArgument(anArgIter, 2);
+    }
+    else if (std::strcmp(theArgVec[anArgIter], "--boundsindex") == 0)
+    {
+      // serve FitAll and z-range from incrementally updated index of displayed objects bounds
+      OcctGtkWindowSample::ToUseBoundsIndex() = true;
+      removeArgument(anArgIter, 1);
+    }
     else if (std::strcmp(theArgVec[anArgIter], "--modern") == 0
           || std::strcmp(theArgVec[anArgIter], "--moderninput") == 0)
     {
-      removeArgument(anArgIter);
+      removeArgument(anArgIter, 1);
       OcctGtkGLAreaViewer::ToUseModernInput() = true;
     }
     else if (std::strcmp(theArgVec[anArgIter], "--legacy") == 0
           || std::strcmp(theArgVec[anArgIter], "--legacyinput") == 0)
     {
-      removeArgument(anArgIter);
+      removeArgument(anArgIter, 1);
       OcctGtkGLAreaViewer::ToUseModernInput() = false;
     }
   }
@@ -54,6 +158,9 @@ int main(int theNbArgs, char* theArgVec[])
   // should be done in sync with OCCT configurations
   OcctGtkTools::gtkGlPlatformSetup();
 
+  // Mesa threading options should be set before creating OpenGL context
+  OcctSoftwareProfile::SetupMesaEnvironment(OcctGtkGLAreaViewer::SoftwareProfileMode() == OcctSoftwareProfile::Mode_On);
+
   Glib::RefPtr<Gtk::Application> aGtkApp =
     Gtk::Application::create("org.opencascade.samples.gtkmm.glarea",
                              Gio::Application::Flags::NON_UNIQUE);